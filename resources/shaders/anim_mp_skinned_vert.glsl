@@ -0,0 +1,28 @@
+#version 420
+
+
+uniform mat4 u_model;
+uniform mat4 u_viewproj;
+
+layout (location = 0) in vec3 a_position;
+layout (location = 4) in uvec4 a_joints;
+layout (location = 5) in vec4 a_weights;
+
+// Joint palette of every GPU-skinned mesh this frame, one matrix per four RGBA32F texels.
+layout (binding = 5) uniform samplerBuffer u_palette;
+uniform int u_paletteOffset;
+
+mat4 GetSkinMatrix() {
+    mat4 skin = mat4(0.0);
+    for (int i = 0; i < 4; ++i) {
+        int base = (u_paletteOffset + int(a_joints[i])) * 4;
+        skin += mat4(texelFetch(u_palette, base), texelFetch(u_palette, base + 1), texelFetch(u_palette, base + 2), texelFetch(u_palette, base + 3)) * a_weights[i];
+    }
+    return skin;
+}
+
+
+void main() {
+    vec4 vertex = vec4(a_position.xyz, 1.);
+    gl_Position = u_viewproj * u_model * GetSkinMatrix() * vertex;
+}
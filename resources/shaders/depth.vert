@@ -1,13 +1,12 @@
 #version 420
 layout (location = 0) in vec3 aPos;
 layout (location = 2) in vec2 aTexCoord;
-
-uniform mat4 model;
+layout (location = 8) in mat4 aInstanceModel;
 
 
 out vec2 UV;
 void main()
 {
     UV = aTexCoord;
-    gl_Position = model * vec4(aPos, 1.0);
+    gl_Position = aInstanceModel * vec4(aPos, 1.0);
 }
\ No newline at end of file
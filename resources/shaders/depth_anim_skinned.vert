@@ -0,0 +1,28 @@
+#version 420
+layout (location = 0) in vec3 aPos;
+layout (location = 2) in vec2 aTexCoord;
+layout (location = 4) in uvec4 aJoints;
+layout (location = 5) in vec4 aWeights;
+
+uniform mat4 model;
+
+// Joint palette of every GPU-skinned mesh this frame, one matrix per four RGBA32F texels.
+layout (binding = 5) uniform samplerBuffer u_palette;
+uniform int u_paletteOffset;
+
+mat4 GetSkinMatrix()
+{
+    mat4 skin = mat4(0.0);
+    for (int i = 0; i < 4; ++i) {
+        int base = (u_paletteOffset + int(aJoints[i])) * 4;
+        skin += mat4(texelFetch(u_palette, base), texelFetch(u_palette, base + 1), texelFetch(u_palette, base + 2), texelFetch(u_palette, base + 3)) * aWeights[i];
+    }
+    return skin;
+}
+
+out vec2 UV;
+void main()
+{
+    UV = aTexCoord;
+    gl_Position = model * GetSkinMatrix() * vec4(aPos, 1.0);
+}
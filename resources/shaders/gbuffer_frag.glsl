@@ -16,15 +16,18 @@ layout (binding = 0) uniform sampler2D diffuseTexture;
 layout (binding = 1) uniform sampler2D normalTexture;
 layout (binding = 2) uniform sampler2D specularTexture;
 
-uniform int hasDiffuseTexture;
-uniform int hasNormalTexture;
-uniform int hasSpecularTexture;
-
-uniform vec2 textureScale;
-
-uniform float uShininess;// 32.0
-uniform vec3 uDiffuseColor;
-uniform vec3 uEmissiveColor;
+// Per-material data, one buffer per Material; layout matches Rendering::MaterialUniforms.
+layout (std140) uniform MaterialData {
+    vec4 uDiffuseColor;
+    vec4 uSpecularColor;
+    vec4 uAmbientColor;
+    vec4 uEmissiveColor;
+    vec2 textureScale;
+    float uShininess;
+    int hasDiffuseTexture;
+    int hasNormalTexture;
+    int hasSpecularTexture;
+};
 
 void main()
 {
@@ -37,7 +40,7 @@ void main()
     if (sampledDiffuse.a < 0.5)
     discard;
 
-    gAlbedo = vec4(sampledDiffuse.rgb * uDiffuseColor, sampledDiffuse.a);
+    gAlbedo = vec4(sampledDiffuse.rgb * uDiffuseColor.rgb, sampledDiffuse.a);
 
 
     // -------------------------------
@@ -63,5 +66,5 @@ void main()
 
     // -------------------------------
     // Emissive
-    gEmissive = uEmissiveColor;
+    gEmissive = uEmissiveColor.rgb;
 }
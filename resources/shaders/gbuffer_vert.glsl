@@ -5,6 +5,7 @@ layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoord;
 layout (location = 3) in vec3 aTangent;
 layout (location = 4) in vec3 aBitangent;
+layout (location = 8) in mat4 aInstanceModel; // per instance, see GLInstanceBuffer
 
 out VS_OUT {
     vec3 FragPos;
@@ -13,12 +14,23 @@ out VS_OUT {
     mat3 TBN;
 } vs_out;
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+// Per-frame camera / light data; layout matches Rendering::FrameUniforms.
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 invView;
+    mat4 invProjection;
+    vec3 viewPos;
+    float farPlane;
+    vec3 lightDir;
+    int cascadeCount;
+    vec4 cascadeSplits[4]; // cascade plane distances, four per vec4
+};
 
 void main()
 {
+    mat4 model = aInstanceModel;
+
     // World position
     vs_out.FragPos = vec3(model * vec4(aPos, 1.0));
 
@@ -14,13 +14,18 @@ layout (binding = 7) uniform sampler2D gEmissive;
 layout (binding = 8) uniform sampler2D bloomTex;
 
 
-uniform vec3 lightDir;
-uniform vec3 viewPos;
-
-uniform mat4 view;
-uniform mat4 invView;
-uniform mat4 invProjection;
-uniform float farPlane;
+// Per-frame camera / light data; layout matches Rendering::FrameUniforms.
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 invView;
+    mat4 invProjection;
+    vec3 viewPos;
+    float farPlane;
+    vec3 lightDir;
+    int cascadeCount;
+    vec4 cascadeSplits[4]; // cascade plane distances, four per vec4
+};
 
 ////$include resources/shaders/common
 
@@ -28,8 +33,11 @@ uniform float farPlane;
 layout (std140) uniform LightSpaceMatrices {
     mat4 lightSpaceMatrices[16];
 };
-uniform float cascadePlaneDistances[16];
-uniform int cascadeCount;
+
+float CascadePlaneDistance(int i)
+{
+    return cascadeSplits[i / 4][i % 4];
+}
 
 /* ---------- Helpers ---------- */
 
@@ -66,7 +74,7 @@ int GetCascadeLayer(vec3 fragPosWorldSpace)
 {
     float depthValue = abs((view * vec4(fragPosWorldSpace, 1.0)).z);
     for (int i = 0; i < cascadeCount; ++i)
-    if (depthValue < cascadePlaneDistances[i])
+    if (depthValue < CascadePlaneDistance(i))
     return i;
     return cascadeCount - 1;
 }
@@ -113,8 +121,8 @@ float ShadowCalculation(vec3 fragPosWorldSpace, int layer, vec3 normal)
     float viewDepth = abs((view * vec4(fragPosWorldSpace, 1.0)).z);
     if (layer == cascadeCount - 1)
     {
-        float fadeStart = cascadePlaneDistances[cascadeCount - 2];
-        float fadeEnd   = cascadePlaneDistances[cascadeCount - 1];
+        float fadeStart = CascadePlaneDistance(cascadeCount - 2);
+        float fadeEnd   = CascadePlaneDistance(cascadeCount - 1);
         float fade = clamp((fadeEnd - viewDepth) / (fadeEnd - fadeStart), 0.0, 1.0);
         shadow *= fade;
     }
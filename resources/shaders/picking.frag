@@ -1,7 +1,7 @@
 #version 330 core
 
 out vec4 FragColor;
-uniform vec3 entityIDColor;
+flat in vec3 entityIDColor;
 
 void main() {
     FragColor = vec4(entityIDColor, 1.0);
@@ -1,12 +1,27 @@
 #version 330 core
 layout (location = 0) in vec3 aPos;
+layout (location = 8) in mat4 aInstanceModel;
+layout (location = 12) in uint aEntityID;
 
-uniform mat4 view;
-uniform mat4 projection;
-uniform mat4 model;
+// Per-frame camera / light data; layout matches Rendering::FrameUniforms.
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 invView;
+    mat4 invProjection;
+    vec3 viewPos;
+    float farPlane;
+    vec3 lightDir;
+    int cascadeCount;
+    vec4 cascadeSplits[4]; // cascade plane distances, four per vec4
+};
+
+flat out vec3 entityIDColor;
 
 void main()
 {
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
+    gl_Position = projection * view * aInstanceModel * vec4(aPos, 1.0);
 
+    // Same packing as Renderer::EncodeEntityID
+    entityIDColor = vec3(float(aEntityID & 0xFFu), float((aEntityID >> 8) & 0xFFu), float((aEntityID >> 16) & 0xFFu)) / 255.0;
 }
\ No newline at end of file
@@ -10,9 +10,18 @@ layout(binding = 1) uniform sampler2D gNormal;
 layout(binding = 2) uniform sampler2D noiseTex;
 
 uniform vec3 samples[32];
-uniform mat4 projection;
-uniform mat4 invProjection;
-uniform mat4 view;
+// Per-frame camera / light data; layout matches Rendering::FrameUniforms.
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 invView;
+    mat4 invProjection;
+    vec3 viewPos;
+    float farPlane;
+    vec3 lightDir;
+    int cascadeCount;
+    vec4 cascadeSplits[4]; // cascade plane distances, four per vec4
+};
 uniform vec2 screenSize; // SSAO render target size (not OS window size)
 
 const int   kernelSize = 32;
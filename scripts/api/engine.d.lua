@@ -233,6 +233,28 @@ function PhysicsManager:getGravity() end
 ---@return RaycastHit|nil
 function PhysicsManager:raycast(origin, direction, maxDistance) end
 
+--- Fixed physics steps per second.
+---@return number
+function PhysicsManager:getStepRate() end
+
+---@param hz number
+function PhysicsManager:setStepRate(hz) end
+
+--- Steps one frame may run before the remaining time is dropped.
+---@return integer
+function PhysicsManager:getMaxStepsPerFrame() end
+
+---@param steps integer
+function PhysicsManager:setMaxStepsPerFrame(steps) end
+
+--- Position of this frame between the previous and latest physics step, in [0, 1).
+---@return number
+function PhysicsManager:getInterpolationAlpha() end
+
+--- Blend dynamic bodies between the last two steps (default on).
+---@param enabled boolean
+function PhysicsManager:setInterpolation(enabled) end
+
 ---@return PhysicsManager
 function getPhysics() end
 
@@ -33,7 +33,7 @@ namespace Engine {
 		ZoneScoped;
 #ifndef GAME_BUILD
 		// Editor free-fly camera (ImGui-aware). Game builds drive the camera from scripts.
-		if (GetState() != PLAYING) {
+		if (GetState() != PLAYING && !IsHeadless()) {
 			if (GetUI().isOverSceneView() && !ImGui::GetIO().WantTextInput) {
 				const float scroll = GetInput().GetMouseScrollDelta();
 				if (scroll != 0.0f) {
@@ -16,6 +16,7 @@ namespace Engine {
 		void                      onGameStart() override {}
 		void                      onShutdown() override;
 		[[nodiscard]] std::string name() const override { return "CameraModule"; };
+		[[nodiscard]] UpdatePhase updatePhase() const override { return UpdatePhase::FrameBegin; }
 		void                      setLuaBindings() override;
 
 
@@ -10,6 +10,7 @@
 #include "components/impl/AnimationComponent.h"
 #include "components/impl/TransformComponent.h"
 #include "components/impl/SkinnedMeshComponent.h"
+#include "components/impl/ShadowCasterComponent.h"
 
 #include <utils/Utils.h>
 #include <components/impl/EntityMetadataComponent.h>
@@ -23,6 +24,9 @@
 #include "core/ThreadPool.h"
 #include <algorithm>
 #include <cmath>
+#include <limits>
+#include <map>
+#include <tuple>
 #include <tracy/Tracy.hpp>
 #include <vector>
 
@@ -45,7 +49,11 @@ namespace Engine {
 		    "drawSkeleton",
 		    sol::property(&AnimationManager::GetDrawSkeletonValue, &AnimationManager::SetDrawSkeleton),
 		    "drawMesh",
-		    sol::property(&AnimationManager::GetDrawMeshValue, &AnimationManager::SetDrawMesh));
+		    sol::property(&AnimationManager::GetDrawMeshValue, &AnimationManager::SetDrawMesh),
+		    "autoPoseSharing",
+		    sol::property(&AnimationManager::GetAutoPoseSharingValue, &AnimationManager::SetAutoPoseSharing),
+		    "poseSharePhases",
+		    sol::property(&AnimationManager::GetPoseSharePhasesValue, &AnimationManager::SetPoseSharePhases));
 
 		lua.set_function("getAnimationManager", []() -> AnimationManager& { return Engine::GetAnimationManager(); });
 
@@ -68,6 +76,9 @@ namespace Engine {
 		render_options_.wireframe     = false;
 		render_options_.skip_skinning = false;
 
+		// Headless: skinning still runs on the CPU (see declareUpdate), nothing is drawn.
+		if (IsHeadless()) return;
+
 		renderer_ = ozz::make_unique<RendererImpl>();
 
 		if (!renderer_->Initialize()) {
@@ -89,43 +100,290 @@ namespace Engine {
 		loaded_skeletons_.clear();
 	}
 
+	void AnimationManager::declareUpdate(ModuleUpdateBuilder& update)
+	{
+		// Pose evaluation only writes AnimationComponent buffers (Transform is read for the LOD
+		// distance), so it can overlap the physics step. Skinning happens later from the renderer.
+		update.AddTask(name(), [this](float dt) { onUpdate(dt); })
+		    .InPhase(UpdatePhase::Simulation)
+		    .OnAnyThread()
+		    .Reads<Components::EntityMetadata>()
+		    .Reads<Components::Transform>()
+		    .Writes<Components::AnimationComponent>();
+
+		// With no renderer to call PrepareSkinnedMeshes, skin once per tick after poses are done.
+		if (IsHeadless()) {
+			update.AddTask("AnimationSkinning", [this](float) { PrepareSkinnedMeshes(); })
+			    .InPhase(UpdatePhase::PostSimulation)
+			    .OnAnyThread()
+			    .Reads<Components::AnimationComponent>()
+			    .Reads<Components::Transform>()
+			    .Writes<Components::SkinnedMeshComponent>();
+		}
+	}
+
+	namespace {
+		/// LOD level for a bounding sphere seen from `eye`; `projectionScale` is projection[1][1].
+		/// An unknown radius (0) only uses the distance bands.
+		int SelectLodLevel(const Components::AnimationLodPolicy& lod, const glm::vec3& center, float radius, const glm::vec3& eye, float projectionScale)
+		{
+			const float distance   = glm::length(center - eye);
+			const float screenSize = distance > radius ? radius * projectionScale / distance : 1.f;
+			int         level      = 0;
+			while (level < Components::kAnimationLodLevels - 1 && (distance > lod.distance[level] || (radius > 0.f && screenSize < lod.screenSize[level]))) {
+				++level;
+			}
+			return level;
+		}
+
+		/// Frame offset in [0, 8) so characters on the same level don't all evaluate on the same frame.
+		uint64_t LodPhase(entt::entity entity)
+		{
+			return (static_cast<uint32_t>(entt::to_integral(entity)) * 2654435761u) >> 29;
+		}
+	} // namespace
+
 	void AnimationManager::onUpdate(float deltaTime)
 	{
 		ZoneScopedN("Animation Update");
+		const uint64_t frame = ++animation_frame_;
 
 		// Collect independent AnimationComponents, then evaluate poses in parallel.
 		// Each component owns its pose buffers — no shared writes.
 		struct AnimWork {
-			Components::AnimationComponent* ac = nullptr;
+			Components::AnimationComponent* ac        = nullptr;
+			entt::entity                    entity    = entt::null;
+			bool                            evaluate  = false;
+			bool                            hidden    = false;   // off-screen with sampling skipped
+			bool                            wasShared = false;   // read another member's pose last update
+			float                           lateness  = 0.f;     // frames since the last evaluation / LOD interval
+			int                             cost      = 0;       // joints sampled
+			AnimWork*                       leader    = nullptr; // pose-sharing group leader, null = evaluates itself
 		};
 		std::vector<AnimWork> work;
 		work.reserve(32);
 
-		auto animationView = GetCurrentSceneRegistry().view<Components::EntityMetadata, Components::AnimationComponent>();
+		auto& registry      = GetCurrentSceneRegistry();
+		auto  animationView = registry.view<Components::EntityMetadata, Components::AnimationComponent>();
+		skipped_poses_       = 0;
+		evaluated_poses_     = 0;
+		deferred_poses_      = 0;
+		shared_pose_groups_  = 0;
+		shared_pose_members_ = 0;
+		std::fill(std::begin(lod_counts_), std::end(lod_counts_), 0);
 		for (auto [entity, metadata, ac] : animationView.each()) {
 			if (!metadata.active) continue;
 			if (!ac.skeleton) continue;
-			work.push_back(AnimWork{&ac});
+
+			AnimWork w{&ac, entity};
+			w.wasShared   = ac.poseSource != entt::null && ac.poseSource != entity;
+			ac.poseSource = entt::null;
+			if (ac.offscreen && skip_offscreen_sampling_) {
+				w.hidden = true;
+				++skipped_poses_;
+				work.push_back(w);
+				continue;
+			}
+
+			ac.lodLevel = 0;
+			if (ac.lod.enabled && lod_projection_scale_ > 0.f) {
+				glm::vec3 center = ac.boundsCenter;
+				if (ac.boundsRadius <= 0.f) {
+					if (const auto* transform = registry.try_get<Components::Transform>(entity)) {
+						center = glm::vec3(transform->GetWorldMatrix()[3]);
+					}
+				}
+				ac.lodLevel = SelectLodLevel(ac.lod, center, ac.boundsRadius, lod_view_position_, lod_projection_scale_);
+			}
+			++lod_counts_[ac.lodLevel];
+
+			const bool reduced  = ac.lod.enabled && ac.lodLevel >= ac.lod.reducedJointsLevel;
+			ac.sampledSoaJoints = reduced ? ac.ReducedSoaJointCount(ac.lod.reducedJointDepth) : 0;
+			w.cost              = reduced ? std::min(ac.sampledSoaJoints * 4, ac.skeleton->num_joints()) : ac.skeleton->num_joints();
+
+			// Staggered by entity so a level's characters spread over its interval; late ones catch up.
+			const uint64_t interval = uint64_t{1} << ac.lodLevel;
+			const uint64_t since    = frame - ac.lastEvaluatedFrame;
+			const bool     frozen   = ac.lod.enabled && ac.lodLevel >= ac.lod.freezeLevel && ac.lastEvaluatedFrame != 0;
+			if (!frozen && ((frame + LodPhase(entity)) % interval == 0 || since >= interval)) {
+				w.lateness = static_cast<float>(since) / static_cast<float>(interval);
+				w.evaluate = true;
+			}
+			work.push_back(w);
+		}
+
+		// Pose sharing: candidates on the same skeleton, looping clip and speed snap their time onto the first
+		// one's phase grid. Each occupied phase is one group, evaluated once by its most detailed member.
+		{
+			ZoneScopedN("Group Shared Poses");
+			std::vector<AnimWork*> candidates;
+			for (AnimWork& w : work) {
+				const auto& ac = *w.ac;
+				if (w.hidden || !(pose_share_auto_ || ac.sharePose)) continue;
+				if (!ac.IsPlaying() || ac.IsFading() || !ac.current.looping || !ac.local_pose || !ac.model_pose) continue;
+				candidates.push_back(&w);
+			}
+
+			auto speedOf  = [](const Components::AnimationComponent& ac) { return ac.current.speed * ac.playbackSpeed; };
+			auto sameClip = [&](const AnimWork* a, const AnimWork* b) {
+				return a->ac->skeleton == b->ac->skeleton && a->ac->current.clip == b->ac->current.clip && speedOf(*a->ac) == speedOf(*b->ac) &&
+				       a->ac->counteractRootOffset == b->ac->counteractRootOffset;
+			};
+			std::stable_sort(candidates.begin(), candidates.end(), [&](const AnimWork* a, const AnimWork* b) {
+				if (a->ac->skeleton != b->ac->skeleton) return std::less<const ozz::animation::Skeleton*>()(a->ac->skeleton, b->ac->skeleton);
+				if (!(a->ac->current.clip == b->ac->current.clip)) return a->ac->current.clip < b->ac->current.clip;
+				if (speedOf(*a->ac) != speedOf(*b->ac)) return speedOf(*a->ac) < speedOf(*b->ac);
+				return a->ac->counteractRootOffset < b->ac->counteractRootOffset;
+			});
+
+			const int                              phases = std::max(pose_share_phases_, 1);
+			std::vector<std::pair<int, AnimWork*>> phased;
+			for (size_t begin = 0, end = 0; begin < candidates.size(); begin = end) {
+				end = begin + 1;
+				while (end < candidates.size() && sameClip(candidates[begin], candidates[end])) ++end;
+				if (end - begin < 2) continue;
+				const float duration = candidates[begin]->ac->GetLength();
+				if (duration <= 0.f) continue;
+
+				// Equal speeds keep the snapped offsets; re-snapping each update only removes float drift.
+				const float step      = duration / static_cast<float>(phases);
+				const float reference = candidates[begin]->ac->current.time;
+				phased.clear();
+				for (size_t i = begin; i < end; ++i) {
+					auto& ac    = *candidates[i]->ac;
+					int   phase = static_cast<int>(std::lround((ac.current.time - reference) / step)) % phases;
+					if (phase < 0) phase += phases;
+					ac.current.time = std::fmod(reference + static_cast<float>(phase) * step, duration);
+					phased.emplace_back(phase, candidates[i]);
+				}
+				// The lowest LOD level leads: it samples every joint any member needs.
+				std::stable_sort(phased.begin(), phased.end(), [](const auto& a, const auto& b) {
+					return a.first != b.first ? a.first < b.first : a.second->ac->lodLevel < b.second->ac->lodLevel;
+				});
+				for (size_t g = 0, next = 0; g < phased.size(); g = next) {
+					next = g + 1;
+					while (next < phased.size() && phased[next].first == phased[g].first) ++next;
+					if (next - g < 2) continue;
+
+					AnimWork& leader      = *phased[g].second;
+					leader.ac->poseSource = leader.entity;
+					for (size_t m = g + 1; m < next; ++m) {
+						AnimWork& member      = *phased[m].second;
+						leader.evaluate      |= member.evaluate;
+						leader.lateness       = std::max(leader.lateness, member.lateness);
+						member.evaluate       = false;
+						member.leader         = &leader;
+						member.ac->poseSource = leader.entity;
+					}
+					++shared_pose_groups_;
+					shared_pose_members_ += static_cast<int>(next - g - 1);
+				}
+			}
 		}
 
-		const float dt      = IsSimulating() ? deltaTime : 0.f;
-		const int   n       = static_cast<int>(work.size());
+		// Over the joint budget: the latest characters go first, the rest wait and gain priority.
+		if (lod_joint_budget_ > 0) {
+			std::vector<AnimWork*> due;
+			for (AnimWork& w : work) {
+				if (w.evaluate) due.push_back(&w);
+			}
+			std::stable_sort(due.begin(), due.end(), [](const AnimWork* a, const AnimWork* b) { return a->lateness > b->lateness; });
+			int spent = 0;
+			for (AnimWork* w : due) {
+				if (spent > 0 && spent + w->cost > lod_joint_budget_) {
+					w->evaluate = false;
+					++deferred_poses_;
+					continue;
+				}
+				spent += w->cost;
+			}
+		}
+		for (AnimWork& w : work) {
+			if (w.evaluate) {
+				w.ac->lastEvaluatedFrame = frame;
+				++evaluated_poses_;
+			}
+			else if (w.leader && w.leader->evaluate) {
+				w.ac->lastEvaluatedFrame = frame;
+			}
+			// Left its group: the own buffers missed every shared frame.
+			if (w.wasShared && w.ac->poseSource == entt::null) {
+				w.ac->poseStale = true;
+			}
+		}
+
+		const float dt = IsSimulating() ? deltaTime : 0.f;
+		const int   n  = static_cast<int>(work.size());
 		// Pose sampling is relatively heavy — parallelize even modest counts.
 		GetThreadPool().ParallelForIndex(n, /*minPerTask=*/1, [&](int i) {
 			ZoneScopedN("Anim Pose Entity");
-			auto& ac = *work[static_cast<size_t>(i)].ac;
+			const AnimWork& w  = work[static_cast<size_t>(i)];
+			auto&           ac = *w.ac;
 			if (ac.IsPlaying()) {
-				ac.UpdatePlayback(dt);
+				if (w.evaluate) {
+					ac.UpdatePlayback(dt);
+				}
+				else {
+					ac.AdvancePlayback(dt);
+				}
 			}
-			else if (ac.local_pose && ac.model_pose) {
+			else if (w.evaluate && ac.local_pose && ac.model_pose) {
 				ac.EvaluatePose();
 			}
+			if (w.hidden) {
+				ac.poseStale = true;
+			}
 		});
 
 		// Invalidate skinned caches for the upcoming render.
 		++pose_generation_;
 	}
 
+	namespace {
+		/// Model-space box around the posed joints, padded by the skin reach and margin.
+		Rendering::AABB ComputePoseBounds(const std::vector<ozz::math::Float4x4>& model_pose, float pad)
+		{
+			Rendering::AABB bounds{glm::vec3(std::numeric_limits<float>::max()), glm::vec3(std::numeric_limits<float>::lowest())};
+			for (const ozz::math::Float4x4& joint : model_pose) {
+				glm::vec3 p;
+				ozz::math::Store3PtrU(joint.cols[3], &p.x);
+				bounds.min = glm::min(bounds.min, p);
+				bounds.max = glm::max(bounds.max, p);
+			}
+			bounds.min -= glm::vec3(pad);
+			bounds.max += glm::vec3(pad);
+			return bounds;
+		}
+	} // namespace
+
+	bool AnimationManager::IsSkinnedEntityVisible(Entity&                                  entity,
+	                                              Components::SkinnedMeshComponent&        skinned,
+	                                              Components::AnimationComponent&          anim,
+	                                              const std::vector<ozz::math::Float4x4>& pose) const
+	{
+		if (pose.empty()) return true;
+
+		if (skinned.skinReach < 0.f) {
+			skinned.skinReach = 0.f;
+			for (const AnimatedMesh& mesh : *skinned.meshes) {
+				skinned.skinReach = std::max(skinned.skinReach, ComputeSkinReach(mesh));
+			}
+		}
+
+		// The pose may be a few frames old when sampling was skipped; the margin covers what moved since.
+		const Rendering::AABB local  = ComputePoseBounds(pose, skinned.skinReach + skinned.cullingMargin);
+		const Rendering::AABB bounds = Rendering::AABB::Transform(local, entity.GetComponent<Components::Transform>().GetWorldMatrix());
+		anim.boundsCenter            = bounds.Center();
+		anim.boundsRadius            = glm::length(bounds.Extents());
+
+		if (!cull_offscreen_ || culling_frusta_.empty()) return true;
+		if (culling_frusta_.front().Intersects(bounds)) return true;
+
+		// Only shadow casters are drawn into the cascades.
+		if (!entity.HasComponent<Components::ShadowCaster>()) return false;
+		return std::any_of(culling_frusta_.begin() + 1, culling_frusta_.end(), [&](const Rendering::Frustum& cascade) { return cascade.Intersects(bounds); });
+	}
+
 	void AnimationManager::PrepareSkinnedMeshes()
 	{
 		ZoneScopedN("PrepareSkinnedMeshes");
@@ -137,19 +395,34 @@ namespace Engine {
 		skinned_generation_ = pose_generation_;
 
 		struct EntitySkinWork {
-			Components::SkinnedMeshComponent* skinned = nullptr;
-			Components::AnimationComponent*   anim    = nullptr;
+			Components::SkinnedMeshComponent*       skinned = nullptr;
+			Components::AnimationComponent*         anim    = nullptr;
+			const std::vector<ozz::math::Float4x4>* sharedPose        = nullptr; // pose-sharing leader's, null = own
+			uint64_t                                sharedPoseVersion = 0;
 		};
 
 		std::vector<EntitySkinWork> work;
+		// GPU-skinned meshes get consecutive palette ranges, assigned here so the parallel pass can write in place.
+		const bool gpuAvailable = renderer_ && renderer_->SupportsGpuSkinning();
+		size_t     paletteSize  = 0;
+		cpu_skinned_meshes_     = 0;
+		gpu_skinned_meshes_     = 0;
+		skinned_entities_       = 0;
+		culled_entities_        = 0;
+		reused_skins_           = 0;
+		shared_skins_           = 0;
 		{
 			ZoneScopedN("Collect Skinned Entities");
-			auto view = GetCurrentSceneRegistry().view<Components::SkinnedMeshComponent, Components::AnimationComponent, Components::Transform>();
+			auto& registry = GetCurrentSceneRegistry();
+			auto  view     = registry.view<Components::SkinnedMeshComponent, Components::AnimationComponent, Components::Transform>();
 			work.reserve(32);
+			// First visible member skinned per (shared pose, path, meshPath); the rest of the group draws its caches.
+			std::map<std::tuple<const void*, bool, std::string>, entt::entity> skinSources;
 			for (auto entity : view) {
 				Entity e(entity, GetCurrentScene());
 				auto&  skinned = e.GetComponent<Components::SkinnedMeshComponent>();
 				auto&  anim    = e.GetComponent<Components::AnimationComponent>();
+				skinned.skinCacheSource = entt::null;
 				if (!anim.model_pose || !skinned.meshes || !skinned.skinning_matrices) {
 					continue;
 				}
@@ -161,38 +434,139 @@ namespace Engine {
 					skinned.skin_frame_cache.clear();
 					skinned.skin_frame_cache.resize(skinned.meshes->size());
 				}
+
+				// Grouped members read the leader's pose, unless it went away or is stale (then their own is re-evaluated).
+				const std::vector<ozz::math::Float4x4>* pose        = anim.model_pose;
+				uint64_t                                poseVersion = anim.poseVersion;
+				if (anim.poseSource != entt::null && anim.poseSource != entity) {
+					const auto* source = registry.valid(anim.poseSource) ? registry.try_get<Components::AnimationComponent>(anim.poseSource) : nullptr;
+					if (source && source->model_pose && source->skeleton == anim.skeleton && !source->poseStale) {
+						pose        = source->model_pose;
+						poseVersion = source->poseVersion;
+					}
+					else {
+						anim.poseSource = entt::null;
+						anim.poseStale  = true;
+					}
+				}
+
+				// Off-screen: no skinning, and the invalid caches keep every pass from drawing it.
+				anim.offscreen = !IsSkinnedEntityVisible(e, skinned, anim, *pose);
+				if (anim.offscreen) {
+					for (auto& c : skinned.skin_frame_cache) c.valid = false;
+					++culled_entities_;
+					continue;
+				}
+
+				// Whole entity on one path; meshes without skin data draw unskinned on the CPU path.
+				size_t entityPalette = 0;
+				bool   gpu           = gpuAvailable && skinned.gpuSkinning;
+				for (const AnimatedMesh& mesh : *skinned.meshes) {
+					gpu &= mesh.skinned();
+					entityPalette += mesh.joint_remaps.size();
+				}
+				gpu = gpu && paletteSize + entityPalette <= static_cast<size_t>(renderer_->MaxPaletteMatrices());
+
+				// Same pose and same mesh file as a member already handled: draw its caches.
+				if (anim.poseSource != entt::null && !skinned.meshPath.empty()) {
+					const auto [source, inserted] = skinSources.try_emplace(std::make_tuple(static_cast<const void*>(pose), gpu, skinned.meshPath), entity);
+					if (!inserted) {
+						for (auto& c : skinned.skin_frame_cache) c.valid = false;
+						skinned.skinCacheSource = source->second;
+						++shared_skins_;
+						continue;
+					}
+				}
+
+				// Pose unchanged since the last CPU skin (LOD skipped or froze it): the vertices are still right.
+				// GPU palettes are rebuilt regardless, their offsets move with the other entities.
+				const bool ownPose       = pose == anim.model_pose;
+				const bool poseUnchanged = !(ownPose && anim.poseStale) && skinned.skinnedPoseVersion == poseVersion;
+				if (!gpu && poseUnchanged && std::all_of(skinned.skin_frame_cache.begin(), skinned.skin_frame_cache.end(), [](const SkinnedMeshFrameCache& c) { return c.valid && !c.gpu; })) {
+					cpu_skinned_meshes_ += static_cast<int>(skinned.meshes->size());
+					++reused_skins_;
+					continue;
+				}
+				++skinned_entities_;
+
 				// Invalidate caches until rebuilt
-				for (auto& c : skinned.skin_frame_cache) {
-					c.valid = false;
+				for (size_t mi = 0; mi < skinned.skin_frame_cache.size(); ++mi) {
+					auto& c          = skinned.skin_frame_cache[mi];
+					c.valid          = false;
+					c.gpu            = gpu;
+					c.palette_offset = static_cast<int>(paletteSize);
+					if (gpu) {
+						paletteSize += (*skinned.meshes)[mi].joint_remaps.size();
+					}
 				}
+				(gpu ? gpu_skinned_meshes_ : cpu_skinned_meshes_) += static_cast<int>(skinned.meshes->size());
 				skinned.skin_cache_frame = pose_generation_;
-				work.push_back(EntitySkinWork{&skinned, &anim});
+				work.push_back(EntitySkinWork{&skinned, &anim, ownPose ? nullptr : pose, poseVersion});
 			}
 		}
 
 		if (work.empty()) {
 			return;
 		}
+		skinning_palette_.resize(paletteSize);
 
-		// Parallel per-entity via global ThreadPool (each entity owns its buffers).
+		// Parallel per-entity via global ThreadPool (each entity owns its buffers and palette range; shared poses are only read).
 		const int entityCount = static_cast<int>(work.size());
 		GetThreadPool().ParallelForIndex(entityCount, /*minPerTask=*/1, [&](int ei) {
 			ZoneScopedN("Skin Entity");
-			auto& skinned = *work[static_cast<size_t>(ei)].skinned;
-			auto& anim    = *work[static_cast<size_t>(ei)].anim;
+			const EntitySkinWork& w       = work[static_cast<size_t>(ei)];
+			auto&                 skinned = *w.skinned;
+			auto&                 anim    = *w.anim;
+			// Came back into view after pose sampling was skipped.
+			if (!w.sharedPose && anim.poseStale) {
+				anim.EvaluatePose();
+			}
+			const std::vector<ozz::math::Float4x4>& pose = w.sharedPose ? *w.sharedPose : *anim.model_pose;
+			skinned.skinnedPoseVersion                   = w.sharedPose ? w.sharedPoseVersion : anim.poseVersion;
 
 			for (size_t mi = 0; mi < skinned.meshes->size(); ++mi) {
-				const AnimatedMesh& mesh = (*skinned.meshes)[mi];
+				const AnimatedMesh&    mesh  = (*skinned.meshes)[mi];
+				SkinnedMeshFrameCache& cache = skinned.skin_frame_cache[mi];
+				if (cache.gpu) {
+					ZoneScopedN("Build Skinning Palette");
+					for (size_t j = 0; j < mesh.joint_remaps.size(); ++j) {
+						skinning_palette_[cache.palette_offset + j] = pose[mesh.joint_remaps[j]] * mesh.inverse_bind_poses[j];
+					}
+					if (!cache.vbo.empty()) {
+						std::vector<uint8_t>().swap(cache.vbo); // switched from the CPU path
+					}
+					cache.vertex_count = mesh.vertex_count();
+					cache.valid        = true;
+					continue;
+				}
 				{
 					ZoneScopedN("Build Skinning Matrices");
 					for (size_t j = 0; j < mesh.joint_remaps.size(); ++j) {
-						(*skinned.skinning_matrices)[j] = (*anim.model_pose)[mesh.joint_remaps[j]] * mesh.inverse_bind_poses[j];
+						(*skinned.skinning_matrices)[j] = pose[mesh.joint_remaps[j]] * mesh.inverse_bind_poses[j];
 					}
 				}
 				// Parts of a mesh also parallelize via ParallelForIndex → ThreadPool.
-				SkinAnimatedMeshToCache(mesh, ozz::make_span(*skinned.skinning_matrices), skinned.skin_frame_cache[mi]);
+				SkinAnimatedMeshToCache(mesh, ozz::make_span(*skinned.skinning_matrices), cache);
 			}
 		});
+
+		if (!skinning_palette_.empty()) {
+			renderer_->UploadSkinningPalette(ozz::make_span(skinning_palette_));
+		}
+	}
+
+	const std::vector<SkinnedMeshFrameCache>& AnimationManager::GetSkinFrameCaches(const Components::SkinnedMeshComponent& skinned) const
+	{
+		if (skinned.skinCacheSource != entt::null) {
+			auto& registry = GetCurrentSceneRegistry();
+			if (registry.valid(skinned.skinCacheSource)) {
+				const auto* source = registry.try_get<Components::SkinnedMeshComponent>(skinned.skinCacheSource);
+				if (source && source->skin_frame_cache.size() == skinned.skin_frame_cache.size()) {
+					return source->skin_frame_cache;
+				}
+			}
+		}
+		return skinned.skin_frame_cache;
 	}
 
 	void AnimationManager::Render()
@@ -210,9 +584,10 @@ namespace Engine {
 
 			const ozz::math::Float4x4 transform = FromMatrix(e.GetComponent<Components::Transform>().GetWorldMatrix());
 
+			const auto& caches = GetSkinFrameCaches(skinned);
 			for (size_t mi = 0; mi < skinned.meshes->size(); ++mi) {
 				const auto& mesh  = (*skinned.meshes)[mi];
-				const auto& cache = skinned.skin_frame_cache[mi];
+				const auto& cache = caches[mi];
 				if (!cache.valid) continue;
 				renderer_->DrawSkinnedMeshCached(cache, mesh, transform, skinned.meshMaterial, render_options_);
 			}
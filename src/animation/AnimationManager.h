@@ -3,7 +3,9 @@
 #include "Camera.h"
 #include "animation/rendering/AnimatedMesh.h"
 #include "animation/rendering/renderer_impl.h"
+#include "components/impl/AnimationComponent.h"
 #include "core/module/Module.h"
+#include "rendering/culling/Frustum.h"
 
 
 #include <ozz/animation/runtime/animation.h>
@@ -17,11 +19,16 @@
 
 #include <ozz/base/memory/unique_ptr.h>
 
+#include <algorithm>
 #include <unordered_map>
+#include <vector>
 
 
 namespace Engine {
-
+	class Entity;
+	namespace Components {
+		class SkinnedMeshComponent;
+	} // namespace Components
 
 	class AnimationManager : public Module {
 	  public:
@@ -30,15 +37,52 @@ namespace Engine {
 		void        onGameStart() override {}
 		void        onShutdown() override;
 		void        setLuaBindings() override;
+		void        declareUpdate(ModuleUpdateBuilder& update) override;
 		std::string name() const override { return "AnimationModule"; }
 
 		void Render();
 		void RenderDebug() const;
 
 		/// Once per frame: build skinning matrices + CPU-skin every skinned mesh (parallelized).
+		/// GPU-skinned entities only build their joint palette, uploaded in one buffer for all passes.
 		/// Call before shadow / GBuffer / mouse-pick draws that need skinned geometry.
 		void PrepareSkinnedMeshes();
 		[[nodiscard]] uint64_t GetPoseGeneration() const { return pose_generation_; }
+		/// Counts onUpdate calls; AnimationComponent::lastEvaluatedFrame is on this clock.
+		[[nodiscard]] uint64_t GetAnimationFrame() const { return animation_frame_; }
+
+		/// Meshes skinned on each path by the last PrepareSkinnedMeshes.
+		[[nodiscard]] int GetCpuSkinnedMeshCount() const { return cpu_skinned_meshes_; }
+		[[nodiscard]] int GetGpuSkinnedMeshCount() const { return gpu_skinned_meshes_; }
+
+		/// This frame's camera frustum followed by one per shadow cascade. PrepareSkinnedMeshes skips
+		/// characters whose bounds miss all of them; with none set (headless) everything is skinned.
+		void SetCullingFrusta(const std::vector<Rendering::Frustum>& frusta) { culling_frusta_ = frusta; }
+		/// Camera position and projection[1][1] for animation LOD; without one every character stays at level 0.
+		void SetLodView(const glm::vec3& position, float projectionScale)
+		{
+			lod_view_position_    = position;
+			lod_projection_scale_ = projectionScale;
+		}
+
+		/// Characters skinned / culled by the last PrepareSkinnedMeshes, and poses left unsampled by the last update.
+		[[nodiscard]] int GetSkinnedEntityCount() const { return skinned_entities_; }
+		[[nodiscard]] int GetCulledEntityCount() const { return culled_entities_; }
+		[[nodiscard]] int GetSkippedPoseCount() const { return skipped_poses_; }
+		/// Poses evaluated / deferred by the budget in the last update, characters per LOD level,
+		/// and CPU skins reused because the pose did not change.
+		[[nodiscard]] int        GetEvaluatedPoseCount() const { return evaluated_poses_; }
+		[[nodiscard]] int        GetDeferredPoseCount() const { return deferred_poses_; }
+		[[nodiscard]] const int* GetLodLevelCounts() const { return lod_counts_; }
+		[[nodiscard]] int        GetReusedSkinCount() const { return reused_skins_; }
+		/// Pose-sharing groups and the members reading a leader's pose in the last update,
+		/// and meshes drawn from another member's skin by the last PrepareSkinnedMeshes.
+		[[nodiscard]] int GetSharedPoseGroupCount() const { return shared_pose_groups_; }
+		[[nodiscard]] int GetSharedPoseMemberCount() const { return shared_pose_members_; }
+		[[nodiscard]] int GetSharedSkinCount() const { return shared_skins_; }
+
+		/// Caches to draw for `skinned`: its own, or those of the group member it shares a skin with this frame.
+		[[nodiscard]] const std::vector<SkinnedMeshFrameCache>& GetSkinFrameCaches(const Components::SkinnedMeshComponent& skinned) const;
 
 		bool&                  GetDrawSkeleton() { return draw_skeleton_; }
 		bool&                  GetDrawMesh() { return draw_mesh_; }
@@ -46,6 +90,20 @@ namespace Engine {
 		bool                   GetDrawMeshValue() const { return draw_mesh_; }
 		void                   SetDrawSkeleton(bool v) { draw_skeleton_ = v; }
 		void                   SetDrawMesh(bool v) { draw_mesh_ = v; }
+		/// Skip skinning characters outside the camera and every shadow cascade.
+		bool& GetCullOffscreen() { return cull_offscreen_; }
+		/// Off-screen characters also skip pose sampling and only advance playback time.
+		bool& GetSkipOffscreenSampling() { return skip_offscreen_sampling_; }
+		/// Joints evaluated per update across all characters, 0 = unlimited. Due poses beyond it wait a frame.
+		int& GetLodJointBudget() { return lod_joint_budget_; }
+		/// Group every playing character for pose sharing, not only those with AnimationComponent::sharePose.
+		bool& GetAutoPoseSharing() { return pose_share_auto_; }
+		bool  GetAutoPoseSharingValue() const { return pose_share_auto_; }
+		void  SetAutoPoseSharing(bool v) { pose_share_auto_ = v; }
+		/// Phase buckets per clip: grouped members snap their time offset to a multiple of duration / phases.
+		int& GetPoseSharePhases() { return pose_share_phases_; }
+		int  GetPoseSharePhasesValue() const { return pose_share_phases_; }
+		void SetPoseSharePhases(int v) { pose_share_phases_ = std::max(v, 1); }
 		RendererImpl::Options& GetRenderOptions() { return render_options_; }
 
 		// Load a skeleton from a file path
@@ -67,6 +125,13 @@ namespace Engine {
 		ozz::unique_ptr<RendererImpl> renderer_;
 
 	  private:
+		/// Updates the entity's world bounds on `anim` from `pose` (its own or the shared one) and tests them (conservatively)
+		/// against the camera and (shadow casters only) the cascades.
+		bool IsSkinnedEntityVisible(Entity&                                  entity,
+		                            Components::SkinnedMeshComponent&        skinned,
+		                            Components::AnimationComponent&          anim,
+		                            const std::vector<ozz::math::Float4x4>& pose) const;
+
 		// Map to store loaded skeletons (legacy; primary cache is AssetManager)
 		std::unordered_map<std::string, std::unique_ptr<ozz::animation::Skeleton>> loaded_skeletons_;
 
@@ -78,6 +143,35 @@ namespace Engine {
 		/// Bumped each animation update; PrepareSkinnedMeshes rebuilds when this changes.
 		uint64_t pose_generation_    = 0;
 		uint64_t skinned_generation_ = ~uint64_t{0};
+
+		/// Joint palettes of every GPU-skinned mesh this frame, at SkinnedMeshFrameCache::palette_offset.
+		std::vector<ozz::math::Float4x4> skinning_palette_;
+		int                              cpu_skinned_meshes_ = 0;
+		int                              gpu_skinned_meshes_ = 0;
+
+		std::vector<Rendering::Frustum> culling_frusta_;
+		bool                            cull_offscreen_          = true;
+		bool                            skip_offscreen_sampling_ = false;
+		int                             skinned_entities_        = 0;
+		int                             culled_entities_         = 0;
+		int                             skipped_poses_           = 0;
+
+		/// Animation LOD scheduler.
+		uint64_t  animation_frame_      = 0;
+		glm::vec3 lod_view_position_    = glm::vec3(0.f);
+		float     lod_projection_scale_ = 0.f;
+		int       lod_joint_budget_     = 0;
+		int       lod_counts_[Components::kAnimationLodLevels]{};
+		int       evaluated_poses_ = 0;
+		int       deferred_poses_  = 0;
+		int       reused_skins_    = 0;
+
+		/// Pose sharing.
+		bool pose_share_auto_     = false;
+		int  pose_share_phases_   = 16;
+		int  shared_pose_groups_  = 0;
+		int  shared_pose_members_ = 0;
+		int  shared_skins_        = 0;
 	};
 
 } // namespace Engine
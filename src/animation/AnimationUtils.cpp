@@ -319,6 +319,35 @@ bool LoadAnimation(const char* _filename, ozz::animation::Animation* _animation)
 	return true;
 }
 
+namespace {
+template <typename _Type>
+bool LoadFromMemory(const void* _data, size_t _size, _Type* _object, const char* _kind)
+{
+	assert(_data && _object);
+	ozz::io::MemoryStream stream;
+	if (stream.Write(_data, _size) != _size || stream.Seek(0, ozz::io::Stream::kSet) != 0) {
+		return false;
+	}
+	ozz::io::IArchive archive(&stream);
+	if (!archive.TestTag<_Type>()) {
+		ozz::log::Err() << "Failed to load " << _kind << " instance from memory." << std::endl;
+		return false;
+	}
+	archive >> *_object;
+	return true;
+}
+} // namespace
+
+bool LoadSkeleton(const void* _data, size_t _size, ozz::animation::Skeleton* _skeleton)
+{
+	return LoadFromMemory(_data, _size, _skeleton, "skeleton");
+}
+
+bool LoadAnimation(const void* _data, size_t _size, ozz::animation::Animation* _animation)
+{
+	return LoadFromMemory(_data, _size, _animation, "animation");
+}
+
 bool LoadRawAnimation(const char* _filename, ozz::animation::offline::RawAnimation* _animation)
 {
 	assert(_filename && _animation);
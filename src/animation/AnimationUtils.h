@@ -169,6 +169,11 @@ bool LoadSkeleton(const char* _filename, ozz::animation::Skeleton* _skeleton);
 // _filename and _animation must be non-nullptr.
 bool LoadAnimation(const char* _filename, ozz::animation::Animation* _animation);
 
+// Same as LoadSkeleton / LoadAnimation, from an ozz archive held in memory
+// (cooked asset packs). _data must be non-nullptr.
+bool LoadSkeleton(const void* _data, size_t _size, ozz::animation::Skeleton* _skeleton);
+bool LoadAnimation(const void* _data, size_t _size, ozz::animation::Animation* _animation);
+
 // Loads a raw animation from an ozz archive file named _filename.
 // This function will fail and return false if the file cannot be opened or if
 // it is not a valid ozz animation archive. A valid animation archive can be
@@ -3,137 +3,12 @@
 #include "core/EngineData.h"
 #include "core/ThreadPool.h"
 
-#include "ozz/base/maths/math_ex.h"
-#include "ozz/base/memory/allocator.h"
-#include "ozz/base/platform.h"
-#include "ozz/geometry/runtime/skinning_job.h"
-
 #include <tracy/Tracy.hpp>
 
 #include <algorithm>
-#include <atomic>
-#include <cstring>
-#include <vector>
+#include <cmath>
 
 namespace Engine {
-	namespace {
-		// Default white color (matches renderer_impl kDefaultColorsArray path)
-		constexpr uint8_t kWhite[4] = {255, 255, 255, 255};
-
-		struct PartRange {
-			size_t part_index   = 0;
-			size_t vertex_begin = 0;
-			size_t vertex_count = 0;
-		};
-
-		bool SkinPart(const AnimatedMesh&                   mesh,
-		              const PartRange&                      range,
-		              ozz::span<const ozz::math::Float4x4>  skinning_matrices,
-		              uint8_t*                              vbo_base,
-		              int                                   vertex_count_total)
-		{
-			const AnimatedMesh::Part& part = mesh.parts[range.part_index];
-			const size_t part_vertex_count = range.vertex_count;
-			if (part_vertex_count == 0) {
-				return true;
-			}
-
-			const size_t positions_stride = sizeof(float) * 3;
-			const size_t normals_stride   = sizeof(float) * 3;
-			const size_t tangents_stride  = sizeof(float) * 3;
-			const size_t colors_stride    = sizeof(uint8_t) * 4;
-			const size_t uvs_stride       = sizeof(float) * 2;
-
-			const size_t positions_offset = 0;
-			const size_t normals_offset   = static_cast<size_t>(vertex_count_total) * positions_stride;
-			const size_t tangents_offset  = normals_offset + static_cast<size_t>(vertex_count_total) * normals_stride;
-			const size_t colors_offset    = tangents_offset + static_cast<size_t>(vertex_count_total) * tangents_stride;
-			const size_t uvs_offset       = colors_offset + static_cast<size_t>(vertex_count_total) * colors_stride;
-
-			const size_t processed = range.vertex_begin;
-
-			ozz::geometry::SkinningJob skinning_job;
-			skinning_job.vertex_count     = static_cast<int>(part_vertex_count);
-			const int influences_count    = part.influences_count();
-			skinning_job.influences_count = influences_count;
-			skinning_job.joint_matrices   = skinning_matrices;
-
-			skinning_job.joint_indices        = ozz::make_span(part.joint_indices);
-			skinning_job.joint_indices_stride = sizeof(uint16_t) * influences_count;
-			if (influences_count > 1) {
-				skinning_job.joint_weights        = ozz::make_span(part.joint_weights);
-				skinning_job.joint_weights_stride = sizeof(float) * (influences_count - 1);
-			}
-
-			skinning_job.in_positions        = ozz::make_span(part.positions);
-			skinning_job.in_positions_stride = sizeof(float) * AnimatedMesh::Part::kPositionsCpnts;
-
-			float* out_pos_begin = reinterpret_cast<float*>(vbo_base + positions_offset + processed * positions_stride);
-			float* out_pos_end   = reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(out_pos_begin) + part_vertex_count * positions_stride);
-			skinning_job.out_positions        = {out_pos_begin, out_pos_end};
-			skinning_job.out_positions_stride = positions_stride;
-
-			float* out_n_begin = reinterpret_cast<float*>(vbo_base + normals_offset + processed * normals_stride);
-			float* out_n_end   = reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(out_n_begin) + part_vertex_count * normals_stride);
-			if (part.normals.size() / AnimatedMesh::Part::kNormalsCpnts == part_vertex_count) {
-				skinning_job.in_normals        = ozz::make_span(part.normals);
-				skinning_job.in_normals_stride = sizeof(float) * AnimatedMesh::Part::kNormalsCpnts;
-				skinning_job.out_normals        = {out_n_begin, out_n_end};
-				skinning_job.out_normals_stride = normals_stride;
-			}
-			else {
-				for (float* n = out_n_begin; n < out_n_end; n = reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(n) + normals_stride)) {
-					n[0] = 0.f;
-					n[1] = 1.f;
-					n[2] = 0.f;
-				}
-			}
-
-			float* out_t_begin = reinterpret_cast<float*>(vbo_base + tangents_offset + processed * tangents_stride);
-			float* out_t_end   = reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(out_t_begin) + part_vertex_count * tangents_stride);
-			// Mesh tangents are 4-component (xyz + handiness); skinning job uses 3 for output xyz.
-			if (part.tangents.size() / AnimatedMesh::Part::kTangentsCpnts == part_vertex_count) {
-				skinning_job.in_tangents        = ozz::make_span(part.tangents);
-				skinning_job.in_tangents_stride = sizeof(float) * AnimatedMesh::Part::kTangentsCpnts;
-				skinning_job.out_tangents        = {out_t_begin, out_t_end};
-				skinning_job.out_tangents_stride = tangents_stride;
-			}
-			else {
-				for (float* t = out_t_begin; t < out_t_end; t = reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(t) + tangents_stride)) {
-					t[0] = 1.f;
-					t[1] = 0.f;
-					t[2] = 0.f;
-				}
-			}
-
-			if (!skinning_job.Run()) {
-				return false;
-			}
-
-			// Colors
-			uint8_t* out_c = vbo_base + colors_offset + processed * colors_stride;
-			if (part.colors.size() / AnimatedMesh::Part::kColorsCpnts == part_vertex_count) {
-				std::memcpy(out_c, part.colors.data(), part_vertex_count * colors_stride);
-			}
-			else {
-				for (size_t v = 0; v < part_vertex_count; ++v) {
-					std::memcpy(out_c + v * colors_stride, kWhite, 4);
-				}
-			}
-
-			// UVs
-			float* uv_dst = reinterpret_cast<float*>(vbo_base + uvs_offset + processed * uvs_stride);
-			if (part.uvs.size() / AnimatedMesh::Part::kUVsCpnts == part_vertex_count) {
-				std::memcpy(uv_dst, part.uvs.data(), part_vertex_count * uvs_stride);
-			}
-			else {
-				std::memset(uv_dst, 0, part_vertex_count * uvs_stride);
-			}
-
-			return true;
-		}
-	} // namespace
-
 	void ParallelForIndex(int count, int grain, const std::function<void(int)>& fn)
 	{
 		if (count <= 0 || !fn) return;
@@ -150,51 +25,83 @@ namespace Engine {
 		}
 	}
 
+	std::shared_ptr<const QuantizedSkin> BuildQuantizedSkin(const AnimatedMesh& mesh)
+	{
+		ZoneScopedN("BuildQuantizedSkin");
+		auto skin = std::make_shared<QuantizedSkin>();
+		skin->buckets.reserve(mesh.parts.size());
+
+		// ozz parts already group vertices by influence count, so each part is one bucket.
+		for (const AnimatedMesh::Part& part : mesh.parts) {
+			const int  vertex_count = part.vertex_count();
+			const bool has_normals  = part.normals.size() / AnimatedMesh::Part::kNormalsCpnts == static_cast<size_t>(vertex_count);
+			const bool has_tangents = part.tangents.size() / AnimatedMesh::Part::kTangentsCpnts == static_cast<size_t>(vertex_count);
+			AppendSkinningBucket(*skin,
+			                     part.influences_count(),
+			                     vertex_count,
+			                     part.positions.data(),
+			                     has_normals ? part.normals.data() : nullptr,
+			                     has_tangents ? part.tangents.data() : nullptr,
+			                     part.joint_indices.data(),
+			                     part.joint_weights.data());
+		}
+		return skin;
+	}
+
+	float ComputeSkinReach(const AnimatedMesh& mesh)
+	{
+		std::vector<float> joints(mesh.inverse_bind_poses.size() * 3);
+		for (size_t j = 0; j < mesh.inverse_bind_poses.size(); ++j) {
+			ozz::math::Store3PtrU(ozz::math::Invert(mesh.inverse_bind_poses[j]).cols[3], &joints[j * 3]);
+		}
+
+		float reach2 = 0.f;
+		for (const AnimatedMesh::Part& part : mesh.parts) {
+			const int influences = part.influences_count();
+			for (int v = 0; v < part.vertex_count(); ++v) {
+				const float* p = &part.positions[static_cast<size_t>(v) * 3];
+				for (int k = 0; k < influences; ++k) {
+					const size_t joint = part.joint_indices[static_cast<size_t>(v * influences + k)];
+					if (joint * 3 >= joints.size()) continue;
+					const float dx = p[0] - joints[joint * 3], dy = p[1] - joints[joint * 3 + 1], dz = p[2] - joints[joint * 3 + 2];
+					reach2         = std::max(reach2, dx * dx + dy * dy + dz * dz);
+				}
+			}
+		}
+		return std::sqrt(reach2);
+	}
+
 	bool SkinAnimatedMeshToCache(const AnimatedMesh& mesh, ozz::span<const ozz::math::Float4x4> skinning_matrices, SkinnedMeshFrameCache& out)
 	{
 		ZoneScopedN("SkinAnimatedMeshToCache");
+		static_assert(sizeof(ozz::math::Float4x4) == sizeof(float) * 16, "Kernel reads the palette as column-major float4x4");
+
+		if (!out.skin) {
+			out.skin = BuildQuantizedSkin(mesh);
+		}
+		const QuantizedSkin& skin = *out.skin;
 
-		const int vertex_count = mesh.vertex_count();
-		if (vertex_count <= 0) {
+		if (skin.vertex_count <= 0 || skin.buckets.empty()) {
 			out.valid        = false;
 			out.vertex_count = 0;
 			out.vbo.clear();
 			return false;
 		}
 
-		out.vertex_count = vertex_count;
-		const int bytes  = out.vboSize();
-		out.vbo.resize(static_cast<size_t>(bytes));
-		out.valid = false;
-
-		// Build per-part ranges (vertex offsets into packed buffer)
-		std::vector<PartRange> ranges;
-		ranges.reserve(mesh.parts.size());
-		size_t cursor = 0;
-		for (size_t p = 0; p < mesh.parts.size(); ++p) {
-			const size_t pvc = static_cast<size_t>(mesh.parts[p].vertex_count());
-			if (pvc == 0) {
-				continue;
-			}
-			ranges.push_back(PartRange{p, cursor, pvc});
-			cursor += pvc;
-		}
+		out.vertex_count = skin.vertex_count;
+		out.vbo.resize(static_cast<size_t>(out.vboSize()));
 
-		if (ranges.empty()) {
-			return false;
-		}
+		uint8_t*             base = out.vbo.data();
+		const SkinningOutput streams{reinterpret_cast<float*>(base + out.positionsOffset()), reinterpret_cast<float*>(base + out.normalsOffset()), reinterpret_cast<float*>(base + out.tangentsOffset())};
+		const float*         matrices = reinterpret_cast<const float*>(skinning_matrices.data());
+		const SkinningKernelLevel level = DetectSkinningKernelLevel();
 
-		// Parallel skin parts — each writes a non-overlapping vertex range.
-		std::atomic<bool> ok{true};
-		const int         n = static_cast<int>(ranges.size());
-		ParallelForIndex(n, /*grain=*/1, [&](int i) {
-			if (!SkinPart(mesh, ranges[static_cast<size_t>(i)], skinning_matrices, out.vbo.data(), vertex_count)) {
-				ok.store(false, std::memory_order_relaxed);
-			}
-		});
+		// Parallel skin buckets — each writes a non-overlapping vertex range.
+		const int n = static_cast<int>(skin.buckets.size());
+		ParallelForIndex(n, /*grain=*/1, [&](int i) { SkinBucket(skin.buckets[static_cast<size_t>(i)], matrices, streams, level); });
 
-		out.valid = ok.load(std::memory_order_relaxed);
-		return out.valid;
+		out.valid = true;
+		return true;
 	}
 
 } // namespace Engine
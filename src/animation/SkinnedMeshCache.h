@@ -1,5 +1,6 @@
 #pragma once
 
+#include "animation/SkinningKernel.h"
 #include "animation/rendering/AnimatedMesh.h"
 
 #include "ozz/base/maths/simd_math.h"
@@ -7,30 +8,44 @@
 
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <vector>
 
 namespace Engine {
 
 	/// CPU-skinned vertex buffer for one AnimatedMesh, shared by shadow / GBuffer / pick draws.
-	/// Layout matches the sample skinned renderer packing:
-	///   [positions xyz][normals xyz][tangents xyz][colors rgba u8][uvs xy]
+	/// Holds only the animated streams: [positions xyz][normals xyz][tangents xyz].
+	/// Colors, UVs and indices never change and are read from the renderer's static mesh buffer.
+	///
+	/// With `gpu` set the mesh is skinned in the vertex shader instead: `vbo` stays empty and
+	/// the mesh's joint palette lives at `palette_offset` (in matrices) in the frame's palette buffer.
 	struct SkinnedMeshFrameCache {
 		std::vector<uint8_t> vbo;
-		int                  vertex_count = 0;
-		bool                 valid        = false;
+		int                  vertex_count   = 0;
+		bool                 valid          = false;
+		bool                 gpu            = false;
+		int                  palette_offset = 0;
+		/// Bucketed, quantized skinning input, built from the mesh on first CPU skin.
+		std::shared_ptr<const QuantizedSkin> skin;
 
 		[[nodiscard]] int positionsOffset() const { return 0; }
 		[[nodiscard]] int normalsOffset() const { return vertex_count * static_cast<int>(sizeof(float) * 3); }
 		[[nodiscard]] int tangentsOffset() const { return normalsOffset() + vertex_count * static_cast<int>(sizeof(float) * 3); }
-		[[nodiscard]] int colorsOffset() const { return tangentsOffset() + vertex_count * static_cast<int>(sizeof(float) * 3); }
-		[[nodiscard]] int uvsOffset() const { return colorsOffset() + vertex_count * static_cast<int>(sizeof(uint8_t) * 4); }
 		[[nodiscard]] int vboSize() const
 		{
-			return uvsOffset() + vertex_count * static_cast<int>(sizeof(float) * 2);
+			return tangentsOffset() + vertex_count * static_cast<int>(sizeof(float) * 3);
 		}
 	};
 
-	/// Run ozz SkinningJob(s) for every mesh part into `out` (CPU only, thread-safe per distinct out).
+	/// Bucket `mesh` parts by influence count with 16-bit weights for the SIMD skinning kernel.
+	std::shared_ptr<const QuantizedSkin> BuildQuantizedSkin(const AnimatedMesh& mesh);
+
+	/// Farthest any bind-pose vertex sits from a joint that influences it. Rigid joint motion keeps every
+	/// skinned vertex within this distance of the posed joints, which makes it a conservative bounds pad.
+	float ComputeSkinReach(const AnimatedMesh& mesh);
+
+	/// Skin every bucket of the mesh into `out` with the widest SIMD kernel the CPU has
+	/// (CPU only, thread-safe per distinct out).
 	bool SkinAnimatedMeshToCache(const AnimatedMesh& mesh, ozz::span<const ozz::math::Float4x4> skinning_matrices, SkinnedMeshFrameCache& out);
 
 	/// ozz multithread-sample style divide-and-conquer over [0, count).
@@ -0,0 +1,177 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#include "SkinningBenchmark.h"
+
+#include "animation/SkinnedMeshCache.h"
+#include "animation/SkinningKernel.h"
+
+#include "ozz/geometry/runtime/skinning_job.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+namespace Engine {
+
+	namespace {
+		using Clock = std::chrono::steady_clock;
+
+		constexpr int kMaxInfluences = 4;
+
+		double Mvps(Clock::time_point start, uint64_t vertices)
+		{
+			const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+			return seconds > 0.0 ? static_cast<double>(vertices) / seconds * 1.0e-6 : 0.0;
+		}
+
+		// One part per influence count, 1..kMaxInfluences, with every stream filled like an imported mesh.
+		AnimatedMesh BuildSyntheticMesh(uint32_t vertices, uint32_t joints, std::mt19937& rng)
+		{
+			std::uniform_real_distribution<float>   unit(-1.f, 1.f);
+			std::uniform_real_distribution<float>   weight(0.05f, 1.f);
+			std::uniform_int_distribution<uint16_t> joint(0, static_cast<uint16_t>(joints - 1));
+
+			AnimatedMesh mesh;
+			mesh.parts.resize(kMaxInfluences);
+			for (int p = 0; p < kMaxInfluences; ++p) {
+				AnimatedMesh::Part& part       = mesh.parts[p];
+				const int           influences = p + 1;
+				const uint32_t      count      = vertices / kMaxInfluences + (static_cast<uint32_t>(p) < vertices % kMaxInfluences ? 1 : 0);
+
+				for (uint32_t v = 0; v < count; ++v) {
+					float n[3] = {unit(rng), unit(rng), unit(rng)};
+					const float len = std::max(std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]), 1e-3f);
+					for (float& c : n) c /= len;
+
+					for (int c = 0; c < 3; ++c) part.positions.push_back(unit(rng));
+					part.normals.insert(part.normals.end(), n, n + 3);
+					// Any unit vector orthogonal to n.
+					const float t[3] = {n[1], -n[0], 0.f};
+					const float tl   = std::max(std::sqrt(t[0] * t[0] + t[1] * t[1]), 1e-6f);
+					part.tangents.insert(part.tangents.end(), {t[0] / tl, t[1] / tl, 0.f, 1.f});
+					part.uvs.insert(part.uvs.end(), {unit(rng) * .5f + .5f, unit(rng) * .5f + .5f});
+					part.colors.insert(part.colors.end(), {255, 255, 255, 255});
+
+					float w[kMaxInfluences];
+					float sum = 0.f;
+					for (int k = 0; k < influences; ++k) sum += (w[k] = weight(rng));
+					for (int k = 0; k < influences; ++k) {
+						part.joint_indices.push_back(joint(rng));
+						if (k < influences - 1) part.joint_weights.push_back(w[k] / sum);
+					}
+				}
+			}
+			return mesh;
+		}
+
+		// The pre-kernel SkinAnimatedMeshToCache: SkinningJob per part into [pos][nrm][tan][color][uv].
+		void SkinWithOzz(const AnimatedMesh& mesh, ozz::span<const ozz::math::Float4x4> matrices, int vertex_count, uint8_t* vbo)
+		{
+			const size_t xyz_stride = sizeof(float) * 3;
+			float*       positions  = reinterpret_cast<float*>(vbo);
+			float*       normals    = positions + vertex_count * 3;
+			float*       tangents   = normals + vertex_count * 3;
+			uint8_t*     colors     = reinterpret_cast<uint8_t*>(tangents + vertex_count * 3);
+			float*       uvs        = reinterpret_cast<float*>(colors + vertex_count * 4);
+
+			int processed = 0;
+			for (const AnimatedMesh::Part& part : mesh.parts) {
+				const int count      = part.vertex_count();
+				const int influences = part.influences_count();
+
+				ozz::geometry::SkinningJob job;
+				job.vertex_count         = count;
+				job.influences_count     = influences;
+				job.joint_matrices       = matrices;
+				job.joint_indices        = ozz::make_span(part.joint_indices);
+				job.joint_indices_stride = sizeof(uint16_t) * influences;
+				if (influences > 1) {
+					job.joint_weights        = ozz::make_span(part.joint_weights);
+					job.joint_weights_stride = sizeof(float) * (influences - 1);
+				}
+				job.in_positions         = ozz::make_span(part.positions);
+				job.in_positions_stride  = xyz_stride;
+				job.out_positions        = {positions + processed * 3, positions + (processed + count) * 3};
+				job.out_positions_stride = xyz_stride;
+				job.in_normals           = ozz::make_span(part.normals);
+				job.in_normals_stride    = xyz_stride;
+				job.out_normals          = {normals + processed * 3, normals + (processed + count) * 3};
+				job.out_normals_stride   = xyz_stride;
+				job.in_tangents          = ozz::make_span(part.tangents);
+				job.in_tangents_stride   = sizeof(float) * AnimatedMesh::Part::kTangentsCpnts;
+				job.out_tangents         = {tangents + processed * 3, tangents + (processed + count) * 3};
+				job.out_tangents_stride  = xyz_stride;
+				job.Run();
+
+				std::memcpy(colors + processed * 4, part.colors.data(), part.colors.size());
+				std::memcpy(uvs + processed * 2, part.uvs.data(), part.uvs.size() * sizeof(float));
+				processed += count;
+			}
+		}
+
+		double TimeKernel(const QuantizedSkin& skin, const float* matrices, const SkinningOutput& out, SkinningKernelLevel level, uint32_t iterations)
+		{
+			const auto start = Clock::now();
+			for (uint32_t it = 0; it < iterations; ++it) {
+				for (const SkinningBucket& bucket : skin.buckets) {
+					SkinBucket(bucket, matrices, out, level);
+				}
+			}
+			return Mvps(start, static_cast<uint64_t>(skin.vertex_count) * iterations);
+		}
+	} // namespace
+
+	SkinningBenchmarkResult RunSkinningBenchmark(uint32_t vertices, uint32_t joints, uint32_t iterations, uint32_t seed)
+	{
+		SkinningBenchmarkResult result;
+		vertices   = std::max<uint32_t>(vertices, kMaxInfluences);
+		joints     = std::clamp<uint32_t>(joints, 1, UINT16_MAX);
+		iterations = std::max<uint32_t>(iterations, 1);
+		result.vertices   = vertices;
+		result.joints     = joints;
+		result.iterations = iterations;
+
+		std::mt19937                          rng(seed);
+		std::uniform_real_distribution<float> angle(-3.14159265f, 3.14159265f);
+		std::uniform_real_distribution<float> offset(-2.f, 2.f);
+
+		const AnimatedMesh mesh = BuildSyntheticMesh(vertices, joints, rng);
+		std::vector<ozz::math::Float4x4> matrices(joints);
+		for (ozz::math::Float4x4& m : matrices) {
+			m = ozz::math::Float4x4::Translation(ozz::math::simd_float4::Load(offset(rng), offset(rng), offset(rng), 0.f)) *
+			    ozz::math::Float4x4::FromEuler(ozz::math::simd_float4::Load(angle(rng), angle(rng), angle(rng), 0.f));
+		}
+		const ozz::span<const ozz::math::Float4x4> palette(matrices.data(), matrices.size());
+		const int                                  vertex_count = static_cast<int>(vertices);
+
+		// Old layout: 36 bytes of skinned streams + 12 bytes of copied colors / uvs per vertex.
+		std::vector<uint8_t> ozz_vbo(static_cast<size_t>(vertex_count) * (sizeof(float) * 11 + 4));
+		auto                 start = Clock::now();
+		for (uint32_t it = 0; it < iterations; ++it) {
+			SkinWithOzz(mesh, palette, vertex_count, ozz_vbo.data());
+		}
+		result.ozzMvps = Mvps(start, static_cast<uint64_t>(vertex_count) * iterations);
+
+		const std::shared_ptr<const QuantizedSkin> skin = BuildQuantizedSkin(mesh);
+		std::vector<float>                         kernel_out(static_cast<size_t>(vertex_count) * 9);
+		const SkinningOutput                       out{kernel_out.data(), kernel_out.data() + vertex_count * 3, kernel_out.data() + vertex_count * 6};
+		const float*                               raw_matrices = reinterpret_cast<const float*>(matrices.data());
+
+		const SkinningKernelLevel level = DetectSkinningKernelLevel();
+		result.scalarMvps               = TimeKernel(*skin, raw_matrices, out, SkinningKernelLevel::Scalar, iterations);
+		if (level >= SkinningKernelLevel::SSE2) result.sse2Mvps = TimeKernel(*skin, raw_matrices, out, SkinningKernelLevel::SSE2, iterations);
+		if (level >= SkinningKernelLevel::AVX2) result.avx2Mvps = TimeKernel(*skin, raw_matrices, out, SkinningKernelLevel::AVX2, iterations);
+
+		// The last run used the detected level; compare its positions with ozz.
+		const float* ozz_positions = reinterpret_cast<const float*>(ozz_vbo.data());
+		for (int i = 0; i < vertex_count * 3; ++i) {
+			result.maxError = std::max(result.maxError, std::abs(ozz_positions[i] - kernel_out[static_cast<size_t>(i)]));
+		}
+		return result;
+	}
+
+} // namespace Engine
@@ -0,0 +1,28 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include <cstdint>
+
+namespace Engine {
+
+	struct SkinningBenchmarkResult {
+		uint32_t vertices   = 0;
+		uint32_t joints     = 0;
+		uint32_t iterations = 0;
+		// Millions of skinned vertices per second, single thread.
+		double ozzMvps    = 0.0; // ozz SkinningJob per part + color / uv copy (the old cache path)
+		double scalarMvps = 0.0;
+		double sse2Mvps   = 0.0; // 0 when the CPU has no SSE2 kernel
+		double avx2Mvps   = 0.0; // 0 when the CPU has no AVX2
+		// Largest position difference of the detected kernel against ozz, in mesh units.
+		float maxError = 0.f;
+	};
+
+	/// Skins a synthetic mesh of `vertices` split over 1-4 influence parts with `joints` random
+	/// matrices, `iterations` times per path.
+	SkinningBenchmarkResult RunSkinningBenchmark(uint32_t vertices = 100000, uint32_t joints = 64, uint32_t iterations = 20, uint32_t seed = 1337);
+
+} // namespace Engine
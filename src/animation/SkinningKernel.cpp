@@ -0,0 +1,331 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#include "SkinningKernel.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define ENGINE_SKINNING_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define ENGINE_TARGET_AVX2
+#else
+#define ENGINE_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif
+#endif
+
+namespace Engine {
+
+	namespace {
+		constexpr int   kStreams     = 9; // px py pz nx ny nz tx ty tz
+		constexpr float kWeightScale = 1.0f / 65535.0f;
+
+		// Blended 3x4 joint matrix: m[c * 3 + r] is row r of column c.
+		void TransformScalar(const float* m, const float* v, bool point, float* dst)
+		{
+			for (int r = 0; r < 3; ++r) {
+				dst[r] = m[r] * v[0] + m[3 + r] * v[1] + m[6 + r] * v[2] + (point ? m[9 + r] : 0.0f);
+			}
+		}
+
+		void WriteDefault(float* dst, int count, float x, float y, float z)
+		{
+			for (int v = 0; v < count; ++v) {
+				dst[v * 3 + 0] = x;
+				dst[v * 3 + 1] = y;
+				dst[v * 3 + 2] = z;
+			}
+		}
+
+		void SkinBucketScalar(const SkinningBucket& b, const float* matrices, const SkinningOutput& out)
+		{
+			const int n = b.influences;
+			for (int v = 0; v < b.vertex_count; ++v) {
+				const int block = v / kSkinningBlockSize;
+				const int lane  = v % kSkinningBlockSize;
+
+				float m[12] = {};
+				for (int k = 0; k < n; ++k) {
+					const size_t slot  = (static_cast<size_t>(block) * n + k) * kSkinningBlockSize + lane;
+					const float* joint = matrices + static_cast<size_t>(b.joints[slot]) * 16;
+					const float  w     = static_cast<float>(b.weights[slot]) * kWeightScale;
+					for (int c = 0; c < 4; ++c) {
+						for (int r = 0; r < 3; ++r) {
+							m[c * 3 + r] += joint[c * 4 + r] * w;
+						}
+					}
+				}
+
+				const float* bind = b.bind_pose.data() + static_cast<size_t>(block) * kStreams * kSkinningBlockSize + lane;
+				const size_t dst  = static_cast<size_t>(b.vertex_begin + v) * 3;
+				float        in[3];
+				for (int s = 0; s < 3; ++s) in[s] = bind[s * kSkinningBlockSize];
+				TransformScalar(m, in, true, out.positions + dst);
+				if (b.has_normals) {
+					for (int s = 0; s < 3; ++s) in[s] = bind[(3 + s) * kSkinningBlockSize];
+					TransformScalar(m, in, false, out.normals + dst);
+				}
+				if (b.has_tangents) {
+					for (int s = 0; s < 3; ++s) in[s] = bind[(6 + s) * kSkinningBlockSize];
+					TransformScalar(m, in, false, out.tangents + dst);
+				}
+			}
+		}
+
+#ifdef ENGINE_SKINNING_X86
+		// Writes `lanes` (1-4) xyz triplets from SoA x / y / z registers.
+		inline void StoreXYZ(float* dst, __m128 x, __m128 y, __m128 z, int lanes)
+		{
+			__m128 w = _mm_setzero_ps();
+			_MM_TRANSPOSE4_PS(x, y, z, w); // x..w now hold lanes 0..3 as (x, y, z, 0)
+			if (lanes == 4) {
+				// Overlapping 4-wide stores; the last lane must not write past its triplet.
+				_mm_storeu_ps(dst + 0, x);
+				_mm_storeu_ps(dst + 3, y);
+				_mm_storeu_ps(dst + 6, z);
+				_mm_storel_pi(reinterpret_cast<__m64*>(dst + 9), w);
+				_mm_store_ss(dst + 11, _mm_movehl_ps(w, w));
+				return;
+			}
+			alignas(16) float tmp[4][4];
+			_mm_store_ps(tmp[0], x);
+			_mm_store_ps(tmp[1], y);
+			_mm_store_ps(tmp[2], z);
+			_mm_store_ps(tmp[3], w);
+			for (int l = 0; l < lanes; ++l) {
+				dst[l * 3 + 0] = tmp[l][0];
+				dst[l * 3 + 1] = tmp[l][1];
+				dst[l * 3 + 2] = tmp[l][2];
+			}
+		}
+
+		// xyz stream at `in` (one lane row of 8 per component) through the blended rows in `m`.
+		inline void TransformSSE2(const __m128* m, const float* in, bool point, float* dst, int lanes)
+		{
+			const __m128 x = _mm_loadu_ps(in);
+			const __m128 y = _mm_loadu_ps(in + kSkinningBlockSize);
+			const __m128 z = _mm_loadu_ps(in + 2 * kSkinningBlockSize);
+			__m128       o[3];
+			for (int r = 0; r < 3; ++r) {
+				o[r] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m[r], x), _mm_mul_ps(m[3 + r], y)), _mm_mul_ps(m[6 + r], z));
+				if (point) o[r] = _mm_add_ps(o[r], m[9 + r]);
+			}
+			StoreXYZ(dst, o[0], o[1], o[2], lanes);
+		}
+
+		// Four lanes per step: the columns of four joint matrices are transposed into rows across lanes.
+		void SkinBucketSSE2(const SkinningBucket& b, const float* matrices, const SkinningOutput& out)
+		{
+			const int    n     = b.influences;
+			const __m128 scale = _mm_set1_ps(kWeightScale);
+			const __m128i zero = _mm_setzero_si128();
+
+			for (int first = 0; first < b.vertex_count; first += 4) {
+				const int block = first / kSkinningBlockSize;
+				const int half  = first % kSkinningBlockSize;
+				const int lanes = std::min(4, b.vertex_count - first);
+
+				__m128 m[12];
+				for (__m128& r : m) r = _mm_setzero_ps();
+
+				for (int k = 0; k < n; ++k) {
+					const size_t    slot = (static_cast<size_t>(block) * n + k) * kSkinningBlockSize + half;
+					const uint16_t* j    = b.joints.data() + slot;
+					const __m128i   wq   = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(b.weights.data() + slot)), zero);
+					const __m128    w    = _mm_mul_ps(_mm_cvtepi32_ps(wq), scale);
+
+					const float* j0 = matrices + static_cast<size_t>(j[0]) * 16;
+					const float* j1 = matrices + static_cast<size_t>(j[1]) * 16;
+					const float* j2 = matrices + static_cast<size_t>(j[2]) * 16;
+					const float* j3 = matrices + static_cast<size_t>(j[3]) * 16;
+					for (int c = 0; c < 4; ++c) {
+						__m128 r0 = _mm_loadu_ps(j0 + c * 4);
+						__m128 r1 = _mm_loadu_ps(j1 + c * 4);
+						__m128 r2 = _mm_loadu_ps(j2 + c * 4);
+						__m128 r3 = _mm_loadu_ps(j3 + c * 4);
+						_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+						m[c * 3 + 0] = _mm_add_ps(m[c * 3 + 0], _mm_mul_ps(r0, w));
+						m[c * 3 + 1] = _mm_add_ps(m[c * 3 + 1], _mm_mul_ps(r1, w));
+						m[c * 3 + 2] = _mm_add_ps(m[c * 3 + 2], _mm_mul_ps(r2, w));
+					}
+				}
+
+				const float* bind = b.bind_pose.data() + static_cast<size_t>(block) * kStreams * kSkinningBlockSize + half;
+				const size_t dst  = static_cast<size_t>(b.vertex_begin + first) * 3;
+				TransformSSE2(m, bind, true, out.positions + dst, lanes);
+				if (b.has_normals) TransformSSE2(m, bind + 3 * kSkinningBlockSize, false, out.normals + dst, lanes);
+				if (b.has_tangents) TransformSSE2(m, bind + 6 * kSkinningBlockSize, false, out.tangents + dst, lanes);
+			}
+		}
+
+		ENGINE_TARGET_AVX2 inline void TransformAVX2(const __m256* m, const float* in, bool point, float* dst, int lanes)
+		{
+			const __m256 x = _mm256_loadu_ps(in);
+			const __m256 y = _mm256_loadu_ps(in + kSkinningBlockSize);
+			const __m256 z = _mm256_loadu_ps(in + 2 * kSkinningBlockSize);
+			__m256       o[3];
+			for (int r = 0; r < 3; ++r) {
+				o[r] = _mm256_fmadd_ps(m[6 + r], z, _mm256_fmadd_ps(m[3 + r], y, _mm256_mul_ps(m[r], x)));
+				if (point) o[r] = _mm256_add_ps(o[r], m[9 + r]);
+			}
+			StoreXYZ(dst, _mm256_castps256_ps128(o[0]), _mm256_castps256_ps128(o[1]), _mm256_castps256_ps128(o[2]), std::min(lanes, 4));
+			if (lanes > 4) {
+				StoreXYZ(dst + 12, _mm256_extractf128_ps(o[0], 1), _mm256_extractf128_ps(o[1], 1), _mm256_extractf128_ps(o[2], 1), lanes - 4);
+			}
+		}
+
+		// A whole block per step, same transpose as SSE2 for each half. Beats 12 gathers per influence.
+		ENGINE_TARGET_AVX2 void SkinBucketAVX2(const SkinningBucket& b, const float* matrices, const SkinningOutput& out)
+		{
+			const int    n     = b.influences;
+			const __m256 scale = _mm256_set1_ps(kWeightScale);
+
+			for (int block = 0; block < b.BlockCount(); ++block) {
+				const int first = block * kSkinningBlockSize;
+				const int lanes = std::min(kSkinningBlockSize, b.vertex_count - first);
+
+				__m256 m[12];
+				for (__m256& r : m) r = _mm256_setzero_ps();
+
+				for (int k = 0; k < n; ++k) {
+					const size_t slot = (static_cast<size_t>(block) * n + k) * kSkinningBlockSize;
+					const __m256 w    = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b.weights.data() + slot)))), scale);
+					const float* j[8];
+					for (int l = 0; l < 8; ++l) j[l] = matrices + static_cast<size_t>(b.joints[slot + l]) * 16;
+					for (int c = 0; c < 4; ++c) {
+						// Lanes 0-3 and 4-7 transpose separately, then pair up into 8-wide rows.
+						__m128 a0 = _mm_loadu_ps(j[0] + c * 4), a1 = _mm_loadu_ps(j[1] + c * 4), a2 = _mm_loadu_ps(j[2] + c * 4), a3 = _mm_loadu_ps(j[3] + c * 4);
+						__m128 b0 = _mm_loadu_ps(j[4] + c * 4), b1 = _mm_loadu_ps(j[5] + c * 4), b2 = _mm_loadu_ps(j[6] + c * 4), b3 = _mm_loadu_ps(j[7] + c * 4);
+						_MM_TRANSPOSE4_PS(a0, a1, a2, a3);
+						_MM_TRANSPOSE4_PS(b0, b1, b2, b3);
+						m[c * 3 + 0] = _mm256_fmadd_ps(_mm256_insertf128_ps(_mm256_castps128_ps256(a0), b0, 1), w, m[c * 3 + 0]);
+						m[c * 3 + 1] = _mm256_fmadd_ps(_mm256_insertf128_ps(_mm256_castps128_ps256(a1), b1, 1), w, m[c * 3 + 1]);
+						m[c * 3 + 2] = _mm256_fmadd_ps(_mm256_insertf128_ps(_mm256_castps128_ps256(a2), b2, 1), w, m[c * 3 + 2]);
+					}
+				}
+
+				const float* bind = b.bind_pose.data() + static_cast<size_t>(block) * kStreams * kSkinningBlockSize;
+				const size_t dst  = static_cast<size_t>(b.vertex_begin + first) * 3;
+				TransformAVX2(m, bind, true, out.positions + dst, lanes);
+				if (b.has_normals) TransformAVX2(m, bind + 3 * kSkinningBlockSize, false, out.normals + dst, lanes);
+				if (b.has_tangents) TransformAVX2(m, bind + 6 * kSkinningBlockSize, false, out.tangents + dst, lanes);
+			}
+		}
+#endif // ENGINE_SKINNING_X86
+	} // namespace
+
+	SkinningKernelLevel DetectSkinningKernelLevel()
+	{
+		static const SkinningKernelLevel level = [] {
+#ifdef ENGINE_SKINNING_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+			int info[4];
+			__cpuid(info, 1);
+			const bool fma     = (info[2] & (1 << 12)) != 0;
+			const bool osxsave = (info[2] & (1 << 27)) != 0;
+			__cpuidex(info, 7, 0);
+			const bool avx2 = (info[1] & (1 << 5)) != 0;
+			if (fma && avx2 && osxsave && (_xgetbv(0) & 0x6) == 0x6) return SkinningKernelLevel::AVX2;
+#else
+			__builtin_cpu_init();
+			if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return SkinningKernelLevel::AVX2;
+#endif
+			return SkinningKernelLevel::SSE2; // x86-64 baseline
+#else
+			return SkinningKernelLevel::Scalar;
+#endif
+		}();
+		return level;
+	}
+
+	const char* SkinningKernelLevelName(SkinningKernelLevel level)
+	{
+		switch (level) {
+			case SkinningKernelLevel::AVX2: return "AVX2";
+			case SkinningKernelLevel::SSE2: return "SSE2";
+			default: return "Scalar";
+		}
+	}
+
+	void AppendSkinningBucket(QuantizedSkin&  skin,
+	                          int             influences,
+	                          int             vertex_count,
+	                          const float*    positions,
+	                          const float*    normals,
+	                          const float*    tangents,
+	                          const uint16_t* joint_indices,
+	                          const float*    joint_weights)
+	{
+		if (vertex_count <= 0 || influences <= 0) return;
+
+		SkinningBucket& b = skin.buckets.emplace_back();
+		b.influences      = influences;
+		b.vertex_begin    = skin.vertex_count;
+		b.vertex_count    = vertex_count;
+		b.has_normals     = normals != nullptr;
+		b.has_tangents    = tangents != nullptr;
+		skin.vertex_count += vertex_count;
+
+		const size_t blocks = static_cast<size_t>(b.BlockCount());
+		b.bind_pose.assign(blocks * kStreams * kSkinningBlockSize, 0.0f);
+		b.joints.assign(blocks * influences * kSkinningBlockSize, 0);
+		b.weights.assign(blocks * influences * kSkinningBlockSize, 0); // padding lanes weigh nothing
+
+		std::vector<float> w(static_cast<size_t>(influences));
+		for (int v = 0; v < vertex_count; ++v) {
+			const size_t block = static_cast<size_t>(v / kSkinningBlockSize);
+			const int    lane  = v % kSkinningBlockSize;
+
+			float* bind = b.bind_pose.data() + block * kStreams * kSkinningBlockSize + lane;
+			for (int s = 0; s < 3; ++s) {
+				bind[s * kSkinningBlockSize] = positions[v * 3 + s];
+				if (normals) bind[(3 + s) * kSkinningBlockSize] = normals[v * 3 + s];
+				if (tangents) bind[(6 + s) * kSkinningBlockSize] = tangents[v * 4 + s];
+			}
+
+			// Quantize all weights, including the implicit last one, then give the rounding
+			// remainder to the heaviest so the vertex still sums to exactly 65535.
+			float remaining = 1.0f;
+			for (int k = 0; k < influences - 1; ++k) {
+				w[k] = joint_weights[static_cast<size_t>(v) * (influences - 1) + k];
+				remaining -= w[k];
+			}
+			w[influences - 1] = remaining;
+
+			int total = 0, heaviest = 0;
+			for (int k = 0; k < influences; ++k) {
+				const size_t slot = (block * influences + k) * kSkinningBlockSize + lane;
+				const int    q    = static_cast<int>(std::lround(std::clamp(w[k], 0.0f, 1.0f) * 65535.0f));
+				b.joints[slot]    = joint_indices[static_cast<size_t>(v) * influences + k];
+				b.weights[slot]   = static_cast<uint16_t>(q);
+				total += q;
+				if (w[k] > w[heaviest]) heaviest = k;
+			}
+			const size_t heaviestSlot = (block * influences + heaviest) * kSkinningBlockSize + lane;
+			b.weights[heaviestSlot]   = static_cast<uint16_t>(std::clamp(b.weights[heaviestSlot] + 65535 - total, 0, 65535));
+		}
+	}
+
+	void SkinBucket(const SkinningBucket& bucket, const float* matrices, const SkinningOutput& out, SkinningKernelLevel level)
+	{
+		if (!bucket.has_normals) WriteDefault(out.normals + static_cast<size_t>(bucket.vertex_begin) * 3, bucket.vertex_count, 0.0f, 1.0f, 0.0f);
+		if (!bucket.has_tangents) WriteDefault(out.tangents + static_cast<size_t>(bucket.vertex_begin) * 3, bucket.vertex_count, 1.0f, 0.0f, 0.0f);
+
+#ifdef ENGINE_SKINNING_X86
+		if (level == SkinningKernelLevel::AVX2) {
+			SkinBucketAVX2(bucket, matrices, out);
+			return;
+		}
+		if (level == SkinningKernelLevel::SSE2) {
+			SkinBucketSSE2(bucket, matrices, out);
+			return;
+		}
+#endif
+		SkinBucketScalar(bucket, matrices, out);
+	}
+
+} // namespace Engine
@@ -0,0 +1,66 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Engine {
+
+	/// Widest CPU skinning kernel; Scalar is the portable fallback.
+	enum class SkinningKernelLevel : uint8_t { Scalar, SSE2, AVX2 };
+
+	/// Best level this CPU supports, detected once.
+	SkinningKernelLevel DetectSkinningKernelLevel();
+	const char*         SkinningKernelLevelName(SkinningKernelLevel level);
+
+	/// Vertices per SIMD block. Bucket streams are padded to a whole block.
+	constexpr int kSkinningBlockSize = 8;
+
+	/// One influence-count bucket (an ozz mesh part), laid out once for the kernels.
+	/// Per block: bind-pose px py pz nx ny nz tx ty tz, 8 lanes each, then
+	/// joint indices and 16-bit weights as [block][influence][lane]. Weights of a vertex sum to 65535.
+	struct SkinningBucket {
+		int                   influences   = 0;
+		int                   vertex_begin = 0; // first output vertex
+		int                   vertex_count = 0;
+		bool                  has_normals  = false;
+		bool                  has_tangents = false;
+		std::vector<float>    bind_pose;
+		std::vector<uint16_t> joints;
+		std::vector<uint16_t> weights;
+
+		[[nodiscard]] int BlockCount() const { return (vertex_count + kSkinningBlockSize - 1) / kSkinningBlockSize; }
+	};
+
+	/// Static skinning input of a mesh, built once from its parts.
+	struct QuantizedSkin {
+		std::vector<SkinningBucket> buckets;
+		int                         vertex_count = 0;
+	};
+
+	/// Appends a part as a bucket. `tangents` has 4 floats per vertex (xyz + handedness), `weights`
+	/// has influences-1 per vertex with the last one implicit (ozz layout). Null normals / tangents are allowed.
+	void AppendSkinningBucket(QuantizedSkin&  skin,
+	                          int             influences,
+	                          int             vertex_count,
+	                          const float*    positions,
+	                          const float*    normals,
+	                          const float*    tangents,
+	                          const uint16_t* joint_indices,
+	                          const float*    joint_weights);
+
+	/// Tightly packed xyz streams for the whole mesh; bucket vertex_begin indexes into them.
+	struct SkinningOutput {
+		float* positions = nullptr;
+		float* normals   = nullptr;
+		float* tangents  = nullptr;
+	};
+
+	/// Skins one bucket with column-major 4x4 `matrices` (16 floats each), indexed by the bucket's joints.
+	void SkinBucket(const SkinningBucket& bucket, const float* matrices, const SkinningOutput& out, SkinningKernelLevel level);
+
+} // namespace Engine
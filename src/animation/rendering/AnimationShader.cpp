@@ -535,6 +535,55 @@ namespace Engine
 													  "    gEmissive = uEmissiveColor;\n"
 													  "}";
 
+		const char* kGBufferShaderSkinnedVS = "#version 420 core\n"
+											  "\n"
+											  "layout (location = 0) in vec3 a_position;\n"
+											  "layout (location = 1) in vec3 a_normal;\n"
+											  "layout (location = 2) in vec2 a_uv;\n"
+											  "layout (location = 3) in vec4 a_color;\n"
+											  "layout (location = 4) in uvec4 a_joints;\n"
+											  "layout (location = 5) in vec4 a_weights;\n"
+											  "\n"
+											  "out VS_OUT {\n"
+											  "    vec3 FragPos;\n"
+											  "    vec3 Normal;\n"
+											  "    vec2 TexCoords;\n"
+											  "    vec4 VertexColor;\n"
+											  "} vs_out;\n"
+											  "\n"
+											  "uniform mat4 u_model;\n"
+											  "uniform mat4 u_view;\n"
+											  "uniform mat4 u_projection;\n"
+											  "\n"
+											  "layout (binding = 5) uniform samplerBuffer u_palette;\n"
+											  "uniform int u_paletteOffset;\n"
+											  "\n"
+											  "mat4 GetSkinMatrix()\n"
+											  "{\n"
+											  "    mat4 skin = mat4(0.0);\n"
+											  "    for (int i = 0; i < 4; ++i) {\n"
+											  "        int base = (u_paletteOffset + int(a_joints[i])) * 4;\n"
+											  "        skin += mat4(texelFetch(u_palette, base), texelFetch(u_palette, base + 1), texelFetch(u_palette, base + 2), texelFetch(u_palette, base + 3)) * a_weights[i];\n"
+											  "    }\n"
+											  "    return skin;\n"
+											  "}\n"
+											  "\n"
+											  "void main()\n"
+											  "{\n"
+											  "    mat4 skin = GetSkinMatrix();\n"
+											  "    vec4 worldPos = u_model * skin * vec4(a_position, 1.0);\n"
+											  "    vs_out.FragPos = worldPos.xyz;\n"
+											  "\n"
+											  "    // Skinned like the CPU path, then the model normal matrix\n"
+											  "    mat3 normalMatrix = transpose(inverse(mat3(u_model)));\n"
+											  "    vs_out.Normal = normalize(normalMatrix * (mat3(skin) * a_normal));\n"
+											  "\n"
+											  "    vs_out.TexCoords = a_uv;\n"
+											  "    vs_out.VertexColor = a_color;\n"
+											  "\n"
+											  "    gl_Position = u_projection * u_view * worldPos;\n"
+											  "}";
+
 
 
 	} // namespace
@@ -893,4 +942,43 @@ namespace Engine
 
 
 	}
-}
\ No newline at end of file
+
+	ozz::unique_ptr<SkinnedAmbientTexturedShader> SkinnedAmbientTexturedShader::Build()
+	{
+		const char* vs[] = {kGBufferShaderSkinnedVS};
+		const char* fs[] = {kGBufferShaderAmbientTexturedFS};
+
+		ozz::unique_ptr<SkinnedAmbientTexturedShader> shader  = ozz::make_unique<SkinnedAmbientTexturedShader>();
+		bool                                          success = true;
+		success &= shader->BuildFromSource(OZZ_ARRAY_SIZE(vs), vs, OZZ_ARRAY_SIZE(fs), fs);
+
+		success &= shader->BindUniform("u_model");
+		success &= shader->BindUniform("u_view");
+		success &= shader->BindUniform("u_projection");
+		success &= shader->BindUniform("u_paletteOffset");
+
+		success &= shader->BindUniform("hasTexture");
+		success &= shader->BindUniform("uSpecularStrength");
+		success &= shader->BindUniform("uEmissiveColor");
+
+		if (!success) {
+			shader.reset();
+		}
+
+		return shader;
+	}
+
+	void SkinnedAmbientTexturedShader::Bind(const ozz::math::Float4x4& _model, const ozz::math::Float4x4& _view, const ozz::math::Float4x4& _proj, int _palette_offset)
+	{
+		GL(UseProgram(program()));
+
+		glUniformMat4(_model, uniform(0));
+		glUniformMat4(_view, uniform(1));
+		glUniformMat4(_proj, uniform(2));
+		glUniform1i(uniform(3), _palette_offset);
+
+		glUniform1i(uniform(4), 1);
+		glUniform1f(uniform(5), 0.05f);
+		glUniform3f(uniform(6), 0.0f, 0.0f, 0.0f);
+	}
+}
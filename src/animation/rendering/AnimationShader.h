@@ -211,4 +211,16 @@ namespace Engine
 				  GLsizei                    _uv_stride,
 				  GLsizei                    _uv_offset);
 	};
-}
\ No newline at end of file
+
+	// GBuffer shader that skins in the vertex shader from the renderer's joint
+	// palette. Attributes come from the mesh VAO's fixed locations.
+	class SkinnedAmbientTexturedShader : public AnimationShader {
+	public:
+		// Constructs the shader.
+		// Returns nullptr if shader compilation failed.
+		static ozz::unique_ptr<SkinnedAmbientTexturedShader> Build();
+
+		// Binds the shader. _palette_offset is the mesh's first matrix in the palette.
+		void Bind(const ozz::math::Float4x4& _model, const ozz::math::Float4x4& _view, const ozz::math::Float4x4& _proj, int _palette_offset);
+	};
+}
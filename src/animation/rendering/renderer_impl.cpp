@@ -25,7 +25,10 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <cstddef>
 #include <utility>
+#include <vector>
 #include <glad/glad.h>
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
@@ -40,6 +43,20 @@ namespace {
 	{
 		return glfwGetCurrentContext() != nullptr;
 	}
+
+	// Texture unit the GPU skinning shaders read the joint palette from (layout binding = 5).
+	constexpr GLenum kPaletteTextureUnit = GL_TEXTURE5;
+
+	// Interleaved bind-pose vertex of a GPU-skinned mesh. Locations match the
+	// GBuffer (0-3), shadow (0, 2) and picking (0) shaders; joints/weights are 4 and 5.
+	struct GpuSkinnedVertex {
+		float    position[3];
+		float    normal[3];
+		float    uv[2];
+		uint8_t  color[4];
+		uint16_t joints[4];
+		float    weights[4];
+	};
 }
 
 namespace Engine{
@@ -80,10 +97,24 @@ namespace Engine{
 			if (dynamic_index_bo_) {
 				GL(DeleteBuffers(1, &dynamic_index_bo_));
 			}
+			for (auto& [mesh, gpu] : static_meshes_) {
+				GL(DeleteVertexArrays(1, &gpu.vao));
+				GL(DeleteBuffers(1, &gpu.vbo));
+				GL(DeleteBuffers(1, &gpu.ibo));
+			}
+			if (palette_texture_) {
+				GL(DeleteTextures(1, &palette_texture_));
+			}
+			if (palette_bo_) {
+				GL(DeleteBuffers(1, &palette_bo_));
+			}
 		}
 		vertex_array_o_   = 0;
 		dynamic_array_bo_ = 0;
 		dynamic_index_bo_ = 0;
+		palette_texture_  = 0;
+		palette_bo_       = 0;
+		static_meshes_.clear();
 	}
 
 	bool RendererImpl::Initialize()
@@ -141,9 +172,188 @@ namespace Engine{
 			return false;
 		}
 
+		// Optional: without it every skinned mesh takes the CPU path.
+		gpu_skinning_supported_ = InitGpuSkinning();
+		if (!gpu_skinning_supported_) {
+			GetAnimationManager().log->warn("GPU skinning unavailable, skinned meshes are skinned on the CPU");
+		}
+
 		return true;
 	}
 
+	bool RendererImpl::InitGpuSkinning()
+	{
+		GLint max_texels = 0;
+		glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &max_texels);
+		max_palette_matrices_ = max_texels / 4;
+		if (max_palette_matrices_ <= 0) {
+			return false;
+		}
+
+		skinned_textured_shader = SkinnedAmbientTexturedShader::Build();
+		if (!skinned_textured_shader) {
+			GetAnimationManager().log->error("Failed to build GPU skinning GBuffer shader");
+			return false;
+		}
+		if (!m_gpu_skinned_mouse_picking_shader.LoadFromFiles("resources/shaders/anim_mp_skinned_vert.glsl", "resources/shaders/anim_mp_frag.glsl", std::nullopt)) {
+			GetAnimationManager().log->error("Failed to load GPU skinning mouse picking shader");
+			return false;
+		}
+		if (!m_gpu_skinned_depth_shader.LoadFromFiles("resources/shaders/depth_anim_skinned.vert", "resources/shaders/depth_anim.frag", "resources/shaders/depth_anim.geom")) {
+			GetAnimationManager().log->error("Failed to load GPU skinning shadow shader");
+			return false;
+		}
+
+		// The texture keeps pointing at palette_bo_ while its storage is reallocated.
+		GL(GenBuffers(1, &palette_bo_));
+		GL(BindBuffer(GL_TEXTURE_BUFFER, palette_bo_));
+		GL(BufferData(GL_TEXTURE_BUFFER, sizeof(ozz::math::Float4x4), nullptr, GL_STREAM_DRAW));
+		GL(BindBuffer(GL_TEXTURE_BUFFER, 0));
+		palette_capacity_ = sizeof(ozz::math::Float4x4);
+
+		GL(GenTextures(1, &palette_texture_));
+		GL(BindTexture(GL_TEXTURE_BUFFER, palette_texture_));
+		GL(TexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, palette_bo_));
+		GL(BindTexture(GL_TEXTURE_BUFFER, 0));
+		return true;
+	}
+
+	void RendererImpl::UploadSkinningPalette(ozz::span<const ozz::math::Float4x4> palette)
+	{
+		ZoneScopedN("Upload Skinning Palette");
+		static_assert(sizeof(ozz::math::Float4x4) == sizeof(float) * 16, "Palette texels are read back as four RGBA32F columns");
+		if (!gpu_skinning_supported_ || palette.empty()) {
+			return;
+		}
+
+		const size_t size = palette.size() * sizeof(ozz::math::Float4x4);
+		GL(BindBuffer(GL_TEXTURE_BUFFER, palette_bo_));
+		if (size > palette_capacity_) {
+			palette_capacity_ = std::max(size, palette_capacity_ * 2);
+		}
+		// Orphan last frame's storage so draws still reading it don't stall the upload.
+		GL(BufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(palette_capacity_), nullptr, GL_STREAM_DRAW));
+		GL(BufferSubData(GL_TEXTURE_BUFFER, 0, static_cast<GLsizeiptr>(size), palette.data()));
+		GL(BindBuffer(GL_TEXTURE_BUFFER, 0));
+	}
+
+	const RendererImpl::StaticSkinnedMesh& RendererImpl::GetStaticSkinnedMesh(const AnimatedMesh& _mesh)
+	{
+		auto it = static_meshes_.find(&_mesh);
+		if (it != static_meshes_.end()) {
+			return it->second;
+		}
+		ZoneScopedN("Upload Static Skinned Mesh");
+
+		std::vector<GpuSkinnedVertex> vertices;
+		vertices.reserve(static_cast<size_t>(_mesh.vertex_count()));
+		bool clamped = false;
+		for (const AnimatedMesh::Part& part : _mesh.parts) {
+			const int influences = part.influences_count();
+			for (int v = 0; v < part.vertex_count(); ++v) {
+				GpuSkinnedVertex out{};
+				std::copy_n(&part.positions[v * 3], 3, out.position);
+				if (part.normals.size() >= static_cast<size_t>(v + 1) * 3) std::copy_n(&part.normals[v * 3], 3, out.normal);
+				if (part.uvs.size() >= static_cast<size_t>(v + 1) * 2) std::copy_n(&part.uvs[v * 2], 2, out.uv);
+				if (part.colors.size() >= static_cast<size_t>(v + 1) * 4) {
+					std::copy_n(&part.colors[v * 4], 4, out.color);
+				}
+				else {
+					std::fill_n(out.color, 4, uint8_t{255});
+				}
+
+				// ozz stores influences-1 weights, the last one is implicit. Keep the 4 heaviest.
+				float remaining = 1.f;
+				for (int k = 0; k < influences; ++k) {
+					const float weight = k < influences - 1 ? part.joint_weights[v * (influences - 1) + k] : remaining;
+					remaining -= weight;
+
+					int slot = k;
+					if (k >= 4) {
+						slot = static_cast<int>(std::min_element(out.weights, out.weights + 4) - out.weights);
+						if (out.weights[slot] >= weight) continue;
+					}
+					out.weights[slot] = weight;
+					out.joints[slot]  = part.joint_indices[v * influences + k];
+				}
+				if (influences > 4) {
+					clamped         = true;
+					const float sum = out.weights[0] + out.weights[1] + out.weights[2] + out.weights[3];
+					for (float& w : out.weights) w /= sum;
+				}
+				vertices.push_back(out);
+			}
+		}
+		if (clamped) {
+			GetAnimationManager().log->warn("GPU skinning keeps the 4 heaviest of up to {} joint influences", _mesh.max_influences_count());
+		}
+
+		StaticSkinnedMesh gpu;
+		gpu.index_count = static_cast<GLsizei>(_mesh.triangle_indices.size());
+		GL(GenVertexArrays(1, &gpu.vao));
+		GL(GenBuffers(1, &gpu.vbo));
+		GL(GenBuffers(1, &gpu.ibo));
+
+		GL(BindVertexArray(gpu.vao));
+		GL(BindBuffer(GL_ARRAY_BUFFER, gpu.vbo));
+		GL(BufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertices.size() * sizeof(GpuSkinnedVertex)), vertices.data(), GL_STATIC_DRAW));
+		GL(BindBuffer(GL_ELEMENT_ARRAY_BUFFER, gpu.ibo));
+		GL(BufferData(GL_ELEMENT_ARRAY_BUFFER, gpu.index_count * sizeof(AnimatedMesh::TriangleIndices::value_type), array_begin(_mesh.triangle_indices), GL_STATIC_DRAW));
+
+		const GLsizei stride = sizeof(GpuSkinnedVertex);
+		GL(EnableVertexAttribArray(0));
+		GL(VertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, GL_PTR_OFFSET(offsetof(GpuSkinnedVertex, position))));
+		GL(EnableVertexAttribArray(1));
+		GL(VertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, GL_PTR_OFFSET(offsetof(GpuSkinnedVertex, normal))));
+		GL(EnableVertexAttribArray(2));
+		GL(VertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, GL_PTR_OFFSET(offsetof(GpuSkinnedVertex, uv))));
+		GL(EnableVertexAttribArray(3));
+		GL(VertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, GL_PTR_OFFSET(offsetof(GpuSkinnedVertex, color))));
+		GL(EnableVertexAttribArray(4));
+		GL(VertexAttribIPointer(4, 4, GL_UNSIGNED_SHORT, stride, GL_PTR_OFFSET(offsetof(GpuSkinnedVertex, joints))));
+		GL(EnableVertexAttribArray(5));
+		GL(VertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, stride, GL_PTR_OFFSET(offsetof(GpuSkinnedVertex, weights))));
+
+		// Back to the renderer's shared VAO, CPU-skinned draws point their attributes at it.
+		GL(BindVertexArray(vertex_array_o_));
+		GL(BindBuffer(GL_ARRAY_BUFFER, 0));
+		GL(BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+
+		return static_meshes_.emplace(&_mesh, gpu).first->second;
+	}
+
+	void RendererImpl::ReleaseSkinnedMesh(const AnimatedMesh& mesh)
+	{
+		auto it = static_meshes_.find(&mesh);
+		if (it == static_meshes_.end()) {
+			return;
+		}
+		if (GlContextAvailable()) {
+			GL(DeleteVertexArrays(1, &it->second.vao));
+			GL(DeleteBuffers(1, &it->second.vbo));
+			GL(DeleteBuffers(1, &it->second.ibo));
+		}
+		static_meshes_.erase(it);
+	}
+
+	const RendererImpl::StaticSkinnedMesh& RendererImpl::BindGpuSkinnedMesh(const AnimatedMesh& _mesh)
+	{
+		const StaticSkinnedMesh& gpu = GetStaticSkinnedMesh(_mesh);
+		GL(ActiveTexture(kPaletteTextureUnit));
+		GL(BindTexture(GL_TEXTURE_BUFFER, palette_texture_));
+		GL(ActiveTexture(GL_TEXTURE0));
+		GL(BindVertexArray(gpu.vao));
+		return gpu;
+	}
+
+	void RendererImpl::UnbindGpuSkinnedMesh()
+	{
+		GL(BindVertexArray(vertex_array_o_));
+		GL(ActiveTexture(kPaletteTextureUnit));
+		GL(BindTexture(GL_TEXTURE_BUFFER, 0));
+		GL(ActiveTexture(GL_TEXTURE0));
+	}
+
 	bool RendererImpl::DrawAxes(const ozz::math::Float4x4& _transform)
 	{
 		GlImmediatePC         im(immediate_renderer(), GL_LINES, _transform);
@@ -1954,15 +2164,36 @@ namespace Engine{
 			return DrawMesh(mesh, transform, material, options);
 		}
 
-		const int     vertex_count     = cache.vertex_count;
+		if (cache.gpu) {
+			ZoneScopedN("GBuffer GPU Skinned Draw");
+			Material* mat_ptr = GetAssetManager().Get(material);
+			if (mat_ptr && GetAssetManager().Get(mat_ptr->GetDiffuseTexture())) {
+				GL(BindTexture(GL_TEXTURE_2D, GetAssetManager().Get(mat_ptr->GetDiffuseTexture())->GetID()));
+			}
+			skinned_textured_shader->Bind(transform, Engine::FromMatrix(GetCamera().GetViewMatrix()), Engine::FromMatrix(GetCamera().GetProjectionMatrix()), cache.palette_offset);
+
+			if (options.wireframe) {
+				GL(PolygonMode(GL_FRONT_AND_BACK, GL_LINE));
+			}
+			const StaticSkinnedMesh& gpu           = BindGpuSkinnedMesh(mesh);
+			GLenum                   attachments[] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2, GL_COLOR_ATTACHMENT3};
+			glDrawBuffers(4, attachments);
+			GL(DrawElements(GL_TRIANGLES, gpu.index_count, GL_UNSIGNED_SHORT, nullptr));
+			UnbindGpuSkinnedMesh();
+			if (options.wireframe) {
+				GL(PolygonMode(GL_FRONT_AND_BACK, GL_FILL));
+			}
+
+			GL(BindTexture(GL_TEXTURE_2D, 0));
+			skinned_textured_shader->Unbind();
+			return true;
+		}
+
 		const GLsizei positions_stride = sizeof(float) * 3;
 		const GLsizei normals_stride   = sizeof(float) * 3;
-		const GLsizei colors_stride    = sizeof(uint8_t) * 4;
-		const GLsizei uvs_stride       = options.texture ? sizeof(float) * 2 : 0;
+		const GLsizei static_stride    = sizeof(GpuSkinnedVertex);
 		const GLsizei positions_offset = cache.positionsOffset();
 		const GLsizei normals_offset   = cache.normalsOffset();
-		const GLsizei colors_offset    = cache.colorsOffset();
-		const GLsizei uvs_offset       = cache.uvsOffset();
 		const GLsizei vbo_size         = static_cast<GLsizei>(cache.vbo.size());
 
 		if (options.wireframe) {
@@ -1970,15 +2201,13 @@ namespace Engine{
 		}
 
 		if (options.triangles) {
+			const StaticSkinnedMesh& static_mesh = GetStaticSkinnedMesh(mesh);
 			{
-				ZoneScopedN("GBuffer Upload Cached VBO/IBO");
+				ZoneScopedN("GBuffer Upload Cached VBO");
 				GL(BindBuffer(GL_ARRAY_BUFFER, dynamic_array_bo_));
 				GL(BufferData(GL_ARRAY_BUFFER, vbo_size, nullptr, GL_STREAM_DRAW));
 				GL(BufferSubData(GL_ARRAY_BUFFER, 0, vbo_size, cache.vbo.data()));
-
-				GL(BindBuffer(GL_ELEMENT_ARRAY_BUFFER, dynamic_index_bo_));
-				const AnimatedMesh::TriangleIndices& indices = mesh.triangle_indices;
-				GL(BufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(AnimatedMesh::TriangleIndices::value_type), array_begin(indices), GL_STREAM_DRAW));
+				GL(BindBuffer(GL_ELEMENT_ARRAY_BUFFER, static_mesh.ibo));
 			}
 
 			AnimationShader* shader = nullptr;
@@ -1988,7 +2217,23 @@ namespace Engine{
 				const bool valid_material = mat_ptr != nullptr;
 				if (options.texture) {
 					shader = ambient_textured_shader.get();
-					ambient_textured_shader->Bind(transform, Engine::FromMatrix(GetCamera().GetViewMatrix()), Engine::FromMatrix(GetCamera().GetProjectionMatrix()), positions_stride, positions_offset, normals_stride, normals_offset, colors_stride, colors_offset, false, uvs_stride, uvs_offset);
+					// Colors and UVs come from the static buffer, positions and normals are re-pointed at this frame's skinned streams.
+					GL(BindBuffer(GL_ARRAY_BUFFER, static_mesh.vbo));
+					ambient_textured_shader->Bind(transform,
+					                              Engine::FromMatrix(GetCamera().GetViewMatrix()),
+					                              Engine::FromMatrix(GetCamera().GetProjectionMatrix()),
+					                              static_stride,
+					                              offsetof(GpuSkinnedVertex, position),
+					                              static_stride,
+					                              offsetof(GpuSkinnedVertex, normal),
+					                              static_stride,
+					                              offsetof(GpuSkinnedVertex, color),
+					                              false,
+					                              static_stride,
+					                              offsetof(GpuSkinnedVertex, uv));
+					GL(BindBuffer(GL_ARRAY_BUFFER, dynamic_array_bo_));
+					GL(VertexAttribPointer(ambient_textured_shader->attrib(0), 3, GL_FLOAT, GL_FALSE, positions_stride, GL_PTR_OFFSET(positions_offset)));
+					GL(VertexAttribPointer(ambient_textured_shader->attrib(1), 3, GL_FLOAT, GL_FALSE, normals_stride, GL_PTR_OFFSET(normals_offset)));
 					if (valid_material) {
 						if (GetAssetManager().Get(mat_ptr->GetDiffuseTexture())) {
 							GL(BindTexture(GL_TEXTURE_2D, GetAssetManager().Get(mat_ptr->GetDiffuseTexture())->GetID()));
@@ -2005,8 +2250,7 @@ namespace Engine{
 				ZoneScopedN("GBuffer DrawElements");
 				GLenum attachments[] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2, GL_COLOR_ATTACHMENT3};
 				glDrawBuffers(4, attachments);
-				const AnimatedMesh::TriangleIndices& indices = mesh.triangle_indices;
-				GL(DrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_SHORT, 0));
+				GL(DrawElements(GL_TRIANGLES, static_mesh.index_count, GL_UNSIGNED_SHORT, nullptr));
 			}
 
 			GL(BindBuffer(GL_ARRAY_BUFFER, 0));
@@ -2020,7 +2264,6 @@ namespace Engine{
 		if (options.wireframe) {
 			GL(PolygonMode(GL_FRONT_AND_BACK, GL_FILL));
 		}
-		(void)vertex_count;
 		return true;
 	}
 
@@ -2031,23 +2274,34 @@ namespace Engine{
 			return false;
 		}
 
+		if (cache.gpu) {
+			ZoneScopedN("MousePick GPU Skinned Draw");
+			m_gpu_skinned_mouse_picking_shader.Bind();
+			UniformMat4(transform, m_gpu_skinned_mouse_picking_shader.GetUniformLocation("u_model"));
+			UniformMat4(GetCamera().view_proj(), m_gpu_skinned_mouse_picking_shader.GetUniformLocation("u_viewproj"));
+			m_gpu_skinned_mouse_picking_shader.SetInt("u_paletteOffset", cache.palette_offset);
+			m_gpu_skinned_mouse_picking_shader.SetVec3("entityIDColor", entityColor);
+
+			const StaticSkinnedMesh& gpu = BindGpuSkinnedMesh(mesh);
+			GL(DrawElements(GL_TRIANGLES, gpu.index_count, GL_UNSIGNED_SHORT, nullptr));
+			UnbindGpuSkinnedMesh();
+			glUseProgram(0);
+			return true;
+		}
+
 		const GLsizei positions_stride = sizeof(float) * 3;
 		const GLsizei normals_stride   = sizeof(float) * 3;
-		const GLsizei colors_stride    = sizeof(uint8_t) * 4;
 		const GLsizei positions_offset = cache.positionsOffset();
 		const GLsizei normals_offset   = cache.normalsOffset();
-		const GLsizei colors_offset    = cache.colorsOffset();
 		const GLsizei vbo_size         = static_cast<GLsizei>(cache.vbo.size());
 
+		const StaticSkinnedMesh& static_mesh = GetStaticSkinnedMesh(mesh);
 		{
-			ZoneScopedN("MousePick Upload Cached VBO/IBO");
+			ZoneScopedN("MousePick Upload Cached VBO");
 			GL(BindBuffer(GL_ARRAY_BUFFER, dynamic_array_bo_));
 			GL(BufferData(GL_ARRAY_BUFFER, vbo_size, nullptr, GL_STREAM_DRAW));
 			GL(BufferSubData(GL_ARRAY_BUFFER, 0, vbo_size, cache.vbo.data()));
-
-			GL(BindBuffer(GL_ELEMENT_ARRAY_BUFFER, dynamic_index_bo_));
-			const AnimatedMesh::TriangleIndices& indices = mesh.triangle_indices;
-			GL(BufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(AnimatedMesh::TriangleIndices::value_type), array_begin(indices), GL_STREAM_DRAW));
+			GL(BindBuffer(GL_ELEMENT_ARRAY_BUFFER, static_mesh.ibo));
 		}
 
 		{
@@ -2058,15 +2312,12 @@ namespace Engine{
 			GL(VertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, positions_stride, GL_PTR_OFFSET(positions_offset)));
 			GL(EnableVertexAttribArray(1));
 			GL(VertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, normals_stride, GL_PTR_OFFSET(normals_offset)));
-			GL(EnableVertexAttribArray(2));
-			GL(VertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, true, colors_stride, GL_PTR_OFFSET(colors_offset)));
 
 			UniformMat4(transform, glGetUniformLocation(m_animation_mouse_picking_shader.GetProgramID(), "u_model"));
 			UniformMat4(GetCamera().view_proj(), glGetUniformLocation(m_animation_mouse_picking_shader.GetProgramID(), "u_viewproj"));
 			m_animation_mouse_picking_shader.SetVec3("entityIDColor", entityColor);
 
-			const AnimatedMesh::TriangleIndices& indices = mesh.triangle_indices;
-			GL(DrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_SHORT, nullptr));
+			GL(DrawElements(GL_TRIANGLES, static_mesh.index_count, GL_UNSIGNED_SHORT, nullptr));
 		}
 
 		GL(BindBuffer(GL_ARRAY_BUFFER, 0));
@@ -2079,30 +2330,41 @@ namespace Engine{
 		return true;
 	}
 
-	bool RendererImpl::DrawSkinnedMeshShadowsCached(Engine::Shader* shadowShader, const SkinnedMeshFrameCache& cache, const AnimatedMesh& mesh, const ozz::math::Float4x4& transform)
+	bool RendererImpl::DrawSkinnedMeshShadowsCached(Engine::Shader* shadowShader, const SkinnedMeshFrameCache& cache, const AnimatedMesh& mesh, const ozz::math::Float4x4& transform, int skipCascades)
 	{
 		ZoneScopedN("DrawSkinnedMeshShadowsCached");
 		if (!cache.valid || cache.vertex_count <= 0 || !shadowShader) {
 			return false;
 		}
 
+		// GPU-skinned meshes use their own depth shader; it shares the LightSpaceMatrices block and geometry stage.
+		if (cache.gpu) {
+			ZoneScopedN("Shadow GPU Skinned Draw");
+			m_gpu_skinned_depth_shader.Bind();
+			UniformMat4(transform, m_gpu_skinned_depth_shader.GetUniformLocation("model"));
+			m_gpu_skinned_depth_shader.SetInt("u_paletteOffset", cache.palette_offset);
+			m_gpu_skinned_depth_shader.SetInt("skipCascades", skipCascades);
+
+			const StaticSkinnedMesh& gpu = BindGpuSkinnedMesh(mesh);
+			GL(DrawElements(GL_TRIANGLES, gpu.index_count, GL_UNSIGNED_SHORT, nullptr));
+			UnbindGpuSkinnedMesh();
+			glUseProgram(0);
+			return true;
+		}
+
 		const GLsizei positions_stride = sizeof(float) * 3;
 		const GLsizei normals_stride   = sizeof(float) * 3;
-		const GLsizei colors_stride    = sizeof(uint8_t) * 4;
 		const GLsizei positions_offset = cache.positionsOffset();
 		const GLsizei normals_offset   = cache.normalsOffset();
-		const GLsizei colors_offset    = cache.colorsOffset();
 		const GLsizei vbo_size         = static_cast<GLsizei>(cache.vbo.size());
 
+		const StaticSkinnedMesh& static_mesh = GetStaticSkinnedMesh(mesh);
 		{
-			ZoneScopedN("Shadow Upload Cached VBO/IBO");
+			ZoneScopedN("Shadow Upload Cached VBO");
 			GL(BindBuffer(GL_ARRAY_BUFFER, dynamic_array_bo_));
 			GL(BufferData(GL_ARRAY_BUFFER, vbo_size, nullptr, GL_STREAM_DRAW));
 			GL(BufferSubData(GL_ARRAY_BUFFER, 0, vbo_size, cache.vbo.data()));
-
-			GL(BindBuffer(GL_ELEMENT_ARRAY_BUFFER, dynamic_index_bo_));
-			const AnimatedMesh::TriangleIndices& indices = mesh.triangle_indices;
-			GL(BufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(AnimatedMesh::TriangleIndices::value_type), array_begin(indices), GL_STREAM_DRAW));
+			GL(BindBuffer(GL_ELEMENT_ARRAY_BUFFER, static_mesh.ibo));
 		}
 
 		{
@@ -2113,13 +2375,14 @@ namespace Engine{
 			GL(VertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, positions_stride, GL_PTR_OFFSET(positions_offset)));
 			GL(EnableVertexAttribArray(1));
 			GL(VertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, normals_stride, GL_PTR_OFFSET(normals_offset)));
+			// UVs for alpha-tested shadows, from the static buffer.
+			GL(BindBuffer(GL_ARRAY_BUFFER, static_mesh.vbo));
 			GL(EnableVertexAttribArray(2));
-			GL(VertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, true, colors_stride, GL_PTR_OFFSET(colors_offset)));
+			GL(VertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(GpuSkinnedVertex), GL_PTR_OFFSET(offsetof(GpuSkinnedVertex, uv))));
 
 			UniformMat4(transform, glGetUniformLocation(shadowShader->GetProgramID(), "model"));
 
-			const AnimatedMesh::TriangleIndices& indices = mesh.triangle_indices;
-			GL(DrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_SHORT, nullptr));
+			GL(DrawElements(GL_TRIANGLES, static_mesh.index_count, GL_UNSIGNED_SHORT, nullptr));
 		}
 
 		GL(BindBuffer(GL_ARRAY_BUFFER, 0));
@@ -2128,7 +2391,6 @@ namespace Engine{
 		glUseProgram(0);
 		glDisableVertexAttribArray(0);
 		glDisableVertexAttribArray(1);
-		glDisableVertexAttribArray(2);
 		return true;
 	}
 
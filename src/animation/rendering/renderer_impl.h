@@ -10,11 +10,13 @@
 #include "ozz/base/containers/vector.h"
 
 #include "ozz/base/memory/unique_ptr.h"
+#include "ozz/base/span.h"
 #include "rendering/Material.h"
 
 
 #include "rendering/Shader.h"
 
+#include <unordered_map>
 
 // Provides helper macro to test for glGetError on a gl call.
 #ifndef NDEBUG
@@ -73,6 +75,7 @@ namespace Engine
 	class AmbientShader;
 	class AmbientTexturedShader;
 	class AmbientShaderInstanced;
+	class SkinnedAmbientTexturedShader;
 	class GlImmediateRenderer;
 
 
@@ -134,7 +137,17 @@ namespace Engine
 		/// Draw using a once-per-frame CPU skin cache (no SkinningJob).
 		bool DrawSkinnedMeshCached(const SkinnedMeshFrameCache& cache, const AnimatedMesh& mesh, const ozz::math::Float4x4& transform, MaterialHandle material, const Options& options = Options());
 		bool DrawSkinnedMeshMousePickingCached(glm::vec3 entityColor, const SkinnedMeshFrameCache& cache, const AnimatedMesh& mesh, const ozz::math::Float4x4& transform);
-		bool DrawSkinnedMeshShadowsCached(Engine::Shader* shadowShader, const SkinnedMeshFrameCache& cache, const AnimatedMesh& mesh, const ozz::math::Float4x4& transform);
+		/// `skipCascades` is set on the GPU-skinning depth shader; the caller sets it on `shadowShader`.
+		bool DrawSkinnedMeshShadowsCached(Engine::Shader* shadowShader, const SkinnedMeshFrameCache& cache, const AnimatedMesh& mesh, const ozz::math::Float4x4& transform, int skipCascades = 0);
+
+		/// GPU skinning: the *Cached draws above skin in the vertex shader when `cache.gpu` is set.
+		[[nodiscard]] bool SupportsGpuSkinning() const { return gpu_skinning_supported_; }
+		/// Largest palette (in matrices) one frame can upload.
+		[[nodiscard]] int MaxPaletteMatrices() const { return max_palette_matrices_; }
+		/// Uploads every GPU-skinned mesh's joint palette for this frame in one buffer update.
+		void UploadSkinningPalette(ozz::span<const ozz::math::Float4x4> palette);
+		/// Frees the static vertex buffers uploaded for `mesh`; call before the mesh is destroyed.
+		void ReleaseSkinnedMesh(const AnimatedMesh& mesh);
 
 		virtual bool DrawMesh(const Engine::AnimatedMesh& _mesh, const ozz::math::Float4x4& _transform, MaterialHandle _material, const Options& _options = Options());
 
@@ -197,6 +210,27 @@ namespace Engine
 		// Draw posture internal instanced rendering implementation.
 		void DrawPosture_InstancedImpl(const ozz::math::Float4x4& _transform, const float* _uniforms, int _instance_count, bool _draw_joints);
 
+		// Static streams of one AnimatedMesh: bind-pose vertices with up to 4 joint influences
+		// each, colors, UVs and indices. Uploaded on first skinned draw and kept until
+		// ReleaseSkinnedMesh; CPU-skinned draws read colors, UVs and indices from here too.
+		struct StaticSkinnedMesh {
+			GLuint  vao         = 0;
+			GLuint  vbo         = 0;
+			GLuint  ibo         = 0;
+			GLsizei index_count = 0;
+		};
+
+		// Finds or uploads the static buffers of `_mesh`.
+		const StaticSkinnedMesh& GetStaticSkinnedMesh(const AnimatedMesh& _mesh);
+
+		// Builds GPU skinning shaders and the palette texture buffer.
+		// Return false if GPU skinning is unavailable; the CPU path is used then.
+		bool InitGpuSkinning();
+
+		// Binds the palette texture buffer and the static buffers of `_mesh`.
+		const StaticSkinnedMesh& BindGpuSkinnedMesh(const AnimatedMesh& _mesh);
+		void                     UnbindGpuSkinnedMesh();
+
 		// Array of matrices used to store model space matrices during DrawSkeleton
 		// execution.
 		ozz::vector<ozz::math::Float4x4> prealloc_models_;
@@ -216,6 +250,14 @@ namespace Engine
 		// Dynamic vbo used for indices.
 		GLuint dynamic_index_bo_ = 0;
 
+		// Static per-mesh buffers and the GPU skinning per-frame joint palette (texture buffer of RGBA32F).
+		std::unordered_map<const AnimatedMesh*, StaticSkinnedMesh> static_meshes_;
+		GLuint                                                      palette_bo_             = 0;
+		GLuint                                                      palette_texture_        = 0;
+		size_t                                                      palette_capacity_       = 0;
+		int                                                         max_palette_matrices_   = 0;
+		bool                                                        gpu_skinning_supported_ = false;
+
 		// Volatile memory buffer that can be used within function scope.
 		// Minimum alignment is 16 bytes.
 		class ScratchBuffer {
@@ -242,6 +284,11 @@ namespace Engine
 		ozz::unique_ptr<PointsShader>           points_shader;
 		Engine::Shader                          m_animation_mouse_picking_shader;
 
+		// GPU skinning variants of the GBuffer, mouse picking and shadow shaders.
+		ozz::unique_ptr<SkinnedAmbientTexturedShader> skinned_textured_shader;
+		Engine::Shader                                m_gpu_skinned_mouse_picking_shader;
+		Engine::Shader                                m_gpu_skinned_depth_shader;
+
 		// Checkered texture
 		// GLuint checkered_texture_ = 0;
 	};
@@ -0,0 +1,110 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#include "AssetBenchmark.h"
+
+#include <chrono>
+#include <random>
+#include <typeindex>
+
+#include "AssetManager.h"
+
+namespace Engine {
+
+	namespace {
+		struct BenchmarkAsset {
+			uint64_t value = 0;
+		};
+
+		using Clock = std::chrono::steady_clock;
+
+		double ElapsedMs(Clock::time_point start)
+		{
+			return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		}
+
+		// The storage layout and lookup Get() used before slot handles.
+		struct LegacyStorageBase {
+			virtual ~LegacyStorageBase() = default;
+		};
+		struct LegacyStorage : LegacyStorageBase {
+			std::unordered_map<std::string, std::unique_ptr<BenchmarkAsset>> guidToAsset;
+		};
+		struct LegacyManager {
+			std::unordered_map<std::type_index, std::unique_ptr<LegacyStorageBase>> storages;
+
+			LegacyStorage& GetStorage()
+			{
+				auto typeId = std::type_index(typeid(BenchmarkAsset));
+				if (storages.find(typeId) == storages.end()) {
+					storages[typeId] = std::make_unique<LegacyStorage>();
+				}
+				return *static_cast<LegacyStorage*>(storages[typeId].get());
+			}
+
+			BenchmarkAsset* Get(const std::string& guid)
+			{
+				auto& storage = GetStorage();
+				auto  it      = storage.guidToAsset.find(guid);
+				return it == storage.guidToAsset.end() ? nullptr : it->second.get();
+			}
+		};
+	} // namespace
+
+	AssetLookupBenchmarkResult RunAssetLookupBenchmark(uint32_t assets, uint32_t lookups, uint32_t seed)
+	{
+		AssetLookupBenchmarkResult result;
+		result.assets  = assets;
+		result.lookups = lookups;
+
+		LegacyManager legacy;
+		AssetManager  manager;
+		auto&         storage = manager.GetStorage<BenchmarkAsset>();
+
+		std::vector<std::string> guids;
+		guids.reserve(assets);
+		for (uint32_t i = 0; i < assets; ++i) {
+			guids.push_back(AssetManager::GenerateGUID());
+			legacy.GetStorage().guidToAsset[guids.back()] = std::make_unique<BenchmarkAsset>(BenchmarkAsset {i});
+			manager.InsertAsset(storage, guids.back(), std::make_unique<BenchmarkAsset>(BenchmarkAsset {i}));
+		}
+
+		// Same random access pattern for every variant; handles live in components, so they persist.
+		std::mt19937                            rng(seed);
+		std::uniform_int_distribution<uint32_t> pick(0, assets - 1);
+		std::vector<uint32_t>                   order(lookups);
+		for (auto& index : order)
+			index = pick(rng);
+
+		std::vector<AssetHandle<BenchmarkAsset>> handles;
+		handles.reserve(assets);
+		for (const auto& guid : guids)
+			handles.emplace_back(guid);
+
+		uint64_t checksum = 0;
+		auto     perGet   = [](Clock::time_point start, uint32_t count) { return ElapsedMs(start) * 1.0e6 / static_cast<double>(count); };
+
+		auto start = Clock::now();
+		for (const uint32_t index : order)
+			checksum += legacy.Get(guids[index])->value;
+		result.legacyNs = perGet(start, lookups);
+
+		start = Clock::now();
+		for (const auto& handle : handles)
+			checksum += manager.Get(handle)->value;
+		result.uncachedNs = perGet(start, assets);
+
+		start = Clock::now();
+		for (const uint32_t index : order)
+			checksum += manager.Get(handles[index])->value;
+		result.cachedNs = perGet(start, lookups);
+
+		// Keep the loops from being optimized away.
+		if (checksum == 0) result.lookups = 0;
+		return result;
+	}
+
+} // namespace Engine
+
+#include "assets/AssetManager.inl"
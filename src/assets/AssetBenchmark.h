@@ -0,0 +1,24 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include <cstdint>
+
+namespace Engine {
+
+	struct AssetLookupBenchmarkResult {
+		uint32_t assets  = 0;
+		uint32_t lookups = 0;
+		// Nanoseconds per Get().
+		double legacyNs   = 0.0; // type_index map → GUID-keyed unordered_map (the old Get)
+		double uncachedNs = 0.0; // first Get() of a handle: GUID → slot under the shared lock
+		double cachedNs   = 0.0; // handle already resolved: generation-checked slot read
+	};
+
+	/// Get() cost on a private AssetManager with `assets` entries and `lookups` random gets
+	/// (the uncached variant can only miss once per handle, so it resolves each handle once).
+	AssetLookupBenchmarkResult RunAssetLookupBenchmark(uint32_t assets = 4096, uint32_t lookups = 1u << 20, uint32_t seed = 1337);
+
+} // namespace Engine
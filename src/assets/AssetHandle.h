@@ -5,6 +5,10 @@
 #ifndef CPP_ENGINE_ASSETHANDLE_H
 #define CPP_ENGINE_ASSETHANDLE_H
 
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
 
 namespace Engine
 {
@@ -33,13 +37,36 @@ namespace Engine
 }
 
 namespace Engine {
+	class AssetManager;
+
 	template <typename T>
 	class AssetHandle {
 		std::string guid {};
 
+		// Slot the GUID resolved to last time (AssetSlotRef::Pack); 0 = not resolved.
+		// Atomic so worker threads can share a handle; a stale value only costs a re-resolve.
+		mutable std::atomic<uint64_t> slot {0};
+
+		friend class AssetManager;
+
 	  public:
 		AssetHandle() = default;
 		explicit AssetHandle(const std::string& guid) : guid(guid) {}
+		AssetHandle(const AssetHandle& other) : guid(other.guid), slot(other.slot.load(std::memory_order_relaxed)) {}
+		AssetHandle& operator=(const AssetHandle& other)
+		{
+			guid = other.guid;
+			slot.store(other.slot.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			return *this;
+		}
+		AssetHandle(AssetHandle&& other) noexcept : guid(std::move(other.guid)), slot(other.slot.load(std::memory_order_relaxed)) {}
+		AssetHandle& operator=(AssetHandle&& other) noexcept
+		{
+			guid = std::move(other.guid);
+			slot.store(other.slot.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			return *this;
+		}
+
 		[[nodiscard]] const std::string& GetID() const { return guid; }
 		[[nodiscard]] bool               IsValid() const { return !guid.empty() && guid.size() == 32; }
 
@@ -2,8 +2,22 @@
 #include "rendering/Renderer.h"
 #include "core/EngineData.h"
 
+#include <algorithm>
+#include <chrono>
+#include <unordered_set>
+
 namespace Engine {
 
+	AssetManager::~AssetManager()
+	{
+		StopLoaderThreads();
+	}
+
+	bool AssetManager::MountPack(const std::string& path)
+	{
+		return m_pack.Open(path);
+	}
+
 	void AssetManager::QueueAction(const AssetAction& action)
 	{
 		std::lock_guard<std::mutex> lock(m_actionMutex);
@@ -12,6 +26,12 @@ namespace Engine {
 
 	void AssetManager::Update()
 	{
+		// Everything that could still hold a pointer from last frame has finished.
+		for (auto& storage : storages)
+			storage->FreeRetired();
+
+		ProcessUploads(uploadBudgetMs);
+
 		std::vector<AssetAction> actions;
 		{
 			std::lock_guard<std::mutex> lock(m_actionMutex);
@@ -62,4 +82,182 @@ namespace Engine {
 		}
 	}
 
+	void AssetManager::StartLoaderThreads()
+	{
+		if (!m_loaderThreads.empty()) return;
+
+		// Decodes block on disk, so they get their own threads instead of the frame job pool
+		// (whose waits would otherwise run a long decode on the main thread).
+		const unsigned hw    = std::max(2u, std::thread::hardware_concurrency());
+		const unsigned count = std::clamp(hw / 2, 1u, 4u);
+
+		m_stopLoaders = false;
+		for (unsigned i = 0; i < count; ++i)
+			m_loaderThreads.emplace_back([this] { LoaderThreadLoop(); });
+		Logger::get("core")->info("[AssetManager] started {} loader threads", count);
+	}
+
+	void AssetManager::StopLoaderThreads()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_loaderMutex);
+			m_stopLoaders = true;
+		}
+		m_decodeCv.notify_all();
+		for (auto& thread : m_loaderThreads)
+			thread.join();
+		m_loaderThreads.clear();
+
+		std::lock_guard<std::mutex> lock(m_loaderMutex);
+		m_decodeQueue.clear();
+		m_uploadQueue.clear();
+	}
+
+	void AssetManager::LoaderThreadLoop()
+	{
+		for (;;) {
+			std::shared_ptr<AsyncLoad> load;
+			{
+				std::unique_lock<std::mutex> lock(m_loaderMutex);
+				m_decodeCv.wait(lock, [this] { return m_stopLoaders || !m_decodeQueue.empty(); });
+				if (m_stopLoaders) return;
+				load = std::move(m_decodeQueue.front());
+				m_decodeQueue.pop_front();
+			}
+
+			{
+				ZoneScopedN("Decode Asset");
+				try {
+					load->payload = load->decode();
+				}
+				catch (const std::exception& e) {
+					Logger::get("core")->error("[AssetManager] exception decoding {}: {}", load->path, e.what());
+				}
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(m_loaderMutex);
+				m_uploadQueue.push_back(std::move(load));
+			}
+			m_uploadCv.notify_all();
+		}
+	}
+
+	void AssetManager::DispatchLoads()
+	{
+		if (m_waitingLoads.empty() || m_loadsInFlight >= kMaxLoadsInFlight) return;
+		{
+			std::lock_guard<std::mutex> lock(m_loaderMutex);
+			while (!m_waitingLoads.empty() && m_loadsInFlight < kMaxLoadsInFlight) {
+				m_decodeQueue.push_back(std::move(m_waitingLoads.front()));
+				m_waitingLoads.pop_front();
+				m_loadsInFlight++;
+			}
+		}
+		m_decodeCv.notify_all();
+	}
+
+	void AssetManager::CompleteLoad(AsyncLoad& load)
+	{
+		m_loadsInFlight--;
+
+		bool loaded = false;
+		if (load.payload) {
+			try {
+				loaded = load.finish(*load.payload);
+			}
+			catch (const std::exception& e) {
+				Logger::get("core")->error("[AssetManager] exception finishing {}: {}", load.path, e.what());
+			}
+		}
+
+		if (loaded) {
+			m_asyncStats.completed++;
+			if (!load.payload->dependencies.empty()) m_asyncDependencies[load.guid] = std::move(load.payload->dependencies);
+		}
+		else {
+			m_asyncStats.failed++;
+			Logger::get("core")->error("[AssetManager] async load failed: {}", load.path);
+		}
+		m_asyncLoads.erase(load.guid);
+	}
+
+	void AssetManager::ProcessUploads(double budgetMs)
+	{
+		ZoneScoped;
+		using Clock = std::chrono::steady_clock;
+
+		m_asyncStats.uploadsLastRun  = 0;
+		m_asyncStats.uploadMsLastRun = 0.0;
+		if (m_asyncLoads.empty()) return;
+
+		DispatchLoads();
+		const auto start = Clock::now();
+		for (;;) {
+			std::shared_ptr<AsyncLoad> load;
+			{
+				std::lock_guard<std::mutex> lock(m_loaderMutex);
+				if (m_uploadQueue.empty()) break;
+				load = std::move(m_uploadQueue.front());
+				m_uploadQueue.pop_front();
+			}
+
+			CompleteLoad(*load);
+			m_asyncStats.uploadsLastRun++;
+			DispatchLoads();
+
+			const double elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+			if (budgetMs > 0.0 && elapsed >= budgetMs) break;
+		}
+		m_asyncStats.uploadMsLastRun = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+
+	std::vector<std::string> AssetManager::PendingClosure(const std::vector<std::string>& roots) const
+	{
+		std::vector<std::string>        pending;
+		std::vector<std::string>        stack(roots.begin(), roots.end());
+		std::unordered_set<std::string> visited;
+
+		while (!stack.empty()) {
+			std::string guid = std::move(stack.back());
+			stack.pop_back();
+			if (!visited.insert(guid).second) continue;
+
+			if (m_asyncLoads.count(guid)) pending.push_back(guid);
+			auto deps = m_asyncDependencies.find(guid);
+			if (deps != m_asyncDependencies.end()) stack.insert(stack.end(), deps->second.begin(), deps->second.end());
+		}
+		return pending;
+	}
+
+	void AssetManager::WaitFor(const std::vector<std::string>& guids)
+	{
+		ZoneScoped;
+		for (;;) {
+			ProcessUploads(0.0);
+
+			std::vector<std::string> pending = PendingClosure(guids);
+			if (pending.empty()) return;
+
+			// Move what we are waiting on ahead of everything else still queued.
+			std::unordered_set<std::string> wanted(pending.begin(), pending.end());
+			std::stable_partition(m_waitingLoads.begin(), m_waitingLoads.end(), [&](const auto& load) { return wanted.count(load->guid) != 0; });
+			DispatchLoads();
+
+			std::unique_lock<std::mutex> lock(m_loaderMutex);
+			if (m_loadsInFlight == 0 && m_uploadQueue.empty()) {
+				Logger::get("core")->error("[AssetManager] WaitFor: {} assets pending but nothing in flight", pending.size());
+				return;
+			}
+			m_uploadCv.wait(lock, [this] { return !m_uploadQueue.empty(); });
+		}
+	}
+
+	AssetManager::AsyncLoadStats AssetManager::GetAsyncLoadStats() const
+	{
+		AsyncLoadStats stats = m_asyncStats;
+		stats.pending        = static_cast<uint32_t>(m_asyncLoads.size());
+		return stats;
+	}
+
 } // namespace Engine
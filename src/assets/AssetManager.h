@@ -5,8 +5,14 @@
 #ifndef CPP_ENGINE_ASSETMANAGER_H
 #define CPP_ENGINE_ASSETMANAGER_H
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <shared_mutex>
+#include <thread>
 #include <unordered_map>
-#include <typeindex>
 
 
 #include <cassert>
@@ -15,6 +21,8 @@
 #include <sstream>
 
 #include "AssetHandle.h"
+#include "AssetPack.h"
+#include "AssetSlotArray.h"
 #include "IAssetLoader.h"
 
 
@@ -22,9 +30,41 @@ namespace Engine {
 
 	class AssetManager {
 	  public:
+		AssetManager() = default;
+		~AssetManager();
+
 		template <typename T>
 		AssetHandle<T> Load(const std::string& path);
 
+		/// Queue `path` on the loader threads and return its handle at once; Get() returns
+		/// nullptr until the asset has been uploaded by Update(). Loaders without async
+		/// support load synchronously. Main thread.
+		template <typename T>
+		AssetHandle<T> LoadAsync(const std::string& path);
+
+		/// Block until `guids` and everything they depend on have finished loading (or failed). Main thread.
+		void WaitFor(const std::vector<std::string>& guids);
+		/// Finish decoded loads for up to `budgetMs` (<= 0: everything that is ready). Main thread.
+		void ProcessUploads(double budgetMs);
+		[[nodiscard]] bool IsLoading(const std::string& guid) const { return m_asyncLoads.count(guid) != 0; }
+
+		struct AsyncLoadStats {
+			uint32_t pending         = 0; // queued, decoding or awaiting upload
+			uint32_t completed       = 0;
+			uint32_t failed          = 0;
+			uint32_t uploadsLastRun  = 0;
+			double   uploadMsLastRun = 0.0;
+		};
+		[[nodiscard]] AsyncLoadStats GetAsyncLoadStats() const;
+
+		/// Main-thread time per frame spent finishing async loads.
+		double uploadBudgetMs = 4.0;
+
+		/// Serve loads from a cooked pack (game builds): paths resolve to GUIDs through its tables instead
+		/// of `.meta` files, and cooked entries decode from the mapping. Main thread, before anything loads.
+		bool MountPack(const std::string& path);
+		[[nodiscard]] const AssetPack* GetPack() const { return m_pack.IsOpen() ? &m_pack : nullptr; }
+
 		template <typename T>
 		T* Get(const AssetHandle<T>& handle);
 
@@ -59,20 +99,35 @@ namespace Engine {
 		};
 
 		void QueueAction(const AssetAction& action);
+		/// Main thread, once per frame: apply queued actions, then free assets unloaded last frame.
 		void Update();
 
 		struct IStorageBase {
-			virtual ~IStorageBase() = default;
+			virtual ~IStorageBase()    = default;
+			virtual void FreeRetired() = 0;
 		};
 
+		/// Assets live in a slot array; the GUID (persisted in `.meta`) maps to a slot.
+		/// Handles cache their slot, so Get() normally skips the GUID lookup entirely.
 		template <typename T>
 		struct AssetStorage : IStorageBase {
-			std::unordered_map<std::string, std::unique_ptr<T>> guidToAsset;
-			std::unordered_map<std::string, std::string>        pathToGuid; // New: Map path to GUID
-			std::unique_ptr<IAssetLoader<T>>                    loader;
+			AssetSlotArray<T>                            slots;
+			std::unordered_map<std::string, uint32_t>    guidToSlot; // guarded by AssetManager::m_lookupMutex
+			std::unordered_map<std::string, std::string> pathToGuid; // New: Map path to GUID
+			std::unique_ptr<IAssetLoader<T>>             loader;
+
+			void FreeRetired() override { slots.FreeRetired(); }
+
+			/// fn(const std::string& guid, T& asset) for every loaded asset. Main thread.
+			template <typename Fn>
+			void ForEach(Fn&& fn) const
+			{
+				slots.ForEach(std::forward<Fn>(fn));
+			}
 		};
 
 
+		/// Safe from any thread once the type has been registered.
 		template <typename T>
 		AssetStorage<T>& GetStorage();
 
@@ -93,10 +148,76 @@ namespace Engine {
 		}
 
 
-		std::unordered_map<std::type_index, std::unique_ptr<IStorageBase>> storages;
-		
+		static constexpr uint32_t kMaxAssetTypes = 32;
+
+		template <typename T>
+		static uint32_t TypeId()
+		{
+			static const uint32_t id = s_nextTypeId.fetch_add(1, std::memory_order_relaxed);
+			return id;
+		}
+
+		/// The pack entry for `normPath`, or nullptr when no pack is mounted or it does not list the path.
+		[[nodiscard]] const AssetPack::Entry* FindPacked(const std::string& normPath) const;
+		/// GUID from the pack entry if there is one, else from the `.meta` file.
+		template <typename T>
+		std::string ResolveGuid(const AssetPack::Entry* packed, const std::string& normPath);
+
+		template <typename T>
+		void InsertAsset(AssetStorage<T>& storage, const std::string& guid, std::unique_ptr<T> asset);
+		template <typename T>
+		void RemoveAsset(AssetStorage<T>& storage, const std::string& guid);
+
+		// Indexed by TypeId<T>(); the table is read lock-free, `storages` owns the entries.
+		std::array<std::atomic<IStorageBase*>, kMaxAssetTypes> m_storageTable {};
+		std::vector<std::unique_ptr<IStorageBase>>             storages;
+		std::mutex                                             m_storageMutex;
+		inline static std::atomic<uint32_t>                    s_nextTypeId {0};
+
+		// Writers (main thread) lock exclusively; uncached Get() on workers locks shared.
+		std::shared_mutex m_lookupMutex;
+
 		std::vector<AssetAction> m_pendingActions;
 		std::mutex               m_actionMutex;
+
+		AssetPack m_pack;
+
+		// --- async loading ---
+
+		/// Decoded assets not yet uploaded hold their CPU data; cap how many exist at once.
+		static constexpr uint32_t kMaxLoadsInFlight = 32;
+
+		struct AsyncLoad {
+			std::string                                    guid;
+			std::string                                    path;
+			std::function<std::unique_ptr<AssetPayload>()> decode; // loader thread
+			std::function<bool(AssetPayload&)>             finish; // main thread; inserts the asset
+			std::unique_ptr<AssetPayload>                  payload;
+		};
+
+		void StartLoaderThreads();
+		void StopLoaderThreads();
+		void LoaderThreadLoop();
+		/// Hand waiting loads to the loader threads while under kMaxLoadsInFlight.
+		void DispatchLoads();
+		void CompleteLoad(AsyncLoad& load);
+		/// GUIDs among `roots` and their known dependencies that are still loading.
+		std::vector<std::string> PendingClosure(const std::vector<std::string>& roots) const;
+
+		std::vector<std::thread>                m_loaderThreads;
+		std::mutex                              m_loaderMutex;
+		std::condition_variable                 m_decodeCv; // loader threads: work queued
+		std::condition_variable                 m_uploadCv; // WaitFor: decode finished
+		std::deque<std::shared_ptr<AsyncLoad>>  m_decodeQueue; // guarded by m_loaderMutex
+		std::deque<std::shared_ptr<AsyncLoad>>  m_uploadQueue; // guarded by m_loaderMutex
+		bool                                    m_stopLoaders = false;
+
+		// Main thread only.
+		std::deque<std::shared_ptr<AsyncLoad>>                        m_waitingLoads;
+		std::unordered_map<std::string, std::shared_ptr<AsyncLoad>> m_asyncLoads; // guid -> load in progress
+		std::unordered_map<std::string, std::vector<std::string>>     m_asyncDependencies;
+		uint32_t                                                      m_loadsInFlight = 0;
+		AsyncLoadStats                                                m_asyncStats;
     };
 
 } // namespace Engine
@@ -39,19 +39,29 @@ namespace Engine {
         std::string normPath = NormalizePath(path);
         auto& storage = GetStorage<T>();
 
-        std::string guid = EnsureMetaFile<T>(normPath);
+        const AssetPack::Entry* packed = FindPacked(normPath);
+        std::string guid = ResolveGuid<T>(packed, normPath);
 
-        auto it = storage.guidToAsset.find(guid);
-        if (it != storage.guidToAsset.end()) return AssetHandle<T>(guid);
+        {
+            std::shared_lock lock(m_lookupMutex);
+            if (storage.guidToSlot.count(guid)) return AssetHandle<T>(guid);
+        }
 
         assert(storage.loader);
         try {
-            auto asset = storage.loader->LoadFromFile(normPath);
+            std::unique_ptr<T> asset;
+            if (packed && packed->cooked) {
+                auto payload = storage.loader->DecodeCooked(m_pack.Data(*packed), packed->dataSize, normPath);
+                if (payload) asset = storage.loader->Finish(*payload, normPath);
+            }
+            else {
+                asset = storage.loader->LoadFromFile(normPath);
+            }
             if (!asset) {
                 Logger::get("core")->error("[AssetManager] LoadFromFile returned null: {}", normPath);
                 return AssetHandle<T>();
             }
-            storage.guidToAsset[guid] = std::move(asset);
+            InsertAsset(storage, guid, std::move(asset));
             storage.pathToGuid[normPath] = guid;
             return AssetHandle<T>(guid);
         }
@@ -71,25 +81,103 @@ namespace Engine {
     }
 
 	template <typename T>
-	T* AssetManager::Get(const AssetHandle<T>& handle)
+	AssetHandle<T> AssetManager::LoadAsync(const std::string& path)
 	{
-		auto&              storage = GetStorage<T>();
-		const std::string& guid    = handle.GetID();
+		std::string normPath = NormalizePath(path);
+		auto&       storage  = GetStorage<T>();
+		assert(storage.loader);
+		if (!storage.loader->SupportsAsync()) return Load<T>(path);
+
+		const AssetPack::Entry* packed = FindPacked(normPath);
+		std::string             guid   = ResolveGuid<T>(packed, normPath);
+		{
+			std::shared_lock lock(m_lookupMutex);
+			if (storage.guidToSlot.count(guid)) return AssetHandle<T>(guid);
+		}
+		if (m_asyncLoads.count(guid)) return AssetHandle<T>(guid);
 
-		auto it = storage.guidToAsset.find(guid);
-		if (it == storage.guidToAsset.end()) return nullptr;
+		auto load  = std::make_shared<AsyncLoad>();
+		load->guid = guid;
+		load->path = normPath;
+		if (packed && packed->cooked) {
+			load->decode = [loader = storage.loader.get(), data = m_pack.Data(*packed), size = packed->dataSize, normPath] { return loader->DecodeCooked(data, size, normPath); };
+		}
+		else {
+			load->decode = [loader = storage.loader.get(), normPath] { return loader->Decode(normPath); };
+		}
+		load->finish = [this, &storage, guid, normPath](AssetPayload& payload) {
+			{
+				// A synchronous Load() of the same asset may have won the race.
+				std::shared_lock lock(m_lookupMutex);
+				if (storage.guidToSlot.count(guid)) return true;
+			}
+			auto asset = storage.loader->Finish(payload, normPath);
+			if (!asset) return false;
+			InsertAsset(storage, guid, std::move(asset));
+			storage.pathToGuid[normPath] = guid;
+			return true;
+		};
+
+		m_asyncLoads.emplace(guid, load);
+		m_waitingLoads.push_back(std::move(load));
+		StartLoaderThreads();
+		DispatchLoads();
+		return AssetHandle<T>(guid);
+	}
 
-		return it->second.get();
+	inline const AssetPack::Entry* AssetManager::FindPacked(const std::string& normPath) const
+	{
+		return m_pack.IsOpen() ? m_pack.FindPath(normPath) : nullptr;
 	}
 
 	template <typename T>
-	void AssetManager::Unload(const AssetHandle<T>& handle)
+	std::string AssetManager::ResolveGuid(const AssetPack::Entry* packed, const std::string& normPath)
 	{
+		return packed ? std::string(m_pack.Guid(*packed)) : EnsureMetaFile<T>(normPath);
+	}
+
+	template <typename T>
+	void AssetManager::InsertAsset(AssetStorage<T>& storage, const std::string& guid, std::unique_ptr<T> asset)
+	{
+		std::unique_lock lock(m_lookupMutex);
+		storage.guidToSlot[guid] = storage.slots.Insert(guid, std::move(asset)).slot;
+	}
+
+	template <typename T>
+	void AssetManager::RemoveAsset(AssetStorage<T>& storage, const std::string& guid)
+	{
+		std::unique_lock lock(m_lookupMutex);
+		auto             it = storage.guidToSlot.find(guid);
+		if (it == storage.guidToSlot.end()) return;
+		storage.slots.Remove(it->second); // freed on the next Update, after in-flight readers are done
+		storage.guidToSlot.erase(it);
+	}
+
+	template <typename T>
+	T* AssetManager::Get(const AssetHandle<T>& handle)
+	{
+		if (!handle.IsValid()) return nullptr;
 		auto& storage = GetStorage<T>();
-		auto  it      = storage.guidToAsset.find(handle.GetID());
-		if (it != storage.guidToAsset.end()) {
-			storage.guidToAsset.erase(it); // deletes the asset, unique_ptr cleans it up
+
+		// Fast path: the slot this handle resolved to last time, if it still holds the same asset.
+		if (T* asset = storage.slots.Resolve(AssetSlotRef::Unpack(handle.slot.load(std::memory_order_relaxed)))) return asset;
+
+		AssetSlotRef ref;
+		{
+			std::shared_lock lock(m_lookupMutex);
+			auto             it = storage.guidToSlot.find(handle.GetID());
+			if (it == storage.guidToSlot.end()) return nullptr;
+			// Under the lock the slot cannot be emptied and reused, so this generation belongs to `guid`.
+			ref = {it->second, storage.slots.Generation(it->second)};
 		}
+		handle.slot.store(ref.Pack(), std::memory_order_relaxed);
+		return storage.slots.Resolve(ref);
+	}
+
+	template <typename T>
+	void AssetManager::Unload(const AssetHandle<T>& handle)
+	{
+		RemoveAsset(GetStorage<T>(), handle.GetID());
 	}
 
 	template <typename T>
@@ -98,8 +186,8 @@ namespace Engine {
 		auto&              storage = GetStorage<T>();
 		const std::string& guid    = handle.GetID();
 
-		auto it = storage.guidToAsset.find(guid);
-		if (it == storage.guidToAsset.end()) return;
+		T* asset = Get(handle);
+		if (!asset) return;
 
 		// Find path from guid (reverse lookup needed or store it)
 		// Since we store path->guid, we can iterate or store guid->path.
@@ -113,7 +201,7 @@ namespace Engine {
 		}
 
 		if (!path.empty()) {
-			if (storage.loader->Reload(*it->second, path)) {
+			if (storage.loader->Reload(*asset, path)) {
 				Logger::get("core")->info("Reloaded asset: {}", path);
 			} else {
 				Logger::get("core")->error("Failed to reload asset: {}", path);
@@ -141,7 +229,7 @@ namespace Engine {
         auto it = storage.pathToGuid.find(normPath);
         if (it != storage.pathToGuid.end()) {
             std::string guid = it->second;
-            storage.guidToAsset.erase(guid);
+            RemoveAsset(storage, guid);
             storage.pathToGuid.erase(it);
             Logger::get("core")->info("Unloaded asset: {}", normPath);
         }
@@ -151,12 +239,25 @@ namespace Engine {
     void AssetManager::UnloadAll()
     {
         auto& storage = GetStorage<T>();
-        storage.guidToAsset.clear();
+        {
+            std::unique_lock lock(m_lookupMutex);
+            storage.slots.Clear();
+            storage.guidToSlot.clear();
+        }
         storage.pathToGuid.clear();
     }
 
     inline void AssetManager::ClearAll()
     {
+        // Loader threads may still be decoding with a loader that is about to go away.
+        StopLoaderThreads();
+        m_waitingLoads.clear();
+        m_asyncLoads.clear();
+        m_asyncDependencies.clear();
+        m_loadsInFlight = 0;
+
+        for (auto& entry : m_storageTable)
+            entry.store(nullptr, std::memory_order_release);
         storages.clear();
         m_pendingActions.clear();
     }
@@ -184,14 +285,12 @@ namespace Engine {
             }
 			
 			// Update asset's internal name if it has one
-			auto assetIt = storage.guidToAsset.find(guid);
-			if (assetIt != storage.guidToAsset.end() && assetIt->second) {
+			if (auto* ptr = Get(AssetHandle<T>(guid))) {
 				std::filesystem::path p(newPath);
 				std::string newName = p.filename().string();
 				
 				// Try to call SetName if it exists, otherwise set m_name directly
 				// This works for types like Texture that have SetName
-				auto* ptr = assetIt->second.get();
 				if constexpr (std::is_same_v<T, Texture>) {
 					static_cast<Texture*>(ptr)->SetName(newName);
 				}
@@ -215,11 +314,18 @@ namespace Engine {
 	template <typename T>
 	typename AssetManager::AssetStorage<T>& AssetManager::GetStorage()
 	{
-		auto typeId = std::type_index(typeid(T));
-		if (storages.find(typeId) == storages.end()) {
-			storages[typeId] = std::make_unique<AssetStorage<T>>();
+		const uint32_t typeId = TypeId<T>();
+		assert(typeId < kMaxAssetTypes);
+
+		if (IStorageBase* storage = m_storageTable[typeId].load(std::memory_order_acquire)) return *static_cast<AssetStorage<T>*>(storage);
+
+		std::lock_guard<std::mutex> lock(m_storageMutex);
+		IStorageBase*               storage = m_storageTable[typeId].load(std::memory_order_acquire);
+		if (!storage) {
+			storage = storages.emplace_back(std::make_unique<AssetStorage<T>>()).get();
+			m_storageTable[typeId].store(storage, std::memory_order_release);
 		}
-		return *static_cast<AssetStorage<T>*>(storages[typeId].get());
+		return *static_cast<AssetStorage<T>*>(storage);
 	}
 
 
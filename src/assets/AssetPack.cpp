@@ -0,0 +1,210 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#include "AssetPack.h"
+
+#include "core/EngineData.h"
+
+#include <fstream>
+
+namespace Engine {
+
+	using namespace AssetPackFormat;
+
+	namespace {
+		uint64_t AlignUp(uint64_t value) { return (value + kAlignment - 1) & ~uint64_t{kAlignment - 1}; }
+
+		uint32_t TableSizeFor(size_t entries)
+		{
+			uint32_t size = 16;
+			while (size < entries * 2) size <<= 1;
+			return size;
+		}
+
+		void PadTo(std::ofstream& os, uint64_t offset)
+		{
+			static const char zeros[kAlignment] = {};
+			const uint64_t    at                = static_cast<uint64_t>(os.tellp());
+			if (offset > at) os.write(zeros, static_cast<std::streamsize>(offset - at));
+		}
+
+		void Insert(std::vector<uint32_t>& table, uint64_t hash, uint32_t index)
+		{
+			const uint32_t mask = static_cast<uint32_t>(table.size() - 1);
+			for (uint32_t slot = static_cast<uint32_t>(hash) & mask;; slot = (slot + 1) & mask) {
+				if (table[slot] == kEmptySlot) {
+					table[slot] = index;
+					return;
+				}
+			}
+		}
+	} // namespace
+
+	bool AssetPack::Open(const std::string& path)
+	{
+		Close();
+		if (!m_file.Open(path)) return false;
+
+		const uint8_t* data = m_file.Data();
+		const uint64_t size = m_file.Size();
+		auto           inRange = [size](uint64_t offset, uint64_t bytes) { return offset <= size && bytes <= size - offset; };
+
+		const auto* header = reinterpret_cast<const Header*>(data);
+		if (size < sizeof(Header) || header->magic != kMagic) {
+			GetDefaultLogger()->error("[AssetPack] '{}' is not an asset pack", path);
+			Close();
+			return false;
+		}
+		if (header->version != kVersion) {
+			GetDefaultLogger()->error("[AssetPack] '{}' is version {}, this build reads {}", path, header->version, kVersion);
+			Close();
+			return false;
+		}
+
+		const uint64_t tableBytes = sizeof(uint32_t) * uint64_t{header->tableSize};
+		bool           valid      = header->fileSize == size && header->tableSize > header->entryCount && (header->tableSize & (header->tableSize - 1)) == 0 &&
+		                 inRange(header->entriesOffset, sizeof(Entry) * uint64_t{header->entryCount}) && inRange(header->guidTableOffset, tableBytes) &&
+		                 inRange(header->pathTableOffset, tableBytes) && inRange(header->stringTableOffset, header->stringTableSize) &&
+		                 header->entriesOffset % kAlignment == 0 && header->guidTableOffset % alignof(uint32_t) == 0 && header->pathTableOffset % alignof(uint32_t) == 0;
+
+		const auto* entries = reinterpret_cast<const Entry*>(data + header->entriesOffset);
+		for (uint32_t i = 0; valid && i < header->entryCount; ++i) {
+			const Entry& entry = entries[i];
+			valid = uint64_t{entry.guidOffset} + entry.guidSize <= header->stringTableSize && uint64_t{entry.pathOffset} + entry.pathSize <= header->stringTableSize &&
+			        (!entry.cooked || (inRange(entry.dataOffset, entry.dataSize) && entry.dataOffset % kAlignment == 0));
+		}
+		const auto* guidTable = reinterpret_cast<const uint32_t*>(data + header->guidTableOffset);
+		const auto* pathTable = reinterpret_cast<const uint32_t*>(data + header->pathTableOffset);
+		for (uint32_t slot = 0; valid && slot < header->tableSize; ++slot) {
+			valid = (guidTable[slot] == kEmptySlot || guidTable[slot] < header->entryCount) && (pathTable[slot] == kEmptySlot || pathTable[slot] < header->entryCount);
+		}
+		if (!valid) {
+			GetDefaultLogger()->error("[AssetPack] '{}' is truncated or corrupt", path);
+			Close();
+			return false;
+		}
+
+		m_header  = header;
+		m_entries = entries;
+		GetDefaultLogger()->info("[AssetPack] mounted '{}': {} assets, {:.1f} MB", path, header->entryCount, size / (1024.0 * 1024.0));
+		return true;
+	}
+
+	void AssetPack::Close()
+	{
+		m_file.Close();
+		m_header  = nullptr;
+		m_entries = nullptr;
+	}
+
+	const AssetPack::Entry* AssetPack::FindGuid(std::string_view guid) const
+	{
+		return m_header ? Find(m_header->guidTableOffset, Hash(guid), guid, false) : nullptr;
+	}
+
+	const AssetPack::Entry* AssetPack::FindPath(std::string_view path) const
+	{
+		return m_header ? Find(m_header->pathTableOffset, Hash(path), path, true) : nullptr;
+	}
+
+	const AssetPack::Entry* AssetPack::Find(uint64_t tableOffset, uint64_t hash, std::string_view key, bool byPath) const
+	{
+		// tableSize > entryCount, so every probe sequence reaches an empty slot.
+		const auto*    table = reinterpret_cast<const uint32_t*>(m_file.Data() + tableOffset);
+		const uint32_t mask  = m_header->tableSize - 1;
+		for (uint32_t slot = static_cast<uint32_t>(hash) & mask; table[slot] != kEmptySlot; slot = (slot + 1) & mask) {
+			const Entry& entry = m_entries[table[slot]];
+			if ((byPath ? entry.pathHash : entry.guidHash) == hash && (byPath ? Path(entry) : Guid(entry)) == key) return &entry;
+		}
+		return nullptr;
+	}
+
+	std::string_view AssetPack::Guid(const Entry& entry) const
+	{
+		return {reinterpret_cast<const char*>(m_file.Data() + m_header->stringTableOffset + entry.guidOffset), entry.guidSize};
+	}
+
+	std::string_view AssetPack::Path(const Entry& entry) const
+	{
+		return {reinterpret_cast<const char*>(m_file.Data() + m_header->stringTableOffset + entry.pathOffset), entry.pathSize};
+	}
+
+	const uint8_t* AssetPack::Data(const Entry& entry) const
+	{
+		return entry.cooked ? m_file.Data() + entry.dataOffset : nullptr;
+	}
+
+	void AssetPackWriter::AddCooked(AssetType type, const std::string& guid, const std::string& path, std::vector<uint8_t> data)
+	{
+		m_items.push_back({type, guid, path, true, std::move(data)});
+	}
+
+	void AssetPackWriter::AddLoose(AssetType type, const std::string& guid, const std::string& path)
+	{
+		m_items.push_back({type, guid, path, false, {}});
+	}
+
+	bool AssetPackWriter::Save(const std::string& path) const
+	{
+		Header header;
+		header.entryCount    = static_cast<uint32_t>(m_items.size());
+		header.tableSize     = TableSizeFor(m_items.size());
+		header.entriesOffset = AlignUp(sizeof(Header));
+
+		std::vector<Entry>    entries(m_items.size());
+		std::vector<uint32_t> guidTable(header.tableSize, kEmptySlot);
+		std::vector<uint32_t> pathTable(header.tableSize, kEmptySlot);
+		std::string           strings;
+		for (uint32_t i = 0; i < m_items.size(); ++i) {
+			const Item& item  = m_items[i];
+			Entry&      entry = entries[i];
+			entry.guidHash    = Hash(item.guid);
+			entry.pathHash    = Hash(item.path);
+			entry.guidOffset  = static_cast<uint32_t>(strings.size());
+			entry.guidSize    = static_cast<uint32_t>(item.guid.size());
+			strings          += item.guid;
+			entry.pathOffset  = static_cast<uint32_t>(strings.size());
+			entry.pathSize    = static_cast<uint32_t>(item.path.size());
+			strings          += item.path;
+			entry.type        = item.type;
+			entry.cooked      = item.cooked ? 1 : 0;
+			Insert(guidTable, entry.guidHash, i);
+			Insert(pathTable, entry.pathHash, i);
+		}
+
+		header.guidTableOffset   = AlignUp(header.entriesOffset + sizeof(Entry) * entries.size());
+		header.pathTableOffset   = AlignUp(header.guidTableOffset + sizeof(uint32_t) * guidTable.size());
+		header.stringTableOffset = AlignUp(header.pathTableOffset + sizeof(uint32_t) * pathTable.size());
+		header.stringTableSize   = strings.size();
+		uint64_t offset          = AlignUp(header.stringTableOffset + strings.size());
+		for (uint32_t i = 0; i < m_items.size(); ++i) {
+			if (!m_items[i].cooked) continue;
+			entries[i].dataOffset = offset;
+			entries[i].dataSize   = m_items[i].data.size();
+			offset                = AlignUp(offset + entries[i].dataSize);
+		}
+		header.fileSize = offset;
+
+		// Cooked data can be large, so the file is streamed rather than assembled in memory.
+		std::ofstream os(path, std::ios::binary | std::ios::trunc);
+		if (!os) return false;
+		os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		PadTo(os, header.entriesOffset);
+		os.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(sizeof(Entry) * entries.size()));
+		PadTo(os, header.guidTableOffset);
+		os.write(reinterpret_cast<const char*>(guidTable.data()), static_cast<std::streamsize>(sizeof(uint32_t) * guidTable.size()));
+		PadTo(os, header.pathTableOffset);
+		os.write(reinterpret_cast<const char*>(pathTable.data()), static_cast<std::streamsize>(sizeof(uint32_t) * pathTable.size()));
+		PadTo(os, header.stringTableOffset);
+		os.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+		for (uint32_t i = 0; i < m_items.size(); ++i) {
+			if (!m_items[i].cooked) continue;
+			PadTo(os, entries[i].dataOffset);
+			os.write(reinterpret_cast<const char*>(m_items[i].data.data()), static_cast<std::streamsize>(m_items[i].data.size()));
+		}
+		PadTo(os, header.fileSize);
+		return os.good();
+	}
+
+} // namespace Engine
@@ -0,0 +1,139 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include "utils/MappedFile.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// Cooked asset pack written by BuildGame and mapped by game builds (AssetManager::MountPack).
+/// Little-endian, read in place.
+///
+///   Header
+///   Entry[entryCount]
+///   uint32 guidTable[tableSize]       open addressing on Entry::guidHash, kEmptySlot = free
+///   uint32 pathTable[tableSize]       same, on Entry::pathHash
+///   string table                      GUIDs and paths
+///   data                              each cooked entry on kAlignment
+namespace Engine::AssetPackFormat {
+
+	constexpr uint32_t kMagic     = 0x50414543u; // "CEAP"
+	constexpr uint32_t kVersion   = 1;
+	constexpr uint32_t kAlignment = 16;
+	constexpr uint32_t kEmptySlot = ~0u;
+
+	enum class AssetType : uint32_t {
+		Texture,
+		Model,
+		Sound,
+		Material,
+		Animation,
+		Skeleton,
+		Prefab,
+		Terrain,
+		Particle,
+	};
+
+	struct Header {
+		uint32_t magic      = kMagic;
+		uint32_t version    = kVersion;
+		uint32_t entryCount = 0;
+		uint32_t tableSize  = 0; // power of two, at least twice entryCount
+		uint64_t entriesOffset     = 0;
+		uint64_t guidTableOffset   = 0;
+		uint64_t pathTableOffset   = 0;
+		uint64_t stringTableOffset = 0;
+		uint64_t stringTableSize   = 0;
+		uint64_t fileSize          = 0;
+	};
+
+	struct Entry {
+		uint64_t  guidHash   = 0;
+		uint64_t  pathHash   = 0;
+		uint32_t  guidOffset = 0; // string table
+		uint32_t  guidSize   = 0;
+		uint32_t  pathOffset = 0;
+		uint32_t  pathSize   = 0;
+		AssetType type       = AssetType::Texture;
+		uint32_t  cooked     = 0; // 0: loose, loaded from `path` with its GUID known up front
+		uint64_t  dataOffset = 0;
+		uint64_t  dataSize   = 0;
+	};
+
+	static_assert(sizeof(Header) == 64 && sizeof(Entry) == 56);
+
+	/// FNV-1a 64.
+	constexpr uint64_t Hash(std::string_view text)
+	{
+		uint64_t hash = 14695981039346656037ull;
+		for (const char c : text) {
+			hash ^= static_cast<uint8_t>(c);
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+} // namespace Engine::AssetPackFormat
+
+namespace Engine {
+
+	/// Where BuildGame writes the pack, relative to the game's working directory.
+	inline constexpr char kAssetPackPath[] = "assets.pack";
+
+	/// A mapped AssetPackFormat file. Entry data stays valid while the pack is open.
+	class AssetPack {
+	  public:
+		using Entry = AssetPackFormat::Entry;
+
+		/// False (and closed) on a missing, foreign or malformed file.
+		bool Open(const std::string& path);
+		void Close();
+
+		[[nodiscard]] bool     IsOpen() const { return m_header != nullptr; }
+		[[nodiscard]] uint32_t EntryCount() const { return m_header ? m_header->entryCount : 0; }
+		[[nodiscard]] const Entry& GetEntry(uint32_t index) const { return m_entries[index]; }
+
+		[[nodiscard]] const Entry* FindGuid(std::string_view guid) const;
+		/// `path` as NormalizePath returns it.
+		[[nodiscard]] const Entry* FindPath(std::string_view path) const;
+
+		[[nodiscard]] std::string_view Guid(const Entry& entry) const;
+		[[nodiscard]] std::string_view Path(const Entry& entry) const;
+		/// Cooked bytes (IAssetLoader::Cook output); nullptr for loose entries.
+		[[nodiscard]] const uint8_t* Data(const Entry& entry) const;
+
+	  private:
+		const Entry* Find(uint64_t tableOffset, uint64_t hash, std::string_view key, bool byPath) const;
+
+		MappedFile                     m_file;
+		const AssetPackFormat::Header* m_header  = nullptr;
+		const Entry*                   m_entries = nullptr;
+	};
+
+	/// Collects cooked and loose entries for BuildGame and writes the pack.
+	class AssetPackWriter {
+	  public:
+		void AddCooked(AssetPackFormat::AssetType type, const std::string& guid, const std::string& path, std::vector<uint8_t> data);
+		void AddLoose(AssetPackFormat::AssetType type, const std::string& guid, const std::string& path);
+
+		[[nodiscard]] size_t EntryCount() const { return m_items.size(); }
+		/// False if the file cannot be written.
+		bool Save(const std::string& path) const;
+
+	  private:
+		struct Item {
+			AssetPackFormat::AssetType type;
+			std::string                guid;
+			std::string                path;
+			bool                       cooked;
+			std::vector<uint8_t>       data;
+		};
+		std::vector<Item> m_items;
+	};
+
+} // namespace Engine
@@ -0,0 +1,145 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Engine {
+
+	/// Where an asset lives in its AssetSlotArray. The generation changes every
+	/// time the slot is emptied, so a stale reference resolves to nullptr.
+	struct AssetSlotRef {
+		uint32_t slot       = 0;
+		uint32_t generation = 0; // 0 = unresolved
+
+		[[nodiscard]] uint64_t Pack() const { return static_cast<uint64_t>(generation) << 32 | slot; }
+		static AssetSlotRef    Unpack(uint64_t packed) { return {static_cast<uint32_t>(packed), static_cast<uint32_t>(packed >> 32)}; }
+	};
+
+	/// Chunked slot storage for one asset type. Chunks are never reallocated, so
+	/// Resolve() may run on any thread while the main thread inserts and removes.
+	/// Removed assets are kept alive until FreeRetired() (once per frame).
+	template <typename T>
+	class AssetSlotArray {
+	  public:
+		static constexpr uint32_t kChunkBits = 8;
+		static constexpr uint32_t kChunkSize = 1u << kChunkBits;
+		static constexpr uint32_t kMaxChunks = 4096; // ~1M assets per type
+
+		AssetSlotArray()
+		{
+			for (auto& chunk : m_chunks)
+				chunk.store(nullptr, std::memory_order_relaxed);
+		}
+
+		~AssetSlotArray()
+		{
+			for (auto& chunk : m_chunks)
+				delete chunk.load(std::memory_order_relaxed);
+		}
+
+		AssetSlotArray(const AssetSlotArray&)            = delete;
+		AssetSlotArray& operator=(const AssetSlotArray&) = delete;
+
+		// --- main thread ---
+
+		AssetSlotRef Insert(const std::string& guid, std::unique_ptr<T> asset)
+		{
+			uint32_t index;
+			if (!m_free.empty()) {
+				index = m_free.back();
+				m_free.pop_back();
+			}
+			else {
+				index = m_size++;
+				if ((index & (kChunkSize - 1)) == 0) m_chunks[index >> kChunkBits].store(new Chunk(), std::memory_order_release);
+			}
+
+			Slot& slot = At(index);
+			slot.guid  = guid;
+			slot.owner = std::move(asset);
+			slot.asset.store(slot.owner.get(), std::memory_order_release);
+			return {index, slot.generation.load(std::memory_order_relaxed)};
+		}
+
+		void Remove(uint32_t index)
+		{
+			Slot& slot = At(index);
+			if (!slot.owner) return;
+
+			slot.asset.store(nullptr, std::memory_order_release);
+			uint32_t next = slot.generation.load(std::memory_order_relaxed) + 1;
+			if (next == 0) next = 1;
+			slot.generation.store(next, std::memory_order_release);
+
+			m_retired.push_back(std::move(slot.owner));
+			slot.guid.clear();
+			m_free.push_back(index);
+		}
+
+		void Clear()
+		{
+			for (uint32_t i = 0; i < m_size; ++i)
+				Remove(i);
+		}
+
+		/// Delete assets removed before this call. Readers must not hold pointers across it.
+		void FreeRetired() { m_retired.clear(); }
+
+		/// fn(const std::string& guid, T& asset) for every live asset.
+		template <typename Fn>
+		void ForEach(Fn&& fn) const
+		{
+			for (uint32_t i = 0; i < m_size; ++i) {
+				const Slot& slot = At(i);
+				if (slot.owner) fn(slot.guid, *slot.owner);
+			}
+		}
+
+		[[nodiscard]] const std::string& GetGUID(uint32_t index) const { return At(index).guid; }
+		[[nodiscard]] T*                 Get(uint32_t index) const { return At(index).owner.get(); }
+		[[nodiscard]] uint32_t           Generation(uint32_t index) const { return At(index).generation.load(std::memory_order_acquire); }
+
+		// --- any thread ---
+
+		[[nodiscard]] T* Resolve(AssetSlotRef ref) const
+		{
+			if (ref.generation == 0 || (ref.slot >> kChunkBits) >= kMaxChunks) return nullptr;
+			const Chunk* chunk = m_chunks[ref.slot >> kChunkBits].load(std::memory_order_acquire);
+			if (!chunk) return nullptr;
+
+			const Slot& slot = chunk->slots[ref.slot & (kChunkSize - 1)];
+			if (slot.generation.load(std::memory_order_acquire) != ref.generation) return nullptr;
+			T* asset = slot.asset.load(std::memory_order_acquire);
+			// Re-check: the slot may have been emptied and refilled between the two loads.
+			if (slot.generation.load(std::memory_order_acquire) != ref.generation) return nullptr;
+			return asset;
+		}
+
+	  private:
+		struct Slot {
+			std::atomic<T*>       asset{nullptr};
+			std::atomic<uint32_t> generation{1};
+			std::unique_ptr<T>    owner; // main thread only
+			std::string           guid;  // main thread only
+		};
+		struct Chunk {
+			Slot slots[kChunkSize];
+		};
+
+		[[nodiscard]] Slot& At(uint32_t index) const { return m_chunks[index >> kChunkBits].load(std::memory_order_relaxed)->slots[index & (kChunkSize - 1)]; }
+
+		std::array<std::atomic<Chunk*>, kMaxChunks> m_chunks;
+		uint32_t                                    m_size = 0; // slots ever handed out
+		std::vector<uint32_t>                       m_free;
+		std::vector<std::unique_ptr<T>>             m_retired;
+	};
+
+} // namespace Engine
@@ -0,0 +1,135 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Engine {
+
+	/// Appends the cooked form of an asset (IAssetLoader::Cook): PODs, length-prefixed strings and arrays.
+	class CookedWriter {
+	  public:
+		explicit CookedWriter(std::vector<uint8_t>& out) : m_out(out) {}
+
+		template <typename T>
+		void Pod(const T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			Bytes(&value, sizeof(T));
+		}
+
+		void String(const std::string& value)
+		{
+			Pod(static_cast<uint32_t>(value.size()));
+			Bytes(value.data(), value.size());
+		}
+
+		template <typename T>
+		void Array(const T* data, size_t count)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			Pod(static_cast<uint64_t>(count));
+			Bytes(data, count * sizeof(T));
+		}
+
+		template <typename T>
+		void Array(const std::vector<T>& values)
+		{
+			Array(values.data(), values.size());
+		}
+
+		void Bytes(const void* data, size_t size)
+		{
+			const auto* bytes = static_cast<const uint8_t*>(data);
+			m_out.insert(m_out.end(), bytes, bytes + size);
+		}
+
+	  private:
+		std::vector<uint8_t>& m_out;
+	};
+
+	/// Cook for assets whose file already is the runtime form (e.g. ozz archives): the bytes as they are.
+	inline bool AppendFileBytes(const std::string& path, std::vector<uint8_t>& out)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file) return false;
+		out.insert(out.end(), std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		return true;
+	}
+
+	/// Reads what CookedWriter wrote, bounds-checked. After the first failure every read fails.
+	class CookedReader {
+	  public:
+		CookedReader(const uint8_t* data, size_t size) : m_cursor(data), m_end(data + size) {}
+
+		template <typename T>
+		bool Pod(T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			const uint8_t* bytes = View(sizeof(T));
+			if (bytes) std::memcpy(&value, bytes, sizeof(T));
+			return bytes != nullptr;
+		}
+
+		bool String(std::string& value)
+		{
+			uint32_t size = 0;
+			if (!Pod(size)) return false;
+			const uint8_t* bytes = View(size);
+			if (bytes) value.assign(reinterpret_cast<const char*>(bytes), size);
+			return bytes != nullptr;
+		}
+
+		template <typename T>
+		bool Array(std::vector<T>& values)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			uint64_t count = 0;
+			if (!Pod(count) || count > Remaining() / sizeof(T)) return Fail();
+			values.resize(count);
+			return Bytes(values.data(), count * sizeof(T));
+		}
+
+		bool Bytes(void* out, size_t size)
+		{
+			const uint8_t* bytes = View(size);
+			if (bytes) std::memcpy(out, bytes, size);
+			return bytes != nullptr;
+		}
+
+		/// `size` bytes in place (no copy), or nullptr if the data is shorter.
+		const uint8_t* View(size_t size)
+		{
+			if (!m_ok || size > Remaining()) {
+				Fail();
+				return nullptr;
+			}
+			const uint8_t* bytes  = m_cursor;
+			m_cursor             += size;
+			return bytes;
+		}
+
+		[[nodiscard]] size_t Remaining() const { return m_ok ? static_cast<size_t>(m_end - m_cursor) : 0; }
+		[[nodiscard]] bool   Ok() const { return m_ok; }
+
+	  private:
+		bool Fail()
+		{
+			m_ok = false;
+			return false;
+		}
+
+		const uint8_t* m_cursor;
+		const uint8_t* m_end;
+		bool           m_ok = true;
+	};
+
+} // namespace Engine
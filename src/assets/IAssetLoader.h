@@ -5,15 +5,65 @@
 #ifndef CPP_ENGINE_IASSETLOADER_H
 #define CPP_ENGINE_IASSETLOADER_H
 
-
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace Engine {
+	/// CPU-side result of IAssetLoader::Decode, handed to Finish on the main thread.
+	struct AssetPayload {
+		virtual ~AssetPayload() = default;
+
+		/// GUIDs this asset needs before it is usable (e.g. a material's textures).
+		/// Decode may fill it; Finish may add to it.
+		std::vector<std::string> dependencies;
+	};
+
+	/// Payload for assets that need no main-thread work: Decode builds the asset itself.
+	template <typename T>
+	struct DecodedAsset : AssetPayload {
+		std::unique_ptr<T> asset;
+	};
+
 	template <typename T>
 	class IAssetLoader {
 	  public:
 		virtual ~IAssetLoader()                                          = default;
 		virtual std::unique_ptr<T> LoadFromFile(const std::string& path) = 0;
 		virtual bool               Reload(T& asset, const std::string& path) { return false; }
+
+		/// Loaders that can split their work for AssetManager::LoadAsync. Others load
+		/// synchronously on the main thread.
+		[[nodiscard]] virtual bool SupportsAsync() const { return false; }
+		/// Worker thread: file I/O and decoding only, no GL/AL and no AssetManager writes. nullptr = failed.
+		virtual std::unique_ptr<AssetPayload> Decode(const std::string& path) { return nullptr; }
+		/// Main thread: GPU/audio uploads and dependent loads.
+		virtual std::unique_ptr<T> Finish(AssetPayload& payload, const std::string& path)
+		{
+			auto* decoded = dynamic_cast<DecodedAsset<T>*>(&payload);
+			return decoded ? std::move(decoded->asset) : nullptr;
+		}
+
+		/// Asset packs (AssetPack): loaders that cook write the runtime-ready form of an asset at build
+		/// time, and game builds decode it from the mapped pack. Others ship their source file as is.
+		[[nodiscard]] virtual bool SupportsCooking() const { return false; }
+		/// Editor side, at build time. False = ship the source file instead.
+		virtual bool Cook(const std::string& path, std::vector<uint8_t>& out) { return false; }
+		/// Any thread, like Decode: `data` is Cook's output in the mapped pack, valid while it stays mounted.
+		/// The payload goes to Finish as usual. nullptr = failed.
+		virtual std::unique_ptr<AssetPayload> DecodeCooked(const uint8_t* data, size_t size, const std::string& path) { return nullptr; }
+
+	  protected:
+		/// Decode for loaders whose LoadFromFile never touches GL/AL: run all of it on the worker.
+		std::unique_ptr<DecodedAsset<T>> DecodeWhole(const std::string& path)
+		{
+			auto asset = LoadFromFile(path);
+			if (!asset) return nullptr;
+			auto payload   = std::make_unique<DecodedAsset<T>>();
+			payload->asset = std::move(asset);
+			return payload;
+		}
 	};
 } // namespace Engine
 
@@ -149,7 +149,7 @@ namespace Engine {
 		{
 			for (const auto& se : entities) {
 				const EntityHandle mapped(AddGuidOffset(se.meta.guid, offset));
-				if (scene->m_entityMap.count(mapped)) {
+				if (scene->Contains(mapped)) {
 					return true;
 				}
 			}
@@ -220,16 +220,13 @@ namespace Engine {
 		}
 		const std::string mappedRoot = AddGuidOffset(rootGuid, offset);
 
-		std::map<EntityHandle, Entity> created;
-		Entity                         rootEntity;
+		Entity rootEntity;
 
 		for (auto& se : spawned) {
 			entt::entity handle = scene->GetRegistry()->create();
 			scene->GetRegistry()->emplace<Components::EntityMetadata>(handle, se.meta);
 			Entity entity(handle, scene);
-			created[EntityHandle(se.meta.guid)] = entity;
 			scene->m_entityList.push_back(entity);
-			scene->m_entityMap[EntityHandle(se.meta.guid)] = entity;
 			if (se.meta.guid == mappedRoot) {
 				rootEntity = entity;
 			}
@@ -0,0 +1,137 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#include "SceneLoadBenchmark.h"
+
+#include "assets/SerializedEntity.h"
+#include "assets/impl/BinarySceneLoader.h"
+#include "assets/impl/JSONSceneLoader.h"
+#include "assets/impl/PackedSceneLoader.h"
+#include "components/AllComponents.h"
+#include "utils/MappedFile.h"
+
+#include <cereal/archives/binary.hpp>
+#include <cereal/archives/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+namespace Engine {
+
+	namespace {
+		using Clock = std::chrono::steady_clock;
+
+		double ElapsedMs(Clock::time_point start)
+		{
+			return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		}
+
+		EntityHandle Suffixed(const EntityHandle& handle, const std::string& suffix)
+		{
+			return handle.IsValid() ? EntityHandle(handle.GetID() + suffix) : handle;
+		}
+
+		/// What the cereal loaders do per entity, minus OnAdded.
+		void EmplaceEntities(std::vector<SerializedEntity>& entities, entt::registry& registry)
+		{
+			for (auto& se : entities) {
+				const entt::entity e = registry.create();
+				registry.emplace<Components::EntityMetadata>(e, se.meta);
+#define X(type, name, fancy)                                                                                                                                                                                                                   \
+	if (se.name.has_value()) registry.emplace<type>(e, se.name.value());
+				COMPONENT_LIST
+#undef X
+			}
+		}
+
+		template <typename Load>
+		double TimeLoads(uint32_t iterations, Load&& load)
+		{
+			double total = 0.0;
+			for (uint32_t it = 0; it < iterations; ++it) {
+				entt::registry registry; // destroyed outside the timed part
+				const auto     start = Clock::now();
+				load(registry);
+				total += ElapsedMs(start);
+			}
+			return total / iterations;
+		}
+
+		uint64_t FileBytes(const std::filesystem::path& path)
+		{
+			std::error_code ec;
+			const auto      size = std::filesystem::file_size(path, ec);
+			return ec ? 0 : static_cast<uint64_t>(size);
+		}
+	} // namespace
+
+	SceneLoadBenchmarkResult RunSceneLoadBenchmark(const std::string& scenePath, uint32_t copies, uint32_t iterations)
+	{
+		SceneLoadBenchmarkResult result;
+		copies            = std::max<uint32_t>(copies, 1);
+		iterations        = std::max<uint32_t>(iterations, 1);
+		result.iterations = iterations;
+
+		std::vector<SerializedEntity> source;
+		if (!JSONSceneLoader::ReadEntities(scenePath, source)) return result;
+
+		std::vector<SerializedEntity> entities;
+		entities.reserve(source.size() * copies);
+		for (uint32_t c = 0; c < copies; ++c) {
+			const std::string suffix = c == 0 ? std::string() : "-" + std::to_string(c);
+			for (const SerializedEntity& original : source) {
+				SerializedEntity& se  = entities.emplace_back(original);
+				se.meta.guid         += suffix;
+				se.meta.parentEntity  = Suffixed(se.meta.parentEntity, suffix);
+				for (EntityHandle& child : se.meta.children) child = Suffixed(child, suffix);
+			}
+		}
+		result.entities = static_cast<uint32_t>(entities.size());
+
+		const std::filesystem::path dir        = std::filesystem::temp_directory_path();
+		const std::filesystem::path jsonPath   = dir / "cpp-engine-scene-benchmark.json";
+		const std::filesystem::path binaryPath = dir / "cpp-engine-scene-benchmark.bin";
+		const std::filesystem::path packedPath = dir / "cpp-engine-scene-benchmark.packed";
+		{
+			std::ofstream             os(jsonPath);
+			cereal::JSONOutputArchive archive(os);
+			archive(cereal::make_nvp("entities", entities));
+		}
+		{
+			std::ofstream               os(binaryPath, std::ios::binary);
+			cereal::BinaryOutputArchive archive(os);
+			archive(cereal::make_nvp("entities", entities));
+		}
+		if (!PackedSceneLoader::WriteEntities(entities, packedPath.string())) return result;
+		entities.clear();
+		result.jsonBytes   = FileBytes(jsonPath);
+		result.binaryBytes = FileBytes(binaryPath);
+		result.packedBytes = FileBytes(packedPath);
+
+		result.jsonMs = TimeLoads(iterations, [&](entt::registry& registry) {
+			std::vector<SerializedEntity> loaded;
+			JSONSceneLoader::ReadEntities(jsonPath.string(), loaded);
+			EmplaceEntities(loaded, registry);
+		});
+		result.binaryMs = TimeLoads(iterations, [&](entt::registry& registry) {
+			std::vector<SerializedEntity> loaded;
+			BinarySceneLoader::ReadEntities(binaryPath.string(), loaded);
+			EmplaceEntities(loaded, registry);
+		});
+		result.packedMs = TimeLoads(iterations, [&](entt::registry& registry) {
+			MappedFile file;
+			if (file.Open(packedPath.string())) PackedSceneLoader::Instantiate(file, registry, nullptr);
+		});
+
+		std::error_code ec;
+		std::filesystem::remove(jsonPath, ec);
+		std::filesystem::remove(binaryPath, ec);
+		std::filesystem::remove(packedPath, ec);
+		result.ok = true;
+		return result;
+	}
+
+} // namespace Engine
@@ -0,0 +1,30 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace Engine {
+
+	struct SceneLoadBenchmarkResult {
+		bool     ok         = false; // false if the source scene could not be read
+		uint32_t entities   = 0;     // per load: the source scene repeated `copies` times
+		uint32_t iterations = 0;
+		uint64_t jsonBytes   = 0;
+		uint64_t binaryBytes = 0;
+		uint64_t packedBytes = 0;
+		// Milliseconds per load into a bare registry: parse, component construction and insertion.
+		// OnAdded (asset loads, physics bodies) is left out; it costs the same for every format.
+		double jsonMs   = 0.0; // JSONSceneLoader::ReadEntities + per-entity emplace
+		double binaryMs = 0.0; // BinarySceneLoader::ReadEntities + per-entity emplace
+		double packedMs = 0.0; // mmap + PackedSceneLoader::Instantiate
+	};
+
+	/// Writes `scenePath` repeated `copies` times (GUIDs suffixed per copy) as JSON, cereal binary and
+	/// packed scenes in the temp directory, then loads each `iterations` times.
+	SceneLoadBenchmarkResult RunSceneLoadBenchmark(const std::string& scenePath = "scenes/scene1.json", uint32_t copies = 50, uint32_t iterations = 3);
+
+} // namespace Engine
@@ -5,6 +5,8 @@
 #include "AnimationLoader.h"
 #include "core/EngineData.h"
 #include "animation/AnimationManager.h"
+#include "animation/AnimationUtils.h"
+#include "assets/CookedData.h"
 
 
 
@@ -23,4 +25,24 @@ namespace Engine {
 		return animation;
 	}
 
+	bool AnimationLoader::Cook(const std::string& path, std::vector<uint8_t>& out)
+	{
+		return AppendFileBytes(path, out);
+	}
+
+	std::unique_ptr<AssetPayload> AnimationLoader::DecodeCooked(const uint8_t* data, size_t size, const std::string& path)
+	{
+		auto* source = new ozz::animation::Animation();
+		if (!LoadAnimation(data, size, source)) {
+			GetDefaultLogger()->error("AnimationLoader: failed to load cooked animation: {}", path);
+			delete source;
+			return nullptr;
+		}
+		auto payload           = std::make_unique<DecodedAsset<Animation>>();
+		payload->asset         = std::make_unique<Animation>();
+		payload->asset->name   = path.substr(path.find_last_of("/\\") + 1);
+		payload->asset->source = source;
+		return payload;
+	}
+
 } // namespace Engine
\ No newline at end of file
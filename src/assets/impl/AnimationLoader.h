@@ -16,5 +16,13 @@ namespace Engine {
 	class AnimationLoader : public IAssetLoader<Animation> {
 	  public:
 		std::unique_ptr<Animation> LoadFromFile(const std::string& path) override;
+
+		[[nodiscard]] bool            SupportsAsync() const override { return true; }
+		std::unique_ptr<AssetPayload> Decode(const std::string& path) override { return DecodeWhole(path); }
+
+		/// Cooked: the ozz archive as is; it is already the runtime form.
+		[[nodiscard]] bool            SupportsCooking() const override { return true; }
+		bool                          Cook(const std::string& path, std::vector<uint8_t>& out) override;
+		std::unique_ptr<AssetPayload> DecodeCooked(const uint8_t* data, size_t size, const std::string& path) override;
 	};
 } // namespace Engine
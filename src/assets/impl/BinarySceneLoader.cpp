@@ -56,31 +56,48 @@ namespace Engine {
 	}
 
 
+	bool BinarySceneLoader::ReadEntities(const std::string& path, std::vector<SerializedEntity>& entities)
+	{
+		if (!std::filesystem::exists(path)) {
+			return false;
+		}
+		try {
+			std::ifstream              is(path, std::ios::binary);
+			cereal::BinaryInputArchive archive(is);
+			archive(cereal::make_nvp("entities", entities));
+			GetDefaultLogger()->info("[cereal] Binary scene parsed {} entities from {}", entities.size(), path);
+		}
+		catch (const cereal::Exception& e) {
+			GetDefaultLogger()->error("[cereal] BinaryInputArchive '{}': {}", path, e.what());
+			std::fprintf(stderr, "[cereal] BinaryInputArchive '%s': %s\n", path.c_str(), e.what());
+			std::fflush(stderr);
+			return false;
+		}
+		catch (const std::exception& e) {
+			GetDefaultLogger()->error("[cereal] exception loading binary scene '{}': {}", path, e.what());
+			std::fprintf(stderr, "[cereal] binary scene '%s': %s\n", path.c_str(), e.what());
+			std::fflush(stderr);
+			return false;
+		}
+		return true;
+	}
+
 	std::unique_ptr<Scene> BinarySceneLoader::LoadFromFile(const std::string& path)
 	{
-		std::unique_ptr<Scene>         scene = GetSceneManager().CreateScene(path);
-		std::vector<Entity>            loaded_entities;
-		std::map<EntityHandle, Entity> loaded_entities_map;
-
-		if (std::filesystem::exists(path)) {
-			try {
-				std::ifstream              is(path, std::ios::binary);
-				cereal::BinaryInputArchive archive(is);
-
-				std::vector<SerializedEntity> entities;
-				archive(cereal::make_nvp("entities", entities));
-				GetDefaultLogger()->info("[cereal] Binary scene parsed {} entities from {}", entities.size(), path);
-
-				for (auto& se : entities) {
-					// Copy before COMPONENT_LIST macros: parameter `name` would rewrite se.meta.name
-					const std::string entityName = se.meta.name;
-					const std::string entityGuid = se.meta.guid;
-					try {
-						auto e = scene->GetRegistry()->create();
-						scene->GetRegistry()->emplace<Engine::Components::EntityMetadata>(e, se.meta);
-						Entity entity(e, scene.get());
-						loaded_entities.push_back(entity);
-						loaded_entities_map[EntityHandle(entityGuid)] = entity;
+		std::unique_ptr<Scene> scene = GetSceneManager().CreateScene(path);
+		std::vector<Entity>    loaded_entities;
+
+		std::vector<SerializedEntity> entities;
+		if (ReadEntities(path, entities)) {
+			for (auto& se : entities) {
+				// Copy before COMPONENT_LIST macros: parameter `name` would rewrite se.meta.name
+				const std::string entityName = se.meta.name;
+				const std::string entityGuid = se.meta.guid;
+				try {
+					auto e = scene->GetRegistry()->create();
+					scene->GetRegistry()->emplace<Engine::Components::EntityMetadata>(e, se.meta);
+					Entity entity(e, scene.get());
+					loaded_entities.push_back(entity);
 
 #define X(type, name, fancy)                                                                                                                                                                                                                   \
 	if (se.name.has_value()) {                                                                                                                                                                                                                 \
@@ -92,29 +109,19 @@ namespace Engine {
 			std::fprintf(stderr, "[cereal] AddComponent %s entity=%s: %s\n", #name, entityName.c_str(), ex.what());                                                                                                                            \
 		}                                                                                                                                                                                                                                      \
 	}
-						COMPONENT_LIST
+					COMPONENT_LIST
 #undef X
-					}
-					catch (const std::exception& ex) {
-						GetDefaultLogger()->error("[cereal] entity {} [{}]: {}", entityName, entityGuid, ex.what());
-						std::fprintf(stderr, "[cereal] entity %s: %s\n", entityName.c_str(), ex.what());
-					}
 				}
-			}
-			catch (const cereal::Exception& e) {
-				GetDefaultLogger()->error("[cereal] BinaryInputArchive '{}': {}", path, e.what());
-				std::fprintf(stderr, "[cereal] BinaryInputArchive '%s': %s\n", path.c_str(), e.what());
-				std::fflush(stderr);
-			}
-			catch (const std::exception& e) {
-				GetDefaultLogger()->error("[cereal] exception loading binary scene '{}': {}", path, e.what());
-				std::fprintf(stderr, "[cereal] binary scene '%s': %s\n", path.c_str(), e.what());
-				std::fflush(stderr);
+				catch (const std::exception& ex) {
+					GetDefaultLogger()->error("[cereal] entity {} [{}]: {}", entityName, entityGuid, ex.what());
+					std::fprintf(stderr, "[cereal] entity %s: %s\n", entityName.c_str(), ex.what());
+				}
 			}
 		}
 
 		scene->m_entityList = loaded_entities;
-		scene->m_entityMap  = loaded_entities_map;
+		// Parents may have been created after their children; fix up link order.
+		scene->ResolveHierarchyLinks();
 
 		return scene;
 	}
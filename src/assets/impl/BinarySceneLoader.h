@@ -11,12 +11,14 @@
 
 
 namespace Engine {
-
+	struct SerializedEntity;
 
 	class [[maybe_unused]] BinarySceneLoader : public IAssetLoader<Scene> {
 	  public:
 		std::unique_ptr<Scene>       LoadFromFile(const std::string& path) override;
 		[[maybe_unused]] static void SerializeScene(const SceneHandle& sceneRef, const std::string& path);
+		/// Parse only, no registry: false (errors logged) if the file is missing or malformed.
+		static bool ReadEntities(const std::string& path, std::vector<SerializedEntity>& entities);
 	};
 } // namespace Engine
 
@@ -70,19 +70,14 @@ namespace Engine {
 		}
 	} // namespace
 
-	std::unique_ptr<Scene> JSONSceneLoader::LoadFromFile(const std::string& path)
+	bool JSONSceneLoader::ReadEntities(const std::string& path, std::vector<SerializedEntity>& entities)
 	{
-		GetDefaultLogger()->info("[cereal] Loading JSON scene: {}", path);
-
-		std::unique_ptr<Scene> scene = GetSceneManager().CreateScene(path);
-
 		std::ifstream is(path);
 		if (!is) {
 			LogCerealError("open failed", path, "could not open file for reading");
-			return scene;
+			return false;
 		}
 
-		std::vector<SerializedEntity> entities;
 		try {
 			nlohmann::json j;
 			is >> j;
@@ -97,19 +92,31 @@ namespace Engine {
 			// Includes cereal::RapidJSONException ("rapidjson internal assertion failure: ...")
 			// and NVP-not-found / type errors.
 			LogCerealError("JSONInputArchive exception", path, e.what());
-			return scene;
+			return false;
 		}
 		catch (const std::exception& e) {
 			LogCerealError("std::exception during deserialize", path, e.what());
-			return scene;
+			return false;
 		}
 		catch (...) {
 			LogCerealError("unknown exception during deserialize", path, "non-std exception");
+			return false;
+		}
+		return true;
+	}
+
+	std::unique_ptr<Scene> JSONSceneLoader::LoadFromFile(const std::string& path)
+	{
+		GetDefaultLogger()->info("[cereal] Loading JSON scene: {}", path);
+
+		std::unique_ptr<Scene> scene = GetSceneManager().CreateScene(path);
+
+		std::vector<SerializedEntity> entities;
+		if (!ReadEntities(path, entities)) {
 			return scene;
 		}
 
-		std::vector<Entity>            loaded_entities;
-		std::map<EntityHandle, Entity> loaded_entities_map;
+		std::vector<Entity> loaded_entities;
 
 		for (size_t i = 0; i < entities.size(); ++i) {
 			auto& se = entities[i];
@@ -122,7 +129,6 @@ namespace Engine {
 				scene->GetRegistry()->emplace<Engine::Components::EntityMetadata>(e, se.meta);
 				Entity entity(e, scene.get());
 				loaded_entities.push_back(entity);
-				loaded_entities_map[EntityHandle(entityGuid)] = entity;
 
 #define X(type, name, fancy)                                                                                                                                                                                                                   \
 	if (se.name.has_value()) {                                                                                                                                                                                                                 \
@@ -152,7 +158,8 @@ namespace Engine {
 		}
 
 		scene->m_entityList = loaded_entities;
-		scene->m_entityMap  = loaded_entities_map;
+		// Parents may have been created after their children; fix up link order.
+		scene->ResolveHierarchyLinks();
 		GetDefaultLogger()->info("[cereal] Scene load finished: {} entities in registry", loaded_entities.size());
 		return scene;
 	}
@@ -4,6 +4,8 @@
 
 #include "MaterialLoader.h"
 
+#include "assets/CookedData.h"
+
 #include <fstream>
 #include <stdexcept>
 
@@ -69,6 +71,75 @@ namespace Engine {
 		return mat;
 	}
 
+	std::unique_ptr<AssetPayload> MaterialLoader::Decode(const std::string& path)
+	{
+		auto payload = DecodeWhole(path);
+		if (!payload) return nullptr;
+		AddTextureDependencies(*payload, *payload->asset);
+		return payload;
+	}
+
+	void MaterialLoader::AddTextureDependencies(AssetPayload& payload, const Material& mat)
+	{
+		for (const TextureHandle& texture : {mat.GetDiffuseTexture(), mat.GetSpecularTexture(), mat.GetNormalTexture(), mat.GetHeightTexture()}) {
+			if (texture.IsValid()) payload.dependencies.push_back(texture.GetID());
+		}
+	}
+
+	bool MaterialLoader::Cook(const std::string& path, std::vector<uint8_t>& out)
+	{
+		const std::unique_ptr<Material> mat = LoadFromFile(path);
+		CookedWriter                    writer(out);
+		writer.String(mat->GetName());
+		for (const TextureHandle& texture : {mat->GetDiffuseTexture(), mat->GetSpecularTexture(), mat->GetNormalTexture(), mat->GetHeightTexture()}) {
+			writer.String(texture.GetID());
+		}
+		writer.Pod(mat->GetDiffuseColor());
+		writer.Pod(mat->GetSpecularColor());
+		writer.Pod(mat->GetAmbientColor());
+		writer.Pod(mat->GetEmissiveColor());
+		writer.Pod(mat->GetShininess());
+		writer.Pod(mat->GetTextureScale());
+		return true;
+	}
+
+	std::unique_ptr<AssetPayload> MaterialLoader::DecodeCooked(const uint8_t* data, size_t size, const std::string& path)
+	{
+		CookedReader reader(data, size);
+		std::string  name;
+		std::string  textures[4];
+		glm::vec3    diffuse{}, specular{}, ambient{}, emissive{};
+		float        shininess = 0.0f;
+		glm::vec2    textureScale{1.0f};
+		reader.String(name);
+		for (std::string& texture : textures) reader.String(texture);
+		reader.Pod(diffuse);
+		reader.Pod(specular);
+		reader.Pod(ambient);
+		reader.Pod(emissive);
+		reader.Pod(shininess);
+		reader.Pod(textureScale);
+		if (!reader.Ok()) return nullptr;
+
+		auto payload   = std::make_unique<DecodedAsset<Material>>();
+		payload->asset = std::make_unique<Material>();
+		Material& mat  = *payload->asset;
+		mat.SetName(name);
+		mat.SetDiffuseTexture(TextureHandle(textures[0]));
+		mat.SetSpecularTexture(TextureHandle(textures[1]));
+		mat.SetNormalTexture(TextureHandle(textures[2]));
+		mat.SetHeightTexture(TextureHandle(textures[3]));
+		mat.SetDiffuseColor(diffuse);
+		mat.SetSpecularColor(specular);
+		mat.SetAmbientColor(ambient);
+		mat.SetEmissiveColor(emissive);
+		mat.SetShininess(shininess);
+		mat.SetTextureScale(textureScale);
+		mat.m_path = path;
+		AddTextureDependencies(*payload, mat);
+		return payload;
+	}
+
 	void MaterialLoader::SaveMaterial(const Material& mat, const std::string& path)
 	{
 		nlohmann::json j;
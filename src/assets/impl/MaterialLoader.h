@@ -15,6 +15,19 @@ namespace Engine {
 	  public:
 		std::unique_ptr<Material> LoadFromFile(const std::string& path) override;
 		void                      SaveMaterial(const Material& mat, const std::string& path);
+
+		/// Materials are plain JSON; the whole load runs on the worker and the textures become dependencies.
+		[[nodiscard]] bool            SupportsAsync() const override { return true; }
+		std::unique_ptr<AssetPayload> Decode(const std::string& path) override;
+
+		/// Cooked: the same fields in binary, no JSON parse at load.
+		[[nodiscard]] bool            SupportsCooking() const override { return true; }
+		bool                          Cook(const std::string& path, std::vector<uint8_t>& out) override;
+		std::unique_ptr<AssetPayload> DecodeCooked(const uint8_t* data, size_t size, const std::string& path) override;
+
+	  private:
+		/// Texture GUIDs the material needs before it renders.
+		static void AddTextureDependencies(AssetPayload& payload, const Material& mat);
 	};
 } // namespace Engine
 
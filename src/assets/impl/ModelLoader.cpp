@@ -1,6 +1,7 @@
 #include "ModelLoader.h"
 
 #include "rendering/Texture.h"
+#include "assets/CookedData.h"
 #include "core/EngineData.h"
 
 
@@ -12,6 +13,13 @@ namespace Engine {
 	namespace Rendering {
 
 		std::unique_ptr<Model> ModelLoader::LoadFromFile(const std::string& path)
+		{
+			auto payload = Decode(path);
+			if (!payload) return nullptr;
+			return Build(static_cast<ModelPayload&>(*payload), false);
+		}
+
+		std::unique_ptr<AssetPayload> ModelLoader::Decode(const std::string& path)
 		{
 			Assimp::Importer importer;
 			const aiScene*   scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_GenNormals | aiProcess_CalcTangentSpace | aiProcess_FlipUVs);
@@ -21,24 +29,127 @@ namespace Engine {
 				return nullptr;
 			}
 
-			std::vector<std::shared_ptr<Mesh>> meshes;
-			std::string                        directory = std::filesystem::path(path).parent_path().string();
-			std::string                        modelName = GetFileName(path);
-			glm::vec3                          boundsMin(std::numeric_limits<float>::max());
-			glm::vec3                          boundsMax(std::numeric_limits<float>::lowest());
+			auto        payload   = std::make_unique<ModelPayload>();
+			std::string directory = std::filesystem::path(path).parent_path().string();
+			payload->name         = GetFileName(path);
+
+			ProcessNode(scene->mRootNode, scene, *payload, directory, glm::mat4(1.0f));
+			return payload;
+		}
+
+		std::unique_ptr<Model> ModelLoader::Finish(AssetPayload& payload, const std::string& path)
+		{
+			return Build(static_cast<ModelPayload&>(payload), true);
+		}
+
+		bool ModelLoader::Cook(const std::string& path, std::vector<uint8_t>& out)
+		{
+			auto decoded = Decode(path);
+			if (!decoded) return false;
+			const auto& payload = static_cast<const ModelPayload&>(*decoded);
+
+			CookedWriter writer(out);
+			writer.String(payload.name);
+			writer.Pod(payload.boundsMin);
+			writer.Pod(payload.boundsMax);
+			writer.Pod(static_cast<uint32_t>(payload.meshes.size()));
+			for (const ModelPayload::MeshData& mesh : payload.meshes) {
+				writer.Array(mesh.vertices);
+				writer.Array(mesh.indices);
+				const Material& material = *mesh.material;
+				writer.String(material.GetName());
+				writer.Pod(material.GetDiffuseColor());
+				writer.Pod(material.GetSpecularColor());
+				writer.Pod(material.GetAmbientColor());
+				writer.Pod(material.GetEmissiveColor());
+				writer.Pod(material.GetShininess());
+				writer.Pod(material.GetTextureScale());
+				for (const std::string& texturePath : mesh.texturePaths) writer.String(texturePath);
+			}
+			return true;
+		}
+
+		std::unique_ptr<AssetPayload> ModelLoader::DecodeCooked(const uint8_t* data, size_t size, const std::string& path)
+		{
+			CookedReader reader(data, size);
+			auto         payload   = std::make_unique<ModelPayload>();
+			uint32_t     meshCount = 0;
+			reader.String(payload->name);
+			reader.Pod(payload->boundsMin);
+			reader.Pod(payload->boundsMax);
+			reader.Pod(meshCount);
+			for (uint32_t i = 0; i < meshCount && reader.Ok(); ++i) {
+				ModelPayload::MeshData& mesh = payload->meshes.emplace_back();
+				reader.Array(mesh.vertices);
+				reader.Array(mesh.indices);
+
+				std::string name;
+				glm::vec3   diffuse{}, specular{}, ambient{}, emissive{};
+				float       shininess = 0.0f;
+				glm::vec2   textureScale{1.0f};
+				reader.String(name);
+				reader.Pod(diffuse);
+				reader.Pod(specular);
+				reader.Pod(ambient);
+				reader.Pod(emissive);
+				reader.Pod(shininess);
+				reader.Pod(textureScale);
+				for (std::string& texturePath : mesh.texturePaths) reader.String(texturePath);
+
+				mesh.material = std::make_shared<Material>();
+				mesh.material->SetName(name);
+				mesh.material->SetDiffuseColor(diffuse);
+				mesh.material->SetSpecularColor(specular);
+				mesh.material->SetAmbientColor(ambient);
+				mesh.material->SetEmissiveColor(emissive);
+				mesh.material->SetShininess(shininess);
+				mesh.material->SetTextureScale(textureScale);
+			}
+			if (!reader.Ok()) {
+				GetDefaultLogger()->error("Cooked model {} is truncated", path);
+				return nullptr;
+			}
+			return payload;
+		}
 
-			ProcessNode(scene->mRootNode, scene, meshes, directory, glm::mat4(1.0f), boundsMin, boundsMax);
+		std::unique_ptr<Model> ModelLoader::Build(ModelPayload& payload, bool async)
+		{
+			static constexpr const char* kSlotNames[ModelPayload::kTextureSlots] = {"texture_diffuse", "texture_specular", "texture_normal", "texture_height"};
 
 			auto model = std::make_unique<Model>();
 			ENGINE_ASSERT(model, "Failed to allocate Model");
-			model->m_meshes    = std::move(meshes);
-			model->m_boundsMin = boundsMin;
-			model->m_boundsMax = boundsMax;
-			model->m_name      = modelName;
+			model->m_meshes.reserve(payload.meshes.size());
+
+			for (auto& mesh : payload.meshes) {
+				for (int slot = 0; slot < ModelPayload::kTextureSlots; ++slot) {
+					const std::string& texturePath = mesh.texturePaths[slot];
+					if (texturePath.empty() || IsHeadless()) continue;
+
+					auto handle = async ? GetAssetManager().LoadAsync<Texture>(texturePath) : GetAssetManager().Load<Texture>(texturePath);
+					if (!handle.IsValid()) {
+						GetDefaultLogger()->warn("Failed to load {} texture from path: {}", kSlotNames[slot], texturePath);
+						continue;
+					}
+					payload.dependencies.push_back(handle.GetID());
+
+					switch (slot) {
+						case ModelPayload::kDiffuse: mesh.material->SetDiffuseTexture(handle); break;
+						case ModelPayload::kSpecular: mesh.material->SetSpecularTexture(handle); break;
+						case ModelPayload::kNormal: mesh.material->SetNormalTexture(handle); break;
+						case ModelPayload::kHeight: mesh.material->SetHeightTexture(handle); break;
+						default: break;
+					}
+				}
+				model->m_meshes.push_back(std::make_shared<Mesh>(std::move(mesh.vertices), std::move(mesh.indices), mesh.material));
+			}
+
+			model->m_boundsMin = payload.boundsMin;
+			model->m_boundsMax = payload.boundsMax;
+			model->m_name      = payload.name;
 			return model;
 		}
 
-		void ModelLoader::ProcessNode(aiNode* node, const aiScene* scene, std::vector<std::shared_ptr<Mesh>>& meshes, const std::string& directory, const glm::mat4& parentTransform, glm::vec3& boundsMin, glm::vec3& boundsMax)
+		void ModelLoader::ProcessNode(aiNode* node, const aiScene* scene, ModelPayload& payload, const std::string& directory, const glm::mat4& parentTransform)
 		{
 			ENGINE_ASSERT(node && scene, "Invalid parameters passed to ProcessNode");
 
@@ -54,24 +165,24 @@ namespace Engine {
 					aiVector3D pos = mesh->mVertices[v];
 					glm::vec3  p   = glm::vec3(pos.x, pos.y, pos.z);
 
-					boundsMin = glm::min(boundsMin, p);
-					boundsMax = glm::max(boundsMax, p);
+					payload.boundsMin = glm::min(payload.boundsMin, p);
+					payload.boundsMax = glm::max(payload.boundsMax, p);
 				}
 
-				meshes.push_back(ProcessMesh(mesh, scene, directory));
+				ProcessMesh(mesh, scene, directory, payload.meshes.emplace_back());
 			}
 
 			for (unsigned int i = 0; i < node->mNumChildren; i++) {
-				ProcessNode(node->mChildren[i], scene, meshes, directory, transform, boundsMin, boundsMax);
+				ProcessNode(node->mChildren[i], scene, payload, directory, transform);
 			}
 		}
 
 
-		std::shared_ptr<Mesh> ModelLoader::ProcessMesh(aiMesh* mesh, const aiScene* scene, const std::string& directory)
+		void ModelLoader::ProcessMesh(aiMesh* mesh, const aiScene* scene, const std::string& directory, ModelPayload::MeshData& out)
 		{
 			ENGINE_ASSERT(mesh, "Null mesh passed to ProcessMesh");
 
-			std::vector<Vertex> vertices;
+			std::vector<Vertex>& vertices = out.vertices;
 			vertices.reserve(mesh->mNumVertices);
 
 			for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
@@ -84,32 +195,28 @@ namespace Engine {
 				vertices.push_back(vertex);
 			}
 
-			std::vector<unsigned int> indices;
+			std::vector<unsigned int>& indices = out.indices;
+			indices.reserve(static_cast<size_t>(mesh->mNumFaces) * 3);
 			for (unsigned int i = 0; i < mesh->mNumFaces; i++) {
 				aiFace face = mesh->mFaces[i];
 				ENGINE_ASSERT(face.mNumIndices >= 3, "Face does not contain at least 3 indices");
 				indices.insert(indices.end(), face.mIndices, face.mIndices + face.mNumIndices);
 			}
 
-			std::shared_ptr<Material> material;
 			if (mesh->mMaterialIndex >= 0) {
 				ENGINE_ASSERT(mesh->mMaterialIndex < scene->mNumMaterials, "Invalid material index");
 				aiMaterial* aiMat = scene->mMaterials[mesh->mMaterialIndex];
-				material          = LoadMaterial(aiMat, directory);
+				LoadMaterial(aiMat, directory, out);
 			}
 			else {
-				material = std::make_shared<Material>();
-				ENGINE_ASSERT(material, "Failed to create fallback material");
+				out.material = std::make_shared<Material>();
+				ENGINE_ASSERT(out.material, "Failed to create fallback material");
 			}
-
-			return std::make_shared<Mesh>(vertices, indices, material);
 		}
 
-		std::vector<TextureHandle> ModelLoader::LoadMaterialTextures(aiMaterial* mat, aiTextureType type, const std::string& typeName, const std::string& directory)
+		std::string ModelLoader::FindMaterialTexture(aiMaterial* mat, aiTextureType type, const std::string& directory)
 		{
-			ENGINE_ASSERT(mat, "Null aiMaterial passed to LoadMaterialTextures");
-
-			std::vector<TextureHandle> textures;
+			ENGINE_ASSERT(mat, "Null aiMaterial passed to FindMaterialTexture");
 
 			for (unsigned int i = 0; i < mat->GetTextureCount(type); ++i) {
 				aiString str;
@@ -128,21 +235,13 @@ namespace Engine {
 				std::filesystem::path fullPath1 = std::filesystem::path("resources/engine") / oldPath.filename();
 				std::filesystem::path fullPath2 = std::filesystem::path(directory) / oldPath.filename();
 
-				std::string fullPathStr = std::filesystem::exists(fullPath2) ? fullPath2.string() : fullPath1.string();
-
-
-				auto handle = GetAssetManager().Load<Texture>(fullPathStr);
-				if (handle.IsValid()) {
-					textures.push_back(handle);
-				}
-				else {
-					GetDefaultLogger()->warn("Failed to load {} texture from path: {}", typeName, fullPathStr);
-				}
+				return std::filesystem::exists(fullPath2) ? fullPath2.string() : fullPath1.string();
 			}
 
-			return textures;
+			return {};
 		}
-		std::shared_ptr<Material> ModelLoader::LoadMaterial(aiMaterial* mat, const std::string& directory)
+
+		void ModelLoader::LoadMaterial(aiMaterial* mat, const std::string& directory, ModelPayload::MeshData& out)
 		{
 			ENGINE_ASSERT(mat, "Null aiMaterial passed to LoadMaterial");
 
@@ -158,15 +257,11 @@ namespace Engine {
 			if (mat->Get(AI_MATKEY_COLOR_EMISSIVE, color) == AI_SUCCESS) material->SetEmissiveColor({color.r, color.g, color.b});
 			if (mat->Get(AI_MATKEY_SHININESS, shininess) == AI_SUCCESS) material->SetShininess(shininess);
 
-			auto loadFirst = [&](aiTextureType type, const std::string& name, auto setter) {
-				auto textures = LoadMaterialTextures(mat, type, name, directory);
-				if (!textures.empty()) setter(material, textures[0]);
-			};
-
-			loadFirst(aiTextureType_DIFFUSE, "texture_diffuse", [](auto& m, auto& t) { m->SetDiffuseTexture(t); });
-			loadFirst(aiTextureType_SPECULAR, "texture_specular", [](auto& m, auto& t) { m->SetSpecularTexture(t); });
-			loadFirst(aiTextureType_NORMALS, "texture_normal", [](auto& m, auto& t) { m->SetNormalTexture(t); });
-			loadFirst(aiTextureType_HEIGHT, "texture_height", [](auto& m, auto& t) { m->SetHeightTexture(t); });
+			// Textures are only located here; they are loaded on the main thread in Build.
+			out.texturePaths[ModelPayload::kDiffuse]  = FindMaterialTexture(mat, aiTextureType_DIFFUSE, directory);
+			out.texturePaths[ModelPayload::kSpecular] = FindMaterialTexture(mat, aiTextureType_SPECULAR, directory);
+			out.texturePaths[ModelPayload::kNormal]   = FindMaterialTexture(mat, aiTextureType_NORMALS, directory);
+			out.texturePaths[ModelPayload::kHeight]   = FindMaterialTexture(mat, aiTextureType_HEIGHT, directory);
 
             material->SetDiffuseColor({1.0, 1.0, 1.0});
             material->SetSpecularColor({1.0, 1.0, 1.0});
@@ -174,7 +269,7 @@ namespace Engine {
             material->SetEmissiveColor({0.0, 0.0, 0.0});
             material->SetShininess(20.0);
 			material->SetName("Material");
-			return material;
+			out.material = std::move(material);
 		}
 
 	} // namespace Rendering
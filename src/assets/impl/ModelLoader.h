@@ -9,19 +9,49 @@
 #include "assimp/postprocess.h"
 #include "assimp/scene.h"
 
+#include <limits>
 #include <unordered_map>
 
 namespace Engine {
 	namespace Rendering {
+		/// Everything assimp produced for one model, before any GL object exists.
+		struct ModelPayload : AssetPayload {
+			enum TextureSlot { kDiffuse, kSpecular, kNormal, kHeight, kTextureSlots };
+
+			struct MeshData {
+				std::vector<Vertex>       vertices;
+				std::vector<unsigned int> indices;
+				std::shared_ptr<Material> material;
+				std::string               texturePaths[kTextureSlots]; // empty = none
+			};
+
+			std::vector<MeshData> meshes;
+			glm::vec3             boundsMin{std::numeric_limits<float>::max()};
+			glm::vec3             boundsMax{std::numeric_limits<float>::lowest()};
+			std::string           name;
+		};
+
 		class ModelLoader : public IAssetLoader<Model> {
 		  public:
 			std::unique_ptr<Model> LoadFromFile(const std::string& path) override;
 
+			[[nodiscard]] bool            SupportsAsync() const override { return true; }
+			std::unique_ptr<AssetPayload> Decode(const std::string& path) override;
+			std::unique_ptr<Model>        Finish(AssetPayload& payload, const std::string& path) override;
+
+			/// Cooked: the meshes' vertex / index buffers, materials and texture paths, no assimp at load.
+			[[nodiscard]] bool            SupportsCooking() const override { return true; }
+			bool                          Cook(const std::string& path, std::vector<uint8_t>& out) override;
+			std::unique_ptr<AssetPayload> DecodeCooked(const uint8_t* data, size_t size, const std::string& path) override;
+
 		  private:
-			static void ProcessNode(aiNode* node, const aiScene* scene, std::vector<std::shared_ptr<Mesh>>& meshes, const std::string& directory, const glm::mat4& parentTransform, glm::vec3& boundsMin, glm::vec3& boundsMax);
-			static std::shared_ptr<Mesh>             ProcessMesh(aiMesh* mesh, const aiScene* scene, const std::string& directory);
-			static std::shared_ptr<Material>         LoadMaterial(aiMaterial* mat, const std::string& directory);
-			static std::vector<TextureHandle> LoadMaterialTextures(aiMaterial* mat, aiTextureType type, const std::string& typeName, const std::string& directory);
+			/// Create the meshes and resolve texture paths; `async` queues textures with LoadAsync.
+			static std::unique_ptr<Model> Build(ModelPayload& payload, bool async);
+
+			static void        ProcessNode(aiNode* node, const aiScene* scene, ModelPayload& payload, const std::string& directory, const glm::mat4& parentTransform);
+			static void        ProcessMesh(aiMesh* mesh, const aiScene* scene, const std::string& directory, ModelPayload::MeshData& out);
+			static void        LoadMaterial(aiMaterial* mat, const std::string& directory, ModelPayload::MeshData& out);
+			static std::string FindMaterialTexture(aiMaterial* mat, aiTextureType type, const std::string& directory);
 		};
 	} // namespace Rendering
-} // namespace Engine
\ No newline at end of file
+} // namespace Engine
@@ -0,0 +1,108 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+/// On-disk layout of packed scenes (PackedSceneLoader). Little-endian, read in place from a mapping.
+///
+///   FileHeader
+///   BlockHeader[blockCount]               one per component type present, COMPONENT_LIST order
+///   per block: uint32 entity indices      ascending, `count` of them
+///              data                       Packed: count * stride records, then the block's arrays
+///                                         Serialized: count BlobRefs, then the cereal binary payloads
+///   string table                          GUIDs, names and paths, each stored once
+///
+/// Every section starts on kAlignment. Entity i of the file is the i-th entity created on load.
+namespace Engine::PackedScene {
+
+	constexpr uint32_t kMagic     = 0x53504543u; // "CEPS"
+	constexpr uint32_t kVersion   = 1;
+	constexpr uint32_t kAlignment = 16;
+	constexpr uint32_t kNoEntity  = ~0u;
+
+	enum class BlockLayout : uint32_t {
+		Packed     = 0, // fixed-size POD records with string refs into the string table
+		Serialized = 1, // one cereal binary blob per component, for types without a packed record
+	};
+
+	struct FileHeader {
+		uint32_t magic       = kMagic;
+		uint32_t version     = kVersion;
+		uint32_t entityCount = 0;
+		uint32_t blockCount  = 0;
+		uint64_t blockTableOffset  = 0;
+		uint64_t stringTableOffset = 0;
+		uint64_t stringTableSize   = 0;
+		uint64_t fileSize          = 0;
+	};
+
+	struct BlockHeader {
+		uint32_t    componentId = 0; // ComponentId of the COMPONENT_LIST name
+		BlockLayout layout      = BlockLayout::Packed;
+		uint32_t    count       = 0;
+		uint32_t    stride      = 0; // record size; 0 for tags, sizeof(BlobRef) when serialized
+		uint64_t    indexOffset = 0;
+		uint64_t    dataOffset  = 0;
+		uint64_t    dataSize    = 0;
+	};
+
+	/// Bytes [offset, offset + size) of the string table.
+	struct StringRef {
+		uint32_t offset = 0;
+		uint32_t size   = 0;
+	};
+
+	/// Bytes [offset, offset + size) of the block data.
+	struct BlobRef {
+		uint64_t offset = 0;
+		uint64_t size   = 0;
+	};
+
+	/// EntityMetadata. Child GUIDs are a StringRef array after the records.
+	struct MetadataRecord {
+		StringRef name;
+		StringRef tag;
+		StringRef guid;
+		StringRef parent;
+		uint32_t  firstChild = 0;
+		uint32_t  childCount = 0;
+		uint32_t  active     = 1;
+		uint32_t  reserved   = 0;
+	};
+
+	struct TransformRecord {
+		float position[3];
+		float rotation[4]; // x y z w
+		float scale[3];
+	};
+
+	/// ModelRenderer. Material override GUIDs are a StringRef array after the records.
+	struct ModelRendererRecord {
+		StringRef model;
+		uint32_t  visible         = 1;
+		uint32_t  backfaceCulling = 1;
+		uint32_t  firstMaterial   = 0;
+		uint32_t  materialCount   = 0;
+	};
+
+	static_assert(std::is_trivially_copyable_v<MetadataRecord> && sizeof(MetadataRecord) == 48);
+	static_assert(std::is_trivially_copyable_v<TransformRecord> && sizeof(TransformRecord) == 40);
+	static_assert(std::is_trivially_copyable_v<ModelRendererRecord> && sizeof(ModelRendererRecord) == 24);
+
+	/// FNV-1a 32 of a COMPONENT_LIST name; "EntityMetadata" for the metadata block.
+	constexpr uint32_t ComponentId(std::string_view name)
+	{
+		uint32_t hash = 2166136261u;
+		for (const char c : name) {
+			hash ^= static_cast<uint8_t>(c);
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+
+} // namespace Engine::PackedScene
@@ -0,0 +1,545 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#include "PackedSceneLoader.h"
+
+#include "BinarySceneLoader.h"
+#include "JSONSceneLoader.h"
+#include "PackedSceneFormat.h"
+
+#include <cereal/archives/binary.hpp>
+
+#include "assets/SerializedEntity.h"
+#include "components/AllComponents.h"
+#include "core/Entity.h"
+#include "core/EngineData.h"
+#include "core/SceneManager.h"
+#include "utils/MappedFile.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+#include <tracy/Tracy.hpp>
+
+namespace Engine {
+
+	using namespace PackedScene;
+
+	namespace {
+		uint64_t AlignUp(uint64_t value) { return (value + kAlignment - 1) & ~uint64_t{kAlignment - 1}; }
+
+		template <typename T>
+		void AppendPod(std::vector<uint8_t>& bytes, const T* data, size_t count)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			const size_t offset = bytes.size();
+			bytes.resize(offset + sizeof(T) * count);
+			if (count > 0) std::memcpy(bytes.data() + offset, data, sizeof(T) * count);
+		}
+
+		void PadTo(std::vector<uint8_t>& bytes, uint64_t size) { bytes.resize(static_cast<size_t>(size), 0); }
+
+		template <typename T>
+		struct PackedCodec;
+
+		/// Builds the file in memory: block data first, then the header, block table and string table around it.
+		class PackedWriter {
+		  public:
+			/// Every distinct string is stored once (GUIDs repeat across entities and components).
+			StringRef Intern(const std::string& value)
+			{
+				if (value.empty()) return {};
+				auto [it, inserted] = m_stringIndex.try_emplace(value);
+				if (inserted) {
+					it->second = StringRef{static_cast<uint32_t>(m_strings.size()), static_cast<uint32_t>(value.size())};
+					m_strings.insert(m_strings.end(), value.begin(), value.end());
+				}
+				return it->second;
+			}
+
+			template <typename T>
+			void AddBlock(const char* name, std::vector<uint32_t> indices, const std::vector<const T*>& components)
+			{
+				if (components.empty()) return;
+				Block block;
+				block.header.componentId = ComponentId(name);
+				block.header.layout      = PackedCodec<T>::kLayout;
+				block.header.count       = static_cast<uint32_t>(components.size());
+				block.header.stride      = PackedCodec<T>::kStride;
+				block.indices            = std::move(indices);
+				PackedCodec<T>::Write(*this, components, block.data);
+				m_blocks.push_back(std::move(block));
+			}
+
+			bool Save(const std::string& path, uint32_t entityCount) const
+			{
+				FileHeader header;
+				header.entityCount      = entityCount;
+				header.blockCount       = static_cast<uint32_t>(m_blocks.size());
+				header.blockTableOffset = AlignUp(sizeof(FileHeader));
+
+				std::vector<BlockHeader> table;
+				uint64_t                 offset = AlignUp(header.blockTableOffset + sizeof(BlockHeader) * m_blocks.size());
+				for (const Block& block : m_blocks) {
+					BlockHeader entry = block.header;
+					entry.indexOffset = offset;
+					entry.dataOffset  = AlignUp(offset + sizeof(uint32_t) * block.indices.size());
+					entry.dataSize    = block.data.size();
+					offset            = AlignUp(entry.dataOffset + entry.dataSize);
+					table.push_back(entry);
+				}
+				header.stringTableOffset = offset;
+				header.stringTableSize   = m_strings.size();
+				header.fileSize          = offset + m_strings.size();
+
+				std::vector<uint8_t> bytes;
+				bytes.reserve(static_cast<size_t>(header.fileSize));
+				AppendPod(bytes, &header, 1);
+				PadTo(bytes, header.blockTableOffset);
+				AppendPod(bytes, table.data(), table.size());
+				for (size_t i = 0; i < m_blocks.size(); ++i) {
+					PadTo(bytes, table[i].indexOffset);
+					AppendPod(bytes, m_blocks[i].indices.data(), m_blocks[i].indices.size());
+					PadTo(bytes, table[i].dataOffset);
+					AppendPod(bytes, m_blocks[i].data.data(), m_blocks[i].data.size());
+				}
+				PadTo(bytes, header.stringTableOffset);
+				AppendPod(bytes, m_strings.data(), m_strings.size());
+
+				std::ofstream os(path, std::ios::binary | std::ios::trunc);
+				if (!os) return false;
+				os.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+				return os.good();
+			}
+
+		  private:
+			struct Block {
+				BlockHeader           header;
+				std::vector<uint32_t> indices;
+				std::vector<uint8_t>  data;
+			};
+			std::vector<Block>                         m_blocks;
+			std::vector<char>                          m_strings;
+			std::unordered_map<std::string, StringRef> m_stringIndex;
+		};
+
+		/// Bounds-checked views into a mapped packed file.
+		class PackedReader {
+		  public:
+			explicit PackedReader(const MappedFile& file) : m_data(file.Data()), m_size(file.Size()) {}
+
+			/// False (errors logged) if the header, block table or string table do not fit the file.
+			bool Validate(const std::string& path)
+			{
+				const auto& header = Header();
+				if (header.version != kVersion) {
+					GetDefaultLogger()->error("[packed] '{}' is version {}, this build reads {}", path, header.version, kVersion);
+					return false;
+				}
+				if (header.fileSize != m_size || !InRange(header.blockTableOffset, sizeof(BlockHeader) * uint64_t{header.blockCount}) ||
+				    !InRange(header.stringTableOffset, header.stringTableSize) || header.blockTableOffset % alignof(BlockHeader) != 0) {
+					GetDefaultLogger()->error("[packed] '{}' is truncated or corrupt", path);
+					return false;
+				}
+				m_strings = std::string_view(reinterpret_cast<const char*>(m_data + header.stringTableOffset), static_cast<size_t>(header.stringTableSize));
+
+				const auto* table = reinterpret_cast<const BlockHeader*>(m_data + header.blockTableOffset);
+				for (uint32_t i = 0; i < header.blockCount; ++i) {
+					const BlockHeader& block = table[i];
+					if (!InRange(block.indexOffset, sizeof(uint32_t) * uint64_t{block.count}) || !InRange(block.dataOffset, block.dataSize) ||
+					    uint64_t{block.count} * block.stride > block.dataSize || block.indexOffset % kAlignment != 0 || block.dataOffset % kAlignment != 0) {
+						GetDefaultLogger()->error("[packed] '{}': block {} is out of range", path, i);
+						return false;
+					}
+					m_blocks.emplace(block.componentId, &block);
+				}
+				return true;
+			}
+
+			[[nodiscard]] const FileHeader&  Header() const { return *reinterpret_cast<const FileHeader*>(m_data); }
+			[[nodiscard]] const BlockHeader* Find(uint32_t componentId) const
+			{
+				const auto it = m_blocks.find(componentId);
+				return it == m_blocks.end() ? nullptr : it->second;
+			}
+			[[nodiscard]] const uint32_t* Indices(const BlockHeader& block) const { return reinterpret_cast<const uint32_t*>(m_data + block.indexOffset); }
+			[[nodiscard]] const uint8_t*  Data(const BlockHeader& block) const { return m_data + block.dataOffset; }
+
+			/// `count` records of T starting `offset` bytes into the block data; null if they don't fit.
+			template <typename T>
+			[[nodiscard]] const T* Array(const BlockHeader& block, uint64_t offset, uint64_t count) const
+			{
+				if (offset % alignof(T) != 0 || offset > block.dataSize || count > (block.dataSize - offset) / sizeof(T)) return nullptr;
+				return reinterpret_cast<const T*>(Data(block) + offset);
+			}
+
+			[[nodiscard]] std::string_view String(StringRef ref) const
+			{
+				if (uint64_t{ref.offset} + ref.size > m_strings.size()) return {};
+				return m_strings.substr(ref.offset, ref.size);
+			}
+
+		  private:
+			[[nodiscard]] bool InRange(uint64_t offset, uint64_t size) const { return offset <= m_size && size <= m_size - offset; }
+
+			const uint8_t*                                        m_data = nullptr;
+			size_t                                                m_size = 0;
+			std::string_view                                      m_strings;
+			std::unordered_map<uint32_t, const BlockHeader*> m_blocks;
+		};
+
+		/// Lets cereal read a blob straight out of the mapping.
+		class MemoryStreamBuf : public std::streambuf {
+		  public:
+			MemoryStreamBuf(const uint8_t* data, size_t size)
+			{
+				char* begin = const_cast<char*>(reinterpret_cast<const char*>(data));
+				setg(begin, begin, begin + size);
+			}
+		};
+
+		/// Block codec per component type. The default stores each component as a cereal binary blob;
+		/// specializations below pack hot or simple components into fixed records.
+		template <typename T>
+		struct PackedCodec {
+			static constexpr BlockLayout kLayout = BlockLayout::Serialized;
+			static constexpr uint32_t    kStride = sizeof(BlobRef);
+
+			static void Write(PackedWriter&, const std::vector<const T*>& components, std::vector<uint8_t>& data)
+			{
+				std::vector<BlobRef> refs(components.size());
+				std::ostringstream   payload(std::ios::binary);
+				for (size_t i = 0; i < components.size(); ++i) {
+					refs[i].offset = static_cast<uint64_t>(payload.tellp());
+					{
+						cereal::BinaryOutputArchive archive(payload);
+						archive(*components[i]);
+					}
+					refs[i].size = static_cast<uint64_t>(payload.tellp()) - refs[i].offset;
+				}
+				const uint64_t base = sizeof(BlobRef) * refs.size();
+				for (BlobRef& ref : refs) ref.offset += base;
+				AppendPod(data, refs.data(), refs.size());
+				const std::string bytes = payload.str();
+				AppendPod(data, bytes.data(), bytes.size());
+			}
+
+			static bool Read(const PackedReader& reader, const BlockHeader& block, std::vector<T>& out)
+			{
+				const BlobRef* refs = reader.Array<BlobRef>(block, 0, block.count);
+				if (!refs) return false;
+				for (uint32_t i = 0; i < block.count; ++i) {
+					const uint8_t* blob = reader.Array<uint8_t>(block, refs[i].offset, refs[i].size);
+					if (!blob) return false;
+					MemoryStreamBuf            buffer(blob, static_cast<size_t>(refs[i].size));
+					std::istream               is(&buffer);
+					cereal::BinaryInputArchive archive(is);
+					archive(out.emplace_back());
+				}
+				return true;
+			}
+		};
+
+		template <>
+		struct PackedCodec<Components::EntityMetadata> {
+			static constexpr BlockLayout kLayout = BlockLayout::Packed;
+			static constexpr uint32_t    kStride = sizeof(MetadataRecord);
+
+			static void Write(PackedWriter& writer, const std::vector<const Components::EntityMetadata*>& components, std::vector<uint8_t>& data)
+			{
+				std::vector<MetadataRecord> records(components.size());
+				std::vector<StringRef>      children;
+				for (size_t i = 0; i < components.size(); ++i) {
+					const Components::EntityMetadata& meta   = *components[i];
+					MetadataRecord&                   record = records[i];
+					record.name       = writer.Intern(meta.name);
+					record.tag        = writer.Intern(meta.tag);
+					record.guid       = writer.Intern(meta.guid);
+					record.parent     = writer.Intern(meta.parentEntity.GetID());
+					record.active     = meta.active ? 1u : 0u;
+					record.firstChild = static_cast<uint32_t>(children.size());
+					record.childCount = static_cast<uint32_t>(meta.children.size());
+					for (const EntityHandle& child : meta.children) children.push_back(writer.Intern(child.GetID()));
+				}
+				AppendPod(data, records.data(), records.size());
+				AppendPod(data, children.data(), children.size());
+			}
+
+			static bool Read(const PackedReader& reader, const BlockHeader& block, std::vector<Components::EntityMetadata>& out)
+			{
+				const auto* records  = reader.Array<MetadataRecord>(block, 0, block.count);
+				const auto  base     = uint64_t{block.count} * sizeof(MetadataRecord);
+				const auto* children = reader.Array<StringRef>(block, base, (block.dataSize - base) / sizeof(StringRef));
+				if (!records || !children) return false;
+				const uint64_t childCount = (block.dataSize - base) / sizeof(StringRef);
+
+				for (uint32_t i = 0; i < block.count; ++i) {
+					const MetadataRecord& record = records[i];
+					if (uint64_t{record.firstChild} + record.childCount > childCount) return false;
+					auto& meta = out.emplace_back(std::string(reader.String(record.name)), std::string(reader.String(record.tag)), std::string(reader.String(record.guid)));
+					meta.active       = record.active != 0;
+					meta.parentEntity = EntityHandle(std::string(reader.String(record.parent)));
+					meta.children.reserve(record.childCount);
+					for (uint32_t c = 0; c < record.childCount; ++c) {
+						meta.children.emplace_back(std::string(reader.String(children[record.firstChild + c])));
+					}
+				}
+				return true;
+			}
+		};
+
+		template <>
+		struct PackedCodec<Components::Transform> {
+			static constexpr BlockLayout kLayout = BlockLayout::Packed;
+			static constexpr uint32_t    kStride = sizeof(TransformRecord);
+
+			static void Write(PackedWriter&, const std::vector<const Components::Transform*>& components, std::vector<uint8_t>& data)
+			{
+				std::vector<TransformRecord> records(components.size());
+				for (size_t i = 0; i < components.size(); ++i) {
+					const glm::vec3& position = components[i]->GetLocalPosition();
+					const glm::quat  rotation = components[i]->GetLocalRotation();
+					const glm::vec3& scale    = components[i]->GetLocalScale();
+					records[i]                = TransformRecord{{position.x, position.y, position.z}, {rotation.x, rotation.y, rotation.z, rotation.w}, {scale.x, scale.y, scale.z}};
+				}
+				AppendPod(data, records.data(), records.size());
+			}
+
+			static bool Read(const PackedReader& reader, const BlockHeader& block, std::vector<Components::Transform>& out)
+			{
+				const auto* records = reader.Array<TransformRecord>(block, 0, block.count);
+				if (!records) return false;
+				for (uint32_t i = 0; i < block.count; ++i) {
+					const TransformRecord& record    = records[i];
+					auto&                  transform = out.emplace_back(glm::vec3(record.position[0], record.position[1], record.position[2]));
+					transform.SetLocalRotation(glm::quat(record.rotation[3], record.rotation[0], record.rotation[1], record.rotation[2]));
+					transform.SetLocalScale(glm::vec3(record.scale[0], record.scale[1], record.scale[2]));
+				}
+				return true;
+			}
+		};
+
+		template <>
+		struct PackedCodec<Components::ShadowCaster> {
+			static constexpr BlockLayout kLayout = BlockLayout::Packed;
+			static constexpr uint32_t    kStride = 0; // tag: the entity index list is all there is
+
+			static void Write(PackedWriter&, const std::vector<const Components::ShadowCaster*>&, std::vector<uint8_t>&) {}
+
+			static bool Read(const PackedReader&, const BlockHeader& block, std::vector<Components::ShadowCaster>& out)
+			{
+				out.resize(block.count);
+				return true;
+			}
+		};
+
+		template <>
+		struct PackedCodec<Components::ModelRenderer> {
+			static constexpr BlockLayout kLayout = BlockLayout::Packed;
+			static constexpr uint32_t    kStride = sizeof(ModelRendererRecord);
+
+			static void Write(PackedWriter& writer, const std::vector<const Components::ModelRenderer*>& components, std::vector<uint8_t>& data)
+			{
+				std::vector<ModelRendererRecord> records(components.size());
+				std::vector<StringRef>           materials;
+				for (size_t i = 0; i < components.size(); ++i) {
+					const Components::ModelRenderer& renderer = *components[i];
+					ModelRendererRecord&             record   = records[i];
+					record.model           = writer.Intern(renderer.model.GetID());
+					record.visible         = renderer.visible ? 1u : 0u;
+					record.backfaceCulling = renderer.backfaceCulling ? 1u : 0u;
+					record.firstMaterial   = static_cast<uint32_t>(materials.size());
+					record.materialCount   = static_cast<uint32_t>(renderer.materialOverrides.size());
+					for (const MaterialHandle& material : renderer.materialOverrides) materials.push_back(writer.Intern(material.GetID()));
+				}
+				AppendPod(data, records.data(), records.size());
+				AppendPod(data, materials.data(), materials.size());
+			}
+
+			static bool Read(const PackedReader& reader, const BlockHeader& block, std::vector<Components::ModelRenderer>& out)
+			{
+				const auto* records   = reader.Array<ModelRendererRecord>(block, 0, block.count);
+				const auto  base      = uint64_t{block.count} * sizeof(ModelRendererRecord);
+				const auto  available = (block.dataSize - base) / sizeof(StringRef);
+				const auto* materials = reader.Array<StringRef>(block, base, available);
+				if (!records || !materials) return false;
+
+				for (uint32_t i = 0; i < block.count; ++i) {
+					const ModelRendererRecord& record = records[i];
+					if (uint64_t{record.firstMaterial} + record.materialCount > available) return false;
+					auto& renderer           = out.emplace_back(ModelHandle(std::string(reader.String(record.model))));
+					renderer.visible         = record.visible != 0;
+					renderer.backfaceCulling = record.backfaceCulling != 0;
+					renderer.materialOverrides.reserve(record.materialCount);
+					for (uint32_t m = 0; m < record.materialCount; ++m) {
+						renderer.materialOverrides.emplace_back(std::string(reader.String(materials[record.firstMaterial + m])));
+					}
+				}
+				return true;
+			}
+		};
+
+		/// Decodes a block, range-inserts it for its entities and runs OnAdded (with a scene).
+		template <typename T>
+		void InsertBlock(const PackedReader& reader, const char* name, entt::registry& registry, const std::vector<entt::entity>& entities, Scene* scene)
+		{
+			const BlockHeader* block = reader.Find(ComponentId(name));
+			if (!block || block->count == 0) return;
+			if (block->layout != PackedCodec<T>::kLayout || block->stride != PackedCodec<T>::kStride) {
+				GetDefaultLogger()->error("[packed] {} block has an unknown layout; re-export the scene", name);
+				return;
+			}
+
+			std::vector<T> components;
+			components.reserve(block->count);
+			std::vector<entt::entity> targets(block->count);
+			const uint32_t*           indices = reader.Indices(*block);
+			try {
+				for (uint32_t i = 0; i < block->count; ++i) {
+					if (indices[i] >= entities.size()) throw std::out_of_range("entity index");
+					targets[i] = entities[indices[i]];
+				}
+				if (!PackedCodec<T>::Read(reader, *block, components)) throw std::out_of_range("record data");
+			}
+			catch (const std::exception& ex) {
+				GetDefaultLogger()->error("[packed] {} block: {}", name, ex.what());
+				return;
+			}
+			registry.insert<T>(targets.begin(), targets.end(), std::make_move_iterator(components.begin()));
+
+			if (!scene) return;
+			for (const entt::entity target : targets) {
+				Entity entity(target, scene);
+				try {
+					registry.get<T>(target).OnAdded(entity);
+				}
+				catch (const std::exception& ex) {
+					const auto* meta = registry.try_get<Components::EntityMetadata>(target);
+					GetDefaultLogger()->error("[packed] OnAdded {} entity={}: {}", name, meta ? meta->name : std::string(), ex.what());
+				}
+			}
+		}
+	} // namespace
+
+	bool PackedSceneLoader::IsPackedScene(const MappedFile& file)
+	{
+		return file.IsOpen() && file.Size() >= sizeof(FileHeader) && reinterpret_cast<const FileHeader*>(file.Data())->magic == kMagic;
+	}
+
+	std::vector<entt::entity> PackedSceneLoader::Instantiate(const MappedFile& file, entt::registry& registry, Scene* scene)
+	{
+		ZoneScopedN("Instantiate Packed Scene");
+		if (!IsPackedScene(file)) return {};
+		PackedReader reader(file);
+		if (!reader.Validate(scene ? scene->GetName() : std::string("<packed>"))) return {};
+
+		std::vector<entt::entity> entities(reader.Header().entityCount);
+		registry.create(entities.begin(), entities.end());
+
+		// Metadata first: the scene indexes GUIDs and links parents as it is constructed. Like the
+		// cereal loaders, metadata skips OnAdded; the rest run it in COMPONENT_LIST order per block.
+		InsertBlock<Components::EntityMetadata>(reader, "EntityMetadata", registry, entities, nullptr);
+#define X(type, name, fancy) InsertBlock<type>(reader, #name, registry, entities, scene);
+		COMPONENT_LIST
+#undef X
+		return entities;
+	}
+
+	std::unique_ptr<Scene> PackedSceneLoader::LoadFromFile(const std::string& path)
+	{
+		ZoneScopedN("PackedSceneLoader::LoadFromFile");
+		MappedFile file;
+		if (!file.Open(path) || !IsPackedScene(file)) {
+			file.Close();
+			return BinarySceneLoader().LoadFromFile(path);
+		}
+
+		std::unique_ptr<Scene>          scene    = GetSceneManager().CreateScene(path);
+		const std::vector<entt::entity> entities = Instantiate(file, *scene->GetRegistry(), scene.get());
+
+		scene->m_entityList.reserve(entities.size());
+		for (const entt::entity entity : entities) {
+			scene->m_entityList.emplace_back(entity, scene.get());
+		}
+		// Parents may have been created after their children; fix up link order.
+		scene->ResolveHierarchyLinks();
+		GetDefaultLogger()->info("[packed] Loaded {} entities from {}", entities.size(), path);
+		return scene;
+	}
+
+	bool PackedSceneLoader::WriteEntities(const std::vector<SerializedEntity>& entities, const std::string& path)
+	{
+		PackedWriter writer;
+		{
+			std::vector<uint32_t>                          indices(entities.size());
+			std::vector<const Components::EntityMetadata*> metadata(entities.size());
+			for (size_t i = 0; i < entities.size(); ++i) {
+				indices[i]  = static_cast<uint32_t>(i);
+				metadata[i] = &entities[i].meta;
+			}
+			writer.AddBlock<Components::EntityMetadata>("EntityMetadata", std::move(indices), metadata);
+		}
+#define X(type, name, fancy)                                                                                                                                                                                                                   \
+	{                                                                                                                                                                                                                                          \
+		std::vector<uint32_t>    indices;                                                                                                                                                                                                      \
+		std::vector<const type*> components;                                                                                                                                                                                                   \
+		for (size_t i = 0; i < entities.size(); ++i) {                                                                                                                                                                                         \
+			if (!entities[i].name.has_value()) continue;                                                                                                                                                                                       \
+			indices.push_back(static_cast<uint32_t>(i));                                                                                                                                                                                       \
+			components.push_back(&entities[i].name.value());                                                                                                                                                                                   \
+		}                                                                                                                                                                                                                                      \
+		writer.AddBlock<type>(#name, std::move(indices), components);                                                                                                                                                                          \
+	}
+		COMPONENT_LIST
+#undef X
+
+		if (!writer.Save(path, static_cast<uint32_t>(entities.size()))) {
+			GetDefaultLogger()->error("[packed] could not write {}", path);
+			return false;
+		}
+		return true;
+	}
+
+	void PackedSceneLoader::SerializeScene(const SceneHandle& sceneRef, const std::string& path)
+	{
+		GetDefaultLogger()->info("Saving packed scene: {}", path);
+		Scene* scene = GetAssetManager().Get(sceneRef);
+		if (!scene) return;
+
+		auto                          registry = scene->GetRegistry();
+		std::vector<SerializedEntity> entities;
+		registry->view<Components::EntityMetadata>().each([&](auto entity, auto& meta) {
+			SerializedEntity se;
+			se.meta = meta;
+#define X(type, name, fancy)                                                                                                                                                                                                                   \
+	if (registry->all_of<type>(entity)) se.name = registry->get<type>(entity);
+			COMPONENT_LIST
+#undef X
+			entities.push_back(std::move(se));
+		});
+		WriteEntities(entities, path);
+	}
+
+	bool PackedSceneLoader::ConvertScene(const std::string& sourcePath, const std::string& packedPath)
+	{
+		std::vector<SerializedEntity> entities;
+		const bool json = std::filesystem::path(sourcePath).extension() == ".json";
+		if (!(json ? JSONSceneLoader::ReadEntities(sourcePath, entities) : BinarySceneLoader::ReadEntities(sourcePath, entities))) {
+			GetDefaultLogger()->error("[packed] could not read {}", sourcePath);
+			return false;
+		}
+		if (!WriteEntities(entities, packedPath)) return false;
+		GetDefaultLogger()->info("[packed] Converted {} ({} entities) -> {}", sourcePath, entities.size(), packedPath);
+		return true;
+	}
+
+} // namespace Engine
+
+#include "assets/AssetManager.inl"
@@ -0,0 +1,34 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include "assets/IAssetLoader.h"
+#include "core/Scene.h"
+
+#include <vector>
+
+namespace Engine {
+	struct SerializedEntity;
+	class MappedFile;
+
+	/// Versioned scene format with one contiguous block per component type (PackedSceneFormat.h).
+	/// Files are memory-mapped and each block is range-inserted into the registry.
+	class PackedSceneLoader : public IAssetLoader<Scene> {
+	  public:
+		/// Packed files load from the mapping; anything else (cereal .bin from older builds) goes to BinarySceneLoader.
+		std::unique_ptr<Scene> LoadFromFile(const std::string& path) override;
+
+		static void SerializeScene(const SceneHandle& sceneRef, const std::string& path);
+		/// False if the file cannot be written.
+		static bool WriteEntities(const std::vector<SerializedEntity>& entities, const std::string& path);
+		/// JSON (.json) or cereal binary scene to a packed scene, without creating a Scene.
+		static bool ConvertScene(const std::string& sourcePath, const std::string& packedPath);
+
+		[[nodiscard]] static bool IsPackedScene(const MappedFile& file);
+		/// Creates the file's entities in `registry` (file order) and inserts every block. OnAdded runs
+		/// only when `scene` is given, which must own `registry`. Empty on a malformed or foreign file.
+		static std::vector<entt::entity> Instantiate(const MappedFile& file, entt::registry& registry, Scene* scene);
+	};
+} // namespace Engine
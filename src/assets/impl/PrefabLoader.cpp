@@ -6,6 +6,7 @@
 
 #include <nlohmann/json.hpp>
 
+#include <cereal/archives/binary.hpp>
 #include <cereal/archives/json.hpp>
 #include <cereal/types/common.hpp>
 #include <cereal/types/map.hpp>
@@ -59,6 +60,41 @@ namespace Engine {
 		return prefab;
 	}
 
+	bool PrefabLoader::Cook(const std::string& path, std::vector<uint8_t>& out)
+	{
+		const std::unique_ptr<Prefab> prefab = LoadFromFile(path);
+		try {
+			std::ostringstream os(std::ios::binary);
+			{
+				cereal::BinaryOutputArchive archive(os);
+				archive(prefab->m_name, prefab->rootGuid, prefab->entities);
+			}
+			const std::string bytes = os.str();
+			out.insert(out.end(), bytes.begin(), bytes.end());
+		}
+		catch (const std::exception& e) {
+			GetDefaultLogger()->error("[Prefab] cook failed for {}: {}", path, e.what());
+			return false;
+		}
+		return true;
+	}
+
+	std::unique_ptr<AssetPayload> PrefabLoader::DecodeCooked(const uint8_t* data, size_t size, const std::string& path)
+	{
+		auto payload   = std::make_unique<DecodedAsset<Prefab>>();
+		payload->asset = std::make_unique<Prefab>();
+		try {
+			std::istringstream is(std::string(reinterpret_cast<const char*>(data), size), std::ios::binary);
+			cereal::BinaryInputArchive archive(is);
+			archive(payload->asset->m_name, payload->asset->rootGuid, payload->asset->entities);
+		}
+		catch (const std::exception& e) {
+			GetDefaultLogger()->error("[Prefab] cooked load failed for {}: {}", path, e.what());
+			return nullptr;
+		}
+		return payload;
+	}
+
 	bool PrefabLoader::SaveToFile(const Prefab& prefab, const std::string& path)
 	{
 		std::error_code ec;
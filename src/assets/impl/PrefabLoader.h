@@ -8,5 +8,10 @@ namespace Engine {
 	  public:
 		std::unique_ptr<Prefab> LoadFromFile(const std::string& path) override;
 		static bool             SaveToFile(const Prefab& prefab, const std::string& path);
+
+		/// Cooked: the entities as cereal binary instead of JSON.
+		[[nodiscard]] bool            SupportsCooking() const override { return true; }
+		bool                          Cook(const std::string& path, std::vector<uint8_t>& out) override;
+		std::unique_ptr<AssetPayload> DecodeCooked(const uint8_t* data, size_t size, const std::string& path) override;
 	};
 } // namespace Engine
@@ -1,6 +1,7 @@
 #include "SkeletonLoader.h"
 
 #include "animation/AnimationUtils.h"
+#include "assets/CookedData.h"
 #include "core/EngineData.h"
 
 namespace Engine {
@@ -21,4 +22,24 @@ namespace Engine {
 		return skeleton;
 	}
 
+	bool SkeletonLoader::Cook(const std::string& path, std::vector<uint8_t>& out)
+	{
+		return AppendFileBytes(path, out);
+	}
+
+	std::unique_ptr<AssetPayload> SkeletonLoader::DecodeCooked(const uint8_t* data, size_t size, const std::string& path)
+	{
+		auto* source = new ozz::animation::Skeleton();
+		if (!LoadSkeleton(data, size, source)) {
+			GetDefaultLogger()->error("SkeletonLoader: failed to load cooked skeleton: {}", path);
+			delete source;
+			return nullptr;
+		}
+		auto payload           = std::make_unique<DecodedAsset<Skeleton>>();
+		payload->asset         = std::make_unique<Skeleton>();
+		payload->asset->name   = path.substr(path.find_last_of("/\\") + 1);
+		payload->asset->source = source;
+		return payload;
+	}
+
 } // namespace Engine
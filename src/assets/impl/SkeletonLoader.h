@@ -8,6 +8,14 @@ namespace Engine {
 	class SkeletonLoader : public IAssetLoader<Skeleton> {
 	  public:
 		std::unique_ptr<Skeleton> LoadFromFile(const std::string& path) override;
+
+		[[nodiscard]] bool            SupportsAsync() const override { return true; }
+		std::unique_ptr<AssetPayload> Decode(const std::string& path) override { return DecodeWhole(path); }
+
+		/// Cooked: the ozz archive as is; it is already the runtime form.
+		[[nodiscard]] bool            SupportsCooking() const override { return true; }
+		bool                          Cook(const std::string& path, std::vector<uint8_t>& out) override;
+		std::unique_ptr<AssetPayload> DecodeCooked(const uint8_t* data, size_t size, const std::string& path) override;
 	};
 
 } // namespace Engine
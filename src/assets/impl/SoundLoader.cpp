@@ -4,9 +4,17 @@
 
 #include "SoundLoader.h"
 
+#include "assets/CookedData.h"
+
 
 
 namespace Engine {
+	namespace {
+		struct SoundPayload : AssetPayload {
+			Audio::SoundData data;
+		};
+	} // namespace
+
 	std::unique_ptr<Audio::SoundBuffer> SoundLoader::LoadFromFile(const std::string& path)
 	{
 		auto buffer = std::make_unique<Audio::SoundBuffer>(path);
@@ -17,4 +25,45 @@ namespace Engine {
 		return buffer;
 	}
 
+	std::unique_ptr<AssetPayload> SoundLoader::Decode(const std::string& path)
+	{
+		auto payload = std::make_unique<SoundPayload>();
+		if (!Audio::SoundBuffer::Decode(path, payload->data)) return nullptr;
+		return payload;
+	}
+
+	bool SoundLoader::Cook(const std::string& path, std::vector<uint8_t>& out)
+	{
+		Audio::SoundData data;
+		if (!Audio::SoundBuffer::Decode(path, data)) return false;
+		CookedWriter writer(out);
+		writer.Pod(static_cast<int32_t>(data.channels));
+		writer.Pod(static_cast<int32_t>(data.sampleRate));
+		writer.Array(data.samples);
+		return true;
+	}
+
+	std::unique_ptr<AssetPayload> SoundLoader::DecodeCooked(const uint8_t* data, size_t size, const std::string& path)
+	{
+		auto         payload    = std::make_unique<SoundPayload>();
+		CookedReader reader(data, size);
+		int32_t      channels   = 0;
+		int32_t      sampleRate = 0;
+		if (!reader.Pod(channels) || !reader.Pod(sampleRate) || !reader.Array(payload->data.samples)) return nullptr;
+		payload->data.name       = GetFileName(path);
+		payload->data.channels   = channels;
+		payload->data.sampleRate = sampleRate;
+		return payload;
+	}
+
+	std::unique_ptr<Audio::SoundBuffer> SoundLoader::Finish(AssetPayload& payload, const std::string& path)
+	{
+		auto buffer = std::make_unique<Audio::SoundBuffer>(static_cast<SoundPayload&>(payload).data);
+		if (!buffer->IsLoaded()) {
+			return nullptr;
+		}
+
+		return buffer;
+	}
+
 } // namespace Engine
\ No newline at end of file
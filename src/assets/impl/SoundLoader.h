@@ -14,5 +14,14 @@ namespace Engine {
 	class SoundLoader : public IAssetLoader<Audio::SoundBuffer> {
 	  public:
 		std::unique_ptr<Audio::SoundBuffer> LoadFromFile(const std::string& path) override;
+
+		[[nodiscard]] bool                  SupportsAsync() const override { return true; }
+		std::unique_ptr<AssetPayload>       Decode(const std::string& path) override;
+		std::unique_ptr<Audio::SoundBuffer> Finish(AssetPayload& payload, const std::string& path) override;
+
+		/// Cooked: decoded 16-bit PCM, so the game build never opens libsndfile.
+		[[nodiscard]] bool                  SupportsCooking() const override { return true; }
+		bool                                Cook(const std::string& path, std::vector<uint8_t>& out) override;
+		std::unique_ptr<AssetPayload>       DecodeCooked(const uint8_t* data, size_t size, const std::string& path) override;
 	};
 } // namespace Engine
\ No newline at end of file
@@ -4,20 +4,19 @@
 
 #include <fstream>
 #include "TerrainLoader.h"
+#include "core/EngineData.h"
+#include "terrain/TerrainBuildCache.h"
+
+#include <tracy/Tracy.hpp>
 
 namespace Engine {
 
 
-	std::unique_ptr<Terrain::TerrainTile> TerrainLoader::LoadFromFile(const std::string& path)
+	void TerrainLoader::ReadHeader(std::istream& file, Terrain::TerrainTile& tile)
 	{
-		auto tile = std::make_unique<Terrain::TerrainTile>();
-
-		std::ifstream file(path, std::ios::binary);
-		if (!file) throw std::runtime_error("Cannot open terrain file");
-
 		char magic[4];
 		file.read(magic, 4);
-		if (std::string(magic, 4) != "TERR") throw std::runtime_error("Invalid format");
+		if (!file || std::string(magic, 4) != "TERR") throw std::runtime_error("Invalid format");
 
 		uint32_t version;
 		file.read(reinterpret_cast<char*>(&version), sizeof(uint32_t));
@@ -26,26 +25,37 @@ namespace Engine {
 
 		uint32_t nameLen;
 		file.read(reinterpret_cast<char*>(&nameLen), sizeof(uint32_t));
-		tile->name.resize(nameLen);
-		file.read(tile->name.data(), nameLen);
+		tile.name.resize(nameLen);
+		file.read(tile.name.data(), nameLen);
 
-		file.read(reinterpret_cast<char*>(&tile->heightRes), sizeof(uint32_t));
-		file.read(reinterpret_cast<char*>(&tile->splatRes), sizeof(uint32_t));
-		file.read(reinterpret_cast<char*>(&tile->sizeX), sizeof(float));
-		file.read(reinterpret_cast<char*>(&tile->sizeY), sizeof(float));
-		file.read(reinterpret_cast<char*>(&tile->sizeZ), sizeof(float));
+		file.read(reinterpret_cast<char*>(&tile.heightRes), sizeof(uint32_t));
+		file.read(reinterpret_cast<char*>(&tile.splatRes), sizeof(uint32_t));
+		file.read(reinterpret_cast<char*>(&tile.sizeX), sizeof(float));
+		file.read(reinterpret_cast<char*>(&tile.sizeY), sizeof(float));
+		file.read(reinterpret_cast<char*>(&tile.sizeZ), sizeof(float));
 
 		if (version >= 3) {
-			file.read(reinterpret_cast<char*>(&tile->posX), sizeof(float));
-			file.read(reinterpret_cast<char*>(&tile->posY), sizeof(float));
-			file.read(reinterpret_cast<char*>(&tile->posZ), sizeof(float));
-			spdlog::debug("loaded terrain chunk at ({}, {}, {})", tile->posX, tile->posY, tile->posZ);
+			file.read(reinterpret_cast<char*>(&tile.posX), sizeof(float));
+			file.read(reinterpret_cast<char*>(&tile.posY), sizeof(float));
+			file.read(reinterpret_cast<char*>(&tile.posZ), sizeof(float));
+			spdlog::debug("loaded terrain chunk at ({}, {}, {})", tile.posX, tile.posY, tile.posZ);
 		}
 		else {
 			spdlog::debug("unknown position, assuming (0, 0, 0).");
 		}
 
-		file.read(reinterpret_cast<char*>(&tile->splatLayerCount), sizeof(uint32_t));
+		file.read(reinterpret_cast<char*>(&tile.splatLayerCount), sizeof(uint32_t));
+		if (!file) throw std::runtime_error("Truncated terrain header");
+	}
+
+	std::unique_ptr<Terrain::TerrainTile> TerrainLoader::ReadTile(const std::string& path)
+	{
+		auto tile = std::make_unique<Terrain::TerrainTile>();
+
+		std::ifstream file(path, std::ios::binary);
+		if (!file) throw std::runtime_error("Cannot open terrain file");
+
+		ReadHeader(file, *tile);
 
 		size_t heightCount = tile->heightRes * tile->heightRes;
 		tile->heightmap.resize(heightCount);
@@ -67,10 +77,55 @@ namespace Engine {
 			file.read(reinterpret_cast<char*>(&tree.prefabIndex), sizeof(uint32_t));
 		}
 
-		tile->GenerateMesh();
-		tile->GenerateSplatTextures();
-		tile->SetupShader();
+		return tile;
+	}
 
+	void TerrainLoader::BuildDerivedData(const std::string& path, Terrain::TerrainTile& tile)
+	{
+		ZoneScopedN("Build terrain derived data");
+		const Terrain::TerrainBuildOptions& options   = Terrain::GetTerrainBuildOptions();
+		const bool                          withSplat = !IsHeadless();
+		const uint64_t                      key       = options.useCache ? Terrain::TerrainBuildCache::HashFile(path) : 0;
+
+		if (!options.useCache || !Terrain::TerrainBuildCache::Load(key, tile, withSplat)) {
+			tile.BuildMesh();
+			// Headless keeps only the heightfield shape for physics.
+			if (withSplat) tile.BuildSplatTextures();
+			if (options.useCache) Terrain::TerrainBuildCache::Store(key, tile);
+		}
+		if (withSplat && options.dumpSplatImages) tile.DumpSplatImages();
+	}
+
+	std::unique_ptr<Terrain::TerrainTile> TerrainLoader::LoadFromFile(const std::string& path)
+	{
+		auto tile = ReadTile(path);
+		BuildDerivedData(path, *tile);
+
+		if (!IsHeadless()) {
+			tile->UploadMesh();
+			tile->UploadSplatTextures();
+			tile->SetupShader();
+		}
+
+		return tile;
+	}
+
+	std::unique_ptr<AssetPayload> TerrainLoader::Decode(const std::string& path)
+	{
+		auto payload   = std::make_unique<DecodedAsset<Terrain::TerrainTile>>();
+		payload->asset = ReadTile(path);
+		BuildDerivedData(path, *payload->asset);
+		return payload;
+	}
+
+	std::unique_ptr<Terrain::TerrainTile> TerrainLoader::Finish(AssetPayload& payload, const std::string& path)
+	{
+		auto tile = IAssetLoader::Finish(payload, path);
+		if (!tile || IsHeadless()) return tile;
+
+		tile->UploadMesh();
+		tile->UploadSplatTextures();
+		tile->SetupShader();
 		return tile;
 	}
 } // namespace Engine
\ No newline at end of file
@@ -7,11 +7,29 @@
 
 #include "terrain/TerrainManager.h"
 #include "assets/IAssetLoader.h"
+
+#include <istream>
+
 namespace Engine {
 
 	class TerrainLoader : public IAssetLoader<Terrain::TerrainTile> {
 	  public:
 		std::unique_ptr<Terrain::TerrainTile> LoadFromFile(const std::string& path) override;
+
+		/// Decode reads the tile and builds (or takes from TerrainBuildCache) its mesh, chunks, splat
+		/// images and heightfield shape; Finish only uploads to GL and sets up the shared shader.
+		[[nodiscard]] bool                    SupportsAsync() const override { return true; }
+		std::unique_ptr<AssetPayload>         Decode(const std::string& path) override;
+		std::unique_ptr<Terrain::TerrainTile> Finish(AssetPayload& payload, const std::string& path) override;
+
+		/// Everything up to the heightmap (name, resolutions, size, position, layer count). Throws on a bad file.
+		static void ReadHeader(std::istream& file, Terrain::TerrainTile& tile);
+
+	  private:
+		/// Header, heightmap, splatmap and trees. Throws on a bad file.
+		static std::unique_ptr<Terrain::TerrainTile> ReadTile(const std::string& path);
+		/// Any thread: BuildMesh + BuildSplatTextures (unless headless), or the cached result of them.
+		static void BuildDerivedData(const std::string& path, Terrain::TerrainTile& tile);
 	};
 
 } // namespace Engine
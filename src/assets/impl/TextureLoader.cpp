@@ -8,6 +8,12 @@
 
 
 namespace Engine {
+	namespace {
+		struct TexturePayload : AssetPayload {
+			TextureData data;
+		};
+	} // namespace
+
 	std::unique_ptr<Texture> TextureLoader::LoadFromFile(const std::string& path)
 	{
 		auto tex = std::make_unique<Texture>();
@@ -21,4 +27,25 @@ namespace Engine {
 		return asset.LoadFromFile(path);
 	}
 
+	std::unique_ptr<AssetPayload> TextureLoader::Decode(const std::string& path)
+	{
+		auto payload = std::make_unique<TexturePayload>();
+		if (!Texture::Decode(path, payload->data)) return nullptr;
+		return payload;
+	}
+
+	std::unique_ptr<AssetPayload> TextureLoader::DecodeCooked(const uint8_t* data, size_t size, const std::string& path)
+	{
+		auto payload = std::make_unique<TexturePayload>();
+		if (!Texture::DecodeCooked(data, size, path, payload->data)) return nullptr;
+		return payload;
+	}
+
+	std::unique_ptr<Texture> TextureLoader::Finish(AssetPayload& payload, const std::string& path)
+	{
+		auto tex = std::make_unique<Texture>();
+		tex->Upload(static_cast<TexturePayload&>(payload).data);
+		return tex;
+	}
+
 } // namespace Engine
\ No newline at end of file
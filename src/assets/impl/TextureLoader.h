@@ -16,6 +16,14 @@ namespace Engine {
 	  public:
 		std::unique_ptr<Texture> LoadFromFile(const std::string& path) override;
 		bool                     Reload(Texture& asset, const std::string& path) override;
+
+		[[nodiscard]] bool            SupportsAsync() const override { return true; }
+		std::unique_ptr<AssetPayload> Decode(const std::string& path) override;
+		std::unique_ptr<Texture>      Finish(AssetPayload& payload, const std::string& path) override;
+
+		[[nodiscard]] bool            SupportsCooking() const override { return true; }
+		bool                          Cook(const std::string& path, std::vector<uint8_t>& out) override { return Texture::Cook(path, out); }
+		std::unique_ptr<AssetPayload> DecodeCooked(const uint8_t* data, size_t size, const std::string& path) override;
 	};
 } // namespace Engine
 
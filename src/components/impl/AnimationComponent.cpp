@@ -17,11 +17,15 @@
 #include "ozz/animation/runtime/skeleton.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 
 namespace Engine::Components {
 
 	namespace {
+		// Source of poseVersion; poses evaluate in parallel and shared-pose readers compare across components.
+		std::atomic<uint64_t> s_nextPoseVersion{0};
+
 		void ResolveRuntimeSkeleton(AnimationComponent& self)
 		{
 			self.skeleton = nullptr;
@@ -39,6 +43,7 @@ namespace Engine::Components {
 		defaultFadeDuration   = other.defaultFadeDuration;
 		playbackSpeed         = other.playbackSpeed;
 		counteractRootOffset  = other.counteractRootOffset;
+		sharePose             = other.sharePose;
 		current.clip          = other.current.clip;
 		current.time          = other.current.time;
 		current.speed         = other.current.speed;
@@ -54,6 +59,7 @@ namespace Engine::Components {
 			defaultFadeDuration  = other.defaultFadeDuration;
 			playbackSpeed        = other.playbackSpeed;
 			counteractRootOffset = other.counteractRootOffset;
+			sharePose            = other.sharePose;
 			current.clip         = other.current.clip;
 			current.time         = other.current.time;
 			current.speed        = other.current.speed;
@@ -428,11 +434,14 @@ namespace Engine::Components {
 			track.localPose.resize(skeleton->num_soa_joints());
 		}
 
+		// ozz samples only as many joints as the output holds; the rest keep their last transform.
+		const size_t soaJoints = sampledSoaJoints > 0 ? std::min(track.localPose.size(), static_cast<size_t>(sampledSoaJoints)) : track.localPose.size();
+
 		ozz::animation::SamplingJob job;
 		job.animation = ozzAnim;
 		job.context   = &track.context;
 		job.ratio     = ratio;
-		job.output    = ozz::make_span(track.localPose);
+		job.output    = ozz::span<ozz::math::SoaTransform>(track.localPose.data(), soaJoints);
 		if (!job.Run()) {
 			GetDefaultLogger()->error("Animation sampling failed");
 		}
@@ -443,6 +452,15 @@ namespace Engine::Components {
 		if (!skeleton || !local_pose || !model_pose) return;
 		if (!current.active) return;
 
+		AdvancePlayback(dt);
+		EvaluatePose();
+	}
+
+	void AnimationComponent::AdvancePlayback(float dt)
+	{
+		if (!skeleton || !local_pose || !model_pose) return;
+		if (!current.active) return;
+
 		// Crossfade progress (wall-clock, not scaled by clip speed)
 		if (isFading) {
 			if (fadeDuration <= 0.f) {
@@ -461,14 +479,32 @@ namespace Engine::Components {
 		if (from.active) {
 			AdvanceTrack(from, dt);
 		}
+	}
 
-		EvaluatePose();
+	int AnimationComponent::ReducedSoaJointCount(int depth)
+	{
+		if (!skeleton) return 0;
+		if (reducedJointsSkeleton == skeleton && reducedJointsDepth == depth) return reducedSoaJoints;
+
+		const auto       parents = skeleton->joint_parents();
+		std::vector<int> depths(parents.size(), 0);
+		int              count = 0;
+		for (size_t i = 0; i < parents.size(); ++i) {
+			depths[i] = parents[i] < 0 ? 0 : depths[static_cast<size_t>(parents[i])] + 1;
+			if (depths[i] <= depth) count = static_cast<int>(i) + 1;
+		}
+		reducedJointsSkeleton = skeleton;
+		reducedJointsDepth    = depth;
+		reducedSoaJoints      = (count + 3) / 4;
+		return reducedSoaJoints;
 	}
 
 	void AnimationComponent::EvaluatePose()
 	{
 		if (!skeleton || !local_pose || !model_pose) return;
 		if (!current.active || !ResolveClip(current)) return;
+		poseStale   = false;
+		poseVersion = s_nextPoseVersion.fetch_add(1, std::memory_order_relaxed) + 1;
 
 		SampleTrack(current);
 
@@ -530,6 +566,8 @@ namespace Engine::Components {
 		    &AnimationComponent::playbackSpeed,
 		    "counteractRootOffset",
 		    &AnimationComponent::counteractRootOffset,
+		    "sharePose",
+		    &AnimationComponent::sharePose,
 		    "setSkeleton",
 		    sol::overload(
 		        [](AnimationComponent& self, const SkeletonReference& h) { self.SetSkeleton(h); },
@@ -593,6 +631,7 @@ namespace Engine::Components {
 		LeftLabelSliderFloat("Playback Speed", &playbackSpeed, 0.f, 3.f);
 		LeftLabelSliderFloat("Default Fade", &defaultFadeDuration, 0.f, 2.f);
 		LeftLabelCheckbox("Counteract Root Offset", &counteractRootOffset);
+		LeftLabelCheckbox("Share Pose", &sharePose);
 		if (restRootValid) {
 			ImGui::Text("Rest root: (%.2f, %.2f, %.2f)", restRootX, restRootY, restRootZ);
 		}
@@ -633,6 +672,22 @@ namespace Engine::Components {
 		if (ImGui::Button("Restart") && current.clip.IsValid()) {
 			Play(current.clip, current.looping, 0.f);
 		}
+
+		if (ImGui::TreeNode("LOD")) {
+			LeftLabelCheckbox("Enabled", &lod.enabled);
+			for (int i = 0; i < kAnimationLodLevels - 1; ++i) {
+				ImGui::PushID(i);
+				ImGui::Text("Level %d (1/%d rate)", i + 1, 1 << (i + 1));
+				LeftLabelDragFloat("Beyond Distance", &lod.distance[i], 0.5f);
+				LeftLabelSliderFloat("Below Screen Size", &lod.screenSize[i], 0.f, 1.f);
+				ImGui::PopID();
+			}
+			LeftLabelSliderInt("Freeze From Level", &lod.freezeLevel, 1, kAnimationLodLevels);
+			LeftLabelSliderInt("Reduced Joints From Level", &lod.reducedJointsLevel, 1, kAnimationLodLevels);
+			LeftLabelSliderInt("Reduced Joint Depth", &lod.reducedJointDepth, 0, 16);
+			ImGui::Text("Current level: %d", lodLevel);
+			ImGui::TreePop();
+		}
 	}
 
 } // namespace Engine::Components
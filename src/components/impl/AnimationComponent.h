@@ -21,6 +21,21 @@
 
 namespace Engine::Components {
 
+	constexpr int kAnimationLodLevels = 4;
+
+	/// Animation LOD bands. A character drops one level past each `distance` or below each `screenSize`
+	/// (fraction of viewport height its bounds cover); level n evaluates its pose every 2^n frames.
+	struct AnimationLodPolicy {
+		bool  enabled                             = true;
+		float distance[kAnimationLodLevels - 1]   = {20.f, 40.f, 80.f};
+		float screenSize[kAnimationLodLevels - 1] = {0.2f, 0.08f, 0.03f};
+		/// From this level on the pose and skin stay frozen and only playback time advances (4 = never).
+		int freezeLevel = kAnimationLodLevels;
+		/// From this level on only joints at most `reducedJointDepth` below the root are sampled (4 = never).
+		int reducedJointsLevel = 2;
+		int reducedJointDepth  = 4;
+	};
+
 	class AnimationComponent : public Component {
 	  public:
 		// Serialized skeleton asset reference (not a raw path).
@@ -51,6 +66,30 @@ namespace Engine::Components {
 		bool      restRootValid = false;
 		float     restRootX = 0.f, restRootY = 0.f, restRootZ = 0.f;
 
+		// Set by AnimationManager when the skinned bounds missed the camera and every shadow cascade.
+		bool offscreen = false;
+		// Playback advanced without sampling while off-screen; re-evaluated before the pose is next skinned.
+		bool poseStale = false;
+		// World bounding sphere of the skinned pose, written with `offscreen` (radius 0 = unknown).
+		glm::vec3 boundsCenter{0.f};
+		float     boundsRadius = 0.f;
+
+		// LOD policy (runtime; not serialized) and AnimationManager scheduler state.
+		AnimationLodPolicy lod{};
+		int                lodLevel           = 0;
+		uint64_t           lastEvaluatedFrame = 0;
+		// New for every EvaluatePose, unique across components; skinning is reused while it is unchanged.
+		uint64_t poseVersion = 0;
+		// SoA joints SampleTrack fills, 0 = all. Unsampled joints keep their last local transform.
+		int sampledSoaJoints = 0;
+
+		// Opt into pose sharing (runtime): characters on the same skeleton and looping clip are snapped onto
+		// shared phases and evaluated once per group. AnimationManager can also group every character.
+		bool sharePose = false;
+		// Set by AnimationManager while grouped: the member whose model pose this one draws with (itself
+		// for the group leader). entt::null when not grouped; the own pose is then current.
+		entt::entity poseSource = entt::null;
+
 		AnimationComponent() = default;
 		AnimationComponent(const AnimationComponent& other);
 		AnimationComponent& operator=(const AnimationComponent& other);
@@ -102,7 +141,11 @@ namespace Engine::Components {
 
 		// Called by AnimationManager each frame
 		void UpdatePlayback(float dt);
+		// Crossfade + clip time only, no sampling (off-screen or LOD-skipped frames).
+		void AdvancePlayback(float dt);
 		void EvaluatePose();
+		// SoA joints covering every joint at most `depth` below the root (skeletons list parents first).
+		int ReducedSoaJointCount(int depth);
 
 		static void AddBindings();
 		static void CleanAnimationContexts();
@@ -113,6 +156,11 @@ namespace Engine::Components {
 		void CacheRestRootModelTranslation();
 		void ApplyRootOffsetCounteract();
 
+		// ReducedSoaJointCount result for (skeleton, depth).
+		const ozz::animation::Skeleton* reducedJointsSkeleton = nullptr;
+		int                             reducedJointsDepth    = -1;
+		int                             reducedSoaJoints      = 0;
+
 		// Resolve engine asset from a track's handle (null if missing/invalid).
 		static Animation* ResolveClip(const AnimationTrack& track);
 
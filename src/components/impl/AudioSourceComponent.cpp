@@ -24,6 +24,7 @@ namespace Engine::Components {
 
 	void AudioSource::OnAdded(Entity& entity)
 	{
+		if (IsHeadless()) return; // no audio device; Play/Stop ignore a null source
 		source = std::make_shared<Audio::SoundSource>(looping);
 	}
 
@@ -54,4 +54,10 @@ namespace Engine::Components {
 			guid = GenerateGUID();
 		}
 	}
+	EntityMetadata::EntityMetadata(std::string name, std::string tag, std::string guid) : name(std::move(name)), tag(std::move(tag)), guid(std::move(guid))
+	{
+		if (this->guid.empty()) {
+			this->guid = GenerateGUID();
+		}
+	}
 } // namespace Engine::Components
\ No newline at end of file
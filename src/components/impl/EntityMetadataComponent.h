@@ -20,10 +20,15 @@ namespace Engine::Components {
 		bool        toBeDestroyedNextUpdate = false;
 		std::string guid;
 
-		// TODO use pointers for runtime?
+		// Persistent links (serialized).
 		EntityHandle              parentEntity;
 		std::vector<EntityHandle> children;
 
+		// Runtime mirrors of the links above (not serialized). Maintained by the
+		// owning Scene and Entity::SetParent; use these for traversal.
+		entt::entity              parent = entt::null;
+		std::vector<entt::entity> childEntities;
+
 		template <class Archive>
 		void serialize(Archive& ar)
 		{
@@ -33,6 +38,8 @@ namespace Engine::Components {
 		EntityMetadata();
 		explicit EntityMetadata(std::string name);
 		explicit EntityMetadata(std::string name, std::string tag);
+		/// Loaders: keeps a stored GUID instead of generating one.
+		EntityMetadata(std::string name, std::string tag, std::string guid);
 
 		void OnAdded(Entity& entity) override;
 		void OnRemoved(Entity& entity) override;
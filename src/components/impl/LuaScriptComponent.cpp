@@ -334,9 +334,9 @@ namespace Engine::Components {
 
 	Entity GetEntityFromHandle(const EntityHandle& handle)
 	{
-		Scene* s = GetCurrentScene();
-		if (s->m_entityMap.count(handle)) {
-			return s->m_entityMap[handle];
+		Entity entity = GetCurrentScene()->Get(handle);
+		if (entity) {
+			return entity;
 		}
 
 		GetScriptManager().log->warn("Script requested an invalid entity: {}", handle.GetID());
@@ -47,6 +47,16 @@ namespace Engine::Components {
 		}
 	}
 
+	void ModelRenderer::Enqueue(Rendering::RenderQueue& queue, const glm::mat4& world, entt::entity entity, float depth, uint8_t pipeline) const
+	{
+		if (!visible || !model.IsValid()) return;
+		const auto* actualModel = GetAssetManager().Get(model);
+		if (!actualModel) return;
+
+		const uint32_t transform = queue.AddTransform(world);
+		actualModel->Enqueue(queue, transform, entity, depth, backfaceCulling, &materialOverrides, pipeline);
+	}
+
 	void ModelRenderer::SetModel(const std::string& path)
 	{
 		SetModel(GetAssetManager().Load<Rendering::Model>(path));
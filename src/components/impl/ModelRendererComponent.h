@@ -35,6 +35,8 @@ namespace Engine::Components {
 		explicit ModelRenderer(const ModelHandle& handle) : model(handle) {}
 		// Draw the model with the given shader and transform
 		void Draw(const Shader& shader, Components::Transform& transform, bool uploadMaterial);
+		// Queue one draw per mesh (material overrides applied); skipped while hidden or unloaded
+		void Enqueue(Rendering::RenderQueue& queue, const glm::mat4& world, entt::entity entity, float depth, uint8_t pipeline = 0) const;
 
 		void SetModel(const std::string& path);
 		void SetModel(const ModelHandle& handle);
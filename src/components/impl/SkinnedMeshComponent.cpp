@@ -20,15 +20,28 @@ namespace Engine::Components {
 	std::unordered_set<std::vector<ozz::math::Float4x4>*> SkinnedMeshComponent::s_skin_mats;
 	std::unordered_set<ozz::vector<Engine::AnimatedMesh>*>        SkinnedMeshComponent::s_all_meshes;
 
+	namespace {
+		/// Drops the static GPU skinning buffers uploaded for these meshes, if a renderer exists.
+		void ReleaseGpuMeshes(const ozz::vector<Engine::AnimatedMesh>& meshes)
+		{
+			if (!Get().animation || !GetAnimationManager().renderer_) return;
+			for (const Engine::AnimatedMesh& mesh : meshes) {
+				GetAnimationManager().renderer_->ReleaseSkinnedMesh(mesh);
+			}
+		}
+	} // namespace
+
 	void SkinnedMeshComponent::FreeMeshes()
 	{
 		if (meshes) {
+			ReleaseGpuMeshes(*meshes);
 			s_all_meshes.erase(meshes);
 			delete meshes;
 			meshes = nullptr;
 		}
 		skin_frame_cache.clear();
 		skin_cache_frame = 0;
+		skinReach        = -1.f;
 	}
 
 	void SkinnedMeshComponent::FreeSkinningMatrices()
@@ -123,6 +136,8 @@ namespace Engine::Components {
 	void SkinnedMeshComponent::RenderInspector(Entity& entity)
 	{
 		LeftLabelCheckbox("Visible", &visible);
+		LeftLabelCheckbox("GPU Skinning", &gpuSkinning);
+		if (LeftLabelDragFloat("Culling Margin", &cullingMargin, 0.01f)) cullingMargin = std::max(cullingMargin, 0.f);
 
 		LeftLabelInputText("Mesh Path", &meshPath);
 		ImGui::SameLine();
@@ -163,6 +178,7 @@ namespace Engine::Components {
 		s_skin_mats.clear();
 
 		for (ozz::vector<Engine::AnimatedMesh>* mesh : s_all_meshes) {
+			ReleaseGpuMeshes(*mesh);
 			delete mesh;
 		}
 		s_all_meshes.clear();
@@ -24,6 +24,17 @@ namespace Engine::Components {
 		uint64_t                           skin_cache_frame = 0;
 		std::string                       meshPath;
         bool visible = true;
+		/// Skin in the vertex shader from a per-frame joint palette; off (or unsupported) uses the CPU skin cache.
+		bool gpuSkinning = true;
+		/// Added to the joint bounds for visibility culling, in model units, for shapes the skin reach misses.
+		float cullingMargin = 0.25f;
+		/// Farthest any bind-pose vertex sits from a joint influencing it; computed on first cull, -1 until then.
+		float skinReach = -1.f;
+		/// AnimationComponent::poseVersion the CPU caches were skinned from; unchanged poses reuse them.
+		uint64_t skinnedPoseVersion = ~uint64_t{0};
+		/// Entity whose caches this one draws this frame (same shared pose and meshPath), entt::null = its own.
+		/// Resolve with AnimationManager::GetSkinFrameCaches.
+		entt::entity skinCacheSource = entt::null;
 
 		MaterialHandle meshMaterial;
 
@@ -51,31 +51,56 @@ namespace Engine::Components {
 		}
 	}
 
+	glm::quat Transform::GetWorldRotation() const
+	{
+		glm::vec3 translation, scale;
+		glm::quat rotation;
+		ExtractTRS(worldMatrix, translation, rotation, scale);
+		return rotation;
+	}
+
+	glm::vec3 Transform::GetWorldScale() const
+	{
+		glm::vec3 translation, scale;
+		glm::quat rotation;
+		ExtractTRS(worldMatrix, translation, rotation, scale);
+		return scale;
+	}
+
 	void Transform::SetLocalFromWorld(const glm::mat4& parentWorld, const glm::vec3& worldPos, const glm::quat& worldRot, const glm::vec3& worldScale)
 	{
 		const glm::mat4 localMatrix = glm::inverse(parentWorld) * ComposeTRS(worldPos, worldRot, worldScale);
 		ExtractTRS(localMatrix, localPosition, localRotation, localScale);
+		MarkDirty();
 	}
 
-	void Transform::SetWorldFromMatrix(const glm::mat4& world)
+	void Transform::SetWorldTRS(const glm::vec3& worldPos, const glm::quat& worldRot, const glm::vec3& worldScl)
 	{
-		worldMatrix = world;
-		ExtractTRS(world, worldPosition, worldRotation, worldScale);
+		const glm::mat4 parentWorld = GetParentWorldMatrix();
+		if (parentWorld == glm::mat4(1.0f)) {
+			// Root (or identity parent): local == world, skip the inverse + decompose.
+			localPosition = worldPos;
+			localRotation = glm::normalize(worldRot);
+			localScale    = worldScl;
+		}
+		else {
+			SetLocalFromWorld(parentWorld, worldPos, worldRot, worldScl);
+		}
+		// Visible right away; the hierarchy pass recomputes children from it.
+		worldMatrix = ComposeTRS(worldPos, worldRot, worldScl);
+		MarkDirty();
 	}
 
 	void Transform::OnAdded(Entity& entity)
 	{
-		worldPosition = localPosition;
-		worldRotation = localRotation;
-		worldScale    = localScale;
-		worldMatrix   = GetLocalMatrix();
+		worldMatrix = GetParentWorldMatrix() * GetLocalMatrix();
 	}
 
 	void Transform::SyncWithPhysics(Entity& entity)
 	{
 		// Use world-space transform
-		glm::vec3 worldPos = worldPosition;
-		glm::quat worldRot = worldRotation;
+		const glm::vec3 worldPos = GetWorldPosition();
+		const glm::quat worldRot = GetWorldRotation();
 
 		if (entity.HasComponent<RigidBodyComponent>()) {
 			auto&          rb             = entity.GetComponent<RigidBodyComponent>();
@@ -105,14 +130,12 @@ namespace Engine::Components {
 
 		ImGui::Checkbox("World Space", &showWorld);
 
-		glm::vec3& pos   = showWorld ? worldPosition : localPosition;
-		glm::quat  rot   = showWorld ? GetWorldRotation() : GetLocalRotation();
-		glm::vec3& scale = showWorld ? worldScale : localScale;
+		glm::vec3 pos   = showWorld ? GetWorldPosition() : localPosition;
+		glm::quat rot   = showWorld ? GetWorldRotation() : GetLocalRotation();
+		glm::vec3 scale = showWorld ? GetWorldScale() : localScale;
 
-		glm::vec3 displayPos = pos;
 		ImGui::PushID("pos");
-		if (LeftLabelDragFloat3("Position", glm::value_ptr(displayPos), 0.1f)) {
-			pos                           = displayPos;
+		if (LeftLabelDragFloat3("Position", glm::value_ptr(pos), 0.1f)) {
 			updatePhysicsPositionManually = true;
 		}
 		ImGui::SameLine();
@@ -135,16 +158,12 @@ namespace Engine::Components {
 		ImGui::PushID("rot");
 		if (LeftLabelDragFloat3("Rotation", glm::value_ptr(cachedEuler), 1.0f)) {
 			rot                           = glm::quat(glm::radians(cachedEuler));
-			if (showWorld) SetWorldRotation(rot);
-			else SetLocalRotation(rot);
 			updatePhysicsPositionManually = true;
 		}
 		ImGui::SameLine();
 		if (ImGui::SmallButton("0##rot")) {
 			rot                           = glm::quat(1, 0, 0, 0);
 			cachedEuler                   = glm::vec3(0.0f);
-			if (showWorld) SetWorldRotation(rot);
-			else SetLocalRotation(rot);
 			updatePhysicsPositionManually = true;
 		}
 		ImGui::PopID();
@@ -160,24 +179,16 @@ namespace Engine::Components {
 		}
 		ImGui::PopID();
 
-		if (showWorld && updatePhysicsPositionManually) {
-			entity.SetWorldTransform(worldPosition, GetWorldRotation(), worldScale);
-			updatePhysicsPositionManually = true;
-		}
-
 		if (updatePhysicsPositionManually) {
-			auto& em           = entity.GetComponent<EntityMetadata>();
-			auto  parentMatrix = glm::mat4(1.0);
-
-			if (em.parentEntity.IsValid()) {
-				Entity parent = GetCurrentScene()->Get(em.parentEntity);
-				if (parent && parent.HasComponent<Transform>()) {
-					auto& parentTr = parent.GetComponent<Transform>();
-					parentMatrix   = parentTr.GetWorldMatrix();
-				}
+			if (showWorld) {
+				SetWorldTRS(pos, rot, scale);
+			}
+			else {
+				SetLocalPosition(pos);
+				SetLocalRotation(rot);
+				SetLocalScale(scale);
+				worldMatrix = GetParentWorldMatrix() * GetLocalMatrix();
 			}
-
-			SetWorldFromMatrix(parentMatrix * GetLocalMatrix());
 			SyncWithPhysics(entity);
 		}
 	}
@@ -221,13 +232,13 @@ namespace Engine::Components {
 		// Transform (world-space access)
 		lua.new_usertype<Transform>("Transform",
 
-		                            // world-space accessors
+		                            // world-space accessors (writes bake into local TRS)
 		                            "position",
-		                            &Transform::worldPosition,
+		                            sol::property(&Transform::GetWorldPosition, &Transform::SetWorldPosition),
 		                            "rotation",
-		                            &Transform::worldRotation,
+		                            sol::property(&Transform::GetWorldRotation, &Transform::SetWorldRotation),
 		                            "scale",
-		                            &Transform::worldScale,
+		                            sol::property(&Transform::GetWorldScale, &Transform::SetWorldScale),
 
 		                            // utility methods
 		                            "setRotation",
@@ -7,6 +7,7 @@
 
 
 #include "components/Components.h"
+#include "core/TransformHierarchy.h"
 
 
 #include <cereal/cereal.hpp>
@@ -21,6 +22,8 @@ namespace Engine {
 		// Transform component for positioning, rotating, and scaling entities (with hierarchy support)
 		class Transform : public Component {
 		  private:
+			friend class Engine::TransformHierarchy;
+
 			// ───────────────────────────────
 			// Local-space properties (serialized)
 			// ───────────────────────────────
@@ -29,33 +32,69 @@ namespace Engine {
 			glm::vec3 localScale    = glm::vec3(1.0f);
 
 			// ───────────────────────────────
-			// World-space (computed, not serialized)
+			// World-space (computed by TransformHierarchy, not serialized).
+			// World T / R / S are decomposed from it on demand.
 			// ───────────────────────────────
-			glm::vec3 worldPosition = glm::vec3(0.0f);
-			glm::quat worldRotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
-			glm::vec3 worldScale    = glm::vec3(1.0f);
-			glm::mat4 worldMatrix   = glm::mat4(1.0f);
+			glm::mat4 worldMatrix = glm::mat4(1.0f);
+
+			// Owning scene's hierarchy, set when the component is constructed in a
+			// registry. Not copied: a copy is a detached value until it is added.
+			TransformHierarchy* m_hierarchy = nullptr;
+			entt::entity        m_entity    = entt::null;
+
+			void MarkDirty()
+			{
+				if (m_hierarchy) m_hierarchy->MarkDirty(m_entity);
+			}
+
+			glm::mat4 GetParentWorldMatrix() const { return m_hierarchy ? m_hierarchy->GetParentWorldMatrix(m_entity) : glm::mat4(1.0f); }
 
 		  public:
-			glm::vec3& GetLocalPosition() { return localPosition; }
-			glm::vec3& GetWorldPosition() { return worldPosition; }
-			glm::quat  GetLocalRotation() { return glm::normalize(localRotation); }
-			glm::quat  GetWorldRotation() { return glm::normalize(worldRotation); }
-			glm::vec3& GetLocalScale() { return localScale; }
-			glm::vec3& GetWorldScale() { return worldScale; }
-
-			glm::mat4& GetWorldMatrix() { return worldMatrix; }
-			void       SetLocalPosition(glm::vec3 newPos) { localPosition = newPos; }
-			void       SetWorldPosition(glm::vec3 newPos) { worldPosition = newPos; }
-			void       SetLocalRotation(glm::quat newRot) { localRotation = glm::normalize(newRot); }
-			void       SetWorldRotation(glm::quat newRot) { worldRotation = glm::normalize(newRot); }
-			void       SetLocalScale(glm::vec3 newScale) { localScale = newScale; }
-			void       SetWorldScale(glm::vec3 newScale) { worldScale = newScale; }
-
-			void SetWorldMatrix(glm::mat4 newWorldMatrix) { worldMatrix = newWorldMatrix; }
-
-			Transform()                       = default;
-			Transform(const Transform& other) = default;
+			const glm::vec3& GetLocalPosition() const { return localPosition; }
+			glm::quat        GetLocalRotation() const { return glm::normalize(localRotation); }
+			const glm::vec3& GetLocalScale() const { return localScale; }
+
+			const glm::mat4& GetWorldMatrix() const { return worldMatrix; }
+			glm::vec3        GetWorldPosition() const { return glm::vec3(worldMatrix[3]); }
+			glm::quat        GetWorldRotation() const;
+			glm::vec3        GetWorldScale() const;
+
+			void SetLocalPosition(glm::vec3 newPos)
+			{
+				localPosition = newPos;
+				MarkDirty();
+			}
+			void SetLocalRotation(glm::quat newRot)
+			{
+				localRotation = glm::normalize(newRot);
+				MarkDirty();
+			}
+			void SetLocalScale(glm::vec3 newScale)
+			{
+				localScale = newScale;
+				MarkDirty();
+			}
+
+			// World-space setters bake into local TRS against the current parent.
+			void SetWorldPosition(glm::vec3 newPos) { SetWorldTRS(newPos, GetWorldRotation(), GetWorldScale()); }
+			void SetWorldRotation(glm::quat newRot) { SetWorldTRS(GetWorldPosition(), newRot, GetWorldScale()); }
+			void SetWorldScale(glm::vec3 newScale) { SetWorldTRS(GetWorldPosition(), GetWorldRotation(), newScale); }
+			void SetWorldTRS(const glm::vec3& worldPos, const glm::quat& worldRot, const glm::vec3& worldScl);
+
+			Transform() = default;
+			Transform(const Transform& other) : Component(other), localPosition(other.localPosition), localRotation(other.localRotation), localScale(other.localScale), worldMatrix(other.worldMatrix) {}
+			Transform(Transform&& other) noexcept = default;
+			Transform& operator=(const Transform& other)
+			{
+				localPosition = other.localPosition;
+				localRotation = other.localRotation;
+				localScale    = other.localScale;
+				worldMatrix   = other.worldMatrix;
+				MarkDirty();
+				return *this;
+			}
+			// Used by the registry when it relocates components; keeps the link.
+			Transform& operator=(Transform&& other) noexcept = default;
 
 			explicit Transform(const glm::vec3& pos) : localPosition(pos) {}
 			explicit Transform(const glm::vec3& pos, const glm::vec3& euler, const glm::vec3& scl = glm::vec3(1.0f)) : localPosition(pos), localRotation(glm::quat(glm::radians(euler))), localScale(scl) {}
@@ -74,7 +113,7 @@ namespace Engine {
 			// ───────────────────────────────
 
 			// Rotation (Euler degrees)
-			void                    SetRotation(const glm::vec3& eulerDegrees) { localRotation = glm::quat(glm::radians(eulerDegrees)); }
+			void                    SetRotation(const glm::vec3& eulerDegrees) { SetLocalRotation(glm::quat(glm::radians(eulerDegrees))); }
 			[[nodiscard]] glm::vec3 GetEulerAngles() const { return glm::degrees(glm::eulerAngles(localRotation)); }
 
 			// Local transform matrix
@@ -94,9 +133,6 @@ namespace Engine {
 			// Bake a world-space pose into local TRS given the parent's world matrix.
 			void SetLocalFromWorld(const glm::mat4& parentWorld, const glm::vec3& worldPos, const glm::quat& worldRot, const glm::vec3& worldScale);
 
-			// Write world cache from a composed world matrix (used by the hierarchy update).
-			void SetWorldFromMatrix(const glm::mat4& world);
-
 
 			// Sync physics
 			void SyncWithPhysics(Entity& entity);
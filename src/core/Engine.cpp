@@ -32,6 +32,7 @@
 #include "assets/impl/ParticleLoader.h"
 #include "assets/impl/MaterialLoader.h"
 #include "assets/impl/BinarySceneLoader.h"
+#include "assets/impl/PackedSceneLoader.h"
 #include "assets/impl/AnimationLoader.h"
 #include "assets/impl/SkeletonLoader.h"
 #include "assets/impl/PrefabLoader.h"
@@ -44,6 +45,8 @@
 #include "utils/Logger.h"
 #include "utils/StartupScene.h"
 #include "assets/AssetWatcher.h"
+#include "core/Replay.h"
+#include "core/FrameTimings.h"
 
 #if defined(__clang__) || defined(__GNUC__)
 #define TracyFunction __PRETTY_FUNCTION__
@@ -59,17 +62,33 @@
 #include "TracyClient.cpp"
 #include "core/ThreadPool.h"
 
+#include <cctype>
+#include <chrono>
 #include <fstream>
+#include <thread>
+#include <unordered_set>
 #include <nlohmann/json.hpp>
 
 namespace fs = std::filesystem;
 
 namespace Engine {
 
-	GEngine::GEngine(int width, int height, const char* title) : m_deltaTime(0.0f), m_lastFrame(0.0f)
+	namespace {
+		/// Terrain tiles page in around the camera through the TerrainStreamer. Headless has no
+		/// terrain module update, so it keeps loading every tile for its heightfield.
+		std::string QueueTerrainTile(const std::string& path)
+		{
+			if (IsHeadless()) return GetAssetManager().LoadAsync<Terrain::TerrainTile>(path).GetID();
+			GetTerrainManager().GetStreamer().AddTile(path);
+			return {};
+		}
+	} // namespace
+
+	GEngine::GEngine(int width, int height, const char* title, bool headless) : m_deltaTime(0.0f), m_lastFrame(0.0f)
 	{
 		ZoneScopedN("Engine Awake");
 		SetState(EDITOR);
+		Get().headless = headless;
 
 		m_moduleManager = std::make_unique<ModuleManager>();
 		Get().manager   = m_moduleManager.get();
@@ -111,6 +130,29 @@ namespace Engine {
 
 		// Register Modules to handle lifecycle
 		auto& modules = *m_moduleManager;
+		if (headless) {
+			// CPU modules only. The rest stay constructed so accessors and Lua bindings
+			// resolve, but they never touch GLFW, GL or OpenAL. No asset hot reload either.
+			GetDefaultLogger()->info("Running headless");
+			modules.RegisterExternal(Get().script);
+			modules.RegisterExternal(Get().input);
+			modules.RegisterExternal(Get().camera);
+			modules.RegisterExternal(Get().physics);
+			modules.RegisterExternal(Get().animation);
+			modules.RegisterExternal(Get().scene);
+
+			modules.RegisterStandIn(Get().window);
+			modules.RegisterStandIn(Get().sound);
+#ifndef GAME_BUILD
+			modules.RegisterStandIn(Get().ui);
+#endif
+			modules.RegisterStandIn(Get().gameUI);
+			modules.RegisterStandIn(Get().particle);
+			modules.RegisterStandIn(Get().renderer);
+			modules.RegisterStandIn(Get().terrain);
+			return;
+		}
+
 		modules.RegisterExternal(Get().script); // ScriptManager must run first to clear subscriptions before UI reloads
 		modules.RegisterExternal(Get().window);
 		modules.RegisterExternal(Get().input);
@@ -151,6 +193,9 @@ namespace Engine {
 			ZoneScopedN("InitAllLuaBindings");
 			m_moduleManager->InitAllLuaBindings();
 		}
+		if (!SetupReplay()) {
+			return false;
+		}
 		{
 			ZoneScopedN("Init All Modules");
 			m_moduleManager->InitAll();
@@ -165,16 +210,30 @@ namespace Engine {
 #ifdef GAME_BUILD
 			const std::string startupScene = ReadStartupScenePath();
 			GetDefaultLogger()->info("Loading game scene: {}", startupScene);
-			GetSceneManager().SetActiveScene(GetAssetManager().Load<Scene>(startupScene));
+			LoadStartupScene(startupScene);
 #else
-			GetSceneManager().SetActiveScene(GetAssetManager().Load<Scene>(SCENE1));
+			LoadStartupScene(SCENE1);
 #endif
 		}
 
-#ifdef GAME_BUILD
-		SetState(PLAYING);
-		Get().manager->StartGame();
+		if (m_replay || m_recorder) {
+			// Same resident assets at frame 0 in both runs; streaming would make frame cost depend on disk timing.
+			ZoneScopedN("Wait For All Assets");
+			std::vector<std::string> guids;
+			guids.reserve(m_assetPaths.size());
+			for (const auto& [guid, path] : m_assetPaths)
+				guids.push_back(guid);
+			GetAssetManager().WaitFor(guids);
+		}
+
+#ifndef GAME_BUILD
+		// There is no editor to press play in (headless), and editor UI clicks are not recorded.
+		if (IsHeadless() || m_replay || m_recorder)
 #endif
+		{
+			SetState(PLAYING);
+			Get().manager->StartGame();
+		}
 
 		return true;
 	}
@@ -182,46 +241,63 @@ namespace Engine {
 
 	void GEngine::LoadGameAssets()
 	{
-		using LoaderFn = std::function<void(const std::string&)>;
+#ifdef GAME_BUILD
+		// BuildGame cooks everything into one pack; its table replaces the directory walk and .meta reads.
+		if (GetAssetManager().MountPack(kAssetPackPath)) {
+			LoadPackedAssets();
+			return;
+		}
+		GetDefaultLogger()->warn("No {} next to the game, loading source assets", kAssetPackPath);
+#endif
+		// Everything is queued with LoadAsync (types without async support load inline);
+		// each returns the asset's GUID, or "" if nothing was queued.
+		using LoaderFn = std::function<std::string(const std::string&)>;
 
 		// .ozz is shared by clips / skeletons / skinned meshes — only auto-load
 		// files whose .meta type is Animation or Skeleton.
-		auto loadOzzByMeta = [](const std::string& p) {
+		auto loadOzzByMeta = [](const std::string& p) -> std::string {
 			const std::string metaPath = p + ".meta";
-			if (!fs::exists(metaPath)) return;
+			if (!fs::exists(metaPath)) return {};
 			try {
 				std::ifstream file(metaPath);
 				nlohmann::json j;
 				file >> j;
-				if (!j.contains("type")) return;
+				if (!j.contains("type")) return {};
 				const std::string type = j["type"].get<std::string>();
 				if (type.find("Skeleton") != std::string::npos) {
-					GetAssetManager().Load<Skeleton>(p);
+					return GetAssetManager().LoadAsync<Skeleton>(p).GetID();
 				}
 				else if (type.find("Animation") != std::string::npos && type.find("offline") == std::string::npos) {
-					GetAssetManager().Load<Animation>(p);
+					return GetAssetManager().LoadAsync<Animation>(p).GetID();
 				}
 			}
 			catch (...) {
 				// ignore malformed meta
 			}
+			return {};
 		};
 
 		std::unordered_map<std::string, LoaderFn> loaders = {
-		    {".png", [this](const std::string& p) { GetAssetManager().Load<Texture>(p); }},
-		    {".jpg", [this](const std::string& p) { GetAssetManager().Load<Texture>(p); }},
-		    {".jpeg", [this](const std::string& p) { GetAssetManager().Load<Texture>(p); }},
-		    {".dds", [this](const std::string& p) { GetAssetManager().Load<Texture>(p); }},
-		    {".material", [this](const std::string& p) { GetAssetManager().Load<Material>(p); }},
-		    {".obj", [this](const std::string& p) { GetAssetManager().Load<Rendering::Model>(p); }},
-		    {".wav", [this](const std::string& p) { GetAssetManager().Load<Audio::SoundBuffer>(p); }},
-		    {".anim", [this](const std::string& p) { GetAssetManager().Load<Animation>(p); }},
-		    {".ozz", [loadOzzByMeta](const std::string& p) { loadOzzByMeta(p); }},
-		    {".bin", [this](const std::string& p) { GetAssetManager().Load<Terrain::TerrainTile>(p); }},
-		    {".efk", [this](const std::string& p) { GetAssetManager().Load<Particle>(p); }},
-		    {".prefab", [this](const std::string& p) { GetAssetManager().Load<Prefab>(p); }},
+		    {".png", [](const std::string& p) { return GetAssetManager().LoadAsync<Texture>(p).GetID(); }},
+		    {".jpg", [](const std::string& p) { return GetAssetManager().LoadAsync<Texture>(p).GetID(); }},
+		    {".jpeg", [](const std::string& p) { return GetAssetManager().LoadAsync<Texture>(p).GetID(); }},
+		    {".dds", [](const std::string& p) { return GetAssetManager().LoadAsync<Texture>(p).GetID(); }},
+		    {".material", [](const std::string& p) { return GetAssetManager().LoadAsync<Material>(p).GetID(); }},
+		    {".obj", [](const std::string& p) { return GetAssetManager().LoadAsync<Rendering::Model>(p).GetID(); }},
+		    {".wav", [](const std::string& p) { return GetAssetManager().LoadAsync<Audio::SoundBuffer>(p).GetID(); }},
+		    {".anim", [](const std::string& p) { return GetAssetManager().LoadAsync<Animation>(p).GetID(); }},
+		    {".ozz", [loadOzzByMeta](const std::string& p) { return loadOzzByMeta(p); }},
+		    {".bin", [](const std::string& p) { return QueueTerrainTile(p); }},
+		    {".efk", [](const std::string& p) { return GetAssetManager().LoadAsync<Particle>(p).GetID(); }},
+		    {".prefab", [](const std::string& p) { return GetAssetManager().LoadAsync<Prefab>(p).GetID(); }},
 		};
 
+		// Headless: textures, sounds and particle effects only exist on the GPU / audio device.
+		if (IsHeadless()) {
+			for (const char* ext : {".png", ".jpg", ".jpeg", ".dds", ".wav", ".efk"})
+				loaders.erase(ext);
+		}
+
 		auto loadFromAssetSubfolder = [&](const std::string& assetSubfolder) {
 			int loadedCount = 0;
 
@@ -263,7 +339,8 @@ namespace Engine {
 
 
 						try {
-							it->second(finalPath);
+							std::string guid = it->second(finalPath);
+							if (!guid.empty()) m_assetPaths[guid] = finalPath;
 							loadedCount++;
 						}
 						catch (const std::exception& e) {
@@ -282,8 +359,6 @@ namespace Engine {
 		loadFromAssetSubfolder("assets");
 
 
-		// TODO store assets to be loaded at the start in scene json
-
 		// TODO terrain instanced detail rendereing
 		// TODO terrain mesh shape?? maybe component
 
@@ -318,23 +393,190 @@ namespace Engine {
 		//		}
 	}
 
+	void GEngine::LoadPackedAssets()
+	{
+		using AssetPackFormat::AssetType;
+		const AssetPack& pack = *GetAssetManager().GetPack();
+
+		for (uint32_t i = 0; i < pack.EntryCount(); ++i) {
+			const AssetPack::Entry& entry = pack.GetEntry(i);
+			const std::string       path(pack.Path(entry));
+
+			// Headless: textures, sounds and particle effects only exist on the GPU / audio device.
+			if (IsHeadless() && (entry.type == AssetType::Texture || entry.type == AssetType::Sound || entry.type == AssetType::Particle)) continue;
+
+			std::string guid;
+			switch (entry.type) {
+				case AssetType::Texture: guid = GetAssetManager().LoadAsync<Texture>(path).GetID(); break;
+				case AssetType::Model: guid = GetAssetManager().LoadAsync<Rendering::Model>(path).GetID(); break;
+				case AssetType::Sound: guid = GetAssetManager().LoadAsync<Audio::SoundBuffer>(path).GetID(); break;
+				case AssetType::Material: guid = GetAssetManager().LoadAsync<Material>(path).GetID(); break;
+				case AssetType::Animation: guid = GetAssetManager().LoadAsync<Animation>(path).GetID(); break;
+				case AssetType::Skeleton: guid = GetAssetManager().LoadAsync<Skeleton>(path).GetID(); break;
+				case AssetType::Prefab: guid = GetAssetManager().LoadAsync<Prefab>(path).GetID(); break;
+				case AssetType::Terrain: guid = QueueTerrainTile(path); break;
+				case AssetType::Particle: guid = GetAssetManager().LoadAsync<Particle>(path).GetID(); break;
+			}
+			if (!guid.empty()) m_assetPaths[guid] = path;
+		}
+		GetDefaultLogger()->info("Queued {} assets from {}", m_assetPaths.size(), kAssetPackPath);
+	}
+
+	std::vector<std::string> GEngine::CollectSceneAssets(const std::string& scenePath) const
+	{
+		auto isHex = [](char c) { return std::isxdigit(static_cast<unsigned char>(c)) != 0; };
+
+		std::vector<std::string>        guids;
+		std::unordered_set<std::string> seen;
+		std::vector<std::string>        files = {scenePath};
+
+		// Handles serialize as bare 32-hex-digit GUIDs in both JSON and binary scenes;
+		// anything that isn't a known asset GUID (entity ids, etc.) is skipped.
+		while (!files.empty()) {
+			const std::string file = std::move(files.back());
+			files.pop_back();
+
+			std::ifstream in(file, std::ios::binary);
+			if (!in) continue;
+			const std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+			for (size_t i = 0; i + 32 <= data.size();) {
+				if (!isHex(data[i]) || (i > 0 && isHex(data[i - 1]))) {
+					++i;
+					continue;
+				}
+				size_t end = i;
+				while (end < data.size() && isHex(data[end]))
+					++end;
+				if (end - i == 32) {
+					std::string guid = data.substr(i, 32);
+					auto        it   = m_assetPaths.find(guid);
+					if (it != m_assetPaths.end() && seen.insert(guid).second) {
+						guids.push_back(guid);
+						if (fs::path(it->second).extension() == ".prefab") files.push_back(it->second);
+					}
+				}
+				i = end;
+			}
+		}
+		return guids;
+	}
+
+	void GEngine::LoadStartupScene(const std::string& scenePath)
+	{
+		{
+			ZoneScopedN("Wait For Scene Assets");
+			const std::vector<std::string> guids = CollectSceneAssets(scenePath);
+			GetDefaultLogger()->info("Startup scene references {} of {} assets; the rest stream in", guids.size(), m_assetPaths.size());
+			GetAssetManager().WaitFor(guids);
+		}
+		GetSceneManager().SetActiveScene(GetAssetManager().Load<Scene>(scenePath));
+	}
+
 	void GEngine::Run()
 	{
-		while (!GetWindow().ShouldClose()) {
+		if (IsHeadless()) {
+			RunHeadless();
+			FinishRun();
+			return;
+		}
+
+		while (!GetWindow().ShouldClose() && !m_stopRequested.load(std::memory_order_relaxed)) {
         TracyCFrameMark
 			//FrameMarkStart("main");
 			auto currentFrame = static_cast<float>(glfwGetTime());
 			m_deltaTime       = currentFrame - m_lastFrame;
 			m_lastFrame       = currentFrame;
 
-			GetAssetManager().Update();
-			m_moduleManager->UpdateAll(m_deltaTime);
-			Get().stepOneFrame = false;
+			if (!Tick(m_deltaTime)) break;
 			//FrameMarkEnd("main");
 		}
+		FinishRun();
+	}
+
+	bool GEngine::SetupReplay()
+	{
+		auto& script = GetScriptManager();
+		if (!replayPath.empty()) {
+			m_replay = std::make_unique<ReplayReader>();
+			if (!m_replay->Open(replayPath)) return false;
+			script.SetRandomSeed(m_replay->Seed());
+		}
+		if (!recordPath.empty()) {
+			m_recorder = std::make_unique<ReplayWriter>();
+			if (!m_recorder->Open(recordPath, script.GetRandomSeed())) return false;
+		}
+		if (!reportPath.empty()) {
+			m_timings = std::make_unique<FrameTimings>();
+			m_moduleManager->SetTaskTimingEnabled(true);
+		}
+		return true;
+	}
+
+	bool GEngine::Tick(float dt)
+	{
+		if (m_replay) {
+			ReplayFrame frame;
+			if (!m_replay->Next(frame)) return false;
+			dt = frame.dt;
+			GetInput().InjectDeviceState(frame.input);
+		}
+
+		const auto start = std::chrono::steady_clock::now();
+		GetAssetManager().Update();
+		m_moduleManager->UpdateAll(dt);
+		Get().stepOneFrame = false;
+
+		if (m_timings) {
+			const float frameMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+			m_timings->AddFrame(frameMs, m_moduleManager->GetScheduledTasks(), m_moduleManager->GetTaskTimesMs());
+		}
+		if (m_recorder) m_recorder->Write({dt, GetInput().GetDeviceState()});
+		return true;
+	}
+
+	void GEngine::FinishRun()
+	{
+		if (m_replay) GetDefaultLogger()->info("Replayed {} of {} frames", m_replay->Position(), m_replay->FrameCount());
+		if (m_recorder) m_recorder->Close();
+		if (m_timings) m_timings->WriteReport(reportPath, {replayPath, GetScriptManager().GetRandomSeed(), IsHeadless()});
 	}
 
 
+	void GEngine::RunHeadless()
+	{
+		using Clock = std::chrono::steady_clock;
+
+		const bool  throttled = tickRate > 0.0f;
+		const float dt        = throttled ? 1.0f / tickRate : 1.0f / 60.0f;
+		const auto  tick      = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(dt));
+
+		GetDefaultLogger()->info("Headless loop: {} ticks/s, dt {:.4f}s, limit {}", tickRate, dt, maxTicks);
+
+		const auto start = Clock::now();
+		auto       next  = start;
+		uint64_t   ticks = 0;
+		while (!m_stopRequested.load(std::memory_order_relaxed) && (maxTicks == 0 || ticks < maxTicks)) {
+			TracyCFrameMark
+			if (!Tick(dt)) break;
+			++ticks;
+
+			if (!throttled) continue;
+			next += tick;
+			const auto now = Clock::now();
+			if (now < next) {
+				std::this_thread::sleep_until(next);
+			}
+			else if (now - next > tick * 4) {
+				// Too far behind to catch up; keep the fixed dt and drop the backlog.
+				next = now;
+			}
+		}
+
+		const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+		GetDefaultLogger()->info("Headless loop ran {} ticks in {:.3f}s ({:.3f} ms/tick)", ticks, seconds, ticks ? seconds * 1000.0 / static_cast<double>(ticks) : 0.0);
+	}
+
 	void GEngine::Shutdown()
 	{
 		Components::AnimationComponent::CleanAnimationContexts();
@@ -358,7 +600,6 @@ namespace Engine {
 					}
 				}
 				scene->m_entityList.clear();
-				scene->m_entityMap.clear();
 			}
 		}
 
@@ -2,13 +2,21 @@
 
 
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include <spdlog/spdlog.h>
 
 namespace Engine {
 	class HotReloadWatcher;
 	class ModuleManager;
 	class Entity;
+	class ReplayWriter;
+	class ReplayReader;
+	class FrameTimings;
 }
 
 namespace efsw {
@@ -27,8 +35,9 @@ namespace Engine {
 		 * @param width The width of the window in pixels.
 		 * @param height The height of the window in pixels.
 		 * @param title The window title.
+		 * @param headless Run without window, GL or audio: only CPU modules are initialized and updated.
 		 */
-		GEngine(int width, int height, const char* title);
+		GEngine(int width, int height, const char* title, bool headless = false);
 
 		/**
 		 * @brief Destroys the engine instance.
@@ -51,9 +60,40 @@ namespace Engine {
 		 */
 		void Shutdown();
 
+		/**
+		 * @brief Ask Run() to return after the current frame. Safe to call from a signal handler.
+		 */
+		void RequestStop() { m_stopRequested.store(true, std::memory_order_relaxed); }
+
+		/// Headless only: simulation ticks per second (<= 0 = as fast as possible).
+		float tickRate = 60.0f;
+		/// Headless only: stop after this many ticks (0 = run until RequestStop()).
+		uint64_t maxTicks = 0;
+
+		/// Record every frame's dt, input and the script random seed to this file.
+		std::string recordPath;
+		/// Drive the engine from a recording instead of the clock and devices; Run() returns at its end.
+		std::string replayPath;
+		/// Write per-frame / per-module-task timings (mean, p50, p99) as JSON when Run() returns.
+		std::string reportPath;
+
 
 	  private:
 		void LoadGameAssets();
+		/// Game builds: queue every asset listed in the mounted pack, by type, without touching the disk.
+		void LoadPackedAssets();
+		/// GUIDs referenced by `scenePath`, directly or through the prefabs it uses.
+		std::vector<std::string> CollectSceneAssets(const std::string& scenePath) const;
+		/// Load `scenePath` once the assets it references are resident; the rest keep streaming.
+		void LoadStartupScene(const std::string& scenePath);
+		/// Fixed-tick loop without GLFW: every module update gets dt = 1 / tickRate.
+		void RunHeadless();
+		/// Open the replay / recording / timing report requested in the public paths.
+		bool SetupReplay();
+		/// One frame. Replays substitute the recorded dt and input; false once the replay is over.
+		bool Tick(float dt);
+		/// Close the recording and write the timing report.
+		void FinishRun();
 
 		std::shared_ptr<spdlog::logger> m_logger; ///< Logger instance.
 
@@ -61,6 +101,13 @@ namespace Engine {
 		float m_lastFrame; ///< Timestamp of last frame.
 
 		std::unique_ptr<ModuleManager> m_moduleManager;
+		std::atomic<bool>              m_stopRequested{false};
+
+		std::unordered_map<std::string, std::string> m_assetPaths; ///< GUID -> path of every asset queued at startup.
+
+		std::unique_ptr<ReplayWriter> m_recorder;
+		std::unique_ptr<ReplayReader> m_replay;
+		std::unique_ptr<FrameTimings> m_timings;
 
 		std::unique_ptr<efsw::FileWatcher> m_assetFileWatcher;
 		std::unique_ptr<HotReloadWatcher>  m_assetWatcher;
@@ -13,7 +13,7 @@
 #define SCENE_LOADER JSONSceneLoader
 #define SCENE1 "scenes/scene1.json"
 #else
-#define SCENE_LOADER BinarySceneLoader
+#define SCENE_LOADER PackedSceneLoader
 #define SCENE1 "scenes/scene1.bin"
 #endif
 
@@ -63,6 +63,7 @@ namespace Engine {
 		std::unique_ptr<ThreadPool>              threadPool;
 		EngineState                              state;
 		bool                                     stepOneFrame = false;
+		bool                                     headless     = false; ///< No window, GL context or audio device.
         RenderSettings*                          renderSettings;
 		ModuleManager*                           manager;
 	};
@@ -89,6 +90,13 @@ namespace Engine {
 		Get().state = st;
 	}
 
+	/// True when running without a window, GL context or audio device (dedicated server / CI).
+	/// Render, audio and UI modules exist but are never initialized or updated.
+	inline bool IsHeadless()
+	{
+		return Get().headless;
+	}
+
 	inline bool IsSimulating()
 	{
 		return Get().state == PLAYING || Get().stepOneFrame;
@@ -4,6 +4,7 @@
 #include "EntityHandle.h"
 #include "components/impl/EntityMetadataComponent.h"
 #include "components/AllComponents.h"
+#include "core/TransformHierarchy.h"
 
 #include "glm/gtx/matrix_decompose.inl"
 
@@ -15,17 +16,17 @@ namespace Engine {
 		entt::entity entityHandle = scene->GetRegistry()->create();
 		Entity       entity(entityHandle, scene);
 
-		// Add default components
-		auto& meta = entity.AddComponent<Components::EntityMetadata>(name);
+		// Add default components (this also registers the GUID with the scene)
+		entity.AddComponent<Components::EntityMetadata>(name);
 
 		scene->m_entityList.push_back(entity);
-		scene->m_entityMap[EntityHandle(meta.guid)] = entity;
 
 		return entity;
 	}
 
 	void Entity::MarkForDestruction()
 	{
+		if (!m_scene) return;
 		auto reg = m_scene->GetRegistry();
 
 		if (reg->valid(GetENTTHandle())) {
@@ -35,16 +36,14 @@ namespace Engine {
 
 
 				// remove as child of parent
-				EntityHandle parentHandle = em.parentEntity;
-				if (parentHandle.IsValid()) {
-					Entity parent = GetCurrentScene()->Get(parentHandle);
-					parent.RemoveChild(GetEntityHandle());
+				if (em.parent != entt::null) {
+					Entity(em.parent, m_scene).RemoveChild(GetEntityHandle());
 				}
 
 				// remove as parent of children
-				for (auto& c : em.children) {
-					Entity e = GetCurrentScene()->Get(c);
-					e.SetParent(EntityHandle()); // unparent
+				const std::vector<entt::entity> children = em.childEntities;
+				for (entt::entity c : children) {
+					Entity(c, m_scene).SetParent(EntityHandle()); // unparent
 				}
 			}
 		}
@@ -53,32 +52,23 @@ namespace Engine {
 
 	void Entity::Destroy()
 	{
+		if (!m_scene) return;
 		auto reg = m_scene->GetRegistry();
 
 		if (reg->valid(GetENTTHandle())) {
 			if (HasComponent<Components::EntityMetadata>()) {
-				auto&        em           = GetComponent<Components::EntityMetadata>();
-
-                std::vector<EntityHandle> entitiesToRemove;
-                entitiesToRemove.insert(entitiesToRemove.end(), em.children.begin(), em.children.end());
-
-                for(auto& childHandle : entitiesToRemove){
-					Entity child = GetCurrentScene()->Get(childHandle);
-                    child.Destroy();
-                }
+				const std::vector<entt::entity> children = GetComponent<Components::EntityMetadata>().childEntities;
+				for (entt::entity c : children) {
+					Entity(c, m_scene).Destroy();
+				}
 
-				EntityHandle parentHandle = em.parentEntity;
-				if (parentHandle.IsValid()) {
-					Entity parent = GetCurrentScene()->Get(parentHandle);
-					parent.RemoveChild(GetEntityHandle());
+				// Re-fetch: destroying children may have moved this component in storage.
+				auto& em = GetComponent<Components::EntityMetadata>();
+				if (em.parent != entt::null) {
+					Entity(em.parent, m_scene).RemoveChild(GetEntityHandle());
 				}
 
 				em.OnRemoved(*this);
-				for (auto& c : em.children) {
-					Entity e = GetCurrentScene()->Get(c);
-					e.SetParent(EntityHandle()); // unparent
-					e.Destroy();
-				}
 			}
 
 #define X(type, name, fancy)                                                                                                                                                                                                                   \
@@ -138,47 +128,46 @@ namespace Engine {
 
 	void Entity::SetParent(const EntityHandle& newParent)
 	{
-		auto& registry = GetCurrentSceneRegistry();
+		auto& registry = *m_scene->GetRegistry();
 
 
 		auto&        childHierarchy = registry.get<Components::EntityMetadata>(m_handle);
 		EntityHandle childHandle    = EntityHandle(childHierarchy.guid);
 
+		// Every path below rewrites parentEntity.
+		m_scene->GetTransformHierarchy().MarkStructureDirty();
 
 		// --- 1. Remove from old parent's children list ---
-		if (childHierarchy.parentEntity.IsValid()) {
-			Entity childHParent = GetCurrentScene()->Get(childHierarchy.parentEntity);
-
-			if (childHParent) {
-				auto& oldParentData = childHParent.GetComponent<Components::EntityMetadata>();
-
-				oldParentData.children.erase(std::remove(oldParentData.children.begin(), oldParentData.children.end(), childHandle), oldParentData.children.end());
-			}
+		if (childHierarchy.parent != entt::null && registry.valid(childHierarchy.parent)) {
+			Entity(childHierarchy.parent, m_scene).RemoveChild(childHandle);
 		}
 
 		// parent is empty
 		if (!newParent.IsValid()) {
 			childHierarchy.parentEntity = EntityHandle();
+			childHierarchy.parent       = entt::null;
 			GetDefaultLogger()->info("empty parent");
 			return;
 		}
-		Entity par   = GetCurrentScene()->Get(newParent);
-		Entity child = GetCurrentScene()->Get(childHandle);
+		Entity par = m_scene->Get(newParent);
 
-		// entity does not exist, just set to root
-		if (!par) {
+		// entity does not exist (or is this entity), just set to root
+		if (!par || par == *this) {
 			childHierarchy.parentEntity = EntityHandle();
+			childHierarchy.parent       = entt::null;
 			GetDefaultLogger()->info("bad parent");
 			return;
 		}
 
 		// --- 2. Update parent link ---
 		childHierarchy.parentEntity = newParent;
+		childHierarchy.parent       = par.GetENTTHandle();
 
 		// --- 3. Add to new parent's children list ---
 
 		auto& newParentData = par.GetComponent<Components::EntityMetadata>();
 		newParentData.children.push_back(childHandle);
+		newParentData.childEntities.push_back(m_handle);
 
 		if (HasComponent<Components::Transform>()) {
 			auto& childTr = registry.get<Components::Transform>(m_handle);
@@ -232,28 +221,7 @@ namespace Engine {
 			return;
 		}
 
-		auto& hr = GetComponent<Components::EntityMetadata>();
-		auto& tr = GetComponent<Components::Transform>();
-
-		if (!hr.parentEntity.IsValid()) {
-			tr.SetLocalPosition(worldPosition);
-			tr.SetLocalRotation(worldRotation);
-			tr.SetLocalScale(worldScale);
-		}
-		else {
-			auto parentEntity = GetCurrentScene()->Get(hr.parentEntity);
-			if (parentEntity && parentEntity.HasComponent<Engine::Components::Transform>()) {
-				auto& parentTr = parentEntity.GetComponent<Engine::Components::Transform>();
-				tr.SetLocalFromWorld(parentTr.GetWorldMatrix(), worldPosition, worldRotation, worldScale);
-			}
-			else {
-				tr.SetLocalPosition(worldPosition);
-				tr.SetLocalRotation(worldRotation);
-				tr.SetLocalScale(worldScale);
-			}
-		}
-
-		tr.SetWorldFromMatrix(Components::Transform::ComposeTRS(worldPosition, worldRotation, worldScale));
+		GetComponent<Components::Transform>().SetWorldTRS(worldPosition, worldRotation, worldScale);
 	}
 	std::vector<EntityHandle> Entity::GetChildren()
 	{
@@ -271,6 +239,10 @@ namespace Engine {
 
 		auto it = std::find(v.begin(), v.end(), handle);
 		if (it != v.end()) v.erase(it);
+
+		const entt::entity child = m_scene->Find(handle);
+		auto&              links = meta.childEntities;
+		links.erase(std::remove(links.begin(), links.end(), child), links.end());
 	}
 
 
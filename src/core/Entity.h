@@ -67,7 +67,7 @@ namespace Engine {
 		[[maybe_unused]] void SetActive(bool active);
 
 
-		Scene* m_scene;
+		Scene* m_scene = nullptr;
 
 	  private:
 		entt::entity m_handle{entt::null};
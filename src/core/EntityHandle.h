@@ -5,19 +5,39 @@
 #ifndef CPP_ENGINE_ENTITYHANDLE_H
 #define CPP_ENGINE_ENTITYHANDLE_H
 
+#include <cstdint>
+#include <string>
 #include <utility>
+#include <vector>
+
 namespace Engine {
+	/// Persistent reference to an entity by GUID. The GUID is hashed once on
+	/// construction into a 64-bit runtime id, which is what Scene lookups use.
 	class EntityHandle {
 		std::string guid;
+		uint64_t    runtimeId = 0;
 
 	  public:
 		EntityHandle() = default;
-		explicit EntityHandle(std::string guid) : guid(std::move(guid)) {}
+		explicit EntityHandle(std::string guid) : guid(std::move(guid)), runtimeId(HashGuid(this->guid)) {}
 		[[nodiscard]] const std::string& GetID() const { return guid; }
+		[[nodiscard]] uint64_t           GetRuntimeID() const { return runtimeId; }
 		[[nodiscard]] bool               IsValid() const { return !guid.empty(); }
 
-		bool operator==(const EntityHandle& other) const { return guid == other.guid; }
+		bool operator==(const EntityHandle& other) const { return runtimeId == other.runtimeId && guid == other.guid; }
 		bool operator<(const EntityHandle& other) const { return guid < other.guid; }
+
+		/// FNV-1a 64. Never returns 0, which is reserved for the empty handle.
+		static uint64_t HashGuid(const std::string& guid)
+		{
+			if (guid.empty()) return 0;
+			uint64_t hash = 14695981039346656037ull;
+			for (const char c : guid) {
+				hash ^= static_cast<uint8_t>(c);
+				hash *= 1099511628211ull;
+			}
+			return hash != 0 ? hash : 1;
+		}
 	};
 
 	using EntityHandleList = std::vector<EntityHandle>;
@@ -0,0 +1,85 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#include "EntityIndex.h"
+
+#include <algorithm>
+
+#include "utils/Utils.h"
+
+namespace Engine {
+
+	namespace {
+		constexpr size_t kMinCapacity = 64;
+
+		size_t NextPowerOfTwo(size_t n)
+		{
+			size_t p = kMinCapacity;
+			while (p < n) p <<= 1;
+			return p;
+		}
+	} // namespace
+
+	void EntityIndex::Reserve(size_t count)
+	{
+		// Keep the load factor at or below 1/2 so probe runs stay short.
+		const size_t capacity = NextPowerOfTwo(count * 2);
+		if (capacity > m_slots.size()) Rehash(capacity);
+	}
+
+	void EntityIndex::Add(uint64_t id, entt::entity entity)
+	{
+		ENGINE_ASSERT(id != 0, "EntityIndex: id 0 is reserved");
+		if ((m_count + 1) * 2 > m_slots.size()) Rehash(NextPowerOfTwo((m_count + 1) * 2));
+
+		size_t slot = id & m_mask;
+		while (m_slots[slot].id != 0) slot = (slot + 1) & m_mask;
+		m_slots[slot] = Slot{id, entity};
+		m_count++;
+	}
+
+	void EntityIndex::Erase(uint64_t id, entt::entity entity)
+	{
+		if (id == 0 || m_count == 0) return;
+
+		size_t slot = id & m_mask;
+		while (m_slots[slot].id != id || m_slots[slot].entity != entity) {
+			if (m_slots[slot].id == 0) return;
+			slot = (slot + 1) & m_mask;
+		}
+
+		// Backward-shift: pull later entries of the probe run into the hole so
+		// lookups never need tombstones.
+		size_t hole = slot;
+		for (size_t next = (hole + 1) & m_mask; m_slots[next].id != 0; next = (next + 1) & m_mask) {
+			const size_t home = m_slots[next].id & m_mask;
+			// Move `next` if its home slot is not in the cyclic range (hole, next].
+			const bool inRange = hole <= next ? (home > hole && home <= next) : (home > hole || home <= next);
+			if (!inRange) {
+				m_slots[hole] = m_slots[next];
+				hole          = next;
+			}
+		}
+		m_slots[hole] = Slot{};
+		m_count--;
+	}
+
+	void EntityIndex::Clear()
+	{
+		std::fill(m_slots.begin(), m_slots.end(), Slot{});
+		m_count = 0;
+	}
+
+	void EntityIndex::Rehash(size_t capacity)
+	{
+		std::vector<Slot> old = std::move(m_slots);
+		m_slots.assign(capacity, Slot{});
+		m_mask  = capacity - 1;
+		m_count = 0;
+		for (const Slot& s : old) {
+			if (s.id != 0) Add(s.id, s.entity);
+		}
+	}
+
+} // namespace Engine
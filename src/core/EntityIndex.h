@@ -0,0 +1,73 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "entt/entt.hpp"
+
+namespace Engine {
+
+	/// Open-addressed runtime id → entt::entity table (linear probing,
+	/// backward-shift deletion, no tombstones). Find is const and touches no
+	/// shared state, so any number of threads may look up while nobody inserts.
+	///
+	/// Ids are hashes and may collide, so several entries can share one. The
+	/// caller's `match(entity)` tells them apart (Scene compares the GUID).
+	class EntityIndex {
+	  public:
+		EntityIndex() = default;
+
+		void Reserve(size_t count);
+		/// Overwrites the entry of `id` that `match` accepts, else adds one. id 0 is reserved for "no entity".
+		template <class Match>
+		void Insert(uint64_t id, entt::entity entity, Match&& match)
+		{
+			if (m_count != 0) {
+				for (size_t slot = id & m_mask; m_slots[slot].id != 0; slot = (slot + 1) & m_mask) {
+					Slot& s = m_slots[slot];
+					if (s.id == id && match(s.entity)) {
+						s.entity = entity;
+						return;
+					}
+				}
+			}
+			Add(id, entity);
+		}
+		/// Remove the entry of `id` that holds `entity`.
+		void Erase(uint64_t id, entt::entity entity);
+		void Clear();
+
+		/// First entity under `id` that `match` accepts.
+		template <class Match>
+		[[nodiscard]] entt::entity Find(uint64_t id, Match&& match) const
+		{
+			if (id == 0 || m_count == 0) return entt::null;
+			for (size_t slot = id & m_mask;; slot = (slot + 1) & m_mask) {
+				const Slot& s = m_slots[slot];
+				if (s.id == id && match(s.entity)) return s.entity;
+				if (s.id == 0) return entt::null;
+			}
+		}
+
+		[[nodiscard]] size_t Size() const { return m_count; }
+
+	  private:
+		struct Slot {
+			uint64_t     id     = 0;
+			entt::entity entity = entt::null;
+		};
+
+		/// Append a new entry, never overwriting.
+		void Add(uint64_t id, entt::entity entity);
+		void Rehash(size_t capacity);
+
+		std::vector<Slot> m_slots;
+		size_t            m_mask  = 0;
+		size_t            m_count = 0;
+	};
+
+} // namespace Engine
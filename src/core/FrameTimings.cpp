@@ -0,0 +1,79 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#include "FrameTimings.h"
+
+#include "core/EngineData.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+#include <nlohmann/json.hpp>
+
+namespace Engine {
+
+	namespace {
+		nlohmann::json Summarize(std::vector<float> samples)
+		{
+			nlohmann::json out;
+			out["samples"] = samples.size();
+			if (samples.empty()) return out;
+
+			std::sort(samples.begin(), samples.end());
+			// Nearest-rank percentile.
+			auto percentile = [&](double p) {
+				const size_t rank = static_cast<size_t>(std::ceil(p * static_cast<double>(samples.size())));
+				return samples[std::clamp<size_t>(rank, 1, samples.size()) - 1];
+			};
+			out["mean"] = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size());
+			out["p50"]  = percentile(0.50);
+			out["p99"]  = percentile(0.99);
+			out["max"]  = samples.back();
+			return out;
+		}
+	} // namespace
+
+	void FrameTimings::AddFrame(float frameMs, const std::vector<ModuleTask>& tasks, const std::vector<float>& taskMs)
+	{
+		m_frameMs.push_back(frameMs);
+		if (taskMs.size() != tasks.size()) return; // schedule rebuilt mid-frame; frame time only
+
+		for (size_t i = 0; i < tasks.size(); ++i) {
+			m_taskMs[tasks[i].name].push_back(taskMs[i]);
+		}
+	}
+
+	bool FrameTimings::WriteReport(const std::string& path, const RunInfo& info) const
+	{
+		nlohmann::json report;
+		report["frames"]   = m_frameMs.size();
+		report["replay"]   = info.replay;
+		report["seed"]     = info.seed;
+		report["headless"] = info.headless;
+#ifdef GAME_BUILD
+		report["build"] = "game";
+#else
+		report["build"] = "editor";
+#endif
+		report["unit"]  = "ms";
+		report["frame"] = Summarize(m_frameMs);
+
+		nlohmann::json& tasks = report["tasks"];
+		tasks                 = nlohmann::json::object();
+		for (const auto& [name, samples] : m_taskMs) {
+			tasks[name] = Summarize(samples);
+		}
+
+		std::ofstream out(path);
+		if (!out) {
+			GetDefaultLogger()->error("Cannot write timing report {}", path);
+			return false;
+		}
+		out << report.dump(2) << '\n';
+		GetDefaultLogger()->info("Wrote timing report for {} frames to {}", m_frameMs.size(), path);
+		return true;
+	}
+
+} // namespace Engine
@@ -0,0 +1,37 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "core/module/ModuleUpdate.h"
+
+namespace Engine {
+
+	/// Frame and per-task timings for one run, written out as a JSON report
+	/// (mean / p50 / p99 / max in ms) so runs of the same replay can be diffed.
+	class FrameTimings {
+	  public:
+		struct RunInfo {
+			std::string replay;
+			uint32_t    seed     = 0;
+			bool        headless = false;
+		};
+
+		/// `taskMs` is parallel to `tasks` (ModuleManager::GetTaskTimesMs).
+		void AddFrame(float frameMs, const std::vector<ModuleTask>& tasks, const std::vector<float>& taskMs);
+		bool WriteReport(const std::string& path, const RunInfo& info) const;
+
+		[[nodiscard]] size_t FrameCount() const { return m_frameMs.size(); }
+
+	  private:
+		std::vector<float>                        m_frameMs;
+		std::map<std::string, std::vector<float>> m_taskMs; // by task name, one sample per frame it ran
+	};
+
+} // namespace Engine
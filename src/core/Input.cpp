@@ -24,13 +24,13 @@ namespace Engine {
 	{
 		ZoneScopedN("Initialize Input");
 
-		double x, y;
-		glfwGetCursorPos(GetWindow().GetNativeWindow(), &x, &y);
-		m_lastMousePosition = glm::vec2(static_cast<float>(x), static_cast<float>(y));
-		m_mousePosition     = m_lastMousePosition;
-
 		m_gameCursorMode = GLFW_CURSOR_NORMAL;
-		SetCursorMode(GLFW_CURSOR_NORMAL);
+		if (!IsHeadless()) {
+			SetCursorMode(GLFW_CURSOR_NORMAL);
+			PollDevices();
+		}
+		m_mousePosition     = m_device.cursor;
+		m_lastMousePosition = m_mousePosition;
 
 		std::memset(&m_gamepadState, 0, sizeof(m_gamepadState));
 		std::memset(&m_prevGamepadState, 0, sizeof(m_prevGamepadState));
@@ -116,26 +116,48 @@ namespace Engine {
 		}
 	}
 
-	void Input::UpdateGamepadState()
+	void Input::PollDevices()
 	{
-		m_prevGamepadState = m_gamepadState;
+		GLFWwindow* win = GetWindow().GetNativeWindow();
 
-		m_gamepadConnected = false;
-		std::memset(&m_gamepadState, 0, sizeof(m_gamepadState));
+		m_device.keys.reset();
+		for (int key = GLFW_KEY_SPACE; key <= GLFW_KEY_LAST; ++key) {
+			if (glfwGetKey(win, key) == GLFW_PRESS) m_device.keys.set(static_cast<size_t>(key));
+		}
+
+		m_device.mouseButtons = 0;
+		for (int btn = 0; btn <= GLFW_MOUSE_BUTTON_LAST; ++btn) {
+			if (glfwGetMouseButton(win, btn) == GLFW_PRESS) m_device.mouseButtons |= static_cast<uint8_t>(1u << btn);
+		}
+
+		double x, y;
+		glfwGetCursorPos(win, &x, &y);
+		m_device.cursor = glm::vec2(static_cast<float>(x), static_cast<float>(y));
+		m_device.scroll = m_scrollDelta;
+
+		m_device.gamepadConnected = false;
+		std::memset(&m_device.gamepad, 0, sizeof(m_device.gamepad));
 
 		// Prefer the first present gamepad (scan GLFW_JOYSTICK_1 .. LAST)
 		m_activeGamepadJid = GLFW_JOYSTICK_1;
 		for (int jid = GLFW_JOYSTICK_1; jid <= GLFW_JOYSTICK_LAST; ++jid) {
 			if (glfwJoystickPresent(jid) && glfwJoystickIsGamepad(jid)) {
 				m_activeGamepadJid = jid;
-				if (glfwGetGamepadState(jid, &m_gamepadState) == GLFW_TRUE) {
-					m_gamepadConnected = true;
+				if (glfwGetGamepadState(jid, &m_device.gamepad) == GLFW_TRUE) {
+					m_device.gamepadConnected = true;
 				}
 				break;
 			}
 		}
 	}
 
+	void Input::UpdateGamepadState()
+	{
+		m_prevGamepadState = m_gamepadState;
+		m_gamepadConnected = m_device.gamepadConnected;
+		m_gamepadState     = m_device.gamepad;
+	}
+
 	float Input::ApplyDeadzone(float value, float deadzone) const
 	{
 		const float dz = std::max(0.0f, deadzone);
@@ -375,7 +397,17 @@ namespace Engine {
 	void Input::onUpdate(float dt)
 	{
 		ZoneScoped;
-		if (GetState() == PLAYING) {
+		if (m_injected) {
+			m_device = *m_injected;
+			m_injected.reset();
+			m_scrollDelta = m_device.scroll;
+		}
+		else if (!IsHeadless()) {
+			PollDevices();
+		}
+		// Headless without a replay: no devices, every key / button stays released.
+
+		if (GetState() == PLAYING && !IsHeadless()) {
 			// Hold Escape: free cursor for ImGui (overrides script setCursorMode(DISABLED)).
 			if (IsKeyPressed(GLFW_KEY_ESCAPE)) {
 				m_gameCursorMode = GLFW_CURSOR_NORMAL;
@@ -390,9 +422,7 @@ namespace Engine {
 		}
 
 		m_lastMousePosition = m_mousePosition;
-		double x, y;
-		glfwGetCursorPos(GetWindow().GetNativeWindow(), &x, &y);
-		m_mousePosition = glm::vec2(static_cast<float>(x), static_cast<float>(y));
+		m_mousePosition     = m_device.cursor;
 
 		m_prevKeyStates = m_keyStates;
 		m_keyStates.clear();
@@ -402,9 +432,9 @@ namespace Engine {
 		}
 
 		m_prevMouseButtonStates = m_mouseButtonStates;
-		m_mouseButtonStates[GLFW_MOUSE_BUTTON_LEFT]   = glfwGetMouseButton(GetWindow().GetNativeWindow(), GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS;
-		m_mouseButtonStates[GLFW_MOUSE_BUTTON_RIGHT]  = glfwGetMouseButton(GetWindow().GetNativeWindow(), GLFW_MOUSE_BUTTON_RIGHT) == GLFW_PRESS;
-		m_mouseButtonStates[GLFW_MOUSE_BUTTON_MIDDLE] = glfwGetMouseButton(GetWindow().GetNativeWindow(), GLFW_MOUSE_BUTTON_MIDDLE) == GLFW_PRESS;
+		m_mouseButtonStates[GLFW_MOUSE_BUTTON_LEFT]   = IsMousePressed(GLFW_MOUSE_BUTTON_LEFT);
+		m_mouseButtonStates[GLFW_MOUSE_BUTTON_RIGHT]  = IsMousePressed(GLFW_MOUSE_BUTTON_RIGHT);
+		m_mouseButtonStates[GLFW_MOUSE_BUTTON_MIDDLE] = IsMousePressed(GLFW_MOUSE_BUTTON_MIDDLE);
 
 		UpdateGamepadState();
 		UpdateAxes(dt);
@@ -422,17 +452,19 @@ namespace Engine {
 
 	bool Input::IsMousePressed(int btn) const
 	{
-		return glfwGetMouseButton(GetWindow().GetNativeWindow(), btn) == GLFW_PRESS;
+		return btn >= 0 && btn <= GLFW_MOUSE_BUTTON_LAST && (m_device.mouseButtons & (1u << btn)) != 0;
 	}
 
+	// Keys and buttons read the per-frame sample, not GLFW directly, so a replay sees
+	// exactly what the recorded run saw. GLFW state only changes in glfwPollEvents anyway.
 	bool Input::IsKeyPressed(int key) const
 	{
-		return glfwGetKey(GetWindow().GetNativeWindow(), key) == GLFW_PRESS;
+		return key >= 0 && key <= GLFW_KEY_LAST && m_device.keys.test(static_cast<size_t>(key));
 	}
 
 	bool Input::IsKeyReleased(int key) const
 	{
-		return glfwGetKey(GetWindow().GetNativeWindow(), key) == GLFW_RELEASE;
+		return !IsKeyPressed(key);
 	}
 
 	[[maybe_unused]] glm::vec2 Input::GetMousePosition()
@@ -465,7 +497,7 @@ namespace Engine {
 	glm::vec2 Input::GetMouseDelta() const
 	{
 #ifndef GAME_BUILD
-		if (ImGui::IsKeyDown(ImGuiKey_Escape)) return {0, 0};
+		if (IsKeyPressed(GLFW_KEY_ESCAPE)) return {0, 0};
 #endif
 		return glm::vec2(m_mousePosition.x, m_lastMousePosition.y) - glm::vec2(m_lastMousePosition.x, m_mousePosition.y);
 	}
@@ -482,6 +514,7 @@ namespace Engine {
 
 	[[maybe_unused]] void Input::SetMousePosition(const glm::vec2& pos)
 	{
+		if (IsHeadless()) return;
 		glfwSetCursorPos(GetWindow().GetNativeWindow(), pos.x, pos.y);
 	}
 
@@ -502,6 +535,7 @@ namespace Engine {
 
 	void Input::SetCursorMode(int mode)
 	{
+		if (IsHeadless()) return;
 		GLFWwindow* win = GetWindow().GetNativeWindow();
 		glfwSetInputMode(win, GLFW_CURSOR, mode);
 		if (glfwRawMouseMotionSupported()) {
@@ -512,6 +546,7 @@ namespace Engine {
 
 	int Input::GetCursorMode()
 	{
+		if (IsHeadless()) return GLFW_CURSOR_NORMAL;
 		return glfwGetInputMode(GetWindow().GetNativeWindow(), GLFW_CURSOR);
 	}
 
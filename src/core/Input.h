@@ -3,12 +3,25 @@
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 
+#include <bitset>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
 #include "core/module/Module.h"
 
 namespace Engine {
+	/// Raw device state Input samples once per frame; everything else is derived from it.
+	/// This is what replays record and inject.
+	struct InputDeviceState {
+		std::bitset<GLFW_KEY_LAST + 1> keys;             // GLFW_KEY_* pressed
+		uint8_t                        mouseButtons = 0; // bit per GLFW_MOUSE_BUTTON_*
+		glm::vec2                      cursor{};
+		float                          scroll           = 0.0f;
+		bool                           gamepadConnected = false;
+		GLFWgamepadstate               gamepad{}; // primary pad only
+	};
+
 	/// Named virtual axis (Unity-style). Combined from keys, gamepad axes, and optional buttons.
 	struct InputAxis {
 		std::string name;
@@ -40,6 +53,7 @@ namespace Engine {
 		void        onGameStart() override {}
 		void        onShutdown() override;
 		std::string name() const override { return "InputModule"; };
+		UpdatePhase updatePhase() const override { return UpdatePhase::FrameBegin; }
 		void        setLuaBindings() override;
 
 		// Keyboard input
@@ -90,8 +104,14 @@ namespace Engine {
 
 		static void ScrollCallback(GLFWwindow* window, double xoffset, double yoffset);
 
+		/// State sampled this frame (what a recording stores).
+		[[nodiscard]] const InputDeviceState& GetDeviceState() const { return m_device; }
+		/// Use `state` instead of the real devices on the next update (replay).
+		void InjectDeviceState(const InputDeviceState& state) { m_injected = state; }
+
 	  private:
 		void RegisterDefaultAxes();
+		void PollDevices();
 		void UpdateGamepadState();
 		void UpdateAxes(float dt);
 		float ComputeAxisRaw(const InputAxis& axis) const;
@@ -107,6 +127,9 @@ namespace Engine {
 
 		int m_gameCursorMode = GLFW_CURSOR_NORMAL;
 
+		InputDeviceState                m_device;
+		std::optional<InputDeviceState> m_injected;
+
 		// Gamepad (primary = GLFW_JOYSTICK_1)
 		bool             m_gamepadConnected = false;
 		GLFWgamepadstate m_gamepadState{};
@@ -0,0 +1,94 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Engine {
+
+	/// Join handle for a batch of jobs. Every job submitted against a counter
+	/// bumps it by one and decrements it when it finishes — no futures, no heap.
+	/// Wait on it through ThreadPool::Wait so the waiting thread helps out.
+	class JobCounter {
+	  public:
+		JobCounter() = default;
+
+		JobCounter(const JobCounter&)            = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+
+		[[nodiscard]] bool IsDone() const { return m_pending.load(std::memory_order_acquire) == 0; }
+		[[nodiscard]] int  Pending() const { return m_pending.load(std::memory_order_acquire); }
+
+		void Add(int n) { m_pending.fetch_add(n, std::memory_order_relaxed); }
+		void Done() { m_pending.fetch_sub(1, std::memory_order_acq_rel); }
+
+	  private:
+		std::atomic<int> m_pending{0};
+	};
+
+	/// Type-erased void() callable with fixed inline storage. Captures that do
+	/// not fit are a compile error — capture by reference / pointer instead.
+	class JobFunction {
+	  public:
+		static constexpr std::size_t kStorageSize = 48;
+
+		JobFunction() = default;
+		~JobFunction() { Reset(); }
+
+		JobFunction(const JobFunction&)            = delete;
+		JobFunction& operator=(const JobFunction&) = delete;
+
+		template <class F>
+		void Set(F&& fn)
+		{
+			using Fn = std::decay_t<F>;
+			static_assert(sizeof(Fn) <= kStorageSize, "Job capture too large for inline storage; capture by reference instead");
+			static_assert(alignof(Fn) <= alignof(std::max_align_t), "Job capture over-aligned");
+
+			Reset();
+			new (m_storage) Fn(std::forward<F>(fn));
+			m_invoke  = [](void* p) { (*static_cast<Fn*>(p))(); };
+			m_destroy = [](void* p) { static_cast<Fn*>(p)->~Fn(); };
+		}
+
+		void Reset()
+		{
+			if (m_destroy) m_destroy(m_storage);
+			m_invoke  = nullptr;
+			m_destroy = nullptr;
+		}
+
+		void operator()() { m_invoke(m_storage); }
+
+		explicit operator bool() const { return m_invoke != nullptr; }
+
+	  private:
+		alignas(std::max_align_t) unsigned char m_storage[kStorageSize]{};
+		void (*m_invoke)(void*)  = nullptr;
+		void (*m_destroy)(void*) = nullptr;
+	};
+
+	/// One unit of work in the pool. Jobs live in caller-owned storage (ParallelFor
+	/// stack arrays, TaskGraph nodes).
+	struct alignas(64) Job {
+		JobFunction fn;
+		JobCounter* counter = nullptr;
+
+		// Task graph wiring: successors are released when this job finishes and
+		// their remaining dependency count drops to zero.
+		Job* const*      successors     = nullptr;
+		uint32_t         successorCount = 0;
+		std::atomic<int> remainingDependencies{0};
+
+		// Only the thread that started the pool may run this job (GL, Lua, ...).
+		bool mainThreadOnly = false;
+	};
+
+} // namespace Engine
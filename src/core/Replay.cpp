@@ -0,0 +1,137 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#include "Replay.h"
+
+#include "core/EngineData.h"
+
+#include <cstring>
+
+namespace Engine {
+
+	namespace {
+		constexpr char     kMagic[4]   = {'C', 'E', 'R', 'P'};
+		constexpr uint32_t kVersion    = 1;
+		constexpr uint8_t  kFlagPad    = 1u << 0;
+		constexpr int      kPadButtons = GLFW_GAMEPAD_BUTTON_LAST + 1;
+		constexpr int      kPadAxes    = GLFW_GAMEPAD_AXIS_LAST + 1;
+
+		template <typename T>
+		void WritePod(std::ofstream& out, const T& value)
+		{
+			out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+
+		template <typename T>
+		bool ReadPod(std::ifstream& in, T& value)
+		{
+			return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+		}
+	} // namespace
+
+	bool ReplayWriter::Open(const std::string& path, uint32_t seed)
+	{
+		m_file.open(path, std::ios::binary | std::ios::trunc);
+		if (!m_file) {
+			GetDefaultLogger()->error("Replay: cannot write {}", path);
+			return false;
+		}
+		m_file.write(kMagic, sizeof(kMagic));
+		WritePod(m_file, kVersion);
+		WritePod(m_file, seed);
+		WritePod(m_file, uint32_t{0});
+		m_frames = 0;
+		return true;
+	}
+
+	void ReplayWriter::Write(const ReplayFrame& frame)
+	{
+		if (!m_file.is_open()) return;
+		const InputDeviceState& in = frame.input;
+
+		WritePod(m_file, frame.dt);
+		WritePod(m_file, in.cursor.x);
+		WritePod(m_file, in.cursor.y);
+		WritePod(m_file, in.scroll);
+		WritePod(m_file, in.mouseButtons);
+		WritePod(m_file, static_cast<uint8_t>(in.gamepadConnected ? kFlagPad : 0));
+
+		// Only held keys; a frame is usually 0-3 of them.
+		uint16_t keys[UINT8_MAX];
+		uint8_t  keyCount = 0;
+		for (size_t key = 0; key < in.keys.size() && keyCount < UINT8_MAX; ++key) {
+			if (in.keys.test(key)) keys[keyCount++] = static_cast<uint16_t>(key);
+		}
+		WritePod(m_file, keyCount);
+		m_file.write(reinterpret_cast<const char*>(keys), static_cast<std::streamsize>(keyCount * sizeof(uint16_t)));
+
+		if (in.gamepadConnected) {
+			m_file.write(reinterpret_cast<const char*>(in.gamepad.buttons), kPadButtons);
+			m_file.write(reinterpret_cast<const char*>(in.gamepad.axes), kPadAxes * sizeof(float));
+		}
+		++m_frames;
+	}
+
+	void ReplayWriter::Close()
+	{
+		if (!m_file.is_open()) return;
+		m_file.close();
+		GetDefaultLogger()->info("Replay: recorded {} frames", m_frames);
+	}
+
+	bool ReplayReader::Open(const std::string& path)
+	{
+		m_frames.clear();
+		m_next = 0;
+
+		std::ifstream in(path, std::ios::binary);
+		char          magic[4];
+		uint32_t      version = 0, reserved = 0;
+		if (!in || !in.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || !ReadPod(in, version) || !ReadPod(in, m_seed) || !ReadPod(in, reserved)) {
+			GetDefaultLogger()->error("Replay: {} is not a replay file", path);
+			return false;
+		}
+		if (version != kVersion) {
+			GetDefaultLogger()->error("Replay: {} has version {}, expected {}", path, version, kVersion);
+			return false;
+		}
+
+		for (;;) {
+			ReplayFrame       frame;
+			InputDeviceState& state = frame.input;
+			uint8_t           flags = 0, keyCount = 0;
+			if (!ReadPod(in, frame.dt)) break; // clean end of file
+			if (!ReadPod(in, state.cursor.x) || !ReadPod(in, state.cursor.y) || !ReadPod(in, state.scroll) || !ReadPod(in, state.mouseButtons) || !ReadPod(in, flags) || !ReadPod(in, keyCount)) {
+				GetDefaultLogger()->warn("Replay: {} is truncated after {} frames", path, m_frames.size());
+				break;
+			}
+			for (uint8_t i = 0; i < keyCount; ++i) {
+				uint16_t key = 0;
+				ReadPod(in, key);
+				if (key < state.keys.size()) state.keys.set(key);
+			}
+			state.gamepadConnected = (flags & kFlagPad) != 0;
+			if (state.gamepadConnected) {
+				in.read(reinterpret_cast<char*>(state.gamepad.buttons), kPadButtons);
+				in.read(reinterpret_cast<char*>(state.gamepad.axes), kPadAxes * sizeof(float));
+			}
+			if (!in) {
+				GetDefaultLogger()->warn("Replay: {} is truncated after {} frames", path, m_frames.size());
+				break;
+			}
+			m_frames.push_back(frame);
+		}
+
+		GetDefaultLogger()->info("Replay: loaded {} frames from {} (seed {})", m_frames.size(), path, m_seed);
+		return true;
+	}
+
+	bool ReplayReader::Next(ReplayFrame& frame)
+	{
+		if (m_next >= m_frames.size()) return false;
+		frame = m_frames[m_next++];
+		return true;
+	}
+
+} // namespace Engine
@@ -0,0 +1,56 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "core/Input.h"
+
+namespace Engine {
+
+	/// Everything outside the engine that shaped one frame.
+	struct ReplayFrame {
+		float            dt = 0.0f;
+		InputDeviceState input;
+	};
+
+	/// Streams frames to a compact binary replay file:
+	///   header: "CERP", u32 version, u32 script random seed, u32 reserved
+	///   frame:  f32 dt, f32 cursor x/y, f32 scroll, u8 mouse buttons, u8 flags,
+	///           u8 key count, u16 keys[count], [u8 pad buttons[15], f32 pad axes[6]]
+	class ReplayWriter {
+	  public:
+		bool Open(const std::string& path, uint32_t seed);
+		void Write(const ReplayFrame& frame);
+		void Close();
+
+		[[nodiscard]] bool     IsOpen() const { return m_file.is_open(); }
+		[[nodiscard]] uint64_t FrameCount() const { return m_frames; }
+
+	  private:
+		std::ofstream m_file;
+		uint64_t      m_frames = 0;
+	};
+
+	/// Reads a whole replay file up front; Next() hands frames out in order.
+	class ReplayReader {
+	  public:
+		bool Open(const std::string& path);
+		bool Next(ReplayFrame& frame);
+
+		[[nodiscard]] uint32_t Seed() const { return m_seed; }
+		[[nodiscard]] size_t   FrameCount() const { return m_frames.size(); }
+		[[nodiscard]] size_t   Position() const { return m_next; }
+
+	  private:
+		std::vector<ReplayFrame> m_frames;
+		size_t                   m_next = 0;
+		uint32_t                 m_seed = 0;
+	};
+
+} // namespace Engine
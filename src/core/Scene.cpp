@@ -4,22 +4,121 @@
 
 #include "core/Scene.h"
 #include "core/Entity.h"
+#include "core/TransformHierarchy.h"
+#include "rendering/culling/CullingWorld.h"
+#include "components/impl/EntityMetadataComponent.h"
+
+#include <algorithm>
 
 namespace Engine {
 	Scene::Scene(std::string name) : m_name(std::move(name))
 	{
-		m_registry = std::make_shared<entt::registry>();
+		m_registry           = std::make_shared<entt::registry>();
+		m_transformHierarchy = std::make_unique<TransformHierarchy>(*this);
+		m_cullingWorld       = std::make_unique<Rendering::CullingWorld>(*this);
+		m_registry->on_construct<Components::EntityMetadata>().connect<&Scene::OnMetadataConstructed>(*this);
+		m_registry->on_destroy<Components::EntityMetadata>().connect<&Scene::OnMetadataDestroyed>(*this);
 	}
 
 	Scene::Scene(std::string name, std::vector<Entity> entities) : m_name(std::move(name))
 	{
-		m_registry   = std::make_shared<entt::registry>();
-		m_entityList = entities;
+		m_registry           = std::make_shared<entt::registry>();
+		m_entityList         = entities;
+		m_transformHierarchy = std::make_unique<TransformHierarchy>(*this);
+		m_cullingWorld       = std::make_unique<Rendering::CullingWorld>(*this);
+		m_registry->on_construct<Components::EntityMetadata>().connect<&Scene::OnMetadataConstructed>(*this);
+		m_registry->on_destroy<Components::EntityMetadata>().connect<&Scene::OnMetadataDestroyed>(*this);
+	}
+
+	Scene::~Scene()
+	{
+		// The registry is shared and may outlive the scene.
+		m_registry->on_construct<Components::EntityMetadata>().disconnect(this);
+		m_registry->on_destroy<Components::EntityMetadata>().disconnect(this);
+	}
+
+	entt::entity Scene::Find(const EntityHandle& handle) const
+	{
+		// The runtime id is a hash; the GUID itself decides between colliding entries.
+		const entt::registry& registry = *m_registry;
+		return m_entityIndex.Find(handle.GetRuntimeID(), [&](entt::entity entity) {
+			const auto* meta = registry.try_get<Components::EntityMetadata>(entity);
+			return meta && meta->guid == handle.GetID();
+		});
 	}
 
 	Entity Scene::Get(const EntityHandle& handle)
 	{
-		return m_entityMap[handle];
+		const entt::entity entity = Find(handle);
+		if (entity == entt::null) return {};
+		return {entity, this};
+	}
+
+	void Scene::OnMetadataConstructed(entt::registry& registry, entt::entity entity)
+	{
+		auto& meta = registry.get<Components::EntityMetadata>(entity);
+		m_entityIndex.Insert(EntityHandle::HashGuid(meta.guid), entity, [&](entt::entity other) {
+			const auto* otherMeta = registry.try_get<Components::EntityMetadata>(other);
+			return otherMeta && otherMeta->guid == meta.guid;
+		});
+
+		// Metadata is often a copy (prefab, loader); never trust its runtime links.
+		meta.parent = entt::null;
+		meta.childEntities.clear();
+
+		// Link whatever is already present; the rest links up as it arrives.
+		const entt::entity parent = Find(meta.parentEntity);
+		if (parent != entt::null && parent != entity) {
+			meta.parent = parent;
+			registry.get<Components::EntityMetadata>(parent).childEntities.push_back(entity);
+		}
+		for (const EntityHandle& childHandle : meta.children) {
+			const entt::entity child = Find(childHandle);
+			if (child == entt::null || child == entity) continue;
+			auto& childMeta = registry.get<Components::EntityMetadata>(child);
+			if (childMeta.parentEntity.GetID() != meta.guid) continue;
+			childMeta.parent = entity;
+			meta.childEntities.push_back(child);
+		}
+		m_transformHierarchy->MarkStructureDirty();
+	}
+
+	void Scene::OnMetadataDestroyed(entt::registry& registry, entt::entity entity)
+	{
+		auto& meta = registry.get<Components::EntityMetadata>(entity);
+		m_entityIndex.Erase(EntityHandle::HashGuid(meta.guid), entity);
+
+		if (meta.parent != entt::null && registry.valid(meta.parent)) {
+			if (auto* parentMeta = registry.try_get<Components::EntityMetadata>(meta.parent)) {
+				auto& siblings = parentMeta->childEntities;
+				siblings.erase(std::remove(siblings.begin(), siblings.end(), entity), siblings.end());
+			}
+		}
+		for (const entt::entity child : meta.childEntities) {
+			if (!registry.valid(child)) continue;
+			if (auto* childMeta = registry.try_get<Components::EntityMetadata>(child)) {
+				if (childMeta->parent == entity) childMeta->parent = entt::null;
+			}
+		}
+		m_transformHierarchy->MarkStructureDirty();
+	}
+
+	void Scene::ResolveHierarchyLinks()
+	{
+		auto view = m_registry->view<Components::EntityMetadata>();
+		for (auto [entity, meta] : view.each()) {
+			meta.parent = Find(meta.parentEntity);
+			if (meta.parent == entity) meta.parent = entt::null;
+			meta.childEntities.clear();
+		}
+		for (auto [entity, meta] : view.each()) {
+			// Children in GUID-list order, so traversal order matches the editor outline.
+			for (const EntityHandle& childHandle : meta.children) {
+				const entt::entity child = Find(childHandle);
+				if (child != entt::null && child != entity) meta.childEntities.push_back(child);
+			}
+		}
+		m_transformHierarchy->MarkStructureDirty();
 	}
 
 } // namespace Engine
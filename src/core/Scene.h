@@ -12,28 +12,55 @@
 
 //#include "core/Entity.h"
 #include "EntityHandle.h"
+#include "EntityIndex.h"
 
 namespace Engine {
 	class Entity;
-	
+	class TransformHierarchy;
+	namespace Rendering {
+		class CullingWorld;
+	}
+
 	// A single scene, essentially just a wrapper for entt::registry
 	class Scene {
 	  public:
 		Scene(std::string name);
 
 		Scene(std::string name, std::vector<Entity> entities);
+		~Scene();
 
 		std::shared_ptr<entt::registry> GetRegistry() { return m_registry; }
 
 		const std::string& GetName() const { return m_name; }
 
+		/// O(1) GUID → entity. Returns a null Entity for unknown / destroyed handles.
 		Entity Get(const EntityHandle& handle);
 
-		std::vector<Entity>            m_entityList;
-		std::map<EntityHandle, Entity> m_entityMap;
+		/// Read-only lookup; safe from worker threads while no entities are created or destroyed.
+		[[nodiscard]] entt::entity Find(const EntityHandle& handle) const;
+		[[nodiscard]] bool         Contains(const EntityHandle& handle) const { return Find(handle) != entt::null; }
+
+		/// Re-resolve every EntityMetadata parent / child link from its GUIDs.
+		/// Called after bulk loads, where parents may be created after their children.
+		void ResolveHierarchyLinks();
+
+		TransformHierarchy&      GetTransformHierarchy() { return *m_transformHierarchy; }
+		Rendering::CullingWorld& GetCullingWorld() { return *m_cullingWorld; }
+
+		std::vector<Entity> m_entityList;
 
 	  private:
+		// Keep the GUID index and the runtime links in step with the registry.
+		void OnMetadataConstructed(entt::registry& registry, entt::entity entity);
+		void OnMetadataDestroyed(entt::registry& registry, entt::entity entity);
+
+		EntityIndex m_entityIndex;
+
 		std::string                     m_name;
 		std::shared_ptr<entt::registry> m_registry;
+		// Declared after the registry: it hooks the registry's Transform signals.
+		std::unique_ptr<TransformHierarchy> m_transformHierarchy;
+		// After the hierarchy: reads its change flags.
+		std::unique_ptr<Rendering::CullingWorld> m_cullingWorld;
 	};
 } // namespace Engine
\ No newline at end of file
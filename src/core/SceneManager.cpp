@@ -11,9 +11,8 @@
 #include "components/impl/RigidBodyComponent.h"
 
 #include "components/impl/EntityMetadataComponent.h"
-#include "core/ThreadPool.h"
+#include "core/TransformHierarchy.h"
 #include "core/EngineData.h"
-#include <vector>
 
 namespace Engine {
 
@@ -66,51 +65,27 @@ namespace Engine {
 	}
 	void SceneManager::UpdateTransforms()
 	{
-		// Each root hierarchy is independent — process roots in parallel.
-		std::vector<Entity> roots;
-		roots.reserve(64);
-
-		auto view = GetCurrentSceneRegistry().view<Components::EntityMetadata, Components::Transform>();
-		for (auto [entity, metadata, transform] : view.each()) {
-			if (!metadata.parentEntity.IsValid()) {
-				roots.emplace_back(entity, GetCurrentScene());
-			}
-		}
+		Scene* scene = GetCurrentScene();
+		if (!scene) return;
 
-		const int n = static_cast<int>(roots.size());
-		GetThreadPool().ParallelForIndex(n, /*minPerTask=*/2, [&](int i) {
-			UpdateTransformRecursive(roots[static_cast<size_t>(i)], glm::mat4(1.0f), false);
-		});
+		// Only dirty subtrees are recomputed; depth levels run on the ThreadPool.
+		TransformHierarchy& hierarchy = scene->GetTransformHierarchy();
+		hierarchy.Update();
 
 		// Kinematic / static bodies follow the authored transform (including parented
 		// platforms). Dynamic bodies are written the other way in PhysicsManager.
 		// Sequential: Jolt BodyInterface is not safe to call from the transform workers.
 		if (IsSimulating()) {
-			auto kinematicView = GetCurrentSceneRegistry().view<Components::Transform, Components::RigidBodyComponent>();
+			auto kinematicView = scene->GetRegistry()->view<Components::Transform, Components::RigidBodyComponent>();
 			for (auto [entity, transform, rb] : kinematicView.each()) {
 				if (rb.bodyID.IsInvalid()) continue;
 				if (rb.motionType == static_cast<int>(JPH::EMotionType::Dynamic)) continue;
-				Entity wrapped(entity, GetCurrentScene());
+				if (!hierarchy.HasChanged(entity)) continue;
+				Entity wrapped(entity, scene);
 				transform.SyncWithPhysics(wrapped);
 			}
 		}
 	}
-	void SceneManager::UpdateTransformRecursive(Entity entity, const glm::mat4& parentMatrix, bool hasParent)
-	{
-		if (!entity.HasComponent<Components::Transform>()) return;
-		auto& transform = entity.GetComponent<Components::Transform>();
-
-		transform.SetWorldFromMatrix(parentMatrix * transform.GetLocalMatrix());
-
-		// Update children
-		auto& hierarchy = entity.GetComponent<Components::EntityMetadata>();
-		for (auto& childHandle : hierarchy.children) {
-			auto childEntity = GetCurrentScene()->Get(childHandle);
-			if (childEntity) {
-				UpdateTransformRecursive(childEntity, transform.GetWorldMatrix(), true);
-			}
-		}
-	}
 } // namespace Engine
 
 #include "assets/AssetManager.inl"
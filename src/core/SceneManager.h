@@ -23,8 +23,8 @@ namespace Engine {
 		void onShutdown() override;
 
 
+		/// Propagate dirty local transforms to world matrices for the active scene.
 		void UpdateTransforms();
-		void UpdateTransformRecursive(Entity entity, const glm::mat4& parentMatrix, bool hasParent);
 
 
 		// Scene management
@@ -0,0 +1,73 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#include "TaskGraph.h"
+
+#include "utils/Utils.h"
+
+namespace Engine {
+
+	void TaskGraph::Precede(TaskId before, TaskId after)
+	{
+		ENGINE_ASSERT(before < m_nodes.size() && after < m_nodes.size(), "TaskGraph::Precede: invalid task id");
+		ENGINE_ASSERT(before != after, "TaskGraph::Precede: task cannot depend on itself");
+
+		auto& successors = m_nodes[before].successorIds;
+		for (TaskId s : successors) {
+			if (s == after) return;
+		}
+		successors.push_back(after);
+		m_nodes[after].dependencyCount++;
+		m_finalized = false;
+	}
+
+	void TaskGraph::Clear()
+	{
+		m_nodes.clear();
+		m_roots.clear();
+		m_finalized = false;
+	}
+
+	void TaskGraph::Finalize()
+	{
+		if (m_finalized) return;
+
+		m_roots.clear();
+		for (auto& node : m_nodes) {
+			node.successorJobs.clear();
+			node.successorJobs.reserve(node.successorIds.size());
+			for (TaskId s : node.successorIds) {
+				node.successorJobs.push_back(&m_nodes[s].job);
+			}
+			node.job.successors     = node.successorJobs.data();
+			node.job.successorCount = static_cast<uint32_t>(node.successorJobs.size());
+			if (node.dependencyCount == 0) {
+				m_roots.push_back(&node.job);
+			}
+		}
+
+		// Kahn's algorithm: every node must be reachable from a root, otherwise
+		// the graph has a cycle and Run would never complete.
+		std::vector<int>    remaining(m_nodes.size());
+		std::vector<TaskId> ready;
+		ready.reserve(m_nodes.size());
+		for (size_t i = 0; i < m_nodes.size(); ++i) {
+			remaining[i] = m_nodes[i].dependencyCount;
+			if (remaining[i] == 0) ready.push_back(static_cast<TaskId>(i));
+		}
+		size_t visited = 0;
+		while (!ready.empty()) {
+			TaskId id = ready.back();
+			ready.pop_back();
+			++visited;
+			for (TaskId s : m_nodes[id].successorIds) {
+				if (--remaining[s] == 0) ready.push_back(s);
+			}
+		}
+		ENGINE_VERIFY(visited == m_nodes.size(), "TaskGraph contains a dependency cycle");
+
+		m_finalized = true;
+	}
+
+} // namespace Engine
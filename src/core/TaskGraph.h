@@ -0,0 +1,78 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/Job.h"
+
+namespace Engine {
+
+	/// A DAG of jobs submitted to the ThreadPool in one go. Build it once (or once
+	/// per frame), then ThreadPool::Run(graph) releases every task as soon as all
+	/// of its predecessors have finished — no blocking ParallelFor between stages.
+	///
+	/// A graph may be run again after the previous run has completed; node storage
+	/// is kept, so re-running a prebuilt graph does not allocate.
+	class TaskGraph {
+	  public:
+		using TaskId                          = uint32_t;
+		static constexpr TaskId kInvalidTask = ~0u;
+
+		TaskGraph() = default;
+
+		TaskGraph(const TaskGraph&)            = delete;
+		TaskGraph& operator=(const TaskGraph&) = delete;
+
+		/// Add a task. The callable must fit JobFunction's inline storage.
+		template <class F>
+		TaskId Add(std::string name, F&& fn)
+		{
+			Node& node = m_nodes.emplace_back();
+			node.name  = std::move(name);
+			node.job.fn.Set(std::forward<F>(fn));
+			m_finalized = false;
+			return static_cast<TaskId>(m_nodes.size() - 1);
+		}
+
+		/// `after` will not start until `before` has finished.
+		void Precede(TaskId before, TaskId after);
+
+		/// Pin a task to the thread that started the pool. It runs while that
+		/// thread waits on the graph (ThreadPool::Wait / RunAndWait).
+		void SetMainThreadOnly(TaskId id, bool mainThreadOnly = true) { m_nodes[id].job.mainThreadOnly = mainThreadOnly; }
+
+		void Clear();
+
+		[[nodiscard]] size_t             Size() const { return m_nodes.size(); }
+		[[nodiscard]] bool               Empty() const { return m_nodes.empty(); }
+		[[nodiscard]] const std::string& GetName(TaskId id) const { return m_nodes[id].name; }
+
+	  private:
+		friend class ThreadPool;
+
+		struct Node {
+			Job                 job;
+			std::string         name;
+			std::vector<TaskId> successorIds;
+			std::vector<Job*>   successorJobs;
+			int                 dependencyCount = 0;
+		};
+
+		/// Resolves successor ids to Job pointers and rejects cycles. Only redone
+		/// after the graph changes.
+		void Finalize();
+
+		// deque: node addresses stay stable while tasks are appended.
+		std::deque<Node>  m_nodes;
+		std::vector<Job*> m_roots;
+		bool              m_finalized = false;
+	};
+
+} // namespace Engine
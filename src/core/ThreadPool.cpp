@@ -1,11 +1,27 @@
 #include "ThreadPool.h"
 
 #include <algorithm>
-#include <chrono>
-#include <vector>
 
 namespace Engine {
 
+	namespace {
+		// Which pool / context slot the current thread belongs to.
+		thread_local const ThreadPool* t_pool  = nullptr;
+		thread_local unsigned          t_index = 0;
+
+		// Idle workers yield this many times before going to sleep.
+		constexpr int kSpinsBeforeSleep = 64;
+
+		uint32_t NextRandom(uint32_t& state)
+		{
+			// xorshift32 — only used to pick a steal victim.
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			return state;
+		}
+	} // namespace
+
 	ThreadPool::ThreadPool(unsigned workers)
 	{
 		Start(workers);
@@ -27,60 +43,252 @@ namespace Engine {
 			workers = hc > 1 ? hc - 1 : 1;
 		}
 
-		m_stop = false;
+		m_contextCount = workers + 1;
+		m_contexts     = std::make_unique<ThreadContext[]>(m_contextCount);
+		for (unsigned i = 0; i < m_contextCount; ++i) {
+			m_contexts[i].index    = i;
+			m_contexts[i].rngState = 2654435761u * (i + 1);
+		}
+
+		// The starting thread (normally main) owns slot 0.
+		t_pool  = this;
+		t_index = 0;
+
+		m_stop.store(false);
 		m_workers.reserve(workers);
 		for (unsigned i = 0; i < workers; ++i) {
-			m_workers.emplace_back([this]() { WorkerLoop(); });
+			m_workers.emplace_back([this, i]() { WorkerLoop(i + 1); });
 		}
 	}
 
 	void ThreadPool::Shutdown()
 	{
+		if (m_stop.load() && m_workers.empty()) return;
+
+		m_stop.store(true);
 		{
-			std::lock_guard lock(m_mutex);
-			if (m_stop && m_workers.empty()) return;
-			m_stop = true;
+			std::lock_guard lock(m_sleepMutex);
 		}
-		m_cv.notify_all();
+		m_sleepCv.notify_all();
+
 		for (auto& t : m_workers) {
 			if (t.joinable()) t.join();
 		}
 		m_workers.clear();
-		std::queue<std::function<void()>> empty;
+		m_contexts.reset();
+		m_contextCount = 0;
+		m_queuedJobs.store(0);
 		{
-			std::lock_guard lock(m_mutex);
-			std::swap(m_tasks, empty);
+			std::lock_guard lock(m_mainThreadMutex);
+			m_mainThreadJobs.clear();
+			m_mainThreadJobCount.store(0);
+		}
+		{
+			std::lock_guard lock(m_externalMutex);
+			m_externalJobs.clear();
+			m_externalJobCount.store(0);
 		}
 	}
 
-	void ThreadPool::WorkerLoop()
+	ThreadPool::ThreadContext* ThreadPool::CurrentContext() const
 	{
+		if (m_stop.load(std::memory_order_relaxed) || !m_contexts) return nullptr;
+		if (t_pool != this || t_index >= m_contextCount) return nullptr;
+		return &m_contexts[t_index];
+	}
+
+	void ThreadPool::WorkerLoop(unsigned index)
+	{
+		t_pool  = this;
+		t_index = index;
+
+		ThreadContext& ctx   = m_contexts[index];
+		int            spins = 0;
 		for (;;) {
-			std::function<void()> job;
-			{
-				std::unique_lock lock(m_mutex);
-				m_cv.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
-				if (m_stop && m_tasks.empty()) return;
-				job = std::move(m_tasks.front());
-				m_tasks.pop();
+			if (Job* job = FindJob(ctx)) {
+				Execute(&ctx, job);
+				spins = 0;
+				continue;
 			}
-			job();
+			if (m_stop.load(std::memory_order_acquire)) return;
+
+			if (++spins < kSpinsBeforeSleep) {
+				std::this_thread::yield();
+				continue;
+			}
+
+			std::unique_lock lock(m_sleepMutex);
+			m_sleepingWorkers.fetch_add(1);
+			m_sleepCv.wait(lock, [this]() { return m_stop.load() || m_queuedJobs.load() > 0; });
+			m_sleepingWorkers.fetch_sub(1);
+			spins = 0;
 		}
 	}
 
-	bool ThreadPool::TryRunOneTask()
+	void ThreadPool::Push(ThreadContext& ctx, Job* job)
 	{
-		std::function<void()> job;
+		if (job->mainThreadOnly) {
+			// Never goes into a stealable deque; the owner picks it up in FindJob.
+			std::lock_guard lock(m_mainThreadMutex);
+			m_mainThreadJobs.push_back(job);
+			m_mainThreadJobCount.fetch_add(1, std::memory_order_release);
+			return;
+		}
+
+		m_queuedJobs.fetch_add(1);
+		if (!ctx.queue.Push(job)) {
+			// Deque full: running inline is always correct, just not parallel.
+			m_queuedJobs.fetch_sub(1);
+			Execute(&ctx, job);
+		}
+	}
+
+	void ThreadPool::WakeWorkers(int n)
+	{
+		if (n <= 0 || m_sleepingWorkers.load() == 0) return;
 		{
-			std::lock_guard lock(m_mutex);
-			if (m_tasks.empty()) return false;
-			job = std::move(m_tasks.front());
-			m_tasks.pop();
+			// Pairs with the predicate check in WorkerLoop so a worker cannot miss
+			// the wake-up between testing m_queuedJobs and blocking.
+			std::lock_guard lock(m_sleepMutex);
+		}
+		if (n == 1) m_sleepCv.notify_one();
+		else m_sleepCv.notify_all();
+	}
+
+	Job* ThreadPool::PopMainThreadJob()
+	{
+		if (m_mainThreadJobCount.load(std::memory_order_acquire) == 0) return nullptr;
+		std::lock_guard lock(m_mainThreadMutex);
+		if (m_mainThreadJobs.empty()) return nullptr;
+		// FIFO keeps pinned tasks in the order they became ready.
+		Job* job = m_mainThreadJobs.front();
+		m_mainThreadJobs.erase(m_mainThreadJobs.begin());
+		m_mainThreadJobCount.fetch_sub(1, std::memory_order_relaxed);
+		return job;
+	}
+
+	void ThreadPool::PushExternal(Job* job)
+	{
+		m_queuedJobs.fetch_add(1);
+		std::lock_guard lock(m_externalMutex);
+		m_externalJobs.push_back(job);
+		m_externalJobCount.fetch_add(1, std::memory_order_release);
+	}
+
+	Job* ThreadPool::PopExternalJob()
+	{
+		if (m_externalJobCount.load(std::memory_order_acquire) == 0) return nullptr;
+		std::lock_guard lock(m_externalMutex);
+		if (m_externalJobs.empty()) return nullptr;
+		Job* job = m_externalJobs.front();
+		m_externalJobs.erase(m_externalJobs.begin());
+		m_externalJobCount.fetch_sub(1, std::memory_order_relaxed);
+		return job;
+	}
+
+	Job* ThreadPool::FindJob(ThreadContext& ctx)
+	{
+		// Pinned jobs first: they are usually on the frame's critical path.
+		if (ctx.index == 0) {
+			if (Job* pinned = PopMainThreadJob()) return pinned;
+		}
+
+		Job* job = ctx.queue.Pop();
+		if (!job && m_contextCount > 1) {
+			// Start at a random victim so thieves don't all hammer the same deque.
+			const unsigned start = NextRandom(ctx.rngState) % m_contextCount;
+			for (unsigned i = 0; i < m_contextCount && !job; ++i) {
+				const unsigned victim = (start + i) % m_contextCount;
+				if (victim == ctx.index) continue;
+				job = m_contexts[victim].queue.Steal();
+			}
 		}
-		job();
+		if (!job) job = PopExternalJob();
+		if (job) m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+		return job;
+	}
+
+	void ThreadPool::Execute(ThreadContext* ctx, Job* job)
+	{
+		// Read everything we need up front: once the counter is released the job's
+		// storage may belong to someone else (a returned stack frame).
+		JobCounter* counter = job->counter;
+
+		job->fn();
+
+		int released = 0;
+		for (uint32_t i = 0; i < job->successorCount; ++i) {
+			Job* next = job->successors[i];
+			if (next->remainingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+				if (ctx) {
+					Push(*ctx, next);
+					++released;
+				}
+				else {
+					Execute(nullptr, next);
+				}
+			}
+		}
+		WakeWorkers(released);
+
+		if (counter) counter->Done();
+	}
+
+	bool ThreadPool::TryRunOneJob(ThreadContext& ctx)
+	{
+		Job* job = FindJob(ctx);
+		if (!job) return false;
+		Execute(&ctx, job);
 		return true;
 	}
 
+	void ThreadPool::Wait(const JobCounter& counter)
+	{
+		ThreadContext* ctx = CurrentContext();
+		while (!counter.IsDone()) {
+			// Help the pool instead of blocking (also unblocks nested ParallelFor).
+			if (ctx && TryRunOneJob(*ctx)) continue;
+			// Foreign threads help with the shared queue their ParallelFor fed.
+			if (!ctx) {
+				if (Job* job = PopExternalJob()) {
+					m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+					Execute(nullptr, job);
+					continue;
+				}
+			}
+			std::this_thread::yield();
+		}
+	}
+
+	void ThreadPool::Run(TaskGraph& graph, JobCounter& counter)
+	{
+		graph.Finalize();
+		if (graph.Empty()) return;
+
+		for (auto& node : graph.m_nodes) {
+			node.job.remainingDependencies.store(node.dependencyCount, std::memory_order_relaxed);
+			node.job.counter = &counter;
+		}
+		counter.Add(static_cast<int>(graph.Size()));
+
+		ThreadContext* ctx = CurrentContext();
+		if (!ctx) {
+			// Not a pool thread (or pool stopped): run the DAG inline in dependency order.
+			for (Job* root : graph.m_roots) Execute(nullptr, root);
+			return;
+		}
+
+		for (Job* root : graph.m_roots) Push(*ctx, root);
+		WakeWorkers(static_cast<int>(graph.m_roots.size()));
+	}
+
+	void ThreadPool::RunAndWait(TaskGraph& graph)
+	{
+		JobCounter counter;
+		Run(graph, counter);
+		Wait(counter);
+	}
+
 	void ThreadPool::ParallelFor(int count, int minPerTask, const std::function<void(int begin, int end)>& rangeFn)
 	{
 		if (count <= 0) return;
@@ -88,59 +296,45 @@ namespace Engine {
 
 		minPerTask = std::max(1, minPerTask);
 
-		// Serial fast path: tiny work or pool not running.
-		if (m_workers.empty() || count <= minPerTask) {
+		// Serial fast path: tiny work or pool not running. Foreign threads hand their
+		// chunks to the workers through the shared queue.
+		ThreadContext* ctx     = CurrentContext();
+		const bool     running = ctx || !m_stop.load(std::memory_order_acquire);
+		if (!running || m_workers.empty() || count <= minPerTask) {
 			rangeFn(0, count);
 			return;
 		}
 
-		const int workers   = static_cast<int>(m_workers.size());
-		const int nChunks   = std::min(count, workers + 1); // include caller as a worker
-		int       chunkSize = (count + nChunks - 1) / nChunks;
-		chunkSize           = std::max(chunkSize, minPerTask);
-
-		struct Range {
-			int b, e;
-		};
-		std::vector<Range> ranges;
-		ranges.reserve(static_cast<size_t>(nChunks));
-		for (int b = 0; b < count; b += chunkSize) {
-			ranges.push_back({b, std::min(b + chunkSize, count)});
-		}
-
-		if (ranges.size() == 1) {
-			rangeFn(ranges[0].b, ranges[0].e);
+		const int threads = static_cast<int>(m_contextCount);
+		int       nChunks = std::min({count / minPerTask, threads * kChunksPerThread, kMaxParallelChunks});
+		if (nChunks <= 1) {
+			rangeFn(0, count);
 			return;
 		}
+		const int chunkSize = (count + nChunks - 1) / nChunks;
+		nChunks             = (count + chunkSize - 1) / chunkSize;
 
-		// Last range runs on the calling thread; the rest go to the pool.
-		// While waiting, the caller helps drain the queue — prevents deadlock
-		// when ParallelFor is nested (e.g. skin entities → skin mesh parts).
-		std::vector<std::future<void>> futures;
-		futures.reserve(ranges.size() - 1);
-		for (size_t i = 0; i + 1 < ranges.size(); ++i) {
-			const int b = ranges[i].b;
-			const int e = ranges[i].e;
-			futures.push_back(Enqueue([&, b, e]() { rangeFn(b, e); }));
+		// Chunk jobs live on this stack frame; Wait below keeps them alive until
+		// every one has released the counter.
+		Job        jobs[kMaxParallelChunks];
+		JobCounter counter;
+		counter.Add(nChunks - 1);
+
+		// Last range runs on the calling thread; the rest go to our deque where
+		// idle workers steal them.
+		for (int i = 0; i + 1 < nChunks; ++i) {
+			const int b = i * chunkSize;
+			const int e = std::min(b + chunkSize, count);
+			jobs[i].fn.Set([&rangeFn, b, e]() { rangeFn(b, e); });
+			jobs[i].counter = &counter;
+			if (ctx) Push(*ctx, &jobs[i]);
+			else PushExternal(&jobs[i]);
 		}
+		WakeWorkers(nChunks - 1);
 
-		const Range& local = ranges.back();
-		rangeFn(local.b, local.e);
+		rangeFn((nChunks - 1) * chunkSize, count);
 
-		for (auto& f : futures) {
-			for (;;) {
-				if (f.wait_for(std::chrono::milliseconds(0)) == std::future_status::ready) {
-					f.get();
-					break;
-				}
-				// Help the pool instead of spinning idle (also unblocks nested ParallelFor).
-				if (!TryRunOneTask()) {
-					f.wait();
-					f.get();
-					break;
-				}
-			}
-		}
+		Wait(counter);
 	}
 
 } // namespace Engine
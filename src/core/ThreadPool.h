@@ -1,19 +1,29 @@
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <functional>
-#include <future>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
 #include <type_traits>
 #include <vector>
 
+#include "core/Job.h"
+#include "core/TaskGraph.h"
+#include "core/WorkStealingQueue.h"
+
 namespace Engine {
 
-	/// Fixed worker pool used by animation skinning, pose eval, transforms, etc.
+	/// Work-stealing worker pool used by animation skinning, pose eval, transforms, etc.
 	/// OpenGL work must stay on the main thread — only CPU-side jobs go here.
+	///
+	/// Every participating thread (the workers plus the thread that called Start)
+	/// owns a lock-free deque; idle threads steal from the others. Jobs carry their
+	/// callable inline and completion is tracked with JobCounter, so submitting a
+	/// small job never touches the allocator. Threads that are not part of the pool
+	/// run submitted work inline; only their ParallelFor chunks reach the workers,
+	/// through a shared queue.
 	class ThreadPool {
 	  public:
 		/// workers == 0 → hardware_concurrency() - 1 (at least 1 if multi-core).
@@ -26,33 +36,25 @@ namespace Engine {
 		void Start(unsigned workers = 0);
 		void Shutdown();
 
-		[[nodiscard]] bool     IsRunning() const { return !m_stop && !m_workers.empty(); }
+		[[nodiscard]] bool     IsRunning() const { return !m_stop.load(std::memory_order_relaxed) && !m_workers.empty(); }
 		[[nodiscard]] unsigned WorkerCount() const { return static_cast<unsigned>(m_workers.size()); }
 
-		/// Queue a job; returns a future for the result.
-		template <class F, class... Args>
-		auto Enqueue(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>>
-		{
-			using R = std::invoke_result_t<F, Args...>;
-			auto task = std::make_shared<std::packaged_task<R()>>(
-			    std::bind(std::forward<F>(f), std::forward<Args>(args)...));
-			std::future<R> fut = task->get_future();
-			{
-				std::lock_guard lock(m_mutex);
-				if (m_stop) {
-					// Run inline if pool is down.
-					(*task)();
-					return fut;
-				}
-				m_tasks.emplace([task]() { (*task)(); });
-			}
-			m_cv.notify_one();
-			return fut;
-		}
+		/// Block until `counter` reaches zero. The waiting thread keeps running
+		/// queued jobs meanwhile, so nested waits cannot deadlock the pool.
+		void Wait(const JobCounter& counter);
+
+		/// Release every root of `graph`; the counter drops to zero once all of its
+		/// tasks have run. The graph must outlive the run. Main-thread-only tasks
+		/// execute while the owner thread waits.
+		void Run(TaskGraph& graph, JobCounter& counter);
+
+		/// Run(graph) + Wait.
+		void RunAndWait(TaskGraph& graph);
 
 		/// Parallel for over [0, count). Splits into range chunks; blocks until done.
 		/// The calling thread also participates (no idle main thread wait).
 		/// minPerTask: don't create a task smaller than this (reduces overhead).
+		/// Also usable from threads outside the pool (e.g. asset loader threads).
 		void ParallelFor(int count, int minPerTask, const std::function<void(int begin, int end)>& rangeFn);
 
 		/// Convenience: one index at a time.
@@ -64,15 +66,54 @@ namespace Engine {
 		}
 
 	  private:
-		void WorkerLoop();
-		/// Pop and run one queued task if any (used while waiting on ParallelFor).
-		bool TryRunOneTask();
-
-		std::vector<std::thread>          m_workers;
-		std::queue<std::function<void()>> m_tasks;
-		mutable std::mutex                m_mutex;
-		std::condition_variable           m_cv;
-		bool                              m_stop = true;
+		// Upper bound on chunks per ParallelFor call; the chunk jobs live on the
+		// caller's stack.
+		static constexpr int kMaxParallelChunks = 64;
+		// A few chunks per thread lets stealing even out uneven ranges.
+		static constexpr int kChunksPerThread = 4;
+
+		struct alignas(64) ThreadContext {
+			WorkStealingQueue queue;
+			uint32_t          rngState = 1;
+			unsigned          index    = 0;
+		};
+
+		void WorkerLoop(unsigned index);
+
+		/// Context of the calling thread, or nullptr if it does not belong to this pool.
+		ThreadContext* CurrentContext() const;
+
+		void Push(ThreadContext& ctx, Job* job);
+		Job* FindJob(ThreadContext& ctx);
+		void Execute(ThreadContext* ctx, Job* job);
+		/// Pop / steal and run one job if any (used while waiting on a counter).
+		bool TryRunOneJob(ThreadContext& ctx);
+		void WakeWorkers(int n);
+		Job* PopMainThreadJob();
+		/// ParallelFor chunks from threads outside the pool; any pool thread may run them.
+		void PushExternal(Job* job);
+		Job* PopExternalJob();
+
+		std::vector<std::thread>         m_workers;
+		std::unique_ptr<ThreadContext[]> m_contexts; // [0] = owner thread, [1..] = workers
+		unsigned                         m_contextCount = 0;
+		std::atomic<bool>                m_stop{true};
+
+		// Jobs pinned to the owner thread. Rare (a handful per frame), so a mutex is fine.
+		std::mutex        m_mainThreadMutex;
+		std::vector<Job*> m_mainThreadJobs;
+		std::atomic<int>  m_mainThreadJobCount{0};
+
+		// Chunks pushed by foreign threads. As rare as pinned jobs, so a mutex again.
+		std::mutex        m_externalMutex;
+		std::vector<Job*> m_externalJobs;
+		std::atomic<int>  m_externalJobCount{0};
+
+		// Sleep / wake for idle workers. m_queuedJobs is only a hint for sleeping.
+		std::atomic<int>        m_queuedJobs{0};
+		std::atomic<int>        m_sleepingWorkers{0};
+		std::mutex              m_sleepMutex;
+		std::condition_variable m_sleepCv;
 	};
 
 } // namespace Engine
@@ -0,0 +1,226 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#include "TransformHierarchy.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "components/impl/EntityMetadataComponent.h"
+#include "components/impl/TransformComponent.h"
+#include "core/EngineData.h"
+#include "core/Entity.h"
+#include "core/Scene.h"
+#include "core/ThreadPool.h"
+#include "utils/Utils.h"
+
+namespace Engine {
+
+	namespace {
+		// Below this many nodes a level is cheaper to walk on one thread.
+		constexpr int kMinNodesPerTask = 256;
+	} // namespace
+
+	TransformHierarchy::TransformHierarchy(Scene& scene) : m_registry(*scene.GetRegistry())
+	{
+		m_registry.on_construct<Components::Transform>().connect<&TransformHierarchy::OnTransformConstructed>(*this);
+		m_registry.on_destroy<Components::Transform>().connect<&TransformHierarchy::OnTransformDestroyed>(*this);
+	}
+
+	TransformHierarchy::~TransformHierarchy()
+	{
+		// The registry is shared and may outlive the scene.
+		m_registry.on_construct<Components::Transform>().disconnect(this);
+		m_registry.on_destroy<Components::Transform>().disconnect(this);
+	}
+
+	void TransformHierarchy::OnTransformConstructed(entt::registry& registry, entt::entity entity)
+	{
+		auto& transform       = registry.get<Components::Transform>(entity);
+		transform.m_hierarchy = this;
+		transform.m_entity    = entity;
+		m_structureDirty      = true;
+	}
+
+	void TransformHierarchy::OnTransformDestroyed(entt::registry&, entt::entity)
+	{
+		m_structureDirty = true;
+	}
+
+	entt::entity TransformHierarchy::ResolveParent(entt::entity entity) const
+	{
+		const auto* meta = m_registry.try_get<Components::EntityMetadata>(entity);
+		if (!meta) return entt::null;
+
+		const entt::entity parent = meta->parent;
+		if (parent == entt::null || parent == entity || !m_registry.valid(parent) || !m_registry.all_of<Components::Transform>(parent)) return entt::null;
+		return parent;
+	}
+
+	glm::mat4 TransformHierarchy::GetParentWorldMatrix(entt::entity entity) const
+	{
+		if (!m_structureDirty) {
+			const NodeIndex node = NodeOf(entity);
+			if (node != kInvalidNode) {
+				const NodeIndex parent = m_parents[node];
+				return parent == kInvalidNode ? glm::mat4(1.0f) : m_transforms[parent]->GetWorldMatrix();
+			}
+		}
+
+		// Order is stale (new entity / reparent this frame): resolve through the metadata.
+		const entt::entity parent = ResolveParent(entity);
+		if (parent == entt::null) return glm::mat4(1.0f);
+		return m_registry.get<Components::Transform>(parent).GetWorldMatrix();
+	}
+
+	void TransformHierarchy::Rebuild()
+	{
+		ZoneScopedN("TransformHierarchy::Rebuild");
+
+		auto view = m_registry.view<Components::Transform>();
+
+		std::vector<entt::entity> entities(view.begin(), view.end());
+		const auto                count = static_cast<NodeIndex>(entities.size());
+
+		// Sparse entity → position in `entities`, used to turn parent entities into indices.
+		std::vector<NodeIndex> slotOf;
+		for (NodeIndex i = 0; i < count; ++i) {
+			const auto index = static_cast<size_t>(entt::to_entity(entities[i]));
+			if (index >= slotOf.size()) slotOf.resize(index + 1, kInvalidNode);
+			slotOf[index] = i;
+		}
+
+		std::vector<NodeIndex> parentSlot(count, kInvalidNode);
+		for (NodeIndex i = 0; i < count; ++i) {
+			const entt::entity parent = ResolveParent(entities[i]);
+			if (parent != entt::null) parentSlot[i] = slotOf[static_cast<size_t>(entt::to_entity(parent))];
+		}
+
+		// Depth of every node; each chain is walked once thanks to memoization.
+		// -1 = unknown, -2 = on the chain currently being walked.
+		std::vector<int32_t>   depth(count, -1);
+		std::vector<NodeIndex> chain;
+		int32_t                maxDepth = 0;
+		for (NodeIndex i = 0; i < count; ++i) {
+			NodeIndex n = i;
+			while (n != kInvalidNode && depth[n] == -1) {
+				depth[n] = -2;
+				chain.push_back(n);
+				n = parentSlot[n];
+			}
+			if (n != kInvalidNode && depth[n] == -2) {
+				ENGINE_WARN("TransformHierarchy: parent cycle detected, treating entity as root");
+				parentSlot[chain.back()] = kInvalidNode;
+				n                        = kInvalidNode;
+			}
+			int32_t d = n == kInvalidNode ? -1 : depth[n];
+			for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+				depth[*it] = ++d;
+			}
+			maxDepth = std::max(maxDepth, d);
+			chain.clear();
+		}
+
+		// Counting sort by depth: parents land before children, each level is contiguous.
+		std::vector<NodeIndex> levelBegin(static_cast<size_t>(maxDepth + 2), 0);
+		for (NodeIndex i = 0; i < count; ++i) levelBegin[static_cast<size_t>(depth[i]) + 1]++;
+		for (size_t d = 1; d < levelBegin.size(); ++d) levelBegin[d] += levelBegin[d - 1];
+
+		std::vector<NodeIndex> nodeOfSlot(count);
+		{
+			std::vector<NodeIndex> cursor(levelBegin.begin(), levelBegin.end() - 1);
+			for (NodeIndex i = 0; i < count; ++i) nodeOfSlot[i] = cursor[static_cast<size_t>(depth[i])]++;
+		}
+
+		std::vector<entt::entity>           entitiesOut(count);
+		std::vector<NodeIndex>              parentsOut(count);
+		std::vector<glm::mat4>              localOut(count);
+		std::vector<glm::mat4>              worldOut(count);
+		std::vector<uint8_t>                dirtyOut(count);
+		std::vector<Components::Transform*> transformsOut(count);
+
+		for (NodeIndex i = 0; i < count; ++i) {
+			const entt::entity e      = entities[i];
+			const NodeIndex    node   = nodeOfSlot[i];
+			const NodeIndex    parent = parentSlot[i] == kInvalidNode ? kInvalidNode : nodeOfSlot[parentSlot[i]];
+
+			entitiesOut[node]   = e;
+			parentsOut[node]    = parent;
+			transformsOut[node] = &view.get<Components::Transform>(e);
+
+			// Keep cached matrices for nodes that survived with the same parent.
+			const NodeIndex old = NodeOf(e);
+			if (old != kInvalidNode) {
+				const NodeIndex    oldParent       = m_parents[old];
+				const entt::entity oldParentEntity = oldParent == kInvalidNode ? entt::null : m_entities[oldParent];
+				const entt::entity newParentEntity = parent == kInvalidNode ? entt::null : entities[parentSlot[i]];
+				localOut[node] = m_local[old];
+				worldOut[node] = m_world[old];
+				dirtyOut[node] = (m_dirty[old] || oldParentEntity != newParentEntity) ? 1 : 0;
+			}
+			else {
+				dirtyOut[node] = 1;
+			}
+		}
+
+		m_entities   = std::move(entitiesOut);
+		m_parents    = std::move(parentsOut);
+		m_local      = std::move(localOut);
+		m_world      = std::move(worldOut);
+		m_dirty      = std::move(dirtyOut);
+		m_transforms = std::move(transformsOut);
+		m_levelBegin = std::move(levelBegin);
+		m_changed.assign(count, 0);
+
+		m_nodeOf.assign(slotOf.size(), kInvalidNode);
+		for (NodeIndex node = 0; node < count; ++node) {
+			m_nodeOf[static_cast<size_t>(entt::to_entity(m_entities[node]))] = node;
+		}
+
+		m_structureDirty = false;
+	}
+
+	void TransformHierarchy::UpdateRange(NodeIndex begin, NodeIndex end)
+	{
+		for (NodeIndex i = begin; i < end; ++i) {
+			const NodeIndex parent        = m_parents[i];
+			const bool      parentChanged = parent != kInvalidNode && m_changed[parent];
+			if (!m_dirty[i] && !parentChanged) {
+				m_changed[i] = 0;
+				continue;
+			}
+
+			Components::Transform& transform = *m_transforms[i];
+			if (m_dirty[i]) {
+				m_local[i] = transform.GetLocalMatrix();
+				m_dirty[i] = 0;
+			}
+			m_world[i]            = parent == kInvalidNode ? m_local[i] : m_world[parent] * m_local[i];
+			transform.worldMatrix = m_world[i];
+			m_changed[i]          = 1;
+		}
+	}
+
+	void TransformHierarchy::Update()
+	{
+		ZoneScoped;
+
+		if (m_structureDirty) Rebuild();
+
+		std::atomic<uint32_t> updated{0};
+		for (size_t d = 0; d + 1 < m_levelBegin.size(); ++d) {
+			const NodeIndex levelBegin = m_levelBegin[d];
+			const int       levelSize  = static_cast<int>(m_levelBegin[d + 1] - levelBegin);
+			// Levels are processed in order; nodes within a level are independent.
+			GetThreadPool().ParallelFor(levelSize, kMinNodesPerTask, [&](int b, int e) {
+				UpdateRange(levelBegin + static_cast<NodeIndex>(b), levelBegin + static_cast<NodeIndex>(e));
+				uint32_t n = 0;
+				for (int i = b; i < e; ++i) n += m_changed[levelBegin + static_cast<NodeIndex>(i)];
+				updated.fetch_add(n, std::memory_order_relaxed);
+			});
+		}
+		m_lastUpdatedCount = updated.load(std::memory_order_relaxed);
+	}
+
+} // namespace Engine
@@ -0,0 +1,118 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "entt/entt.hpp"
+
+namespace Engine {
+	class Scene;
+	namespace Components {
+		class Transform;
+	}
+
+	/// Flat, depth-sorted mirror of a scene's Transform hierarchy.
+	///
+	/// Every Transform owns one node; nodes are stored as parallel arrays ordered
+	/// by depth, so a parent always sits before its children and each depth level
+	/// is one contiguous range. Transform setters flag their node dirty; Update()
+	/// then walks the arrays once and only recomputes world matrices for dirty
+	/// nodes and for nodes whose parent changed in the same pass. Static geometry
+	/// costs one byte test per frame.
+	///
+	/// Structural edits (Transform added / removed, reparenting) only mark the
+	/// order stale; it is rebuilt with a linear counting sort on the next Update,
+	/// keeping the cached matrices of nodes whose parent did not change.
+	class TransformHierarchy {
+	  public:
+		using NodeIndex                        = uint32_t;
+		static constexpr NodeIndex kInvalidNode = ~0u;
+
+		explicit TransformHierarchy(Scene& scene);
+		~TransformHierarchy();
+
+		TransformHierarchy(const TransformHierarchy&)            = delete;
+		TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+
+		/// Flag an entity's local transform as changed. Safe to call from worker
+		/// threads for distinct entities (each node has its own flag byte).
+		void MarkDirty(entt::entity entity)
+		{
+			const NodeIndex node = NodeOf(entity);
+			if (node != kInvalidNode) m_dirty[node] = 1;
+		}
+
+		/// A parent link changed somewhere; the order is rebuilt on the next Update.
+		void MarkStructureDirty() { m_structureDirty = true; }
+
+		/// Bring every world matrix up to date. Depth levels run on the ThreadPool.
+		void Update();
+
+		/// World matrix of `entity`'s parent, or identity for roots.
+		[[nodiscard]] glm::mat4 GetParentWorldMatrix(entt::entity entity) const;
+
+		/// True if the entity's world matrix was recomputed by the last Update.
+		[[nodiscard]] bool HasChanged(entt::entity entity) const
+		{
+			const NodeIndex node = NodeOf(entity);
+			return node != kInvalidNode && m_changed[node] != 0;
+		}
+
+		/// True if the entity was flagged since the last Update (its world matrix may
+		/// already have been written directly, e.g. by SetWorldTRS).
+		[[nodiscard]] bool IsDirty(entt::entity entity) const
+		{
+			const NodeIndex node = NodeOf(entity);
+			return node != kInvalidNode && m_dirty[node] != 0;
+		}
+
+		[[nodiscard]] size_t Size() const { return m_entities.size(); }
+		/// Nodes recomputed by the last Update.
+		[[nodiscard]] uint32_t GetLastUpdatedCount() const { return m_lastUpdatedCount; }
+
+	  private:
+		[[nodiscard]] NodeIndex NodeOf(entt::entity entity) const
+		{
+			const auto index = static_cast<size_t>(entt::to_entity(entity));
+			if (index >= m_nodeOf.size()) return kInvalidNode;
+			const NodeIndex node = m_nodeOf[index];
+			// Entity slots are recycled; make sure the node still belongs to this version.
+			if (node == kInvalidNode || node >= m_entities.size() || m_entities[node] != entity) return kInvalidNode;
+			return node;
+		}
+
+		/// Parent entity from EntityMetadata's runtime link, or entt::null for roots / parents without a Transform.
+		[[nodiscard]] entt::entity ResolveParent(entt::entity entity) const;
+
+		void Rebuild();
+		void UpdateRange(NodeIndex begin, NodeIndex end);
+
+		void OnTransformConstructed(entt::registry& registry, entt::entity entity);
+		void OnTransformDestroyed(entt::registry& registry, entt::entity entity);
+
+		entt::registry& m_registry;
+
+		// Node arrays, depth-sorted.
+		std::vector<entt::entity>           m_entities;
+		std::vector<NodeIndex>              m_parents;
+		std::vector<glm::mat4>              m_local;
+		std::vector<glm::mat4>              m_world;
+		std::vector<uint8_t>                m_dirty;   // local TRS changed since last Update
+		std::vector<uint8_t>                m_changed; // world recomputed by last Update
+		std::vector<Components::Transform*> m_transforms;
+		std::vector<NodeIndex>              m_levelBegin; // level d = [m_levelBegin[d], m_levelBegin[d + 1])
+
+		// entt::to_entity(e) → node.
+		std::vector<NodeIndex> m_nodeOf;
+
+		bool     m_structureDirty   = true;
+		uint32_t m_lastUpdatedCount = 0;
+	};
+
+} // namespace Engine
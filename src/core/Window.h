@@ -21,6 +21,7 @@ namespace Engine {
 
 
 		[[nodiscard]] std::string name() const override { return "WindowModule"; }
+		[[nodiscard]] UpdatePhase updatePhase() const override { return UpdatePhase::FrameBegin; }
 		void                      onInit() override;
 		void                      onGameStart() override;
 		void                      onUpdate(float dt) override;
@@ -56,10 +57,10 @@ namespace Engine {
 		std::vector<std::string>                 ConsumeDroppedFiles();
 		void                                     ClearDroppedFiles() { m_droppedFiles.clear(); m_dropAgeFrames = 0; }
 
-		int targetWidth;
-		int targetHeight;
-		int targetX;
-		int targetY;
+		int targetWidth  = 800;
+		int targetHeight = 600;
+		int targetX      = 0;
+		int targetY      = 0;
 
 	  private:
 		GLFWwindow*              m_window;
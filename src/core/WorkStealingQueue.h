@@ -0,0 +1,86 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace Engine {
+	struct Job;
+
+	/// Fixed-capacity Chase-Lev deque (Lê et al., "Correct and Efficient
+	/// Work-Stealing for Weak Memory Models"). The owning thread pushes/pops at the
+	/// bottom, any other thread steals from the top. Push fails when full — the
+	/// caller then runs the job inline.
+	class WorkStealingQueue {
+	  public:
+		static constexpr int64_t kCapacity = 4096;
+		static_assert((kCapacity & (kCapacity - 1)) == 0, "capacity must be a power of two");
+
+		/// Owner only.
+		bool Push(Job* job)
+		{
+			const int64_t b = m_bottom.load(std::memory_order_relaxed);
+			const int64_t t = m_top.load(std::memory_order_acquire);
+			if (b - t >= kCapacity) return false;
+
+			m_jobs[b & kMask].store(job, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			m_bottom.store(b + 1, std::memory_order_relaxed);
+			return true;
+		}
+
+		/// Owner only. LIFO — keeps the most recently pushed (cache-warm) job local.
+		Job* Pop()
+		{
+			const int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+			m_bottom.store(b, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t t = m_top.load(std::memory_order_relaxed);
+
+			if (t > b) {
+				// Empty.
+				m_bottom.store(b + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			Job* job = m_jobs[b & kMask].load(std::memory_order_relaxed);
+			if (t == b) {
+				// Last element — race against thieves for it.
+				if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+					job = nullptr;
+				}
+				m_bottom.store(b + 1, std::memory_order_relaxed);
+			}
+			return job;
+		}
+
+		/// Any thread. FIFO — thieves take the oldest (usually largest) work.
+		Job* Steal()
+		{
+			int64_t t = m_top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const int64_t b = m_bottom.load(std::memory_order_acquire);
+			if (t >= b) return nullptr;
+
+			Job* job = m_jobs[t & kMask].load(std::memory_order_relaxed);
+			if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+				return nullptr; // lost the race
+			}
+			return job;
+		}
+
+		[[nodiscard]] bool Empty() const { return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed); }
+
+	  private:
+		static constexpr int64_t kMask = kCapacity - 1;
+
+		alignas(64) std::atomic<int64_t> m_top{0};
+		alignas(64) std::atomic<int64_t> m_bottom{0};
+		alignas(64) std::array<std::atomic<Job*>, kCapacity> m_jobs{};
+	};
+
+} // namespace Engine
@@ -1,24 +1,31 @@
-#pragma once
-
+//
+// Created by gabe on 6/22/25.
+//
 
 #include "Module.h"
 
+#include <algorithm>
+
 namespace Engine {
-	class ModuleManager {
-	  public:
-		template <typename T>
-		void RegisterModule();
-		template <typename T>
-		void RegisterExternal(std::shared_ptr<T> mod);
-
-		void InitAll();
-		void StartGame();
-		void InitAllLuaBindings();
-		void UpdateAll(float dt);
-		void ShutdownAll();
-
-	  private:
-		std::vector<std::shared_ptr<Module>> m_modules;
-	};
+
+	void Module::declareUpdate(ModuleUpdateBuilder& update)
+	{
+		update.AddTask(name(), [this](float dt) { onUpdate(dt); }).InPhase(updatePhase());
+	}
+
+	bool ModuleTask::ConflictsWith(const ModuleTask& other) const
+	{
+		if (IsExclusive() || other.IsExclusive()) return true;
+
+		auto intersects = [](const std::vector<AccessKey>& a, const std::vector<AccessKey>& b) {
+			for (AccessKey k : a) {
+				if (std::find(b.begin(), b.end(), k) != b.end()) return true;
+			}
+			return false;
+		};
+
+		// Read/read is fine; any write against a read or write of the same key is not.
+		return intersects(writes, other.writes) || intersects(writes, other.reads) || intersects(reads, other.writes);
+	}
+
 } // namespace Engine
-#include "ModuleManager.inl"
@@ -2,6 +2,7 @@
 
 
 #include "utils/Logger.h"
+#include "ModuleUpdate.h"
 
 namespace Engine {
 	class Module {
@@ -14,5 +15,11 @@ namespace Engine {
 		virtual void                      setLuaBindings() {}
 		[[nodiscard]] virtual std::string name() const = 0;
 		std::shared_ptr<spdlog::logger>   log;
+
+		/// Describe per-frame work for the ModuleManager scheduler. The default is a
+		/// single main-thread task that calls onUpdate and conflicts with everything.
+		virtual void declareUpdate(ModuleUpdateBuilder& update);
+		/// Phase of the default onUpdate task.
+		[[nodiscard]] virtual UpdatePhase updatePhase() const { return UpdatePhase::Update; }
 	};
-} // namespace Engine
\ No newline at end of file
+} // namespace Engine
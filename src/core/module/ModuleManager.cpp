@@ -5,6 +5,10 @@
 
 #include "ModuleManager.h"
 #include "core/EngineData.h"
+#include "core/ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
 
 namespace Engine {
 
@@ -30,13 +34,81 @@ namespace Engine {
 		for (auto& module : m_modules) {
 			module->setLuaBindings();
 		}
+		// Scripts may still reference stand-ins (getWindow(), ...).
+		for (auto& module : m_standIns) {
+			module->setLuaBindings();
+		}
 	}
 
 	void ModuleManager::UpdateAll(float dt)
 	{
+		if (m_scheduleDirty) {
+			BuildSchedule();
+		}
+
+		m_frameDt = dt;
+		if (m_taskTiming) m_taskTimesMs.assign(m_tasks.size(), 0.0f);
+		if (m_parallelUpdate && Get().threadPool && GetThreadPool().IsRunning()) {
+			// Main-thread tasks run on this thread while it waits; the rest are
+			// picked up by workers as soon as their dependencies are done.
+			GetThreadPool().RunAndWait(m_frameGraph);
+		}
+		else {
+			for (size_t i = 0; i < m_tasks.size(); ++i) {
+				RunTask(i);
+			}
+		}
+	}
+
+	void ModuleManager::BuildSchedule()
+	{
+		m_tasks.clear();
+		m_frameGraph.Clear();
+
+		ModuleUpdateBuilder builder(m_tasks);
 		for (auto& module : m_modules) {
-			module->onUpdate(dt);
+			module->declareUpdate(builder);
+		}
+
+		// Phase first, then declaration (== registration) order.
+		std::stable_sort(m_tasks.begin(), m_tasks.end(), [](const ModuleTask& a, const ModuleTask& b) { return a.phase < b.phase; });
+
+		for (size_t i = 0; i < m_tasks.size(); ++i) {
+			const auto id = m_frameGraph.Add(m_tasks[i].name, [this, i]() { RunTask(i); });
+			m_frameGraph.SetMainThreadOnly(id, m_tasks[i].affinity == ThreadAffinity::MainThread);
+		}
+
+		// An earlier task that conflicts with a later one must finish first.
+		// Non-conflicting tasks are left unordered and may overlap.
+		for (size_t j = 0; j < m_tasks.size(); ++j) {
+			for (size_t i = 0; i < j; ++i) {
+				if (m_tasks[i].ConflictsWith(m_tasks[j])) {
+					m_frameGraph.Precede(static_cast<TaskGraph::TaskId>(i), static_cast<TaskGraph::TaskId>(j));
+				}
+			}
+		}
+
+		auto logger = GetDefaultLogger();
+		for (const auto& task : m_tasks) {
+			logger->debug("Frame task '{}' (phase {}, {})", task.name, static_cast<int>(task.phase), task.affinity == ThreadAffinity::MainThread ? "main thread" : "any thread");
 		}
+
+		m_scheduleDirty = false;
+	}
+
+	void ModuleManager::RunTask(size_t index)
+	{
+		ZoneScoped;
+		const ModuleTask& task = m_tasks[index];
+		ZoneName(task.name.c_str(), task.name.size());
+		if (!m_taskTiming) {
+			task.fn(m_frameDt);
+			return;
+		}
+
+		const auto start = std::chrono::steady_clock::now();
+		task.fn(m_frameDt);
+		m_taskTimesMs[index] = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
 	}
 
 	void ModuleManager::ShutdownAll()
@@ -50,5 +122,10 @@ namespace Engine {
 	void ModuleManager::Clear()
 	{
 		m_modules.clear();
+		m_standIns.clear();
+		m_tasks.clear();
+		m_taskTimesMs.clear();
+		m_frameGraph.Clear();
+		m_scheduleDirty = true;
 	}
 } // namespace Engine
\ No newline at end of file
@@ -8,6 +8,7 @@
 
 #include <unordered_map>
 #include "Module.h"
+#include "core/TaskGraph.h"
 
 namespace Engine {
 	class ModuleManager {
@@ -18,6 +19,12 @@ namespace Engine {
 		template <typename T>
 		void RegisterExternal(std::shared_ptr<T> mod);
 
+		/// Keep a module reachable (accessor, logger, Lua bindings) without ever
+		/// initializing, updating or shutting it down. Used for the render / audio /
+		/// UI modules in headless mode.
+		template <typename T>
+		void RegisterStandIn(std::shared_ptr<T> mod);
+
 		void InitAll();
 		void InitAllLuaBindings();
 		void UpdateAll(float dt);
@@ -26,8 +33,34 @@ namespace Engine {
 
 		void StartGame();
 
+		/// When false, module tasks run one after another on the main thread in
+		/// schedule order (useful when chasing threading bugs).
+		void SetParallelUpdate(bool parallel) { m_parallelUpdate = parallel; }
+		bool IsParallelUpdate() const { return m_parallelUpdate; }
+
+		/// Tasks in schedule order (phase, then declaration order).
+		const std::vector<ModuleTask>& GetScheduledTasks() const { return m_tasks; }
+
+		/// Time each task with a steady clock; read the results after UpdateAll.
+		void SetTaskTimingEnabled(bool enabled) { m_taskTiming = enabled; }
+		/// Milliseconds per task last frame, parallel to GetScheduledTasks(). Empty unless timing is enabled.
+		const std::vector<float>& GetTaskTimesMs() const { return m_taskTimesMs; }
+
 	  private:
+		/// Collect every module's declared tasks and build the frame DAG.
+		void BuildSchedule();
+		void RunTask(size_t index);
+
 		std::vector<std::shared_ptr<Module>> m_modules;
+		std::vector<std::shared_ptr<Module>> m_standIns;
+
+		std::vector<ModuleTask> m_tasks;
+		std::vector<float>      m_taskTimesMs; // one slot per task, each written only by its own task
+		TaskGraph               m_frameGraph;
+		float                   m_frameDt        = 0.0f;
+		bool                    m_scheduleDirty  = true;
+		bool                    m_parallelUpdate = true;
+		bool                    m_taskTiming     = false;
 	};
 } // namespace Engine
-#include "ModuleManager.inl"
\ No newline at end of file
+#include "ModuleManager.inl"
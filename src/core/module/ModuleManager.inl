@@ -8,6 +8,7 @@ void Engine::ModuleManager::RegisterModule()
 	auto module = std::make_shared<T>();
 	module->log = Logger::get(module->name());
 	m_modules.push_back(module);
+	m_scheduleDirty = true;
 }
 
 template <typename T>
@@ -18,4 +19,15 @@ void Engine::ModuleManager::RegisterExternal(std::shared_ptr<T> mod)
 
 	mod->log = Logger::get(mod->name());
 	m_modules.push_back(std::static_pointer_cast<Engine::Module>(mod));
+	m_scheduleDirty = true;
+}
+
+template <typename T>
+void Engine::ModuleManager::RegisterStandIn(std::shared_ptr<T> mod)
+{
+	ENGINE_ASSERT(mod, "module must not be null");
+	static_assert(std::is_base_of<Engine::Module, T>::value, "T must inherit from Module");
+
+	mod->log = Logger::get(mod->name());
+	m_standIns.push_back(std::static_pointer_cast<Engine::Module>(mod));
 }
\ No newline at end of file
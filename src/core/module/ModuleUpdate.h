@@ -0,0 +1,117 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "entt/entt.hpp"
+
+namespace Engine {
+
+	/// Coarse frame ordering. Tasks run phase by phase, then in module
+	/// registration order; within that order only conflicting tasks are
+	/// serialized, everything else may overlap.
+	enum class UpdatePhase : uint8_t {
+		FrameBegin,     // window events, input, camera, gameplay scripts
+		Simulation,     // physics stepping, animation pose evaluation
+		PostSimulation, // physics → transform sync, late scripts
+		Update,         // default for modules that don't declare anything finer
+	};
+
+	enum class ThreadAffinity : uint8_t {
+		MainThread, // GL / GLFW / ImGui / Lua / OpenAL
+		AnyThread,
+	};
+
+	/// Key for a piece of data a task touches: a component type or a named
+	/// engine resource ("PhysicsWorld", ...).
+	using AccessKey = entt::id_type;
+
+	/// One schedulable piece of a module's frame work.
+	struct ModuleTask {
+		std::string                name;
+		std::function<void(float)> fn;
+		UpdatePhase                phase    = UpdatePhase::Update;
+		ThreadAffinity             affinity = ThreadAffinity::MainThread;
+		std::vector<AccessKey>     reads;
+		std::vector<AccessKey>     writes;
+		size_t                     order = 0; // declaration order across all modules
+
+		/// Tasks that declare no access at all are treated as touching everything.
+		[[nodiscard]] bool IsExclusive() const { return reads.empty() && writes.empty(); }
+
+		[[nodiscard]] bool ConflictsWith(const ModuleTask& other) const;
+	};
+
+	/// Fluent access declaration returned by ModuleUpdateBuilder::AddTask.
+	class ModuleTaskBuilder {
+	  public:
+		explicit ModuleTaskBuilder(ModuleTask& task) : m_task(task) {}
+
+		ModuleTaskBuilder& InPhase(UpdatePhase phase)
+		{
+			m_task.phase = phase;
+			return *this;
+		}
+
+		/// Allow the scheduler to run this task on a ThreadPool worker.
+		ModuleTaskBuilder& OnAnyThread()
+		{
+			m_task.affinity = ThreadAffinity::AnyThread;
+			return *this;
+		}
+
+		template <typename T>
+		ModuleTaskBuilder& Reads()
+		{
+			m_task.reads.push_back(entt::type_hash<T>::value());
+			return *this;
+		}
+
+		template <typename T>
+		ModuleTaskBuilder& Writes()
+		{
+			m_task.writes.push_back(entt::type_hash<T>::value());
+			return *this;
+		}
+
+		ModuleTaskBuilder& ReadsResource(const char* resource)
+		{
+			m_task.reads.push_back(entt::hashed_string::value(resource));
+			return *this;
+		}
+
+		ModuleTaskBuilder& WritesResource(const char* resource)
+		{
+			m_task.writes.push_back(entt::hashed_string::value(resource));
+			return *this;
+		}
+
+	  private:
+		ModuleTask& m_task;
+	};
+
+	/// Passed to Module::declareUpdate; collects the module's tasks.
+	class ModuleUpdateBuilder {
+	  public:
+		explicit ModuleUpdateBuilder(std::vector<ModuleTask>& tasks) : m_tasks(tasks) {}
+
+		ModuleTaskBuilder AddTask(std::string name, std::function<void(float)> fn)
+		{
+			ModuleTask& task = m_tasks.emplace_back();
+			task.name        = std::move(name);
+			task.fn          = std::move(fn);
+			task.order       = m_tasks.size() - 1;
+			return ModuleTaskBuilder(task);
+		}
+
+	  private:
+		std::vector<ModuleTask>& m_tasks;
+	};
+
+} // namespace Engine
@@ -1,12 +1,87 @@
 #include "core/Engine.h"
+#include "assets/impl/PackedSceneLoader.h"
+#include "utils/StartupScene.h"
 
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
 
 using namespace Engine;
 
-int main()
+namespace {
+	GEngine* g_engine = nullptr;
+
+	void HandleStopSignal(int /*signal*/)
+	{
+		if (g_engine) g_engine->RequestStop();
+	}
+
+	void PrintUsage(const char* exe)
+	{
+		spdlog::info("Usage: {} [--headless] [--tick-rate=<hz>] [--ticks=<n>] [--record=<file>] [--replay=<file>] [--report=<file>] [--pack-scene=<file>]", exe);
+		spdlog::info("  --headless        run scripts / physics / animation without window, GL or audio");
+		spdlog::info("  --tick-rate=<hz>  headless ticks per second, 0 = as fast as possible (default 60)");
+		spdlog::info("  --ticks=<n>       headless: exit after n ticks (default: run until SIGINT)");
+		spdlog::info("  --record=<file>   record per-frame dt, input and the script random seed");
+		spdlog::info("  --replay=<file>   replay a recording frame by frame, then exit");
+		spdlog::info("  --report=<file>   write frame / module task timings (mean, p50, p99) as JSON on exit");
+		spdlog::info("  --pack-scene=<file>  convert a .json / .bin scene to the packed format in scenes/<name>.bin, then exit");
+	}
+} // namespace
+
+int main(int argc, char** argv)
 {
+#ifdef HEADLESS_BUILD
+	bool headless = true;
+#else
+	bool headless = false;
+#endif
+	float       tickRate = 60.0f;
+	uint64_t    maxTicks = 0;
+	std::string recordPath, replayPath, reportPath;
+
+	for (int i = 1; i < argc; ++i) {
+		const char* arg = argv[i];
+		if (std::strcmp(arg, "--headless") == 0) {
+			headless = true;
+		}
+		else if (std::strncmp(arg, "--tick-rate=", 12) == 0) {
+			tickRate = std::strtof(arg + 12, nullptr);
+		}
+		else if (std::strncmp(arg, "--ticks=", 8) == 0) {
+			maxTicks = std::strtoull(arg + 8, nullptr, 10);
+		}
+		else if (std::strncmp(arg, "--record=", 9) == 0) {
+			recordPath = arg + 9;
+		}
+		else if (std::strncmp(arg, "--replay=", 9) == 0) {
+			replayPath = arg + 9;
+		}
+		else if (std::strncmp(arg, "--report=", 9) == 0) {
+			reportPath = arg + 9;
+		}
+		else if (std::strncmp(arg, "--pack-scene=", 13) == 0) {
+			const std::string source = arg + 13;
+			return PackedSceneLoader::ConvertScene(source, SceneBinPathFromSource(source)) ? 0 : -1;
+		}
+		else {
+			spdlog::warn("Unknown argument: {}", arg);
+			PrintUsage(argv[0]);
+			return -1;
+		}
+	}
+
 	spdlog::info("Running in {}", std::filesystem::current_path().string());
-	GEngine engine(1600, 1200, "cpp-engine");
+	GEngine engine(1600, 1200, "cpp-engine", headless);
+	engine.tickRate   = tickRate;
+	engine.maxTicks   = maxTicks;
+	engine.recordPath = recordPath;
+	engine.replayPath = replayPath;
+	engine.reportPath = reportPath;
+
+	g_engine = &engine;
+	std::signal(SIGINT, HandleStopSignal);
+	std::signal(SIGTERM, HandleStopSignal);
 
 	if (!engine.Initialize()) {
 		spdlog::critical("Failed to init engine");
@@ -15,5 +90,6 @@ int main()
 
 	engine.Run();
 	engine.Shutdown();
+	g_engine = nullptr;
 	return 0;
 }
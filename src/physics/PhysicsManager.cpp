@@ -4,6 +4,7 @@
 #include "core/EngineData.h"
 #include "scripting/ScriptManager.h"
 #include "components/impl/RigidBodyComponent.h"
+#include "components/impl/LuaScriptComponent.h"
 #include "Jolt/Physics/Character/CharacterVirtual.h"
 #include "Jolt/Physics/Collision/RayCast.h"
 #include "Jolt/Physics/Collision/CastResult.h"
@@ -36,6 +37,18 @@ namespace Engine {
 		return physics;
 	}
 
+	BodyInterface* PhysicsManager::GetBodyInterface()
+	{
+		return physics ? &physics->GetBodyInterface() : nullptr;
+	}
+
+	void PhysicsManager::KeepBodyAdded(const BodyID& body)
+	{
+		if (!physics || body.IsInvalid()) return;
+		BodyInterface& bodies = physics->GetBodyInterface();
+		if (!bodies.IsAdded(body)) bodies.AddBody(body, EActivation::DontActivate);
+	}
+
 	bool PhysicsManager::Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, glm::vec3& outHitPoint, float& outDistance) const
 	{
 		glm::vec3 unusedNormal{};
@@ -134,6 +147,8 @@ namespace Engine {
 
 	void PhysicsManager::onGameStart()
 	{
+		ResetStepping();
+
 		// Bodies are created in OnAdded from whatever world cache existed at load
 		// (often just a copy of local). Rebuild the hierarchy and push kinematic
 		// poses before the first physics step.
@@ -143,27 +158,92 @@ namespace Engine {
 	void PhysicsManager::onUpdate(float dt)
 	{
 		ZoneScopedNC("Physics Update", 0x46556D);
-		// Collision Steps to simulate. Should be around 1 per 16ms
-		int cCollisionSteps = static_cast<int>(glm::ceil(dt * 60.0f));
-		// Retrieve the maximum number of jobs the job system can handle
-		int maxJobs = jobs->GetMaxConcurrency();
-		// Limit the number of collision steps to the maximum number of available jobs
-		cCollisionSteps = std::min(cCollisionSteps, maxJobs);
-		// Step the world
-		if (IsSimulating()) {
+		StepSimulation(dt);
+		SyncAfterStep(dt);
+	}
+
+	void PhysicsManager::declareUpdate(ModuleUpdateBuilder& update)
+	{
+		update.AddTask("Physics Step", [this](float dt) { StepSimulation(dt); })
+		    .InPhase(UpdatePhase::Simulation)
+		    .OnAnyThread()
+		    .WritesResource("PhysicsWorld")
+		    .Reads<Components::LuaScript>(); // contact listener queues script collisions
+		update.AddTask("Physics Sync", [this](float dt) { SyncAfterStep(dt); }).InPhase(UpdatePhase::PostSimulation);
+	}
+
+	void PhysicsManager::StepSimulation(float dt)
+	{
+		ZoneScopedNC("Physics Step", 0x46556D);
+		if (!IsSimulating()) {
+			ResetStepping();
+			return;
+		}
+
+		m_accumulator += dt;
+		int steps = static_cast<int>(m_accumulator / fixedTimestep);
+		m_accumulator -= static_cast<float>(steps) * fixedTimestep;
+		if (steps > maxStepsPerFrame) {
+			// Too far behind to catch up within budget: run the budget, drop the rest.
+			steps = std::max(maxStepsPerFrame, 1);
+		}
+
+		for (int i = 0; i < steps; ++i) {
+			// Counted before recording, so the poses carry the step number this frame ends on.
+			++m_stepCount;
+			if (i == steps - 1 && interpolate) RecordPreviousPoses();
+
 			// Update Character controller
 			{
 				ZoneScopedNC("Update Player Controller", 0x46556D);
-				controller->Update(character, physics, allocater, dt);
+				controller->Update(character, physics, allocater, fixedTimestep);
 			}
 
 			// Update Physics
 			{
 				ZoneScopedNC("Step Physics", 0x46556D);
-				physics->Update(dt, cCollisionSteps, allocater.get(), jobs.get());
+				physics->Update(fixedTimestep, 1, allocater.get(), jobs.get());
 			}
 		}
 
+		m_stepsLastFrame     = steps;
+		m_interpolationAlpha = m_accumulator / fixedTimestep;
+	}
+
+	void PhysicsManager::RecordPreviousPoses()
+	{
+		ZoneScopedNC("Record Physics Poses", 0x46556D);
+		if (m_previousPoses.size() < physics->GetMaxBodies()) m_previousPoses.resize(physics->GetMaxBodies());
+
+		// Sleeping bodies are skipped: they won't move, so the sync uses their current pose.
+		physics->GetActiveBodies(EBodyType::RigidBody, m_activeBodies);
+		const BodyInterface& body_interface = physics->GetBodyInterface();
+		for (const BodyID& id : m_activeBodies) {
+			const RVec3 p    = body_interface.GetCenterOfMassPosition(id);
+			const Quat  q    = body_interface.GetRotation(id);
+			BodyPose&   pose = m_previousPoses[id.GetIndex()];
+			pose.position    = glm::vec3(p.GetX(), p.GetY(), p.GetZ());
+			pose.rotation    = glm::quat(q.GetW(), q.GetX(), q.GetY(), q.GetZ());
+			pose.id          = id;
+			pose.step        = m_stepCount; // the step about to run
+		}
+	}
+
+	void PhysicsManager::ResetStepping()
+	{
+		m_accumulator        = 0.0f;
+		m_interpolationAlpha = 0.0f;
+		m_stepsLastFrame     = 0;
+		m_stepCount++; // invalidates recorded poses
+	}
+
+	void PhysicsManager::SetStepRate(float hz)
+	{
+		fixedTimestep = 1.0f / glm::clamp(hz, 1.0f, 1000.0f);
+	}
+
+	void PhysicsManager::SyncAfterStep(float dt)
+	{
 		// Only pull physics → transform while simulating. Doing this in the editor
 		// overwrote authored local rotations (quat_cast on a scaled matrix) every frame.
 		if (IsSimulating()) {
@@ -243,7 +323,19 @@ namespace Engine {
 			                                                    result["distance"] = hitDistance;
 			                                                    result["fraction"] = (maxDistance > 0.0f) ? (hitDistance / maxDistance) : 0.0f;
 			                                                    return sol::make_object(GetScriptManager().lua, result);
-		                                                    });
+		                                                    },
+		                                                    "getStepRate",
+		                                                    &PhysicsManager::GetStepRate,
+		                                                    "setStepRate",
+		                                                    &PhysicsManager::SetStepRate,
+		                                                    "getMaxStepsPerFrame",
+		                                                    [](PhysicsManager& self) { return self.maxStepsPerFrame; },
+		                                                    "setMaxStepsPerFrame",
+		                                                    [](PhysicsManager& self, int steps) { self.maxStepsPerFrame = std::max(steps, 1); },
+		                                                    "getInterpolationAlpha",
+		                                                    &PhysicsManager::GetInterpolationAlpha,
+		                                                    "setInterpolation",
+		                                                    [](PhysicsManager& self, bool enabled) { self.interpolate = enabled; });
 
 		// Provide access to the main PhysicsManager
 		GetScriptManager().lua.set_function("getPhysics", []() -> PhysicsManager& { return Engine::GetPhysics(); });
@@ -343,22 +435,8 @@ namespace Engine {
 			glm::vec3 worldPos = controller.GetPosition();
 			glm::quat worldRot = controller.GetRotation();
 
-			auto hr = GetCurrentSceneRegistry().get<Components::EntityMetadata>(entity);
-
-			if (!hr.parentEntity.IsValid()) {
-				// Root: local == world so later Scene::UpdateTransforms keeps the capsule pose.
-				tr.SetLocalPosition(worldPos);
-				tr.SetLocalRotation(worldRot);
-			}
-			else {
-				auto parentEntity = GetCurrentScene()->Get(hr.parentEntity);
-				if (parentEntity && parentEntity.HasComponent<Engine::Components::Transform>()) {
-					auto& parentTr = parentEntity.GetComponent<Engine::Components::Transform>();
-					tr.SetLocalFromWorld(parentTr.GetWorldMatrix(), worldPos, worldRot, tr.GetWorldScale());
-				}
-			}
-
-			tr.SetWorldFromMatrix(Components::Transform::ComposeTRS(worldPos, worldRot, tr.GetWorldScale()));
+			// Bakes into local TRS so the next hierarchy update keeps the capsule pose.
+			tr.SetWorldTRS(worldPos, worldRot, tr.GetWorldScale());
 		}
 	}
 
@@ -368,9 +446,8 @@ namespace Engine {
 		if (!physics) return;
 
 		struct SyncItem {
-			entt::entity                          entity{};
-			Components::Transform*                tr = nullptr;
-			Components::RigidBodyComponent*       rb = nullptr;
+			Components::Transform*          tr = nullptr;
+			Components::RigidBodyComponent* rb = nullptr;
 		};
 
 		std::vector<SyncItem> items;
@@ -380,12 +457,13 @@ namespace Engine {
 			if (rb.bodyID.IsInvalid()) continue;
 			// Kinematic / static bodies are driven by the transform hierarchy.
 			if (rb.motionType != static_cast<int>(EMotionType::Dynamic)) continue;
-			items.push_back(SyncItem{entity, &tr, &rb});
+			items.push_back(SyncItem{&tr, &rb});
 		}
 
 		// Jolt Get* body queries are multi-thread safe; each item writes only its own Transform.
 		BodyInterface& body_interface = physics->GetBodyInterface();
 		const int      n              = static_cast<int>(items.size());
+		const float    alpha          = m_interpolationAlpha;
 		GetThreadPool().ParallelForIndex(n, /*minPerTask=*/4, [&](int i) {
 			auto& item = items[static_cast<size_t>(i)];
 			auto& tr   = *item.tr;
@@ -398,30 +476,26 @@ namespace Engine {
 
 			DecomposeMatrix(tform, worldPos, worldRot, scl);
 
+			// Render between the pose before the latest step and the latest one.
+			if (interpolate) {
+				const uint32_t index = rb.bodyID.GetIndex();
+				if (index < m_previousPoses.size()) {
+					const BodyPose& prev = m_previousPoses[index];
+					if (prev.id == rb.bodyID && prev.step == m_stepCount) {
+						worldPos = glm::mix(prev.position, worldPos, alpha);
+						worldRot = glm::slerp(prev.rotation, worldRot, alpha);
+					}
+				}
+			}
+
 			if (rb.centerOfMassOffset.LengthSq() > 0.0f) {
 				glm::vec3 offsetGlm     = glm::vec3(rb.centerOfMassOffset.GetX(), rb.centerOfMassOffset.GetY(), rb.centerOfMassOffset.GetZ());
 				glm::vec3 rotatedOffset = worldRot * offsetGlm;
 				worldPos -= rotatedOffset;
 			}
 
-			tr.SetWorldPosition(worldPos);
-			tr.SetWorldRotation(worldRot);
-
-			auto& hr = GetCurrentSceneRegistry().get<Components::EntityMetadata>(item.entity);
-
-			if (!hr.parentEntity.IsValid()) {
-				tr.SetLocalPosition(worldPos);
-				tr.SetLocalRotation(worldRot);
-			}
-			else {
-				auto parentEntity = GetCurrentScene()->Get(hr.parentEntity);
-				if (parentEntity && parentEntity.HasComponent<Components::Transform>()) {
-					auto& parentTr = parentEntity.GetComponent<Components::Transform>();
-					tr.SetLocalFromWorld(parentTr.GetWorldMatrix(), worldPos, worldRot, tr.GetWorldScale());
-				}
-			}
-
-			tr.SetWorldFromMatrix(Components::Transform::ComposeTRS(worldPos, worldRot, tr.GetWorldScale()));
+			// Parent lookup goes through the flat hierarchy; only this node's dirty byte is written.
+			tr.SetWorldTRS(worldPos, worldRot, tr.GetWorldScale());
 		});
 	}
 
@@ -441,4 +515,4 @@ namespace Engine {
 	}
 
 
-} // namespace Engine
\ No newline at end of file
+} // namespace Engine
\ No newline at end of file
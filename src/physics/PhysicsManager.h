@@ -65,10 +65,22 @@ namespace Engine {
 		void        onShutdown() override;
 		std::string name() const override { return "PhysicsManger"; };
 		void        setLuaBindings() override;
+		void        declareUpdate(ModuleUpdateBuilder& update) override;
+
+		/// Player controller + Jolt step. Touches only the physics world, so the
+		/// scheduler may run it on a worker alongside other simulation work.
+		/// Advances in whole `fixedTimestep` steps; the remainder carries over.
+		void StepSimulation(float dt);
+		/// Physics → transform sync and late script updates (main thread).
+		void SyncAfterStep(float dt);
 
 		void                              SyncPhysicsEntities();
 		void                              SyncCharacterEntities();
 		std::shared_ptr<PhysicsSystem>    GetPhysicsSystem();
+		/// Null before onInit.
+		BodyInterface*                    GetBodyInterface();
+		/// Scene switches remove every body from the world; put back one that outlives scenes (terrain, trees).
+		void                              KeepBodyAdded(const BodyID& body);
 		std::shared_ptr<CharacterVirtual> GetCharacter();
 		PlayerController*                 GetPlayerController();
 		const PlayerController*           GetPlayerController() const;
@@ -80,6 +92,20 @@ namespace Engine {
 		/// Same as Raycast, also writes outward surface normal at the hit (world space).
 		bool Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, glm::vec3& outHitPoint, glm::vec3& outNormal, float& outDistance) const;
 
+		/// Seconds per physics step (default 60 Hz).
+		float fixedTimestep = 1.0f / 60.0f;
+		/// Steps a single frame may take; time beyond that is dropped instead of
+		/// making the next frame slower still.
+		int   maxStepsPerFrame = 4;
+		/// Blend dynamic bodies between the last two steps when syncing transforms.
+		bool  interpolate = true;
+
+		void                SetStepRate(float hz);
+		[[nodiscard]] float GetStepRate() const { return 1.0f / fixedTimestep; }
+		/// How far the frame is between the previous and the latest step, in [0, 1).
+		[[nodiscard]] float GetInterpolationAlpha() const { return m_interpolationAlpha; }
+		[[nodiscard]] int   GetStepsLastFrame() const { return m_stepsLastFrame; }
+
 		BPLayerInterfaceImpl              broad_phase_layer_interface;
 		ObjectVsBroadPhaseLayerFilterImpl object_vs_broadphase_layer_filter;
 		ObjectLayerPairFilterImpl         object_vs_object_layer_filter;
@@ -87,5 +113,24 @@ namespace Engine {
 		BodyActivationListenerImpl        body_activation_listener;
 
 		std::unordered_map<JPH::BodyID, Entity> bodyToEntityMap;
+
+	  private:
+		/// Centre-of-mass pose of a body before the latest step.
+		struct BodyPose {
+			glm::vec3   position{};
+			glm::quat   rotation{1.0f, 0.0f, 0.0f, 0.0f};
+			JPH::BodyID id;
+			uint32_t    step = 0; // m_stepCount when recorded
+		};
+
+		void RecordPreviousPoses();
+		void ResetStepping();
+
+		float                 m_accumulator        = 0.0f;
+		float                 m_interpolationAlpha = 0.0f;
+		int                   m_stepsLastFrame     = 0;
+		uint32_t              m_stepCount          = 0;
+		std::vector<BodyPose> m_previousPoses; // indexed by BodyID::GetIndex()
+		JPH::BodyIDVector     m_activeBodies;
 	};
-} // namespace Engine
\ No newline at end of file
+} // namespace Engine
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "Material.h"
 
+#include <cstring>
 #include <utility>
 
 namespace Engine {
@@ -71,4 +72,36 @@ namespace Engine {
 	{
 		m_textureScale = textureScale;
 	}
+
+	Rendering::MaterialUniforms Material::BuildUniforms() const
+	{
+		Rendering::MaterialUniforms uniforms{};
+		uniforms.diffuseColor       = glm::vec4(m_diffuseColor, 1.0f);
+		uniforms.specularColor      = glm::vec4(m_specularColor, 1.0f);
+		uniforms.ambientColor       = glm::vec4(m_ambientColor, 1.0f);
+		uniforms.emissiveColor      = glm::vec4(m_emissiveColor, 1.0f);
+		uniforms.textureScale       = m_textureScale;
+		uniforms.shininess          = m_shininess;
+		uniforms.hasDiffuseTexture  = m_diffuseTexture.IsValid() ? 1 : 0;
+		uniforms.hasNormalTexture   = m_normalTexture.IsValid() ? 1 : 0;
+		uniforms.hasSpecularTexture = m_specularTexture.IsValid() ? 1 : 0;
+		return uniforms;
+	}
+
+	GLuint Material::GetUniformBuffer() const
+	{
+		// Comparing 96 bytes is cheaper than tracking every writer (the material editor edits fields directly).
+		const Rendering::MaterialUniforms uniforms = BuildUniforms();
+		UniformCache&                     cache    = m_uniformCache;
+		if (!cache.buffer) {
+			cache.buffer = std::make_unique<Rendering::UniformBuffer>();
+			cache.buffer->Create(sizeof(Rendering::MaterialUniforms));
+		}
+		if (!cache.valid || std::memcmp(&uniforms, &cache.uploaded, sizeof(uniforms)) != 0) {
+			cache.buffer->Update(&uniforms, sizeof(uniforms));
+			cache.uploaded = uniforms;
+			cache.valid    = true;
+		}
+		return cache.buffer->GetID();
+	}
 } // namespace Engine
\ No newline at end of file
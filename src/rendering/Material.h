@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Texture.h"
+#include "rendering/UniformBuffers.h"
 
 
 
@@ -46,6 +47,10 @@ namespace Engine {
 		void                             SetName(const std::string& name) { m_name = name; }
 		[[nodiscard]] const std::string& GetName() const { return m_name; }
 
+		/// std140 MaterialData buffer (binding Rendering::kMaterialDataBinding). Created on first use and
+		/// re-uploaded only when a property changed since the previous call. Needs a GL context.
+		[[nodiscard]] GLuint GetUniformBuffer() const;
+
 		std::string m_path;
 
 	  private:
@@ -68,5 +73,23 @@ namespace Engine {
 
 		// Material name
 		std::string m_name;
+
+		/// GPU copy of the properties above. Copies of a Material get their own buffer.
+		struct UniformCache {
+			std::unique_ptr<Rendering::UniformBuffer> buffer;
+			Rendering::MaterialUniforms               uploaded{};
+			bool                                      valid = false;
+
+			UniformCache() = default;
+			UniformCache(const UniformCache&) {}
+			UniformCache& operator=(const UniformCache&)
+			{
+				valid = false;
+				return *this;
+			}
+		};
+		mutable UniformCache m_uniformCache;
+
+		[[nodiscard]] Rendering::MaterialUniforms BuildUniforms() const;
 	};
 } // namespace Engine
\ No newline at end of file
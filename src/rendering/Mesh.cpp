@@ -10,6 +10,7 @@
 
 #include <spdlog/spdlog.h>
 #include "rendering/Renderer.h"
+#include "rendering/queue/GLInstanceBuffer.h"
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 
@@ -20,13 +21,16 @@ namespace Engine {
 		std::unordered_set<GLuint> Mesh::s_vbos;
 		std::unordered_set<GLuint> Mesh::s_ebos;
 
-		Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, const std::shared_ptr<Material>& material) : m_vertices(vertices), m_indices(indices), m_material(material), m_vao(0), m_vbo(0), m_ebo(0)
+		Mesh::Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::shared_ptr<Material> material) : m_vertices(std::move(vertices)), m_indices(std::move(indices)), m_material(std::move(material)), m_vao(0), m_vbo(0), m_ebo(0)
 		{
 			SetupMesh();
 		}
 
 		void Mesh::SetupMesh()
 		{
+			// Headless: keep the CPU copy (colliders, bounds), there is no GL context.
+			if (IsHeadless()) return;
+
 			glGenVertexArrays(1, &m_vao);
 			glGenBuffers(1, &m_vbo);
 			glGenBuffers(1, &m_ebo);
@@ -58,6 +62,9 @@ namespace Engine {
 			glEnableVertexAttribArray(4);
 			glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*) offsetof(Vertex, Bitangent));
 
+			// World matrix + entity id per instance, from the shared per-frame buffer.
+			GLInstanceBuffer::SetupAttributes();
+
 			glBindVertexArray(0);
 		}
 
@@ -86,18 +93,23 @@ namespace Engine {
 					}
 					ENGINE_GLCheckError();
 
-					shader.SetInt("hasDiffuseTexture", mat->GetDiffuseTexture().IsValid() ? 1 : 0);
-					shader.SetInt("hasNormalTexture", mat->GetNormalTexture().IsValid() ? 1 : 0);
-					shader.SetInt("hasSpecularTexture", mat->GetSpecularTexture().IsValid() ? 1 : 0);
+					if (shader.UsesUniformBlock(kMaterialDataBinding)) {
+						glBindBufferBase(GL_UNIFORM_BUFFER, kMaterialDataBinding, mat->GetUniformBuffer());
+					}
+					else {
+						shader.SetInt("hasDiffuseTexture", mat->GetDiffuseTexture().IsValid() ? 1 : 0);
+						shader.SetInt("hasNormalTexture", mat->GetNormalTexture().IsValid() ? 1 : 0);
+						shader.SetInt("hasSpecularTexture", mat->GetSpecularTexture().IsValid() ? 1 : 0);
 
-					shader.SetVec2("textureScale", mat->GetTextureScale());
+						shader.SetVec2("textureScale", mat->GetTextureScale());
 
 
-					shader.SetVec3("uDiffuseColor", mat->GetDiffuseColor());
-					shader.SetVec3("uSpecularColor", mat->GetSpecularColor());
-					shader.SetVec3("uAmbientColor", mat->GetAmbientColor());
-					shader.SetVec3("uEmissiveColor", mat->GetEmissiveColor());
-					shader.SetFloat("uShininess", mat->GetShininess());
+						shader.SetVec3("uDiffuseColor", mat->GetDiffuseColor());
+						shader.SetVec3("uSpecularColor", mat->GetSpecularColor());
+						shader.SetVec3("uAmbientColor", mat->GetAmbientColor());
+						shader.SetVec3("uEmissiveColor", mat->GetEmissiveColor());
+						shader.SetFloat("uShininess", mat->GetShininess());
+					}
 				}
 				else {
 					shader.SetInt("hasDiffuseTexture", 0);
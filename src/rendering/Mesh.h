@@ -23,7 +23,7 @@ namespace Engine::Rendering {
 
 	class Mesh {
 	  public:
-		Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, const std::shared_ptr<Material>& material);
+		Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::shared_ptr<Material> material);
 		~Mesh() = default;
 
 		void                                           Draw(const Shader& shader, bool cullBackfaces, bool uploadMaterial, const MaterialHandle& materialOverride) const;
@@ -32,8 +32,9 @@ namespace Engine::Rendering {
 		[[nodiscard]] const std::shared_ptr<Material>& GetMaterial() const { return m_material; }
 		[[nodiscard]] const std::vector<Vertex>&       GetVertices() const { return m_vertices; }
 		[[nodiscard]] const std::vector<unsigned int>& GetIndices() const { return m_indices; }
+		[[nodiscard]] uint32_t                         GetIndexCount() const { return static_cast<uint32_t>(m_indices.size()); }
 
-        [[nodiscard]] GLuint GetVAO() { return m_vao; }
+        [[nodiscard]] GLuint GetVAO() const { return m_vao; }
         [[nodiscard]] GLuint GetVBO() { return m_vbo; }
         [[nodiscard]] GLuint GetEBO() { return m_ebo; }
 
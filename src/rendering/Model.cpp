@@ -1,6 +1,7 @@
 #include "Model.h"
 
 #include "assets/impl/ModelLoader.h"
+#include "rendering/queue/GLRenderCommands.h"
 
 
 
@@ -21,4 +22,42 @@ namespace Engine::Rendering {
 			mesh->Draw(shader, cullBackfaces, uploadMaterial, materialOverrides[j++]);
 		}
 	}
+
+	void Model::Enqueue(RenderQueue& queue, uint32_t transform, entt::entity entity, float depth, bool cullBackfaces, const std::vector<MaterialHandle>* materialOverrides, uint8_t pipeline) const
+	{
+		for (size_t i = 0; i < m_meshes.size(); ++i) {
+			const Mesh& mesh = *m_meshes[i];
+
+			// Same rule as Mesh::Draw: a set override wins, even if it is not loaded.
+			const Material* material = mesh.GetMaterial().get();
+			if (materialOverrides && i < materialOverrides->size() && (*materialOverrides)[i].IsValid()) {
+				material = GetAssetManager().Get((*materialOverrides)[i]);
+			}
+
+			DrawItem item;
+			item.material      = material;
+			item.vertexArray   = mesh.GetVAO();
+			item.indexCount    = mesh.GetIndexCount();
+			item.transform     = transform;
+			item.entity        = entity;
+			item.pipeline      = pipeline;
+			item.cullBackfaces = cullBackfaces;
+			queue.Add(item, depth);
+		}
+	}
+
+	void Model::EnqueueDepth(RenderQueue& queue, uint32_t transform, entt::entity entity) const
+	{
+		for (const auto& mesh : m_meshes) {
+			DrawItem item;
+			item.material    = DepthOnlyMaterial(mesh->GetMaterial().get());
+			item.vertexArray = mesh->GetVAO();
+			item.indexCount  = mesh->GetIndexCount();
+			item.transform   = transform;
+			item.entity      = entity;
+			queue.Add(item, 0.0f);
+		}
+	}
 } // namespace Engine::Rendering
+
+#include "assets/AssetManager.inl"
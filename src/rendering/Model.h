@@ -2,6 +2,7 @@
 
 #include "Mesh.h"
 #include "Shader.h"
+#include "rendering/queue/RenderQueue.h"
 
 
 
@@ -16,6 +17,10 @@ namespace Engine::Rendering {
 
 		void Draw(const Shader& shader, bool cullBackfaces, bool uploadMaterial) const;
 		void Draw(const Shader& shader, bool cullBackfaces, bool uploadMaterial, const std::vector<MaterialHandle>& materialOverrides) const;
+		/// Queue one draw per mesh. `materialOverrides` may be null (mesh materials only).
+		void Enqueue(RenderQueue& queue, uint32_t transform, entt::entity entity, float depth, bool cullBackfaces, const std::vector<MaterialHandle>* materialOverrides, uint8_t pipeline = 0) const;
+		/// Queue for a GLRenderCommands::kDepthOnly pass: mesh materials through DepthOnlyMaterial, faces culled.
+		void EnqueueDepth(RenderQueue& queue, uint32_t transform, entt::entity entity) const;
 
 		[[maybe_unused]] [[nodiscard]] const std::vector<std::shared_ptr<Mesh>>& GetMeshes() const { return m_meshes; }
 
@@ -5,6 +5,7 @@
 
 #include "core/EngineData.h"
 #include "core/Input.h"
+#include "core/Scene.h"
 #include "terrain/TerrainManager.h"
 #include "animation/AnimationManager.h"
 #include "rendering/particles/ParticleManager.h"
@@ -25,6 +26,8 @@
 
 #include "components/impl/AnimationComponent.h"
 #include "Texture.h"
+#include "rendering/queue/GLInstanceBuffer.h"
+#include "rendering/queue/GLRenderCommands.h"
 
 #include <random>
 
@@ -79,6 +82,8 @@ namespace Engine {
             InitFullscreenQuad();
         }
 
+        m_frameUniforms.Create(sizeof(Rendering::FrameUniforms));
+
         {
             ZoneScopedN("Generate SSAO kernel");
             // Generate ssao kernel
@@ -160,6 +165,8 @@ namespace Engine {
     void Renderer::onShutdown() {
         Texture::CleanAllTextures();
         Rendering::Mesh::CleanAllMeshes();
+        Rendering::GLInstanceBuffer::CleanUp();
+        m_frameUniforms.Destroy();
 
         m_skybox.reset();
         if (m_text3DRenderer) {
@@ -221,24 +228,8 @@ namespace Engine {
         glActiveTexture(GL_TEXTURE7);
         glBindTexture(GL_TEXTURE_2D, GetWindow().GetGBuffer()->GetEmissive());
 
+        // Samplers use layout(binding); camera, light and cascades come from FrameData.
         glm::mat4 V = GetCamera().GetViewMatrix();
-        glm::mat4 viewInv = glm::inverse(V);
-        m_lightingShader.SetMat4("invView", &viewInv);
-        glm::mat4 projInv = glm::inverse(GetCamera().GetProjectionMatrix());
-        m_lightingShader.SetMat4("invProjection", &projInv);
-
-
-        m_lightingShader.SetInt("gDepth", 0);
-        m_lightingShader.SetInt("gNormal", 1);
-        m_lightingShader.SetInt("gAlbedo", 2);
-        m_lightingShader.SetInt("gMaterial", 3);
-        m_lightingShader.SetInt("skybox", 4);
-        m_lightingShader.SetInt("ssaoBlurTex", 5);
-
-        m_lightingShader.SetInt("gEmissive", 7);
-        m_lightingShader.SetInt("bloomTex", 8);
-
-        // Camera + light uniforms
         m_shadowRenderer->UploadShadowMatrices(m_lightingShader, V, 6);
 
 
@@ -254,11 +245,25 @@ namespace Engine {
     void Renderer::onUpdate(float dt) {
         ZoneScopedN("Render");
 
+        m_uniformCallsLastFrame = Shader::TakeUniformCallCount();
+
         PreRender();
 
-        // CPU-skin all characters once; shadow / GBuffer / pick reuse the cache.
+        // Camera + cascade visible lists; every pass below draws from these.
+        CullViews();
+        UpdateFrameUniforms();
+
+        // Skin every character inside one of those views once; shadow / GBuffer / pick reuse the cache.
+        GetAnimationManager().SetCullingFrusta(m_viewFrusta);
+        GetAnimationManager().SetLodView(GetCamera().GetPosition(), GetCamera().GetProjectionMatrix()[1][1]);
         GetAnimationManager().PrepareSkinnedMeshes();
 
+        // Every pass below appends its instances to the shared buffer.
+        Rendering::GLInstanceBuffer::BeginFrame();
+
+        // Terrain tiles and their tree instances for the shadow and GBuffer passes.
+        GetTerrainManager().PrepareFrame(m_viewFrusta);
+
         // Shadows
         RenderShadowMaps();
 
@@ -424,19 +429,8 @@ namespace Engine {
         glActiveTexture(GL_TEXTURE2);
         glBindTexture(GL_TEXTURE_2D, ssaoBuf->noiseTex);
 
-        glm::mat4 V       = GetCamera().GetViewMatrix();
-        glm::mat4 proj    = GetCamera().GetProjectionMatrix();
-        glm::mat4 projInv = glm::inverse(proj);
-        m_ssaoShader.SetMat4("view", &V);
-        m_ssaoShader.SetMat4("projection", &proj);
-        m_ssaoShader.SetMat4("invProjection", &projInv);
-
-        m_ssaoShader.SetInt("gDepth", 0);
-        m_ssaoShader.SetInt("gNormal", 1);
-        m_ssaoShader.SetInt("noiseTex", 2);
-
-        int loc = glGetUniformLocation(m_ssaoShader.GetProgramID(), "samples");
-        glUniform3fv(loc, 32, &ssaoKernel[0].x);
+        // view / projection / invProjection come from FrameData.
+        m_ssaoShader.SetVec3Array(m_ssaoShader.GetUniformLocation("samples"), ssaoKernel.data(), static_cast<int>(ssaoKernel.size()));
 
         // Noise tile scale must use SSAO FBO size, not OS window size.
         m_ssaoShader.SetVec2("screenSize", glm::vec2(static_cast<float>(ssaoBuf->width), static_cast<float>(ssaoBuf->height)));
@@ -461,8 +455,6 @@ namespace Engine {
         glDepthMask(GL_FALSE);
 
         m_ssaoBlurShader.Bind();
-        m_ssaoBlurShader.SetInt("ssaoInput", 0);
-        m_ssaoBlurShader.SetInt("gDepth", 1);
 
         glActiveTexture(GL_TEXTURE0);
         glBindTexture(GL_TEXTURE_2D, ssaoBuf->ssaoTex);
@@ -493,29 +485,34 @@ namespace Engine {
         Shader &gbufferShader = GetGBufferShader();
 
         gbufferShader.Bind();
-
-        // View / projection matricies
-
-        glm::mat4 V = GetCamera().GetViewMatrix();
-        gbufferShader.SetMat4("view", &V);
-        glm::mat4 proj = GetCamera().GetProjectionMatrix();
-        gbufferShader.SetMat4("projection", &proj);
-
         ENGINE_GLCheckError();
 
-        auto view = GetCurrentSceneRegistry().view<
-                Engine::Components::EntityMetadata,
-                Engine::Components::Transform,
-                Engine::Components::ModelRenderer
-        >();
+        m_gbufferQueue.Clear();
+        m_gbufferBatcher.Clear();
+        if (m_visibleSets.empty()) return;
 
-        for (auto [entity, metadata, transform, renderer]: view.each()) {
-            if (!renderer.visible)
-                continue;
-
-            renderer.Draw(gbufferShader, transform, true);
+        {
+            ZoneScopedN("Build GBuffer Queue");
+            auto &registry = GetCurrentSceneRegistry();
+            const glm::vec3 cameraPos = GetCamera().GetPosition();
+            const float invFarPlane = 1.0f / GetRenderSettings()->CAMERA_FAR_PLANE;
+
+            for (const entt::entity entity: m_visibleSets[kCameraView].entities) {
+                const auto &renderer = registry.get<Engine::Components::ModelRenderer>(entity);
+                const glm::mat4 &world = registry.get<Engine::Components::Transform>(entity).GetWorldMatrix();
+                renderer.Enqueue(m_gbufferQueue, world, entity, glm::distance(cameraPos, glm::vec3(world[3])) * invFarPlane);
+            }
+            m_gbufferQueue.Sort();
         }
 
+        // One instanced draw per (mesh, material, cull mode) run of the sorted queue.
+        m_gbufferBatcher.Build(m_gbufferQueue);
+        m_gbufferBaseInstance = Rendering::GLInstanceBuffer::Upload(m_gbufferBatcher.GetInstances());
+
+        Rendering::GLRenderCommands commands(gbufferShader, Rendering::GLRenderCommands::kUploadMaterials);
+        m_gbufferQueueStats = m_gbufferBatcher.Submit(commands, m_gbufferBaseInstance);
+        commands.End();
+
         //TODO add unbind??
         //gbufferShader.Unbind();
     }
@@ -538,24 +535,15 @@ namespace Engine {
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
             GetMousePickingShader().Bind();
-
-            ENGINE_GLCheckError();
-            glm::mat4 V = GetCamera().GetViewMatrix();
-            GetMousePickingShader().SetMat4("view", &V);
-            glm::mat4 proj = GetCamera().GetProjectionMatrix();
-            GetMousePickingShader().SetMat4("projection", &proj);
             ENGINE_GLCheckError();
         }
 
         {
             ZoneScopedN("Model Renderer Mouse Picking");
-            auto view = GetCurrentSceneRegistry().view<Engine::Components::EntityMetadata, Engine::Components::Transform, Engine::Components::ModelRenderer>();
-            for (auto [entity, metadata, transform, renderer]: view.each()) {
-                glm::vec3 encodedColor = EncodeEntityID(entity);
-                GetMousePickingShader().SetVec3("entityIDColor", encodedColor);
-                if (!renderer.visible) continue;
-                renderer.Draw(GetMousePickingShader(), transform, false);
-            }
+            // Same batches and instance data as the GBuffer pass; entity ids come from the instance buffer.
+            Rendering::GLRenderCommands commands(GetMousePickingShader(), Rendering::GLRenderCommands::kNone);
+            m_gbufferBatcher.Submit(commands, m_gbufferBaseInstance);
+            commands.End();
         }
 
         {
@@ -577,9 +565,10 @@ namespace Engine {
 
                 glm::vec3 encodedColor = EncodeEntityID(entity);
 
+                const auto& caches = GetAnimationManager().GetSkinFrameCaches(skinned);
                 for (size_t mi = 0; mi < skinned.meshes->size(); ++mi) {
                     const auto& mesh  = (*skinned.meshes)[mi];
-                    const auto& cache = skinned.skin_frame_cache[mi];
+                    const auto& cache = caches[mi];
                     if (!cache.valid) continue;
                     GetAnimationManager().renderer_->DrawSkinnedMeshMousePickingCached(encodedColor, cache, mesh, transform);
                 }
@@ -600,7 +589,56 @@ namespace Engine {
 
     void Renderer::RenderShadowMaps() {
         RENDER_STEP("Render Shadow Maps");
-        m_shadowRenderer->RenderShadowMaps();
+        // Per-cascade lists: each cascade decides on its own whether it needs redrawing.
+        const size_t cascades = m_visibleSets.size() > kCameraView + 1 ? m_visibleSets.size() - kCameraView - 1 : 0;
+        m_shadowRenderer->RenderShadowMaps(cascades ? m_visibleSets.data() + kCameraView + 1 : nullptr, cascades);
+    }
+
+    void Renderer::CullViews() {
+        ZoneScopedN("Cull Views");
+
+        Scene *scene = GetCurrentScene();
+        if (!scene) {
+            m_visibleSets.clear();
+            return;
+        }
+
+        const std::vector<glm::mat4> &lightMatrices = m_shadowRenderer->UpdateLightSpaceMatrices();
+        m_viewFrusta.resize(1 + lightMatrices.size());
+        m_visibleSets.resize(m_viewFrusta.size());
+
+        m_viewFrusta[kCameraView].SetFromMatrix(GetCamera().GetProjectionMatrix() * GetCamera().GetViewMatrix());
+        for (size_t i = 0; i < lightMatrices.size(); ++i) {
+            m_viewFrusta[kCameraView + 1 + i].SetFromMatrix(lightMatrices[i]);
+        }
+
+        Rendering::CullingWorld &culling = scene->GetCullingWorld();
+        culling.Sync();
+        culling.Cull(m_viewFrusta.data(), m_viewFrusta.size(), m_visibleSets.data());
+    }
+
+    void Renderer::UpdateFrameUniforms() {
+        ZoneScoped;
+        const RenderSettings *settings = GetRenderSettings();
+
+        Rendering::FrameUniforms frame{};
+        frame.view          = GetCamera().GetViewMatrix();
+        frame.projection    = GetCamera().GetProjectionMatrix();
+        frame.invView       = glm::inverse(frame.view);
+        frame.invProjection = glm::inverse(frame.projection);
+        frame.viewPos       = GetCamera().GetPosition();
+        frame.farPlane      = settings->CAMERA_FAR_PLANE;
+        frame.lightDir      = settings->lightDir;
+
+        const size_t cascades = std::min<size_t>(settings->shadowCascadeLevels.size(), 16);
+        frame.cascadeCount    = static_cast<int32_t>(cascades);
+        for (size_t i = 0; i < cascades; ++i) {
+            frame.cascadeSplits[i / 4][static_cast<int>(i % 4)] = settings->shadowCascadeLevels[i];
+        }
+
+        m_frameUniforms.Update(&frame, sizeof(frame));
+        // Rebound every frame: third-party renderers (RmlUi, Effekseer) may reuse indexed bindings.
+        m_frameUniforms.Bind(Rendering::kFrameDataBinding);
     }
 
     void Renderer::RenderGizmos(bool mousePicking) {
@@ -8,6 +8,9 @@
 #include "rendering/shadows/ShadowMapRenderer.h"
 #include "rendering/effects/bloom/BloomRenderer.h"
 #include "rendering/text/Text3DRenderer.h"
+#include "rendering/culling/CullingWorld.h"
+#include "rendering/queue/InstanceBatcher.h"
+#include "rendering/UniformBuffers.h"
 
 
 
@@ -37,6 +40,18 @@ namespace Engine {
 		void RenderSSAO();
 		void RenderSSAOBlur();
 		void RenderShadowMaps();
+		void CullViews();
+		/// Write camera, light and cascade data to the FrameData uniform buffer; after CullViews.
+		void UpdateFrameUniforms();
+
+		/// This frame's culling results: the camera view, then one per shadow cascade.
+		[[nodiscard]] const std::vector<Rendering::VisibleSet>& GetVisibleSets() const { return m_visibleSets; }
+		static constexpr size_t                                 kCameraView = 0;
+
+		/// What the GBuffer queue submitted last frame (draws, state changes, uniform uploads).
+		[[nodiscard]] const Rendering::RenderQueueStats& GetGBufferQueueStats() const { return m_gbufferQueueStats; }
+		/// glUniform* calls made through Shader during the previous frame.
+		[[nodiscard]] uint32_t GetUniformCallsLastFrame() const { return m_uniformCallsLastFrame; }
 
 		Shader& GetShader() { return m_shader; }
 		Shader& GetLightingShader() { return m_lightingShader; }
@@ -55,6 +70,17 @@ namespace Engine {
 		std::shared_ptr<BloomRenderer> m_bloomRenderer;
 		std::unique_ptr<Text3DRenderer> m_text3DRenderer;
 
+		std::vector<Rendering::Frustum>    m_viewFrusta;
+		std::vector<Rendering::VisibleSet> m_visibleSets;
+
+		Rendering::RenderQueue      m_gbufferQueue;
+		Rendering::InstanceBatcher  m_gbufferBatcher; // reused by the picking pass
+		uint32_t                    m_gbufferBaseInstance = 0;
+		Rendering::RenderQueueStats m_gbufferQueueStats;
+
+		Rendering::UniformBuffer m_frameUniforms;
+		uint32_t                 m_uniformCallsLastFrame = 0;
+
 		Engine::Shader          m_shader;
 		Engine::Shader          m_mousePickingShader;
 		Engine::Shader          m_modelPreviewShader;
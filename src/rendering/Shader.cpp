@@ -1,16 +1,20 @@
 #include "Shader.h"
 
 
+#include <algorithm>
 #include <fstream>
 #include <glm/gtc/type_ptr.hpp>
 
 #include <sstream>
 
 #include "core/EngineData.h"
+#include "rendering/UniformBuffers.h"
 #include <regex>
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 namespace Engine {
+	uint32_t Shader::s_uniformCalls = 0;
+
 	Shader::Shader() : programID(0)
 	{
 	}
@@ -24,6 +28,8 @@ namespace Engine {
 			glDeleteProgram(programID);
 		}
 		programID = 0;
+		m_uniformLocations.clear();
+		m_uniformBlocks = 0;
 	}
 
 	Shader::~Shader()
@@ -70,6 +76,7 @@ namespace Engine {
 
 		// Create shader program
 		programID = glCreateProgram();
+		m_uniformLocations.clear();
 		glAttachShader(programID, vertexShader);
 		glAttachShader(programID, fragmentShader);
 		if (geometryPath.has_value()) {
@@ -110,6 +117,7 @@ namespace Engine {
 		}
 
 		programID = glCreateProgram();
+		m_uniformLocations.clear();
 		glAttachShader(programID, vertexShader);
 		glAttachShader(programID, fragmentShader);
 
@@ -133,42 +141,104 @@ namespace Engine {
 		ENGINE_GLCheckError();
 	}
 
+	GLint Shader::GetUniformLocation(const std::string& name) const
+	{
+		const auto it = m_uniformLocations.find(name);
+		return it != m_uniformLocations.end() ? it->second : -1;
+	}
+
+	uint32_t Shader::TakeUniformCallCount()
+	{
+		const uint32_t calls = s_uniformCalls;
+		s_uniformCalls       = 0;
+		return calls;
+	}
+
 	void Shader::SetBool(const std::string& name, bool value) const
 	{
-		glUniform1i(glGetUniformLocation(programID, name.c_str()), (int) value);
+		SetInt(GetUniformLocation(name), value ? 1 : 0);
 		ENGINE_GLCheckError();
 	}
 
 	void Shader::SetInt(const std::string& name, int value) const
 	{
-		glUniform1i(glGetUniformLocation(programID, name.c_str()), value);
+		SetInt(GetUniformLocation(name), value);
 		ENGINE_GLCheckError();
 	}
 
 	void Shader::SetFloat(const std::string& name, float value) const
 	{
-		glUniform1f(glGetUniformLocation(programID, name.c_str()), value);
+		SetFloat(GetUniformLocation(name), value);
 		ENGINE_GLCheckError();
 	}
 
 	void Shader::SetVec3(const std::string& name, glm::vec3 value) const
 	{
-		glUniform3fv(glGetUniformLocation(programID, name.c_str()), 1, (GLfloat*) glm::value_ptr(value));
+		SetVec3(GetUniformLocation(name), value);
 		ENGINE_GLCheckError();
 	}
 
 	void Shader::SetVec2(const std::string& name, glm::vec2 value) const
 	{
-		glUniform2fv(glGetUniformLocation(programID, name.c_str()), 1, (GLfloat*) glm::value_ptr(value));
+		SetVec2(GetUniformLocation(name), value);
 		ENGINE_GLCheckError();
 	}
 
 	void Shader::SetMat4(const std::string& name, glm::mat4* value) const
 	{
-		glUniformMatrix4fv(glGetUniformLocation(programID, name.c_str()), 1, GL_FALSE, glm::value_ptr(*value));
+		SetMat4(GetUniformLocation(name), *value);
 		ENGINE_GLCheckError();
 	}
 
+	void Shader::SetInt(GLint location, int value) const
+	{
+		if (location < 0) return;
+		glUniform1i(location, value);
+		++s_uniformCalls;
+	}
+
+	void Shader::SetFloat(GLint location, float value) const
+	{
+		if (location < 0) return;
+		glUniform1f(location, value);
+		++s_uniformCalls;
+	}
+
+	void Shader::SetVec2(GLint location, glm::vec2 value) const
+	{
+		if (location < 0) return;
+		glUniform2fv(location, 1, glm::value_ptr(value));
+		++s_uniformCalls;
+	}
+
+	void Shader::SetVec3(GLint location, glm::vec3 value) const
+	{
+		if (location < 0) return;
+		glUniform3fv(location, 1, glm::value_ptr(value));
+		++s_uniformCalls;
+	}
+
+	void Shader::SetMat4(GLint location, const glm::mat4& value) const
+	{
+		if (location < 0) return;
+		glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+		++s_uniformCalls;
+	}
+
+	void Shader::SetFloatArray(GLint location, const float* values, int count) const
+	{
+		if (location < 0 || count <= 0) return;
+		glUniform1fv(location, count, values);
+		++s_uniformCalls;
+	}
+
+	void Shader::SetVec3Array(GLint location, const glm::vec3* values, int count) const
+	{
+		if (location < 0 || count <= 0) return;
+		glUniform3fv(location, count, glm::value_ptr(values[0]));
+		++s_uniformCalls;
+	}
+
 	bool Shader::CompileShader(GLuint& shader, GLenum type, const std::string& source)
 	{
 		shader                 = glCreateShader(type);
@@ -190,7 +260,62 @@ namespace Engine {
 
 		GLint success;
 		glGetProgramiv(programID, GL_LINK_STATUS, &success);
-		return success == GL_TRUE;
+		if (success != GL_TRUE) return false;
+
+		ReflectProgram();
+		return true;
+	}
+
+	void Shader::ReflectProgram()
+	{
+		m_uniformLocations.clear();
+		m_uniformBlocks = 0;
+
+		GLint uniformCount = 0, maxNameLength = 0;
+		glGetProgramiv(programID, GL_ACTIVE_UNIFORMS, &uniformCount);
+		glGetProgramiv(programID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+		std::vector<GLchar> nameBuffer(static_cast<size_t>(std::max(maxNameLength, 1)));
+
+		for (GLint i = 0; i < uniformCount; ++i) {
+			GLint   arraySize = 0;
+			GLenum  type      = 0;
+			GLsizei length    = 0;
+			glGetActiveUniform(programID, static_cast<GLuint>(i), static_cast<GLsizei>(nameBuffer.size()), &length, &arraySize, &type, nameBuffer.data());
+			const std::string name(nameBuffer.data(), static_cast<size_t>(length));
+
+			const GLint location = glGetUniformLocation(programID, name.c_str());
+			if (location < 0) continue; // uniform block member
+
+			// Arrays are reported as "name[0]": register the bare name and every element.
+			constexpr const char* kFirstElement = "[0]";
+			if (name.size() > 3 && name.compare(name.size() - 3, 3, kFirstElement) == 0) {
+				const std::string base = name.substr(0, name.size() - 3);
+				m_uniformLocations[base] = location;
+				m_uniformLocations[name] = location;
+				for (GLint element = 1; element < arraySize; ++element) {
+					const std::string elementName = base + "[" + std::to_string(element) + "]";
+					m_uniformLocations[elementName] = glGetUniformLocation(programID, elementName.c_str());
+				}
+			}
+			else {
+				m_uniformLocations[name] = location;
+			}
+		}
+
+		GLint blockCount = 0;
+		glGetProgramiv(programID, GL_ACTIVE_UNIFORM_BLOCKS, &blockCount);
+		for (GLint block = 0; block < blockCount; ++block) {
+			GLchar  blockName[128];
+			GLsizei length = 0;
+			glGetActiveUniformBlockName(programID, static_cast<GLuint>(block), sizeof(blockName), &length, blockName);
+			const int binding = Rendering::FindUniformBlockBinding(std::string(blockName, static_cast<size_t>(length)));
+			if (binding < 0) {
+				GetDefaultLogger()->warn("Shader {}: uniform block {} has no engine binding", programID, blockName);
+				continue;
+			}
+			glUniformBlockBinding(programID, static_cast<GLuint>(block), static_cast<GLuint>(binding));
+			m_uniformBlocks |= 1u << binding;
+		}
 	}
 
 	void Shader::CheckShaderError(GLuint shader, GLenum whatToCheck, const std::string& errorMessage)
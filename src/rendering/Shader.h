@@ -3,9 +3,11 @@
 #include <spdlog/spdlog.h>
 
 #include <optional>
+#include <unordered_map>
 
 typedef unsigned int GLuint;
 typedef unsigned int GLenum;
+typedef int          GLint;
 
 
 namespace Engine {
@@ -33,15 +35,42 @@ namespace Engine {
 		void SetVec3(const std::string& name, glm::vec3 value) const;
 		void SetMat4(const std::string& name, glm::mat4* value) const;
 
+		/// Location of a uniform, -1 if it is not active. All active uniforms (and every
+		/// element of uniform arrays) are reflected at link time, so this never calls GL;
+		/// hot paths still resolve locations up front and use the setters below.
+		[[nodiscard]] GLint GetUniformLocation(const std::string& name) const;
+
+		// Location-based setters; -1 is ignored like glUniform* does.
+		void SetInt(GLint location, int value) const;
+		void SetFloat(GLint location, float value) const;
+		void SetVec2(GLint location, glm::vec2 value) const;
+		void SetVec3(GLint location, glm::vec3 value) const;
+		void SetMat4(GLint location, const glm::mat4& value) const;
+		void SetFloatArray(GLint location, const float* values, int count) const;
+		void SetVec3Array(GLint location, const glm::vec3* values, int count) const;
+
+		/// True if the program declares the engine uniform block bound at `binding` (see Rendering::UniformBlockBinding).
+		[[nodiscard]] bool UsesUniformBlock(GLuint binding) const { return (m_uniformBlocks & (1u << binding)) != 0; }
+
+		/// glUniform* calls issued through any Shader since the last call; resets the counter.
+		static uint32_t TakeUniformCallCount();
+
 		// Get the program ID
 		[[maybe_unused]] [[nodiscard]] GLuint GetProgramID() const { return programID; }
 
 	  private:
 		GLuint programID;
 
+		std::unordered_map<std::string, GLint> m_uniformLocations;
+		uint32_t                               m_uniformBlocks = 0; // bit per bound engine block
+
+		static uint32_t s_uniformCalls;
+
 		// Helper functions
 		bool        CompileShader(GLuint& shader, GLenum type, const std::string& source);
 		bool        LinkProgram();
+		/// Fill the uniform location table and bind the engine's uniform blocks.
+		void        ReflectProgram();
 		void        CheckShaderError(GLuint shader, GLenum whatToCheck, const std::string& errorMessage);
 		void        CheckProgramError(GLuint program, GLenum whatToCheck, const std::string& errorMessage);
 		std::string ReadFile(const std::string& filePath);
@@ -6,11 +6,14 @@
 #include <stb/stb_image.h>
 
 #include "rendering/Renderer.h"
+#include "assets/CookedData.h"
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 
 #define DDS_USE_STD_FILESYSTEM 1
 
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
 #include <dds.hpp>
 #include <EffekseerRendererGL/EffekseerRendererGL.GLExtension.h>
@@ -36,69 +39,178 @@ namespace Engine {
 
 	bool Texture::LoadFromFile(const std::string& path)
 	{
-		// Check if file is HDR
-		if (stbi_is_hdr(path.c_str())) {
-			return LoadHDRFromFile(path);
-		}
-        if(ends_with(path, ".dds")){
-            return LoadDDSFromFile(path);
-        }
+		TextureData data;
+		return Decode(path, data) && Upload(data);
+	}
 
-		m_name = path.substr(path.find_last_of("/\\") + 1);
-		if (glGetString(GL_VERSION) == nullptr) {
-			std::cerr << "No valid OpenGL context!" << std::endl;
+	namespace {
+		bool DecodeDDS(const std::string& path, TextureData& out)
+		{
+			auto image = std::make_shared<dds::Image>();
+			if (dds::readFile(path, image.get()) != dds::ReadResult::Success) {
+				GetRenderer().log->error("Failed to load dds texture: {}", path);
+				return false;
+			}
+			out.width  = static_cast<int>(image->width);
+			out.height = static_cast<int>(image->height);
+			out.dds    = std::move(image);
+			return true;
 		}
 
-		// Generate texture ID
-		glGenTextures(1, &m_textureID);
-		s_loadedTextures.insert(m_textureID);
+		bool DecodeImage(const std::string& path, TextureData& out, bool hdr)
+		{
+			// The flip flag is per thread so concurrent decodes don't race on it.
+			out.isHDR = hdr;
+			stbi_set_flip_vertically_on_load_thread(hdr);
+			void* data = hdr ? static_cast<void*>(stbi_loadf(path.c_str(), &out.width, &out.height, &out.channels, 0))
+			                 : static_cast<void*>(stbi_load(path.c_str(), &out.width, &out.height, &out.channels, 0));
+			if (!data) {
+				if (hdr)
+					GetRenderer().log->error("No data for HDR texture: {}", path);
+				else
+					GetRenderer().log->error("Failed to load texture: {}", path);
+				return false;
+			}
+			out.pixels.reset(data, stbi_image_free);
 
-		GLenum err = glGetError();
-		if (err != GL_NO_ERROR) {
-			std::cerr << "OpenGL Error: " << err << std::endl;
+			if (out.channels != 1 && out.channels != 3 && out.channels != 4) {
+				GetRenderer().log->error("Unsupported number of channels: {}", out.channels);
+				out.pixels.reset();
+				return false;
+			}
+			return true;
 		}
+	} // namespace
 
-		glBindTexture(GL_TEXTURE_2D, m_textureID);
-
+	bool Texture::Decode(const std::string& path, TextureData& out)
+	{
+		out.name = path.substr(path.find_last_of("/\\") + 1);
+		if (stbi_is_hdr(path.c_str())) return DecodeImage(path, out, true);
+		if (ends_with(path, ".dds")) return DecodeDDS(path, out);
+		return DecodeImage(path, out, false);
+	}
 
-		// Set texture parameters
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	namespace {
+		enum class CookedFormat : uint32_t { LDR, HDR, DDS };
+
+		struct CookedTextureHeader {
+			CookedFormat format    = CookedFormat::LDR;
+			uint32_t     width     = 0;
+			uint32_t     height    = 0;
+			uint32_t     channels  = 0;
+			uint32_t     mipLevels = 1;
+			uint32_t     reserved  = 0;
+		};
+
+		size_t MipChainBytes(int width, int height, int channels, int levels)
+		{
+			size_t bytes = 0;
+			for (int mip = 0; mip < levels; ++mip) {
+				bytes  += static_cast<size_t>(width) * height * channels;
+				width   = std::max(1, width / 2);
+				height  = std::max(1, height / 2);
+			}
+			return bytes;
+		}
 
-		// Load image data
-		stbi_set_flip_vertically_on_load(false);
-		unsigned char* data = stbi_load(path.c_str(), &m_width, &m_height, &m_channels, 0);
+		/// Box-filtered levels below `level0` down to 1x1, the chain glGenerateMipmap would build.
+		int AppendMipChain(const uint8_t* level0, int width, int height, int channels, CookedWriter& out)
+		{
+			std::vector<uint8_t> current(level0, level0 + static_cast<size_t>(width) * height * channels);
+			out.Bytes(current.data(), current.size());
+			int levels = 1;
+			while (width > 1 || height > 1) {
+				const int            nextWidth  = std::max(1, width / 2);
+				const int            nextHeight = std::max(1, height / 2);
+				std::vector<uint8_t> next(static_cast<size_t>(nextWidth) * nextHeight * channels);
+				for (int y = 0; y < nextHeight; ++y) {
+					const int y0 = std::min(y * 2, height - 1), y1 = std::min(y * 2 + 1, height - 1);
+					for (int x = 0; x < nextWidth; ++x) {
+						const int x0 = std::min(x * 2, width - 1), x1 = std::min(x * 2 + 1, width - 1);
+						for (int c = 0; c < channels; ++c) {
+							auto texel = [&](int tx, int ty) { return static_cast<int>(current[(static_cast<size_t>(ty) * width + tx) * channels + c]); };
+							const int sum = texel(x0, y0) + texel(x1, y0) + texel(x0, y1) + texel(x1, y1);
+							next[(static_cast<size_t>(y) * nextWidth + x) * channels + c] = static_cast<uint8_t>((sum + 2) / 4);
+						}
+					}
+				}
+				out.Bytes(next.data(), next.size());
+				current = std::move(next);
+				width   = nextWidth;
+				height  = nextHeight;
+				++levels;
+			}
+			return levels;
+		}
+	} // namespace
 
-		if (!data) {
-			GetRenderer().log->error("Failed to load texture: {}", path);
-			return false;
+	bool Texture::Cook(const std::string& path, std::vector<uint8_t>& out)
+	{
+		CookedWriter        writer(out);
+		CookedTextureHeader header;
+		if (ends_with(path, ".dds")) {
+			header.format = CookedFormat::DDS;
+			writer.Pod(header);
+			return AppendFileBytes(path, out);
 		}
 
-		// Determine format based on number of channels
-		GLenum format;
-		if (m_channels == 1)
-			format = GL_RED;
-		else if (m_channels == 3)
-			format = GL_RGB;
-		else if (m_channels == 4)
-			format = GL_RGBA;
+		TextureData data;
+		if (!Decode(path, data) || !data.pixels) return false;
+		header.format   = data.isHDR ? CookedFormat::HDR : CookedFormat::LDR;
+		header.width    = static_cast<uint32_t>(data.width);
+		header.height   = static_cast<uint32_t>(data.height);
+		header.channels = static_cast<uint32_t>(data.channels);
+
+		// The header is patched once the level count is known.
+		const size_t headerAt = out.size();
+		writer.Pod(header);
+		const size_t texels = static_cast<size_t>(data.width) * data.height * data.channels;
+		if (data.isHDR) {
+			writer.Bytes(data.pixels.get(), texels * sizeof(float)); // HDR textures have no mips
+		}
 		else {
-            GetRenderer().log->error("Unsupported number of channels: {}", m_channels);
-			stbi_image_free(data);
-			return false;
+			header.mipLevels = static_cast<uint32_t>(AppendMipChain(static_cast<const uint8_t*>(data.pixels.get()), data.width, data.height, data.channels, writer));
+			std::memcpy(out.data() + headerAt, &header, sizeof(header));
 		}
+		return true;
+	}
 
-		// Upload texture data
-		glTexImage2D(GL_TEXTURE_2D, 0, static_cast<int>(format), m_width, m_height, 0, format, GL_UNSIGNED_BYTE, data);
-		glGenerateMipmap(GL_TEXTURE_2D);
-
-		// Free image data
-		stbi_image_free(data);
-		glBindTexture(GL_TEXTURE_2D, 0);
+	bool Texture::DecodeCooked(const uint8_t* data, size_t size, const std::string& path, TextureData& out)
+	{
+		CookedReader        reader(data, size);
+		CookedTextureHeader header;
+		if (!reader.Pod(header)) return false;
+		out.name = path.substr(path.find_last_of("/\\") + 1);
+
+		if (header.format == CookedFormat::DDS) {
+			// UploadDDSTexture2D reads from image->data, so the file is copied into it like readFile does.
+			const size_t bytes = reader.Remaining();
+			if (bytes < sizeof(uint32_t) + sizeof(dds::FileHeader)) return false;
+			auto image  = std::make_shared<dds::Image>();
+			image->data = std::make_unique<uint8_t[]>(bytes);
+			reader.Bytes(image->data.get(), bytes);
+			if (dds::readImage(image->data.get(), bytes, image.get()) != dds::ReadResult::Success) {
+				GetRenderer().log->error("Failed to read cooked dds texture: {}", path);
+				return false;
+			}
+			out.width  = static_cast<int>(image->width);
+			out.height = static_cast<int>(image->height);
+			out.dds    = std::move(image);
+			return true;
+		}
 
-		m_isHDR = false;
+		if (header.channels != 1 && header.channels != 3 && header.channels != 4) return false;
+		out.width     = static_cast<int>(header.width);
+		out.height    = static_cast<int>(header.height);
+		out.channels  = static_cast<int>(header.channels);
+		out.isHDR     = header.format == CookedFormat::HDR;
+		out.mipLevels = out.isHDR ? 1 : static_cast<int>(header.mipLevels);
+		const size_t bytes = out.isHDR ? static_cast<size_t>(out.width) * out.height * out.channels * sizeof(float)
+		                               : MipChainBytes(out.width, out.height, out.channels, out.mipLevels);
+		const uint8_t* pixels = reader.View(bytes);
+		if (!pixels) return false;
+		// Non-owning: the pack mapping outlives every upload.
+		out.pixels = std::shared_ptr<void>(const_cast<uint8_t*>(pixels), [](void*) {});
 		return true;
 	}
 
@@ -496,88 +608,80 @@ namespace Engine {
         return tex;
     }
 
-    bool Texture::LoadDDSFromFile(const std::string &path) {
-        m_name = path.substr(path.find_last_of("/\\") + 1);
-        if (glGetString(GL_VERSION) == nullptr) {
-            std::cerr << "No valid OpenGL context!" << std::endl;
-        }
-
-
-
-
-        // Load image data
-        dds::Image image;
-        auto result = dds::readFile(path, &image);
-
-        if (result != dds::ReadResult::Success) {
-            GetRenderer().log->error("Failed to load dds texture: {}", path);
-            return false;
-        }
-
-        //GetRenderer().log->info("loaded {} dds ({}x{}) with  alpha: {}. Format: {}", path, image.width, image.height, image.supportsAlpha, image.format);
-
-        m_textureID = UploadDDSTexture2D(&image);
-        s_loadedTextures.insert(m_textureID);
-
-        m_isHDR = false;
-        return true;
-    }
-
-	bool Texture::LoadHDRFromFile(const std::string& path)
+	bool Texture::Upload(const TextureData& data)
 	{
-		m_name = path.substr(path.find_last_of("/\\") + 1);
-		// Generate texture ID
+		if (!data.pixels && !data.dds) return false;
+
+		m_name     = data.name;
+		m_width    = data.width;
+		m_height   = data.height;
+		m_channels = data.channels;
+		m_isHDR    = data.isHDR;
+
+		if (data.dds) {
+			m_textureID = UploadDDSTexture2D(data.dds.get());
+			s_loadedTextures.insert(m_textureID);
+			return true;
+		}
+
 		glGenTextures(1, &m_textureID);
 		s_loadedTextures.insert(m_textureID);
 		glBindTexture(GL_TEXTURE_2D, m_textureID);
 
-		// Set texture parameters
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-		// Load HDR image data
-		stbi_set_flip_vertically_on_load(true);
-		float* data = stbi_loadf(path.c_str(), &m_width, &m_height, &m_channels, 0);
-
-		if (!data) {
-            GetRenderer().log->error("No data for HDR texture: {}", path);
-			return false;
-		}
+		const GLenum format = m_channels == 1 ? GL_RED : m_channels == 3 ? GL_RGB : GL_RGBA;
+		if (m_isHDR) {
+			const GLenum internalFormat = m_channels == 1 ? GL_R16F : m_channels == 3 ? GL_RGB16F : GL_RGBA16F;
 
-		// Determine format based on number of channels
-		GLenum internalFormat, format;
-		if (m_channels == 1) {
-			internalFormat = GL_R16F;
-			format         = GL_RED;
-		}
-		else if (m_channels == 3) {
-			internalFormat = GL_RGB16F;
-			format         = GL_RGB;
-		}
-		else if (m_channels == 4) {
-			internalFormat = GL_RGBA16F;
-			format         = GL_RGBA;
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glTexImage2D(GL_TEXTURE_2D, 0, static_cast<int>(internalFormat), m_width, m_height, 0, format, GL_FLOAT, data.pixels.get());
+			GetDefaultLogger()->info("Loaded HDR texture: {} ({}x{}, {} channels)", m_name, m_width, m_height, m_channels);
 		}
 		else {
-			spdlog::error("Unsupported number of channels for HDR: {}", m_channels);
-			stbi_image_free(data);
-			return false;
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			if (data.mipLevels > 1) {
+				// Cooked chain: rows are tightly packed at every level.
+				glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+				const auto* level  = static_cast<const uint8_t*>(data.pixels.get());
+				int         width  = m_width;
+				int         height = m_height;
+				for (int mip = 0; mip < data.mipLevels; ++mip) {
+					glTexImage2D(GL_TEXTURE_2D, mip, static_cast<int>(format), width, height, 0, format, GL_UNSIGNED_BYTE, level);
+					level  += static_cast<size_t>(width) * height * m_channels;
+					width   = std::max(1, width / 2);
+					height  = std::max(1, height / 2);
+				}
+				glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+			}
+			else {
+				glTexImage2D(GL_TEXTURE_2D, 0, static_cast<int>(format), m_width, m_height, 0, format, GL_UNSIGNED_BYTE, data.pixels.get());
+				glGenerateMipmap(GL_TEXTURE_2D);
+			}
 		}
 
-		// Upload HDR texture data
-		glTexImage2D(GL_TEXTURE_2D, 0, static_cast<int>(internalFormat), m_width, m_height, 0, format, GL_FLOAT, data);
-
-		// Free image data
-		stbi_image_free(data);
 		glBindTexture(GL_TEXTURE_2D, 0);
-
-		m_isHDR = true;
-		GetDefaultLogger()->info("Loaded HDR texture: {} ({}x{}, {} channels)", path, m_width, m_height, m_channels);
 		return true;
 	}
 
+	bool Texture::LoadDDSFromFile(const std::string& path)
+	{
+		TextureData data;
+		data.name = path.substr(path.find_last_of("/\\") + 1);
+		return DecodeDDS(path, data) && Upload(data);
+	}
+
+	bool Texture::LoadHDRFromFile(const std::string& path)
+	{
+		TextureData data;
+		data.name = path.substr(path.find_last_of("/\\") + 1);
+		return DecodeImage(path, data, true) && Upload(data);
+	}
+
 	void Texture::Bind(unsigned int unit) const
 	{
 		glActiveTexture(GL_TEXTURE0 + unit);
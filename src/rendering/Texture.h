@@ -3,16 +3,43 @@
 
 #include <spdlog/spdlog.h>
 
+#include <memory>
 #include <unordered_set>
+#include <vector>
 
 typedef unsigned int GLuint;
 
+namespace dds {
+	struct Image;
+}
+
 namespace Engine {
+	/// Decoded image waiting for upload. Produced by Texture::Decode on any thread.
+	struct TextureData {
+		std::string                 name;
+		int                         width    = 0;
+		int                         height   = 0;
+		int                         channels = 0;
+		bool                        isHDR    = false;
+		std::shared_ptr<void>       pixels; // stbi buffer (8-bit, or float for HDR)
+		std::shared_ptr<dds::Image> dds;    // set instead of pixels for .dds files
+		int                         mipLevels = 1; // > 1: `pixels` holds the whole chain, level 0 first
+	};
+
 	class Texture {
 	  public:
 		Texture();
 		~Texture() = default;
 
+		/// Read and decode `path` without touching GL. Safe on worker threads.
+		static bool           Decode(const std::string& path, TextureData& out);
+		/// Create the GL texture from decoded data. Main thread.
+		bool                  Upload(const TextureData& data);
+		/// Asset packs: decoded pixels plus a prebuilt mip chain (8-bit), or the .dds file as is.
+		static bool           Cook(const std::string& path, std::vector<uint8_t>& out);
+		/// Cook's output without a copy of the pixels: they point into `data`, which must outlive the upload.
+		static bool           DecodeCooked(const uint8_t* data, size_t size, const std::string& path, TextureData& out);
+
 		bool                  LoadFromFile(const std::string& path);
 		bool                  LoadDDSFromFile(const std::string& path);
 		bool                  LoadHDRFromFile(const std::string& path);
@@ -27,6 +54,8 @@ namespace Engine {
 		[[nodiscard]] int                   GetWidth() const { return m_width; }
 		[[nodiscard]] int                   GetHeight() const { return m_height; }
 		[[maybe_unused]] [[nodiscard]] bool IsHDR() const { return m_isHDR; }
+		/// False only when the texture is known to have no alpha channel; compressed DDS count as having one.
+		[[nodiscard]] bool                  HasAlpha() const { return m_channels == 4 || m_channels == 0; }
 
 	  private:
 		GLuint      m_textureID;
@@ -0,0 +1,54 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#include "UniformBuffers.h"
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+namespace Engine::Rendering {
+
+	int FindUniformBlockBinding(const std::string& blockName)
+	{
+		if (blockName == "LightSpaceMatrices") return kLightSpaceMatricesBinding;
+		if (blockName == "FrameData") return kFrameDataBinding;
+		if (blockName == "MaterialData") return kMaterialDataBinding;
+		return -1;
+	}
+
+	void UniformBuffer::Create(size_t size)
+	{
+		if (m_buffer != 0 && m_size == size) return;
+		Destroy();
+		glGenBuffers(1, &m_buffer);
+		glBindBuffer(GL_UNIFORM_BUFFER, m_buffer);
+		glBufferData(GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+		m_size = size;
+	}
+
+	void UniformBuffer::Update(const void* data, size_t size)
+	{
+		ENGINE_ASSERT(m_buffer != 0 && size <= m_size, "UniformBuffer::Update out of range");
+		glBindBuffer(GL_UNIFORM_BUFFER, m_buffer);
+		glBufferSubData(GL_UNIFORM_BUFFER, 0, static_cast<GLsizeiptr>(size), data);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	}
+
+	void UniformBuffer::Bind(GLuint binding) const
+	{
+		glBindBufferBase(GL_UNIFORM_BUFFER, binding, m_buffer);
+	}
+
+	void UniformBuffer::Destroy()
+	{
+		if (m_buffer == 0) return;
+		if (glfwGetCurrentContext() != nullptr) {
+			glDeleteBuffers(1, &m_buffer);
+		}
+		m_buffer = 0;
+		m_size   = 0;
+	}
+
+} // namespace Engine::Rendering
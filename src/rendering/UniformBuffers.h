@@ -0,0 +1,80 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+namespace Engine::Rendering {
+
+	/// Fixed uniform buffer binding points. Shader binds every block it knows by name at link time.
+	enum UniformBlockBinding : GLuint {
+		kLightSpaceMatricesBinding = 0, // ShadowMapRenderer::matricesUBO
+		kFrameDataBinding          = 1,
+		kMaterialDataBinding       = 2,
+	};
+
+	/// Binding point for a uniform block name, -1 for blocks the engine does not manage.
+	int FindUniformBlockBinding(const std::string& blockName);
+
+	/// std140 `FrameData`: camera and light state, written once per frame by the Renderer.
+	/// Keep in sync with the block in gbuffer_vert, lighting_frag, ssao_frag, picking.vert and the terrain shader.
+	struct FrameUniforms {
+		glm::mat4 view;
+		glm::mat4 projection;
+		glm::mat4 invView;
+		glm::mat4 invProjection;
+		glm::vec3 viewPos;
+		float     farPlane;
+		glm::vec3 lightDir;
+		int32_t   cascadeCount;
+		glm::vec4 cascadeSplits[4]; // 16 cascade plane distances, packed four per vec4
+	};
+	static_assert(offsetof(FrameUniforms, viewPos) == 256 && offsetof(FrameUniforms, lightDir) == 272 && offsetof(FrameUniforms, cascadeSplits) == 288, "FrameUniforms must match std140 FrameData");
+	static_assert(sizeof(FrameUniforms) == 352, "FrameUniforms must match std140 FrameData");
+
+	/// std140 `MaterialData`: one buffer per Material, rewritten only when the material changes.
+	struct MaterialUniforms {
+		glm::vec4 diffuseColor;
+		glm::vec4 specularColor;
+		glm::vec4 ambientColor;
+		glm::vec4 emissiveColor;
+		glm::vec2 textureScale;
+		float     shininess;
+		int32_t   hasDiffuseTexture;
+		int32_t   hasNormalTexture;
+		int32_t   hasSpecularTexture;
+		int32_t   padding[2];
+	};
+	static_assert(offsetof(MaterialUniforms, textureScale) == 64 && offsetof(MaterialUniforms, hasSpecularTexture) == 84, "MaterialUniforms must match std140 MaterialData");
+	static_assert(sizeof(MaterialUniforms) == 96, "MaterialUniforms must match std140 MaterialData");
+
+	/// A GL uniform buffer of fixed size. Not copyable; Destroy() needs a current context.
+	class UniformBuffer {
+	  public:
+		UniformBuffer() = default;
+		~UniformBuffer() { Destroy(); }
+		UniformBuffer(const UniformBuffer&)            = delete;
+		UniformBuffer& operator=(const UniformBuffer&) = delete;
+
+		void Create(size_t size);
+		void Update(const void* data, size_t size);
+		/// glBindBufferBase on `binding`.
+		void Bind(GLuint binding) const;
+		void Destroy();
+
+		[[nodiscard]] GLuint GetID() const { return m_buffer; }
+		[[nodiscard]] bool   IsCreated() const { return m_buffer != 0; }
+
+	  private:
+		GLuint m_buffer = 0;
+		size_t m_size   = 0;
+	};
+
+} // namespace Engine::Rendering
@@ -0,0 +1,380 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#include "BoundsTree.h"
+
+#include <algorithm>
+
+#include "utils/Utils.h"
+
+namespace Engine::Rendering {
+
+	namespace {
+		// Leaves are grown by this much so small motions stay inside the stored box.
+		constexpr float kFatMarginAbsolute = 0.05f;
+		constexpr float kFatMarginRelative = 0.1f;
+		// Reinsert a shrunk object once its fat box is this many times too large.
+		constexpr float kMaxFatAreaRatio = 4.0f;
+		// The tree stays balanced, so traversal depth is ~1.44 * log2(count).
+		constexpr int kMaxStackDepth = 128;
+
+		AABB Fatten(const AABB& box)
+		{
+			const glm::vec3 margin = glm::vec3(kFatMarginAbsolute) + (box.max - box.min) * kFatMarginRelative;
+			return {box.min - margin, box.max + margin};
+		}
+	} // namespace
+
+	BoundsTree::ProxyId BoundsTree::AllocateNode()
+	{
+		if (m_freeList == kNullProxy) {
+			m_nodes.emplace_back();
+			return static_cast<ProxyId>(m_nodes.size() - 1);
+		}
+		const ProxyId node = m_freeList;
+		m_freeList         = m_nodes[node].parent;
+		m_nodes[node]      = Node{};
+		return node;
+	}
+
+	void BoundsTree::FreeNode(ProxyId node)
+	{
+		m_nodes[node].parent = m_freeList;
+		m_nodes[node].height = -1;
+		m_nodes[node].entity = entt::null;
+		m_freeList           = node;
+	}
+
+	BoundsTree::ProxyId BoundsTree::CreateProxy(const AABB& box, entt::entity entity)
+	{
+		const ProxyId proxy    = AllocateNode();
+		m_nodes[proxy].box    = Fatten(box);
+		m_nodes[proxy].entity = entity;
+		m_nodes[proxy].height = 0;
+		InsertLeaf(proxy);
+		m_proxyCount++;
+		return proxy;
+	}
+
+	void BoundsTree::DestroyProxy(ProxyId proxy)
+	{
+		ENGINE_ASSERT(proxy >= 0 && proxy < static_cast<ProxyId>(m_nodes.size()) && m_nodes[proxy].IsLeaf(), "BoundsTree: not a leaf");
+		RemoveLeaf(proxy);
+		FreeNode(proxy);
+		m_proxyCount--;
+	}
+
+	bool BoundsTree::MoveProxy(ProxyId proxy, const AABB& box)
+	{
+		ENGINE_ASSERT(proxy >= 0 && proxy < static_cast<ProxyId>(m_nodes.size()) && m_nodes[proxy].IsLeaf(), "BoundsTree: not a leaf");
+		const AABB& current = m_nodes[proxy].box;
+		const AABB  fat     = Fatten(box);
+		if (current.Contains(box) && current.SurfaceArea() <= fat.SurfaceArea() * kMaxFatAreaRatio) return false;
+
+		RemoveLeaf(proxy);
+		m_nodes[proxy].box = fat;
+		InsertLeaf(proxy);
+		return true;
+	}
+
+	void BoundsTree::Clear()
+	{
+		m_nodes.clear();
+		m_root       = kNullProxy;
+		m_freeList   = kNullProxy;
+		m_proxyCount = 0;
+	}
+
+	void BoundsTree::InsertLeaf(ProxyId leaf)
+	{
+		if (m_root == kNullProxy) {
+			m_root                = leaf;
+			m_nodes[leaf].parent = kNullProxy;
+			return;
+		}
+
+		// Descend towards the sibling with the lowest surface-area cost.
+		const AABB leafBox = m_nodes[leaf].box;
+		ProxyId    index   = m_root;
+		while (!m_nodes[index].IsLeaf()) {
+			const Node& node     = m_nodes[index];
+			const float area     = node.box.SurfaceArea();
+			const float combined = AABB::Union(node.box, leafBox).SurfaceArea();
+
+			// Cost of making a new parent here, and the area every deeper choice adds to this node.
+			const float cost        = 2.0f * combined;
+			const float inheritance = 2.0f * (combined - area);
+
+			auto descendCost = [&](ProxyId child) {
+				const Node& c      = m_nodes[child];
+				const float merged = AABB::Union(leafBox, c.box).SurfaceArea();
+				return (c.IsLeaf() ? merged : merged - c.box.SurfaceArea()) + inheritance;
+			};
+			const float cost1 = descendCost(node.child1);
+			const float cost2 = descendCost(node.child2);
+
+			if (cost < cost1 && cost < cost2) break;
+			index = cost1 < cost2 ? node.child1 : node.child2;
+		}
+
+		const ProxyId sibling   = index;
+		const ProxyId oldParent = m_nodes[sibling].parent;
+		const ProxyId newParent = AllocateNode();
+
+		m_nodes[newParent].parent = oldParent;
+		m_nodes[newParent].box    = AABB::Union(leafBox, m_nodes[sibling].box);
+		m_nodes[newParent].height = m_nodes[sibling].height + 1;
+		m_nodes[newParent].child1 = sibling;
+		m_nodes[newParent].child2 = leaf;
+		m_nodes[sibling].parent   = newParent;
+		m_nodes[leaf].parent      = newParent;
+
+		if (oldParent == kNullProxy) {
+			m_root = newParent;
+		}
+		else if (m_nodes[oldParent].child1 == sibling) {
+			m_nodes[oldParent].child1 = newParent;
+		}
+		else {
+			m_nodes[oldParent].child2 = newParent;
+		}
+
+		Refit(m_nodes[leaf].parent);
+	}
+
+	void BoundsTree::RemoveLeaf(ProxyId leaf)
+	{
+		if (leaf == m_root) {
+			m_root = kNullProxy;
+			return;
+		}
+
+		const ProxyId parent      = m_nodes[leaf].parent;
+		const ProxyId grandParent = m_nodes[parent].parent;
+		const ProxyId sibling     = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+		FreeNode(parent);
+		if (grandParent == kNullProxy) {
+			m_root                  = sibling;
+			m_nodes[sibling].parent = kNullProxy;
+			return;
+		}
+
+		if (m_nodes[grandParent].child1 == parent) {
+			m_nodes[grandParent].child1 = sibling;
+		}
+		else {
+			m_nodes[grandParent].child2 = sibling;
+		}
+		m_nodes[sibling].parent = grandParent;
+		Refit(grandParent);
+	}
+
+	void BoundsTree::Refit(ProxyId node)
+	{
+		while (node != kNullProxy) {
+			node = Balance(node);
+
+			Node& n  = m_nodes[node];
+			n.height = 1 + std::max(m_nodes[n.child1].height, m_nodes[n.child2].height);
+			n.box    = AABB::Union(m_nodes[n.child1].box, m_nodes[n.child2].box);
+			node     = n.parent;
+		}
+	}
+
+	BoundsTree::ProxyId BoundsTree::Balance(ProxyId iA)
+	{
+		Node& A = m_nodes[iA];
+		if (A.IsLeaf() || A.height < 2) return iA;
+
+		const ProxyId iB = A.child1;
+		const ProxyId iC = A.child2;
+		Node&         B  = m_nodes[iB];
+		Node&         C  = m_nodes[iC];
+
+		const int32_t balance = C.height - B.height;
+
+		// Hang `up` (a child of A) in A's place and give A one of its children.
+		auto replaceInParent = [&](ProxyId up) {
+			Node& U = m_nodes[up];
+			U.parent = A.parent;
+			A.parent = up;
+			if (U.parent == kNullProxy) {
+				m_root = up;
+			}
+			else if (m_nodes[U.parent].child1 == iA) {
+				m_nodes[U.parent].child1 = up;
+			}
+			else {
+				m_nodes[U.parent].child2 = up;
+			}
+		};
+
+		if (balance > 1) {
+			// Rotate C up.
+			const ProxyId iF = C.child1;
+			const ProxyId iG = C.child2;
+			Node&         F  = m_nodes[iF];
+			Node&         G  = m_nodes[iG];
+
+			C.child1 = iA;
+			replaceInParent(iC);
+
+			if (F.height > G.height) {
+				C.child2 = iF;
+				A.child2 = iG;
+				G.parent = iA;
+				A.box    = AABB::Union(B.box, G.box);
+				C.box    = AABB::Union(A.box, F.box);
+				A.height = 1 + std::max(B.height, G.height);
+				C.height = 1 + std::max(A.height, F.height);
+			}
+			else {
+				C.child2 = iG;
+				A.child2 = iF;
+				F.parent = iA;
+				A.box    = AABB::Union(B.box, F.box);
+				C.box    = AABB::Union(A.box, G.box);
+				A.height = 1 + std::max(B.height, F.height);
+				C.height = 1 + std::max(A.height, G.height);
+			}
+			return iC;
+		}
+
+		if (balance < -1) {
+			// Rotate B up.
+			const ProxyId iD = B.child1;
+			const ProxyId iE = B.child2;
+			Node&         D  = m_nodes[iD];
+			Node&         E  = m_nodes[iE];
+
+			B.child1 = iA;
+			replaceInParent(iB);
+
+			if (D.height > E.height) {
+				B.child2 = iD;
+				A.child1 = iE;
+				E.parent = iA;
+				A.box    = AABB::Union(C.box, E.box);
+				B.box    = AABB::Union(A.box, D.box);
+				A.height = 1 + std::max(C.height, E.height);
+				B.height = 1 + std::max(A.height, D.height);
+			}
+			else {
+				B.child2 = iE;
+				A.child1 = iD;
+				D.parent = iA;
+				A.box    = AABB::Union(C.box, D.box);
+				B.box    = AABB::Union(A.box, E.box);
+				A.height = 1 + std::max(C.height, D.height);
+				B.height = 1 + std::max(A.height, E.height);
+			}
+			return iB;
+		}
+
+		return iA;
+	}
+
+	void BoundsTree::AppendLeaves(ProxyId node, std::vector<entt::entity>& out) const
+	{
+		ProxyId stack[kMaxStackDepth];
+		int     top  = 0;
+		stack[top++] = node;
+		while (top > 0) {
+			const Node& n = m_nodes[stack[--top]];
+			if (n.IsLeaf()) {
+				out.push_back(n.entity);
+				continue;
+			}
+			ENGINE_ASSERT(top + 2 <= kMaxStackDepth, "BoundsTree: traversal stack overflow");
+			stack[top++] = n.child2;
+			stack[top++] = n.child1;
+		}
+	}
+
+	void BoundsTree::QuerySubtree(const Frustum& frustum, const SubtreeJob& job, std::vector<entt::entity>& out, CullStats& stats) const
+	{
+		if (job.node == kNullProxy) return;
+
+		SubtreeJob stack[kMaxStackDepth];
+		int        top  = 0;
+		stack[top++]    = job;
+		while (top > 0) {
+			const SubtreeJob current = stack[--top];
+			const Node&      n       = m_nodes[current.node];
+
+			uint8_t mask = current.mask;
+			if (mask != 0) {
+				stats.nodeTests++;
+				const Frustum::Result result = frustum.Test(n.box, mask);
+				if (result == Frustum::Result::Outside) continue;
+			}
+
+			if (n.IsLeaf()) {
+				out.push_back(n.entity);
+				continue;
+			}
+			if (mask == 0) {
+				// Fully inside: everything below is visible without further tests.
+				AppendLeaves(current.node, out);
+				continue;
+			}
+			ENGINE_ASSERT(top + 2 <= kMaxStackDepth, "BoundsTree: traversal stack overflow");
+			stack[top++] = {n.child2, mask};
+			stack[top++] = {n.child1, mask};
+		}
+	}
+
+	void BoundsTree::Query(const Frustum& frustum, std::vector<entt::entity>& out, CullStats& stats) const
+	{
+		QuerySubtree(frustum, {m_root, Frustum::kAllPlanes}, out, stats);
+	}
+
+	void BoundsTree::Partition(const Frustum& frustum, size_t targetJobs, std::vector<SubtreeJob>& jobs, std::vector<entt::entity>& out, CullStats& stats) const
+	{
+		jobs.clear();
+		if (m_root == kNullProxy) return;
+
+		jobs.push_back({m_root, Frustum::kAllPlanes});
+		std::vector<SubtreeJob> next;
+		while (jobs.size() < targetJobs) {
+			bool split = false;
+			next.clear();
+			for (const SubtreeJob& job : jobs) {
+				const Node& n    = m_nodes[job.node];
+				uint8_t     mask = job.mask;
+				if (mask == 0 || n.IsLeaf()) {
+					// Nothing left to split: fully-inside subtrees and leaves stay whole.
+					next.push_back(job);
+					continue;
+				}
+
+				stats.nodeTests++;
+				if (frustum.Test(n.box, mask) == Frustum::Result::Outside) continue;
+				if (mask == 0) {
+					next.push_back({job.node, 0});
+					continue;
+				}
+				next.push_back({n.child1, mask});
+				next.push_back({n.child2, mask});
+				split = true;
+			}
+			jobs.swap(next);
+			if (!split) break;
+		}
+
+		// Leaves are cheaper to test here than to hand to a task.
+		size_t kept = 0;
+		for (const SubtreeJob& job : jobs) {
+			if (m_nodes[job.node].IsLeaf()) {
+				QuerySubtree(frustum, job, out, stats);
+			}
+			else {
+				jobs[kept++] = job;
+			}
+		}
+		jobs.resize(kept);
+	}
+
+} // namespace Engine::Rendering
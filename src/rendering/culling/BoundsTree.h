@@ -0,0 +1,85 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "entt/entt.hpp"
+#include "Frustum.h"
+
+namespace Engine::Rendering {
+
+	/// Per-view culling counters.
+	struct CullStats {
+		uint32_t tested    = 0; // objects in the tree when the view was culled
+		uint32_t culled    = 0;
+		uint32_t visible   = 0;
+		uint32_t nodeTests = 0; // box / frustum tests the traversal actually did
+	};
+
+	/// Dynamic AABB tree (incremental SAH insert + AVL-style rotations).
+	///
+	/// Leaves store a "fat" box slightly larger than the object, so small motions
+	/// only compare two boxes instead of touching the tree. Knows nothing about GL,
+	/// assets or components; frustum queries are const and may run concurrently.
+	class BoundsTree {
+	  public:
+		using ProxyId                         = int32_t;
+		static constexpr ProxyId kNullProxy = -1;
+
+		/// A subtree still to be traversed, with the frustum planes it may straddle.
+		struct SubtreeJob {
+			ProxyId node = kNullProxy;
+			uint8_t mask = Frustum::kAllPlanes;
+		};
+
+		ProxyId CreateProxy(const AABB& box, entt::entity entity);
+		void    DestroyProxy(ProxyId proxy);
+		/// Update a leaf's bounds. Returns true if it had to be reinserted.
+		bool    MoveProxy(ProxyId proxy, const AABB& box);
+		void    Clear();
+
+		[[nodiscard]] const AABB&  GetFatAABB(ProxyId proxy) const { return m_nodes[proxy].box; }
+		[[nodiscard]] entt::entity GetEntity(ProxyId proxy) const { return m_nodes[proxy].entity; }
+		[[nodiscard]] uint32_t     GetProxyCount() const { return m_proxyCount; }
+		[[nodiscard]] int32_t      GetHeight() const { return m_root == kNullProxy ? 0 : m_nodes[m_root].height; }
+
+		/// Append every entity whose fat box touches the frustum.
+		void Query(const Frustum& frustum, std::vector<entt::entity>& out, CullStats& stats) const;
+
+		/// Walk the top of the tree breadth-first until about `targetJobs`
+		/// independent subtrees remain. Leaves reached on the way go to `out`;
+		/// the rest is left in `jobs` for QuerySubtree, one per task.
+		void Partition(const Frustum& frustum, size_t targetJobs, std::vector<SubtreeJob>& jobs, std::vector<entt::entity>& out, CullStats& stats) const;
+		void QuerySubtree(const Frustum& frustum, const SubtreeJob& job, std::vector<entt::entity>& out, CullStats& stats) const;
+
+	  private:
+		struct Node {
+			AABB         box;
+			entt::entity entity = entt::null;
+			ProxyId      parent = kNullProxy; // next free node while on the free list
+			ProxyId      child1 = kNullProxy;
+			ProxyId      child2 = kNullProxy;
+			int32_t      height = 0; // leaf = 0, free = -1
+
+			[[nodiscard]] bool IsLeaf() const { return child1 == kNullProxy; }
+		};
+
+		ProxyId AllocateNode();
+		void    FreeNode(ProxyId node);
+		void    InsertLeaf(ProxyId leaf);
+		void    RemoveLeaf(ProxyId leaf);
+		void    Refit(ProxyId node);
+		ProxyId Balance(ProxyId a);
+		void    AppendLeaves(ProxyId node, std::vector<entt::entity>& out) const;
+
+		std::vector<Node> m_nodes;
+		ProxyId           m_root       = kNullProxy;
+		ProxyId           m_freeList   = kNullProxy;
+		uint32_t          m_proxyCount = 0;
+	};
+
+} // namespace Engine::Rendering
@@ -0,0 +1,207 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#include "CullingWorld.h"
+
+#include <algorithm>
+
+#include "components/impl/ModelRendererComponent.h"
+#include "components/impl/TransformComponent.h"
+#include "core/EngineData.h"
+#include "core/Scene.h"
+#include "core/ThreadPool.h"
+#include "core/TransformHierarchy.h"
+#include "utils/Utils.h"
+
+namespace Engine::Rendering {
+
+	namespace {
+		constexpr uint32_t kNotTracked = ~0u;
+		// Below this many proxies a view is culled serially; task overhead would dominate.
+		constexpr uint32_t kMinProxiesForParallel = 512;
+		// Subtrees each view is split into for the ThreadPool.
+		constexpr size_t kJobsPerView = 16;
+	} // namespace
+
+	CullingWorld::CullingWorld(Scene& scene) : m_registry(*scene.GetRegistry()), m_hierarchy(scene.GetTransformHierarchy())
+	{
+		m_registry.on_construct<Components::ModelRenderer>().connect<&CullingWorld::OnRenderableConstructed>(*this);
+		m_registry.on_construct<Components::Transform>().connect<&CullingWorld::OnRenderableConstructed>(*this);
+		m_registry.on_destroy<Components::ModelRenderer>().connect<&CullingWorld::OnRenderableDestroyed>(*this);
+		m_registry.on_destroy<Components::Transform>().connect<&CullingWorld::OnRenderableDestroyed>(*this);
+	}
+
+	CullingWorld::~CullingWorld()
+	{
+		// The registry is shared and may outlive the scene.
+		m_registry.on_construct<Components::ModelRenderer>().disconnect(this);
+		m_registry.on_construct<Components::Transform>().disconnect(this);
+		m_registry.on_destroy<Components::ModelRenderer>().disconnect(this);
+		m_registry.on_destroy<Components::Transform>().disconnect(this);
+	}
+
+	void CullingWorld::OnRenderableConstructed(entt::registry&, entt::entity entity)
+	{
+		// The other component may not exist yet; Sync checks for both.
+		m_pending.push_back(entity);
+	}
+
+	void CullingWorld::OnRenderableDestroyed(entt::registry&, entt::entity entity)
+	{
+		Untrack(entity);
+	}
+
+	void CullingWorld::Track(entt::entity entity)
+	{
+		const auto index = static_cast<size_t>(entt::to_entity(entity));
+		if (index >= m_trackedOf.size()) m_trackedOf.resize(index + 1, kNotTracked);
+		if (m_trackedOf[index] != kNotTracked) return;
+
+		m_trackedOf[index] = static_cast<uint32_t>(m_tracked.size());
+		m_tracked.push_back({entity});
+	}
+
+	void CullingWorld::Untrack(entt::entity entity)
+	{
+		const auto index = static_cast<size_t>(entt::to_entity(entity));
+		if (index >= m_trackedOf.size() || m_trackedOf[index] == kNotTracked) return;
+
+		const uint32_t slot = m_trackedOf[index];
+		RemoveProxy(m_tracked[slot]);
+
+		// Swap-remove keeps the tracked list dense.
+		if (slot + 1 != m_tracked.size()) {
+			m_tracked[slot] = std::move(m_tracked.back());
+			m_trackedOf[static_cast<size_t>(entt::to_entity(m_tracked[slot].entity))] = slot;
+		}
+		m_tracked.pop_back();
+		m_trackedOf[index] = kNotTracked;
+	}
+
+	void CullingWorld::RemoveProxy(Tracked& tracked)
+	{
+		if (tracked.proxy == BoundsTree::kNullProxy) return;
+		m_tree.DestroyProxy(tracked.proxy);
+		tracked.proxy = BoundsTree::kNullProxy;
+	}
+
+	void CullingWorld::Sync()
+	{
+		ZoneScoped;
+
+		for (const entt::entity entity : m_pending) {
+			if (m_registry.valid(entity) && m_registry.all_of<Components::Transform, Components::ModelRenderer>(entity)) Track(entity);
+		}
+		m_pending.clear();
+
+		for (Tracked& tracked : m_tracked) {
+			const auto& renderer = m_registry.get<Components::ModelRenderer>(tracked.entity);
+
+			// The handle is a plain field (inspector, Lua); compare instead of hooking every writer.
+			if (!(renderer.model == tracked.model)) {
+				tracked.model     = renderer.model;
+				tracked.hasBounds = false;
+			}
+			// `visible` is left to the draw loops: hidden renderers still cast shadows.
+			if (!tracked.model.IsValid()) {
+				RemoveProxy(tracked);
+				continue;
+			}
+
+			bool refit = tracked.proxy == BoundsTree::kNullProxy;
+			if (!tracked.hasBounds) {
+				const Rendering::Model* model = GetAssetManager().Get(tracked.model);
+				if (!model) {
+					// Not loaded (yet); Draw would skip it too.
+					RemoveProxy(tracked);
+					continue;
+				}
+				tracked.localBounds = {model->m_boundsMin, model->m_boundsMax};
+				tracked.hasBounds   = true;
+				refit               = true;
+			}
+
+			if (!refit && !m_hierarchy.IsDirty(tracked.entity) && !m_hierarchy.HasChanged(tracked.entity)) continue;
+
+			const auto& transform = m_registry.get<Components::Transform>(tracked.entity);
+			const AABB  world     = AABB::Transform(tracked.localBounds, transform.GetWorldMatrix());
+			if (tracked.proxy == BoundsTree::kNullProxy) {
+				tracked.proxy = m_tree.CreateProxy(world, tracked.entity);
+			}
+			else {
+				m_tree.MoveProxy(tracked.proxy, world);
+			}
+		}
+	}
+
+	void CullingWorld::Cull(const Frustum* frusta, size_t count, VisibleSet* results)
+	{
+		ZoneScoped;
+
+		const uint32_t objects  = m_tree.GetProxyCount();
+		const bool     parallel = objects >= kMinProxiesForParallel && Get().threadPool && GetThreadPool().IsRunning();
+
+		m_jobs.clear();
+		m_jobView.clear();
+		for (size_t v = 0; v < count; ++v) {
+			VisibleSet& result = results[v];
+			result.entities.clear();
+			result.stats = {};
+
+			if (!parallel) {
+				m_tree.Query(frusta[v], result.entities, result.stats);
+				continue;
+			}
+			m_tree.Partition(frusta[v], kJobsPerView, m_viewJobs, result.entities, result.stats);
+			m_jobs.insert(m_jobs.end(), m_viewJobs.begin(), m_viewJobs.end());
+			m_jobView.insert(m_jobView.end(), m_viewJobs.size(), static_cast<uint32_t>(v));
+		}
+
+		if (!m_jobs.empty()) {
+			if (m_jobResults.size() < m_jobs.size()) m_jobResults.resize(m_jobs.size());
+			m_jobStats.assign(m_jobs.size(), CullStats{});
+
+			GetThreadPool().ParallelForIndex(static_cast<int>(m_jobs.size()), 1, [&](int j) {
+				m_jobResults[j].clear();
+				m_tree.QuerySubtree(frusta[m_jobView[j]], m_jobs[j], m_jobResults[j], m_jobStats[j]);
+			});
+
+			// Concatenate in job order so the lists are deterministic.
+			for (size_t j = 0; j < m_jobs.size(); ++j) {
+				VisibleSet& result = results[m_jobView[j]];
+				result.entities.insert(result.entities.end(), m_jobResults[j].begin(), m_jobResults[j].end());
+				result.stats.nodeTests += m_jobStats[j].nodeTests;
+			}
+		}
+
+		for (size_t v = 0; v < count; ++v) {
+			CullStats& stats = results[v].stats;
+			stats.tested     = objects;
+			stats.visible    = static_cast<uint32_t>(results[v].entities.size());
+			stats.culled     = objects - stats.visible;
+		}
+	}
+
+	void CullingWorld::Merge(const VisibleSet* sets, size_t count, std::vector<entt::entity>& out)
+	{
+		out.clear();
+		if (++m_mergeGeneration == 0) {
+			std::fill(m_mergeStamp.begin(), m_mergeStamp.end(), 0u);
+			m_mergeGeneration = 1;
+		}
+
+		for (size_t s = 0; s < count; ++s) {
+			for (const entt::entity entity : sets[s].entities) {
+				const auto index = static_cast<size_t>(entt::to_entity(entity));
+				if (index >= m_mergeStamp.size()) m_mergeStamp.resize(index + 1, 0u);
+				if (m_mergeStamp[index] == m_mergeGeneration) continue;
+				m_mergeStamp[index] = m_mergeGeneration;
+				out.push_back(entity);
+			}
+		}
+	}
+
+} // namespace Engine::Rendering
+
+#include "assets/AssetManager.inl"
@@ -0,0 +1,89 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "entt/entt.hpp"
+#include "assets/AssetHandle.h"
+#include "BoundsTree.h"
+#include "Frustum.h"
+
+namespace Engine {
+	class Scene;
+	class TransformHierarchy;
+} // namespace Engine
+
+namespace Engine::Rendering {
+
+	/// Result of culling one view: compact list of entities to draw plus counters.
+	struct VisibleSet {
+		std::vector<entt::entity> entities;
+		CullStats                 stats;
+	};
+
+	/// Keeps a BoundsTree of every ModelRenderer with a loaded model in a scene.
+	///
+	/// World boxes come from the model's bounds and the Transform world matrix.
+	/// Sync() only refits entities the TransformHierarchy flagged as dirty or
+	/// changed; adds / removes arrive through registry signals.
+	class CullingWorld {
+	  public:
+		explicit CullingWorld(Scene& scene);
+		~CullingWorld();
+
+		CullingWorld(const CullingWorld&)            = delete;
+		CullingWorld& operator=(const CullingWorld&) = delete;
+
+		/// Bring the tree up to date. Main thread, before any Cull this frame.
+		void Sync();
+
+		/// Cull `count` views; results[i] belongs to frusta[i]. Views and the
+		/// subtrees of each view run on the ThreadPool.
+		void Cull(const Frustum* frusta, size_t count, VisibleSet* results);
+
+		/// Union of several visible lists, each entity once, in first-seen order.
+		void Merge(const VisibleSet* sets, size_t count, std::vector<entt::entity>& out);
+
+		[[nodiscard]] const BoundsTree& GetTree() const { return m_tree; }
+
+	  private:
+		struct Tracked {
+			entt::entity         entity = entt::null;
+			BoundsTree::ProxyId  proxy  = BoundsTree::kNullProxy;
+			ModelHandle          model;
+			AABB                 localBounds;
+			bool                 hasBounds = false;
+		};
+
+		void Track(entt::entity entity);
+		void Untrack(entt::entity entity);
+		void RemoveProxy(Tracked& tracked);
+
+		void OnRenderableConstructed(entt::registry& registry, entt::entity entity);
+		void OnRenderableDestroyed(entt::registry& registry, entt::entity entity);
+
+		entt::registry&     m_registry;
+		TransformHierarchy& m_hierarchy;
+		BoundsTree          m_tree;
+
+		std::vector<Tracked>      m_tracked;
+		std::vector<uint32_t>     m_trackedOf; // entt::to_entity(e) → index in m_tracked
+		std::vector<entt::entity> m_pending;
+
+		// Cull scratch, reused between frames.
+		std::vector<BoundsTree::SubtreeJob>    m_viewJobs;
+		std::vector<BoundsTree::SubtreeJob>    m_jobs;
+		std::vector<uint32_t>                  m_jobView;
+		std::vector<std::vector<entt::entity>> m_jobResults;
+		std::vector<CullStats>                 m_jobStats;
+
+		std::vector<uint32_t> m_mergeStamp;
+		uint32_t              m_mergeGeneration = 0;
+	};
+
+} // namespace Engine::Rendering
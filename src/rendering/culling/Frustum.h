@@ -0,0 +1,109 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+namespace Engine::Rendering {
+
+	/// Axis-aligned box in world space.
+	struct AABB {
+		glm::vec3 min{0.0f};
+		glm::vec3 max{0.0f};
+
+		[[nodiscard]] glm::vec3 Center() const { return (min + max) * 0.5f; }
+		[[nodiscard]] glm::vec3 Extents() const { return (max - min) * 0.5f; }
+
+		[[nodiscard]] float SurfaceArea() const
+		{
+			const glm::vec3 d = max - min;
+			return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+		}
+
+		[[nodiscard]] bool Contains(const AABB& other) const
+		{
+			return glm::all(glm::lessThanEqual(min, other.min)) && glm::all(glm::greaterThanEqual(max, other.max));
+		}
+
+		[[nodiscard]] static AABB Union(const AABB& a, const AABB& b) { return {glm::min(a.min, b.min), glm::max(a.max, b.max)}; }
+
+		/// Bounds of `local` after transforming it by `m` (Arvo: no corner loop).
+		[[nodiscard]] static AABB Transform(const AABB& local, const glm::mat4& m)
+		{
+			const glm::vec3 c = glm::vec3(m * glm::vec4(local.Center(), 1.0f));
+			const glm::vec3 e = local.Extents();
+			const glm::vec3 ext(glm::abs(m[0][0]) * e.x + glm::abs(m[1][0]) * e.y + glm::abs(m[2][0]) * e.z,
+			                    glm::abs(m[0][1]) * e.x + glm::abs(m[1][1]) * e.y + glm::abs(m[2][1]) * e.z,
+			                    glm::abs(m[0][2]) * e.x + glm::abs(m[1][2]) * e.y + glm::abs(m[2][2]) * e.z);
+			return {c - ext, c + ext};
+		}
+	};
+
+	/// Six clip planes pulled from a view-projection matrix (OpenGL clip space).
+	/// Works for perspective cameras and for the orthographic shadow cascades.
+	class Frustum {
+	  public:
+		static constexpr uint8_t kAllPlanes = 0x3F;
+
+		enum class Result : uint8_t { Outside, Intersects, Inside };
+
+		Frustum() = default;
+		explicit Frustum(const glm::mat4& viewProjection) { SetFromMatrix(viewProjection); }
+
+		void SetFromMatrix(const glm::mat4& m)
+		{
+			const glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+			const glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+			const glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+			const glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+			m_planes[0] = row3 + row0; // left
+			m_planes[1] = row3 - row0; // right
+			m_planes[2] = row3 + row1; // bottom
+			m_planes[3] = row3 - row1; // top
+			m_planes[4] = row3 + row2; // near
+			m_planes[5] = row3 - row2; // far
+
+			for (glm::vec4& p : m_planes) {
+				const float len = glm::length(glm::vec3(p));
+				if (len > 0.0f) p /= len;
+			}
+		}
+
+		/// Test `box` against the planes still set in `mask`. Planes the box is
+		/// completely inside of are cleared from `mask`, so children of a node
+		/// only test the planes their parent straddled.
+		[[nodiscard]] Result Test(const AABB& box, uint8_t& mask) const
+		{
+			const glm::vec3 c = box.Center();
+			const glm::vec3 e = box.Extents();
+			for (int i = 0; i < 6; ++i) {
+				const uint8_t bit = static_cast<uint8_t>(1u << i);
+				if (!(mask & bit)) continue;
+
+				const glm::vec3 n = glm::vec3(m_planes[i]);
+				const float     s = glm::dot(n, c) + m_planes[i].w;
+				const float     r = glm::dot(glm::abs(n), e);
+				if (s + r < 0.0f) return Result::Outside;
+				if (s - r >= 0.0f) mask &= static_cast<uint8_t>(~bit);
+			}
+			return mask == 0 ? Result::Inside : Result::Intersects;
+		}
+
+		[[nodiscard]] bool Intersects(const AABB& box) const
+		{
+			uint8_t mask = kAllPlanes;
+			return Test(box, mask) != Result::Outside;
+		}
+
+		[[nodiscard]] const glm::vec4& GetPlane(int i) const { return m_planes[i]; }
+
+	  private:
+		glm::vec4 m_planes[6]{};
+	};
+
+} // namespace Engine::Rendering
@@ -252,19 +252,18 @@ namespace Engine {
 		// Effects are bound to a Manager — reload all Particle assets onto the new one.
 		auto& storage  = GetAssetManager().GetStorage<Particle>();
 		int   reloaded = 0;
-		for (auto& [guid, asset] : storage.guidToAsset) {
-			if (!asset) continue;
-			const std::string& path = asset->GetPath();
+		storage.ForEach([&](const std::string& guid, Particle& asset) {
+			const std::string& path = asset.GetPath();
 			if (path.empty()) {
 				log->warn("Particle {} has empty path; cannot rebind to new manager", guid);
-				continue;
+				return;
 			}
-			if (!asset->LoadFromFile(path)) {
+			if (!asset.LoadFromFile(path)) {
 				log->error("Failed to reload particle effect after manager reset: {}", path);
-				continue;
+				return;
 			}
 			++reloaded;
-		}
+		});
 		if (reloaded > 0) {
 			log->info("Rebound {} particle effect(s) to new Effekseer manager", reloaded);
 		}
@@ -272,6 +271,8 @@ namespace Engine {
 
 	void ParticleManager::PlayEffect(Entity& entity)
 	{
+		if (IsHeadless()) return;
+
 		const auto& manager = GetManager();
 		ENGINE_VERIFY(manager != nullptr, "ParticleManager::PlayEffect: Effekseer manager is null");
 
@@ -0,0 +1,114 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#include "GLInstanceBuffer.h"
+
+#include <algorithm>
+
+#include "utils/Utils.h"
+
+namespace Engine::Rendering {
+
+	namespace {
+		// Large enough that non-instanced draws of these VAOs still read in-bounds instance 0.
+		constexpr uint32_t kInitialCapacity = 1024;
+		constexpr GLsizei  kStride          = sizeof(InstanceData);
+	} // namespace
+
+	GLuint   GLInstanceBuffer::s_buffer   = 0;
+	uint32_t GLInstanceBuffer::s_capacity = 0;
+	uint32_t GLInstanceBuffer::s_cursor   = 0;
+
+	void GLInstanceBuffer::EnsureCreated()
+	{
+		if (s_buffer != 0) return;
+		glGenBuffers(1, &s_buffer);
+		glBindBuffer(GL_ARRAY_BUFFER, s_buffer);
+		glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(kInitialCapacity) * kStride, nullptr, GL_STREAM_DRAW);
+		s_capacity = kInitialCapacity;
+		s_cursor   = 0;
+	}
+
+	void GLInstanceBuffer::SetupAttributes()
+	{
+		EnsureCreated();
+		glBindBuffer(GL_ARRAY_BUFFER, s_buffer);
+		for (GLuint column = 0; column < 4; ++column) {
+			const GLuint location = kWorldLocation + column;
+			glEnableVertexAttribArray(location);
+			glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, kStride, reinterpret_cast<void*>(offsetof(InstanceData, world) + column * sizeof(glm::vec4)));
+			glVertexAttribDivisor(location, 1);
+		}
+		glEnableVertexAttribArray(kEntityLocation);
+		glVertexAttribIPointer(kEntityLocation, 1, GL_UNSIGNED_INT, kStride, reinterpret_cast<void*>(offsetof(InstanceData, entity)));
+		glVertexAttribDivisor(kEntityLocation, 1);
+	}
+
+	void GLInstanceBuffer::BeginFrame()
+	{
+		EnsureCreated();
+		glBindBuffer(GL_ARRAY_BUFFER, s_buffer);
+		glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(s_capacity) * kStride, nullptr, GL_STREAM_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		s_cursor = 0;
+	}
+
+	void GLInstanceBuffer::Grow(uint32_t required)
+	{
+		ZoneScoped;
+		const uint32_t capacity = std::max(required, s_capacity * 2);
+
+		// Same buffer name keeps every VAO's attribute binding valid; copy this frame's
+		// earlier uploads through a scratch buffer so they stay drawable.
+		GLuint scratch = 0;
+		if (s_cursor > 0) {
+			glGenBuffers(1, &scratch);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, scratch);
+			glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(s_cursor) * kStride, nullptr, GL_STREAM_COPY);
+			glBindBuffer(GL_COPY_READ_BUFFER, s_buffer);
+			glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, static_cast<GLsizeiptr>(s_cursor) * kStride);
+		}
+
+		glBindBuffer(GL_ARRAY_BUFFER, s_buffer);
+		glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(capacity) * kStride, nullptr, GL_STREAM_DRAW);
+		s_capacity = capacity;
+
+		if (scratch != 0) {
+			glBindBuffer(GL_COPY_READ_BUFFER, scratch);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, s_buffer);
+			glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, static_cast<GLsizeiptr>(s_cursor) * kStride);
+			glDeleteBuffers(1, &scratch);
+		}
+		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	}
+
+	uint32_t GLInstanceBuffer::Upload(const std::vector<InstanceData>& instances)
+	{
+		ZoneScoped;
+		EnsureCreated();
+
+		const uint32_t base  = s_cursor;
+		const auto     count = static_cast<uint32_t>(instances.size());
+		if (count == 0) return base;
+		if (base + count > s_capacity) Grow(base + count);
+
+		glBindBuffer(GL_ARRAY_BUFFER, s_buffer);
+		glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(base) * kStride, static_cast<GLsizeiptr>(count) * kStride, instances.data());
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		ENGINE_GLCheckError();
+
+		s_cursor += count;
+		return base;
+	}
+
+	void GLInstanceBuffer::CleanUp()
+	{
+		if (s_buffer != 0) glDeleteBuffers(1, &s_buffer);
+		s_buffer   = 0;
+		s_capacity = 0;
+		s_cursor   = 0;
+	}
+
+} // namespace Engine::Rendering
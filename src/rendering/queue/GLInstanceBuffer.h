@@ -0,0 +1,37 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include <vector>
+
+#include "InstanceBatcher.h"
+
+namespace Engine::Rendering {
+
+	/// Per-frame instance data shared by every mesh VAO. Each pass appends its
+	/// instances and draws with a base instance, so the VAOs never need re-pointing.
+	class GLInstanceBuffer {
+	  public:
+		static constexpr GLuint kWorldLocation  = 8; // mat4: 8, 9, 10, 11
+		static constexpr GLuint kEntityLocation = 12;
+
+		/// Point the instance attributes of the bound VAO at the shared buffer.
+		static void SetupAttributes();
+		/// Orphan last frame's storage; earlier uploads are invalid afterwards.
+		static void BeginFrame();
+		/// Append instances; returns the base instance to draw them with. Valid until the next BeginFrame.
+		static uint32_t Upload(const std::vector<InstanceData>& instances);
+		static void     CleanUp();
+
+	  private:
+		static void EnsureCreated();
+		static void Grow(uint32_t required);
+
+		static GLuint   s_buffer;
+		static uint32_t s_capacity; // in instances
+		static uint32_t s_cursor;
+	};
+
+} // namespace Engine::Rendering
@@ -0,0 +1,220 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#include "GLRenderCommands.h"
+
+#include "core/EngineData.h"
+#include "rendering/Material.h"
+#include "rendering/Texture.h"
+
+namespace Engine::Rendering {
+
+	namespace {
+		// Same packing as Renderer::EncodeEntityID.
+		glm::vec3 EncodeEntityID(entt::entity entityID)
+		{
+			const auto  id = static_cast<uint32_t>(entityID);
+			const float r  = static_cast<float>(id & 0xFF) / 255.0f;
+			const float g  = static_cast<float>((id >> 8) & 0xFF) / 255.0f;
+			const float b  = static_cast<float>((id >> 16) & 0xFF) / 255.0f;
+			return {r, g, b};
+		}
+
+		/// Stands in for draws without a material. Never destroyed: there is no GL context at exit.
+		const Material& DefaultMaterial()
+		{
+			static const Material* material = [] {
+				auto* m = new Material();
+				m->SetAmbientColor(glm::vec3(1.0f));
+				m->SetEmissiveColor(glm::vec3(0.0f));
+				return m;
+			}();
+			return *material;
+		}
+
+		GLuint ResolveTexture(const TextureHandle& handle)
+		{
+			if (!handle.IsValid()) return 0;
+			const Texture* texture = GetAssetManager().Get(handle);
+			return texture ? texture->GetID() : 0;
+		}
+	} // namespace
+
+	GLRenderCommands::GLRenderCommands(const Shader& shader, uint32_t flags) : m_shader(shader), m_flags(flags)
+	{
+		m_loc.model = shader.GetUniformLocation("model");
+		if (m_flags & kEntityIdColor) {
+			m_loc.entityIdColor = shader.GetUniformLocation("entityIDColor");
+		}
+		if (m_flags & kDepthOnly) {
+			m_loc.diffuseTexture = shader.GetUniformLocation("diffuseTexture");
+		}
+		else if (m_flags & kUploadMaterials) {
+			m_materialBlock      = shader.UsesUniformBlock(kMaterialDataBinding);
+			m_loc.diffuseTexture     = shader.GetUniformLocation("diffuseTexture");
+			m_loc.normalTexture      = shader.GetUniformLocation("normalTexture");
+			m_loc.specularTexture    = shader.GetUniformLocation("specularTexture");
+			m_loc.hasDiffuseTexture  = shader.GetUniformLocation("hasDiffuseTexture");
+			m_loc.hasNormalTexture   = shader.GetUniformLocation("hasNormalTexture");
+			m_loc.hasSpecularTexture = shader.GetUniformLocation("hasSpecularTexture");
+			m_loc.textureScale       = shader.GetUniformLocation("textureScale");
+			m_loc.diffuseColor       = shader.GetUniformLocation("uDiffuseColor");
+			m_loc.specularColor      = shader.GetUniformLocation("uSpecularColor");
+			m_loc.ambientColor       = shader.GetUniformLocation("uAmbientColor");
+			m_loc.emissiveColor      = shader.GetUniformLocation("uEmissiveColor");
+			m_loc.shininess          = shader.GetUniformLocation("uShininess");
+		}
+	}
+
+	void GLRenderCommands::InvalidateState()
+	{
+		m_texturesKnown = false;
+	}
+
+	void GLRenderCommands::BindPipeline(uint8_t)
+	{
+		m_shader.Bind();
+		if (m_flags & kDepthOnly) {
+			m_shader.SetInt(m_loc.diffuseTexture, 0);
+		}
+		else if (m_flags & kUploadMaterials) {
+			// Sampler units never change; set them once per program bind.
+			m_shader.SetInt(m_loc.diffuseTexture, 0);
+			m_shader.SetInt(m_loc.normalTexture, 1);
+			m_shader.SetInt(m_loc.specularTexture, 2);
+		}
+	}
+
+	void GLRenderCommands::BindTexture(int unit, GLuint texture, RenderQueueStats& stats)
+	{
+		if (m_texturesKnown && m_boundTextures[unit] == texture) return;
+		glActiveTexture(GL_TEXTURE0 + unit);
+		glBindTexture(GL_TEXTURE_2D, texture);
+		m_boundTextures[unit] = texture;
+		stats.textureBinds++;
+	}
+
+	void GLRenderCommands::BindMaterial(const Material* material, RenderQueueStats& stats)
+	{
+		if (m_flags & kDepthOnly) {
+			// The depth shader samples diffuse alpha unconditionally; 0 reads as opaque.
+			BindTexture(0, material ? ResolveTexture(material->GetDiffuseTexture()) : 0, stats);
+			m_texturesKnown = true;
+			return;
+		}
+		if (!(m_flags & kUploadMaterials)) return;
+
+		auto upload = [&stats](GLint location, auto&& set) {
+			if (location < 0) return;
+			set(location);
+			stats.uniformUploads++;
+		};
+
+		if (material) {
+			// Missing textures bind 0 so nothing from the previous material leaks in
+			// (the depth shader samples diffuse alpha unconditionally).
+			BindTexture(0, ResolveTexture(material->GetDiffuseTexture()), stats);
+			BindTexture(1, ResolveTexture(material->GetNormalTexture()), stats);
+			BindTexture(2, ResolveTexture(material->GetSpecularTexture()), stats);
+			m_texturesKnown = true;
+
+			if (m_materialBlock) {
+				glBindBufferBase(GL_UNIFORM_BUFFER, kMaterialDataBinding, material->GetUniformBuffer());
+				ENGINE_GLCheckError();
+				return;
+			}
+
+			upload(m_loc.hasDiffuseTexture, [&](GLint l) { m_shader.SetInt(l, material->GetDiffuseTexture().IsValid() ? 1 : 0); });
+			upload(m_loc.hasNormalTexture, [&](GLint l) { m_shader.SetInt(l, material->GetNormalTexture().IsValid() ? 1 : 0); });
+			upload(m_loc.hasSpecularTexture, [&](GLint l) { m_shader.SetInt(l, material->GetSpecularTexture().IsValid() ? 1 : 0); });
+			upload(m_loc.textureScale, [&](GLint l) { m_shader.SetVec2(l, material->GetTextureScale()); });
+			upload(m_loc.diffuseColor, [&](GLint l) { m_shader.SetVec3(l, material->GetDiffuseColor()); });
+			upload(m_loc.specularColor, [&](GLint l) { m_shader.SetVec3(l, material->GetSpecularColor()); });
+			upload(m_loc.ambientColor, [&](GLint l) { m_shader.SetVec3(l, material->GetAmbientColor()); });
+			upload(m_loc.emissiveColor, [&](GLint l) { m_shader.SetVec3(l, material->GetEmissiveColor()); });
+			upload(m_loc.shininess, [&](GLint l) { m_shader.SetFloat(l, material->GetShininess()); });
+		}
+		else {
+			BindTexture(0, 0, stats);
+			BindTexture(1, 0, stats);
+			BindTexture(2, 0, stats);
+			m_texturesKnown = true;
+
+			if (m_materialBlock) {
+				glBindBufferBase(GL_UNIFORM_BUFFER, kMaterialDataBinding, DefaultMaterial().GetUniformBuffer());
+				ENGINE_GLCheckError();
+				return;
+			}
+
+			upload(m_loc.hasDiffuseTexture, [&](GLint l) { m_shader.SetInt(l, 0); });
+			upload(m_loc.hasNormalTexture, [&](GLint l) { m_shader.SetInt(l, 0); });
+			upload(m_loc.hasSpecularTexture, [&](GLint l) { m_shader.SetInt(l, 0); });
+			upload(m_loc.shininess, [&](GLint l) { m_shader.SetFloat(l, 32.0f); });
+			upload(m_loc.ambientColor, [&](GLint l) { m_shader.SetVec3(l, glm::vec3(1.0f)); });
+			upload(m_loc.emissiveColor, [&](GLint l) { m_shader.SetVec3(l, glm::vec3(0.0f)); });
+		}
+		ENGINE_GLCheckError();
+	}
+
+	const Material* DepthOnlyMaterial(const Material* material)
+	{
+		if (!material || !material->GetDiffuseTexture().IsValid()) return nullptr;
+		// Not loaded yet: keep the material; it binds nothing now and samples alpha once loaded.
+		const Texture* texture = GetAssetManager().Get(material->GetDiffuseTexture());
+		return !texture || texture->HasAlpha() ? material : nullptr;
+	}
+
+	void GLRenderCommands::SetCullBackfaces(bool cull)
+	{
+		if (cull)
+			glEnable(GL_CULL_FACE);
+		else
+			glDisable(GL_CULL_FACE);
+	}
+
+	void GLRenderCommands::BindVertexArray(uint32_t vertexArray)
+	{
+		glBindVertexArray(vertexArray);
+	}
+
+	void GLRenderCommands::SetTransform(const glm::mat4& world, entt::entity entity, RenderQueueStats& stats)
+	{
+		if (m_loc.model >= 0) {
+			m_shader.SetMat4(m_loc.model, world);
+			stats.uniformUploads++;
+		}
+		if (m_loc.entityIdColor >= 0) {
+			m_shader.SetVec3(m_loc.entityIdColor, EncodeEntityID(entity));
+			stats.uniformUploads++;
+		}
+	}
+
+	void GLRenderCommands::DrawIndexed(uint32_t indexCount)
+	{
+		glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indexCount), GL_UNSIGNED_INT, nullptr);
+	}
+
+	void GLRenderCommands::DrawIndexedInstanced(uint32_t indexCount, uint32_t firstInstance, uint32_t instanceCount)
+	{
+		glDrawElementsInstancedBaseInstance(GL_TRIANGLES, static_cast<GLsizei>(indexCount), GL_UNSIGNED_INT, nullptr, static_cast<GLsizei>(instanceCount), firstInstance);
+	}
+
+	void GLRenderCommands::End()
+	{
+		glBindVertexArray(0);
+		if (m_texturesKnown) {
+			for (int unit = kTextureUnits - 1; unit >= 0; --unit) {
+				if (m_boundTextures[unit] == 0) continue;
+				glActiveTexture(GL_TEXTURE0 + unit);
+				glBindTexture(GL_TEXTURE_2D, 0);
+				m_boundTextures[unit] = 0;
+			}
+		}
+		glActiveTexture(GL_TEXTURE0);
+		ENGINE_GLCheckError();
+	}
+
+} // namespace Engine::Rendering
+
+#include "assets/AssetManager.inl"
@@ -0,0 +1,75 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include "RenderQueue.h"
+#include "rendering/Shader.h"
+
+namespace Engine::Rendering {
+
+	/// RenderCommandSink that draws with one Shader. Uniform locations are resolved
+	/// once per pass and texture units remember what is bound, so switching to a
+	/// material that shares textures with the previous one costs no binds. Shaders
+	/// with a MaterialData block get the material's uniform buffer bound instead of
+	/// per-material uniform uploads.
+	class GLRenderCommands : public RenderCommandSink {
+	  public:
+		enum Flags : uint32_t {
+			kNone            = 0,
+			kUploadMaterials = 1 << 0, // textures + material uniforms
+			kEntityIdColor   = 1 << 1, // mouse picking: per-entity `entityIDColor`
+			kDepthOnly       = 1 << 2, // shadow / depth passes: the diffuse texture for alpha testing, nothing else
+		};
+
+		GLRenderCommands(const Shader& shader, uint32_t flags);
+
+		void InvalidateState() override;
+		void BindPipeline(uint8_t pipeline) override;
+		void BindMaterial(const Material* material, RenderQueueStats& stats) override;
+		void SetCullBackfaces(bool cull) override;
+		void BindVertexArray(uint32_t vertexArray) override;
+		void SetTransform(const glm::mat4& world, entt::entity entity, RenderQueueStats& stats) override;
+		void DrawIndexed(uint32_t indexCount) override;
+		void DrawIndexedInstanced(uint32_t indexCount, uint32_t firstInstance, uint32_t instanceCount) override;
+
+		/// Leave GL the way the per-mesh Draw path did: no VAO, texture units empty.
+		void End();
+
+	  private:
+		static constexpr int kTextureUnits = 3; // diffuse, normal, specular
+
+		void BindTexture(int unit, GLuint texture, RenderQueueStats& stats);
+
+		const Shader& m_shader;
+		uint32_t      m_flags;
+
+		struct Locations {
+			GLint model              = -1;
+			GLint entityIdColor      = -1;
+			GLint diffuseTexture     = -1;
+			GLint normalTexture      = -1;
+			GLint specularTexture    = -1;
+			GLint hasDiffuseTexture  = -1;
+			GLint hasNormalTexture   = -1;
+			GLint hasSpecularTexture = -1;
+			GLint textureScale       = -1;
+			GLint diffuseColor       = -1;
+			GLint specularColor      = -1;
+			GLint ambientColor       = -1;
+			GLint emissiveColor      = -1;
+			GLint shininess          = -1;
+		} m_loc;
+
+		bool m_materialBlock = false;
+
+		GLuint m_boundTextures[kTextureUnits] = {};
+		bool   m_texturesKnown                = false;
+	};
+
+	/// What a kDepthOnly pass needs of `material`: itself if its diffuse alpha may cut texels out,
+	/// otherwise null, so opaque meshes batch together whatever their material.
+	const Material* DepthOnlyMaterial(const Material* material);
+
+} // namespace Engine::Rendering
@@ -0,0 +1,58 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#include "InstanceBatcher.h"
+
+#include <tracy/Tracy.hpp>
+
+namespace Engine::Rendering {
+
+	namespace {
+		bool SameBatch(const DrawItem& a, const DrawItem& b)
+		{
+			return a.vertexArray == b.vertexArray && a.material == b.material && a.pipeline == b.pipeline && a.cullBackfaces == b.cullBackfaces && a.indexCount == b.indexCount;
+		}
+	} // namespace
+
+	void InstanceBatcher::Clear()
+	{
+		m_instances.clear();
+		m_batches.clear();
+	}
+
+	void InstanceBatcher::Build(const RenderQueue& queue)
+	{
+		ZoneScoped;
+		Clear();
+		m_instances.reserve(queue.Size());
+
+		for (size_t i = 0; i < queue.Size(); ++i) {
+			const DrawItem& item = queue.GetSorted(i);
+			if (m_batches.empty() || !SameBatch(m_batches.back().item, item)) {
+				m_batches.push_back({item, static_cast<uint32_t>(m_instances.size()), 0});
+			}
+			m_batches.back().instanceCount++;
+
+			InstanceData& instance = m_instances.emplace_back();
+			instance.world         = queue.GetTransform(item.transform);
+			instance.entity        = static_cast<uint32_t>(item.entity);
+		}
+	}
+
+	RenderQueueStats InstanceBatcher::Submit(RenderCommandSink& sink, uint32_t baseInstance) const
+	{
+		ZoneScoped;
+
+		RenderQueueStats stats;
+		StateTracker     state(sink, stats, true);
+		for (const InstanceBatch& batch : m_batches) {
+			state.Apply(batch.item);
+			sink.DrawIndexedInstanced(batch.item.indexCount, baseInstance + batch.firstInstance, batch.instanceCount);
+			stats.draws++;
+			stats.instances += batch.instanceCount;
+		}
+		return stats;
+	}
+
+} // namespace Engine::Rendering
@@ -0,0 +1,49 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "RenderQueue.h"
+
+namespace Engine::Rendering {
+
+	/// One instance as the vertex shaders read it (locations 8-11 world, 12 entity id).
+	struct InstanceData {
+		glm::mat4 world;
+		uint32_t  entity;
+		uint32_t  padding[3]; // keep 16-byte stride alignment
+	};
+	static_assert(sizeof(InstanceData) == 80, "InstanceData layout must match GLInstanceBuffer attributes");
+
+	/// Consecutive draws that share every piece of state, drawn with one instanced call.
+	struct InstanceBatch {
+		DrawItem item; // state of the batch; transform / entity are per instance
+		uint32_t firstInstance = 0;
+		uint32_t instanceCount = 0;
+	};
+
+	/// Groups a sorted RenderQueue by (pipeline, material, cull mode, mesh) and packs
+	/// each group's world matrices and entity ids contiguously. Pure CPU; the
+	/// instance array is uploaded by whoever owns the GPU buffer.
+	class InstanceBatcher {
+	  public:
+		void Clear();
+		/// `queue` must already be sorted, otherwise groups split wherever state alternates.
+		void Build(const RenderQueue& queue);
+
+		/// One DrawIndexedInstanced per batch. `baseInstance` is where GetInstances() landed in the GPU buffer.
+		RenderQueueStats Submit(RenderCommandSink& sink, uint32_t baseInstance) const;
+
+		[[nodiscard]] const std::vector<InstanceData>&  GetInstances() const { return m_instances; }
+		[[nodiscard]] const std::vector<InstanceBatch>& GetBatches() const { return m_batches; }
+
+	  private:
+		std::vector<InstanceData>  m_instances;
+		std::vector<InstanceBatch> m_batches;
+	};
+
+} // namespace Engine::Rendering
@@ -0,0 +1,140 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#include "RenderQueue.h"
+
+#include <algorithm>
+
+#include <tracy/Tracy.hpp>
+
+namespace Engine::Rendering {
+
+	namespace {
+		// Key layout, most significant first. 61 bits used.
+		constexpr int kPipelineBits    = 4;
+		constexpr int kMaterialBits    = 20;
+		constexpr int kCullBits        = 1;
+		constexpr int kVertexArrayBits = 20;
+		constexpr int kDepthBits       = 16;
+
+		constexpr int kDepthShift       = 0;
+		constexpr int kVertexArrayShift = kDepthShift + kDepthBits;
+		constexpr int kCullShift        = kVertexArrayShift + kVertexArrayBits;
+		constexpr int kMaterialShift    = kCullShift + kCullBits;
+		constexpr int kPipelineShift    = kMaterialShift + kMaterialBits;
+		static_assert(kPipelineShift + kPipelineBits <= 64, "Sort key does not fit in 64 bits");
+
+		constexpr uint64_t Mask(int bits) { return (uint64_t{1} << bits) - 1; }
+	} // namespace
+
+	uint64_t RenderQueue::MakeKey(uint8_t pipeline, uint32_t materialId, bool cullBackfaces, uint32_t vertexArray, float depth)
+	{
+		const auto quantizedDepth = static_cast<uint64_t>(std::clamp(depth, 0.0f, 1.0f) * static_cast<float>(Mask(kDepthBits)));
+		return (static_cast<uint64_t>(pipeline) & Mask(kPipelineBits)) << kPipelineShift | (static_cast<uint64_t>(materialId) & Mask(kMaterialBits)) << kMaterialShift |
+		       static_cast<uint64_t>(cullBackfaces ? 1 : 0) << kCullShift | (static_cast<uint64_t>(vertexArray) & Mask(kVertexArrayBits)) << kVertexArrayShift |
+		       quantizedDepth << kDepthShift;
+	}
+
+	void RenderQueue::Clear()
+	{
+		m_items.clear();
+		m_order.clear();
+		m_transforms.clear();
+		m_materialIds.clear();
+	}
+
+	uint32_t RenderQueue::AddTransform(const glm::mat4& world)
+	{
+		m_transforms.push_back(world);
+		return static_cast<uint32_t>(m_transforms.size() - 1);
+	}
+
+	uint32_t RenderQueue::MaterialId(const Material* material)
+	{
+		// Dense ids in first-seen order; 0 is the default material.
+		if (!material) return 0;
+		const auto [it, inserted] = m_materialIds.try_emplace(material, static_cast<uint32_t>(m_materialIds.size() + 1));
+		return it->second;
+	}
+
+	void RenderQueue::Add(const DrawItem& item, float depth)
+	{
+		const uint64_t key = MakeKey(item.pipeline, MaterialId(item.material), item.cullBackfaces, item.vertexArray, depth);
+		m_order.push_back({key, static_cast<uint32_t>(m_items.size())});
+		m_items.push_back(item);
+	}
+
+	void RenderQueue::Sort()
+	{
+		ZoneScoped;
+		// Stable so equal keys keep submission order (deterministic frames).
+		std::stable_sort(m_order.begin(), m_order.end(), [](const SortEntry& a, const SortEntry& b) { return a.key < b.key; });
+	}
+
+	StateTracker::StateTracker(RenderCommandSink& sink, RenderQueueStats& stats, bool elideRedundantState) : m_sink(sink), m_stats(stats), m_elide(elideRedundantState)
+	{
+		m_sink.InvalidateState();
+	}
+
+	bool StateTracker::Apply(const DrawItem& item)
+	{
+		if (!m_elide) {
+			m_sink.InvalidateState();
+			m_first = true;
+		}
+
+		const bool pipelineChanged = m_first || item.pipeline != m_pipeline;
+		if (pipelineChanged) {
+			m_sink.BindPipeline(item.pipeline);
+			m_stats.pipelineBinds++;
+			m_pipeline = item.pipeline;
+		}
+		// A new program has none of the previous material uniforms.
+		if (pipelineChanged || item.material != m_material) {
+			m_sink.BindMaterial(item.material, m_stats);
+			m_stats.materialBinds++;
+			m_material = item.material;
+		}
+		if (m_first || item.cullBackfaces != m_cullBackfaces) {
+			m_sink.SetCullBackfaces(item.cullBackfaces);
+			m_stats.rasterStateChanges++;
+			m_cullBackfaces = item.cullBackfaces;
+		}
+		if (m_first || item.vertexArray != m_vertexArray) {
+			m_sink.BindVertexArray(item.vertexArray);
+			m_stats.vertexArrayBinds++;
+			m_vertexArray = item.vertexArray;
+		}
+
+		m_first = false;
+		return pipelineChanged;
+	}
+
+	RenderQueueStats RenderQueue::Submit(RenderCommandSink& sink, bool elideRedundantState) const
+	{
+		ZoneScoped;
+
+		RenderQueueStats stats;
+		StateTracker     state(sink, stats, elideRedundantState);
+
+		bool     first     = true;
+		uint32_t transform = 0;
+		for (const SortEntry& entry : m_order) {
+			const DrawItem& item = m_items[entry.item];
+
+			const bool pipelineChanged = state.Apply(item);
+			if (first || pipelineChanged || !elideRedundantState || item.transform != transform) {
+				sink.SetTransform(m_transforms[item.transform], item.entity, stats);
+				transform = item.transform;
+			}
+
+			sink.DrawIndexed(item.indexCount);
+			stats.draws++;
+			stats.instances++;
+			first = false;
+		}
+		return stats;
+	}
+
+} // namespace Engine::Rendering
@@ -0,0 +1,124 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "entt/entt.hpp"
+
+namespace Engine {
+	class Material;
+}
+
+namespace Engine::Rendering {
+
+	/// What a queue submission actually sent to the sink.
+	struct RenderQueueStats {
+		uint32_t draws              = 0;
+		uint32_t instances          = 0;
+		uint32_t pipelineBinds      = 0;
+		uint32_t materialBinds      = 0;
+		uint32_t textureBinds       = 0;
+		uint32_t vertexArrayBinds   = 0;
+		uint32_t rasterStateChanges = 0;
+		uint32_t uniformUploads     = 0;
+
+		[[nodiscard]] uint32_t StateChanges() const { return pipelineBinds + materialBinds + textureBinds + vertexArrayBinds + rasterStateChanges; }
+	};
+
+	/// One indexed draw. The material is resolved (overrides applied) when queued.
+	struct DrawItem {
+		const Material* material      = nullptr; // null = built-in default material
+		uint32_t        vertexArray   = 0;
+		uint32_t        indexCount    = 0;
+		uint32_t        transform     = 0; // RenderQueue::AddTransform index
+		entt::entity    entity        = entt::null;
+		uint8_t         pipeline      = 0;
+		bool            cullBackfaces = true;
+	};
+
+	/// Receives the state changes of a submission. The renderer implements it
+	/// with GL calls; benchmarks implement it with counters.
+	class RenderCommandSink {
+	  public:
+		virtual ~RenderCommandSink() = default;
+
+		/// Forget any cached state; the next bind of each kind must be issued.
+		virtual void InvalidateState() {}
+		virtual void BindPipeline(uint8_t pipeline) = 0;
+		virtual void BindMaterial(const Material* material, RenderQueueStats& stats) = 0;
+		virtual void SetCullBackfaces(bool cull) = 0;
+		virtual void BindVertexArray(uint32_t vertexArray) = 0;
+		virtual void SetTransform(const glm::mat4& world, entt::entity entity, RenderQueueStats& stats) = 0;
+		virtual void DrawIndexed(uint32_t indexCount) = 0;
+		/// Per-instance data comes from the instance buffer, starting at `firstInstance`.
+		virtual void DrawIndexedInstanced(uint32_t indexCount, uint32_t firstInstance, uint32_t instanceCount) = 0;
+	};
+
+	/// Issues only the state that differs from the previous draw.
+	class StateTracker {
+	  public:
+		StateTracker(RenderCommandSink& sink, RenderQueueStats& stats, bool elideRedundantState);
+
+		/// Bind what `item` needs. Returns true if the pipeline changed, i.e. per-draw uniforms are gone.
+		bool Apply(const DrawItem& item);
+
+	  private:
+		RenderCommandSink& m_sink;
+		RenderQueueStats&  m_stats;
+		bool               m_elide;
+
+		bool            m_first         = true;
+		uint8_t         m_pipeline      = 0;
+		const Material* m_material      = nullptr;
+		bool            m_cullBackfaces = false;
+		uint32_t        m_vertexArray   = 0;
+	};
+
+	/// Flat list of draws for one pass, sorted by a packed 64-bit key
+	/// (pipeline → material → cull mode → vertex array → front-to-back depth)
+	/// so Submit only issues the state that differs from the previous draw.
+	class RenderQueue {
+	  public:
+		void Clear();
+
+		/// World matrices are shared by every mesh of an entity.
+		uint32_t AddTransform(const glm::mat4& world);
+		/// `depth` is the normalized view distance in [0, 1]; used as the last sort criterion.
+		void     Add(const DrawItem& item, float depth);
+		void     Sort();
+
+		/// Issue every draw. With `elideRedundantState` off every draw re-binds
+		/// everything, which is what the per-mesh Draw path used to do.
+		RenderQueueStats Submit(RenderCommandSink& sink, bool elideRedundantState = true) const;
+
+		[[nodiscard]] size_t Size() const { return m_items.size(); }
+		[[nodiscard]] bool   Empty() const { return m_items.empty(); }
+
+		/// Items in submission order (sorted once Sort has run).
+		[[nodiscard]] const DrawItem&  GetSorted(size_t index) const { return m_items[m_order[index].item]; }
+		[[nodiscard]] const glm::mat4& GetTransform(uint32_t index) const { return m_transforms[index]; }
+
+		static uint64_t MakeKey(uint8_t pipeline, uint32_t materialId, bool cullBackfaces, uint32_t vertexArray, float depth);
+
+	  private:
+		uint32_t MaterialId(const Material* material);
+
+		struct SortEntry {
+			uint64_t key;
+			uint32_t item;
+		};
+
+		std::vector<DrawItem>                           m_items;
+		std::vector<SortEntry>                          m_order;
+		std::vector<glm::mat4>                          m_transforms;
+		std::unordered_map<const Material*, uint32_t> m_materialIds;
+	};
+
+} // namespace Engine::Rendering
@@ -0,0 +1,155 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#include "RenderQueueBenchmark.h"
+
+#include <array>
+#include <chrono>
+#include <random>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "InstanceBatcher.h"
+#include "rendering/Material.h"
+
+namespace Engine::Rendering {
+
+	namespace {
+		constexpr uint32_t kModels           = 32;
+		constexpr uint32_t kMaxMeshes        = 4;
+		constexpr uint32_t kMaterials        = 64;
+		constexpr uint32_t kTextures         = 48;
+		constexpr uint32_t kMaterialUniforms = 9; // has* x3, scale, 4 colors, shininess
+		constexpr uint32_t kSamplerUniforms  = 3;
+
+		using Clock = std::chrono::steady_clock;
+
+		double ElapsedMs(Clock::time_point start)
+		{
+			return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		}
+
+		/// Counts what GLRenderCommands would send to the driver.
+		class CountingSink : public RenderCommandSink {
+		  public:
+			CountingSink(const Material* materials, const std::array<uint32_t, 3>* textures) : m_materials(materials), m_textures(textures) {}
+
+			void InvalidateState() override { m_texturesKnown = false; }
+			void BindPipeline(uint8_t) override { m_pipelineUniforms += kSamplerUniforms; }
+			void BindMaterial(const Material* material, RenderQueueStats& stats) override
+			{
+				const std::array<uint32_t, 3> none{};
+				const auto& textures = material ? m_textures[material - m_materials] : none;
+				for (int unit = 0; unit < 3; ++unit) {
+					if (m_texturesKnown && m_bound[unit] == textures[unit]) continue;
+					m_bound[unit] = textures[unit];
+					stats.textureBinds++;
+				}
+				m_texturesKnown = true;
+				stats.uniformUploads += kMaterialUniforms;
+			}
+			void SetCullBackfaces(bool) override {}
+			void BindVertexArray(uint32_t) override {}
+			void SetTransform(const glm::mat4&, entt::entity, RenderQueueStats& stats) override { stats.uniformUploads++; }
+			void DrawIndexed(uint32_t) override {}
+			void DrawIndexedInstanced(uint32_t, uint32_t, uint32_t) override {}
+
+			uint32_t TakePipelineUniforms()
+			{
+				const uint32_t count = m_pipelineUniforms;
+				m_pipelineUniforms   = 0;
+				return count;
+			}
+
+		  private:
+			const Material*                m_materials;
+			const std::array<uint32_t, 3>* m_textures;
+			std::array<uint32_t, 3>        m_bound{};
+			bool                           m_texturesKnown    = false;
+			uint32_t                       m_pipelineUniforms = 0;
+		};
+
+		struct SyntheticMesh {
+			uint32_t vertexArray;
+			uint32_t indexCount;
+			uint32_t material;
+		};
+	} // namespace
+
+	RenderQueueBenchmarkResult RunRenderQueueBenchmark(uint32_t entityCount, uint32_t seed)
+	{
+		std::mt19937                            rng(seed);
+		std::uniform_int_distribution<uint32_t> pickModel(0, kModels - 1);
+		std::uniform_int_distribution<uint32_t> pickMaterial(0, kMaterials - 1);
+		std::uniform_int_distribution<uint32_t> pickTexture(1, kTextures);
+		std::uniform_int_distribution<uint32_t> pickMeshCount(1, kMaxMeshes);
+		std::uniform_real_distribution<float>   unit(0.0f, 1.0f);
+
+		// Textures are shared between materials (normal / specular maps especially), as in real content.
+		std::vector<Material>                materials(kMaterials);
+		std::vector<std::array<uint32_t, 3>> materialTextures(kMaterials);
+		for (auto& textures : materialTextures) {
+			textures = {pickTexture(rng), unit(rng) < 0.5f ? pickTexture(rng) % 8 : 0u, unit(rng) < 0.3f ? pickTexture(rng) % 4 : 0u};
+		}
+
+		uint32_t                                nextVertexArray = 1;
+		std::vector<std::vector<SyntheticMesh>> models(kModels);
+		std::vector<bool>                       doubleSided(kModels);
+		for (uint32_t m = 0; m < kModels; ++m) {
+			const uint32_t meshes = pickMeshCount(rng);
+			for (uint32_t i = 0; i < meshes; ++i) {
+				models[m].push_back({nextVertexArray++, 300 + (rng() % 5000) * 3, pickMaterial(rng)});
+			}
+			doubleSided[m] = unit(rng) < 0.1f;
+		}
+
+		RenderQueueBenchmarkResult result;
+		result.entities = entityCount;
+
+		RenderQueue queue;
+		auto        start = Clock::now();
+		for (uint32_t e = 0; e < entityCount; ++e) {
+			const uint32_t  m         = pickModel(rng);
+			const glm::mat4 world     = glm::translate(glm::mat4(1.0f), glm::vec3(unit(rng), unit(rng), unit(rng)) * 500.0f);
+			const uint32_t  transform = queue.AddTransform(world);
+			for (const SyntheticMesh& mesh : models[m]) {
+				DrawItem item;
+				item.material      = &materials[mesh.material];
+				item.vertexArray   = mesh.vertexArray;
+				item.indexCount    = mesh.indexCount;
+				item.transform     = transform;
+				item.entity        = static_cast<entt::entity>(e);
+				item.cullBackfaces = !doubleSided[m];
+				queue.Add(item, unit(rng));
+			}
+		}
+		result.buildMs = ElapsedMs(start);
+
+		CountingSink sink(materials.data(), materialTextures.data());
+
+		start                = Clock::now();
+		result.naive         = queue.Submit(sink, false);
+		result.submitNaiveMs = ElapsedMs(start);
+		result.naive.uniformUploads += sink.TakePipelineUniforms();
+
+		start         = Clock::now();
+		queue.Sort();
+		result.sortMs = ElapsedMs(start);
+
+		start                 = Clock::now();
+		result.sorted         = queue.Submit(sink, true);
+		result.submitSortedMs = ElapsedMs(start);
+		result.sorted.uniformUploads += sink.TakePipelineUniforms();
+
+		InstanceBatcher batcher;
+		start = Clock::now();
+		batcher.Build(queue);
+		result.instanced = batcher.Submit(sink, 0);
+		result.batchMs   = ElapsedMs(start);
+		result.instanced.uniformUploads += sink.TakePipelineUniforms();
+
+		return result;
+	}
+
+} // namespace Engine::Rendering
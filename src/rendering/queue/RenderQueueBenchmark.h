@@ -0,0 +1,29 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include <cstdint>
+
+#include "RenderQueue.h"
+
+namespace Engine::Rendering {
+
+	struct RenderQueueBenchmarkResult {
+		uint32_t         entities = 0;
+		RenderQueueStats naive;     // submission order, every draw re-binds everything
+		RenderQueueStats sorted;    // sorted by key, redundant state elided
+		RenderQueueStats instanced; // sorted, one instanced draw per InstanceBatcher group
+		double           buildMs        = 0.0;
+		double           sortMs         = 0.0;
+		double           submitNaiveMs  = 0.0;
+		double           submitSortedMs = 0.0;
+		double           batchMs        = 0.0;
+	};
+
+	/// Build a synthetic scene (shared models / materials / textures, some double-sided),
+	/// queue it and submit it to a counting sink unsorted, sorted and instanced. No GL involved.
+	RenderQueueBenchmarkResult RunRenderQueueBenchmark(uint32_t entityCount = 10000, uint32_t seed = 1337);
+
+} // namespace Engine::Rendering
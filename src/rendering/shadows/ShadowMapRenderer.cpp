@@ -3,6 +3,9 @@
 //
 
 #include "ShadowMapRenderer.h"
+#include "rendering/queue/GLInstanceBuffer.h"
+#include "rendering/queue/GLRenderCommands.h"
+#include "rendering/UniformBuffers.h"
 #include "glm/ext/matrix_transform.hpp"
 #include "spdlog/spdlog.h"
 
@@ -15,7 +18,14 @@
 #include "components/impl/SkinnedMeshComponent.h"
 
 #include "animation/AnimationManager.h"
+#include "terrain/TerrainManager.h"
 #include "components/impl/AnimationComponent.h"
+#include "core/Scene.h"
+#include "core/TransformHierarchy.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
 
 #include <tracy/Tracy.hpp>
 
@@ -49,11 +59,23 @@ namespace Engine {
 		return getFrustumCornersWorldSpace(proj * view);
 	}
 
-	glm::mat4 ShadowMapRenderer::getLightSpaceMatrix(const float nearPlane, const float farPlane)
+	ShadowMapRenderer::Slice ShadowMapRenderer::getSlice(size_t cascade) const
 	{
-		const auto proj    = glm::perspective(glm::radians(GetCamera().m_fov), GetWindow().GetTargetAspectRatio(), nearPlane, farPlane); // m_camera.GetProjectionMatrix(Window::GetTargetAspectRatio());
-		const auto corners = getFrustumCornersWorldSpace(proj, GetCamera().GetViewMatrix());
+		const RenderSettings*     settings = GetRenderSettings();
+		const std::vector<float>& levels   = settings->shadowCascadeLevels;
+		if (cascade == 0) return {settings->CAMERA_NEAR_PLANE, levels[0]};
+		if (cascade < levels.size()) return {levels[cascade - 1], levels[cascade]};
+		return {levels[cascade - 1], settings->CAMERA_FAR_PLANE};
+	}
 
+	std::vector<glm::vec4> ShadowMapRenderer::getSliceCorners(const Slice& slice)
+	{
+		const auto proj = glm::perspective(glm::radians(GetCamera().m_fov), GetWindow().GetTargetAspectRatio(), slice.nearPlane, slice.farPlane); // m_camera.GetProjectionMatrix(Window::GetTargetAspectRatio());
+		return getFrustumCornersWorldSpace(proj, GetCamera().GetViewMatrix());
+	}
+
+	glm::mat4 ShadowMapRenderer::getLightSpaceMatrix(const std::vector<glm::vec4>& corners, const float margin)
+	{
 		glm::vec3 center = glm::vec3(0, 0, 0);
 		for (const auto& v : corners) {
 			center += glm::vec3(v);
@@ -78,6 +100,14 @@ namespace Engine {
 			maxZ           = std::max(maxZ, trf.z);
 		}
 
+		// Held cascades: room for the camera to move before the slice leaves the map.
+		const float padX  = (maxX - minX) * margin;
+		const float padY  = (maxY - minY) * margin;
+		minX             -= padX;
+		maxX             += padX;
+		minY             -= padY;
+		maxY             += padY;
+
 		// Tune this parameter according to the scene
 		constexpr float zMult = 5.0f;
 		if (minZ < 0) {
@@ -97,23 +127,20 @@ namespace Engine {
 		return lightProjection * lightView;
 	}
 
-	std::vector<glm::mat4> ShadowMapRenderer::getLightSpaceMatrices()
+	bool ShadowMapRenderer::covers(const glm::mat4& lightMatrix, const std::vector<glm::vec4>& corners)
 	{
-		std::vector<glm::mat4> ret;
-		for (size_t i = 0; i < GetRenderSettings()->shadowCascadeLevels.size() + 1; ++i) {
-			if (i == 0) {
-				ret.push_back(getLightSpaceMatrix(GetRenderSettings()->CAMERA_NEAR_PLANE, GetRenderSettings()->shadowCascadeLevels[i]));
-			}
-			else if (i < GetRenderSettings()->shadowCascadeLevels.size()) {
-				ret.push_back(getLightSpaceMatrix(GetRenderSettings()->shadowCascadeLevels[i - 1], GetRenderSettings()->shadowCascadeLevels[i]));
-			}
-			else {
-				ret.push_back(getLightSpaceMatrix(GetRenderSettings()->shadowCascadeLevels[i - 1], GetRenderSettings()->CAMERA_FAR_PLANE));
-			}
+		for (const auto& v : corners) {
+			const glm::vec4 p = lightMatrix * v;
+			if (std::abs(p.x) > p.w || std::abs(p.y) > p.w || std::abs(p.z) > p.w) return false;
 		}
-		return ret;
+		return true;
 	}
 
+	size_t ShadowMapRenderer::CascadeCount() const
+	{
+		// Layers the lighting pass samples; the matrix past the last split is never rendered.
+		return std::min({GetRenderSettings()->shadowCascadeLevels.size(), m_lightMatrices.size(), kMaxShadowCascades});
+	}
 
 	void ShadowMapRenderer::Initialize()
 	{
@@ -124,6 +151,8 @@ namespace Engine {
 		if (!m_animationDepthShader.LoadFromFiles("resources/shaders/depth_anim.vert", "resources/shaders/depth_anim.frag", "resources/shaders/depth_anim.geom")) {
 			GetDefaultLogger()->error("Failed to load animation depth shader");
 		}
+		m_depthSkipLocation     = m_depthShader.GetUniformLocation("skipCascades");
+		m_animationSkipLocation = m_animationDepthShader.GetUniformLocation("skipCascades");
 
 
 		glGenFramebuffers(1, &lightFBO);
@@ -156,89 +185,395 @@ namespace Engine {
 			return;
 		}
 
+		// Single layers of either array, for per-cascade clears and static cache copies.
+		for (GLuint* fbo : {&m_layerReadFBO, &m_layerDrawFBO}) {
+			glGenFramebuffers(1, fbo);
+			glBindFramebuffer(GL_FRAMEBUFFER, *fbo);
+			glDrawBuffer(GL_NONE);
+			glReadBuffer(GL_NONE);
+		}
+
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
 		glGenBuffers(1, &matricesUBO);
 		glBindBuffer(GL_UNIFORM_BUFFER, matricesUBO);
 		glBufferData(GL_UNIFORM_BUFFER, sizeof(glm::mat4x4) * 16, nullptr, GL_STATIC_DRAW);
-		glBindBufferBase(GL_UNIFORM_BUFFER, 0, matricesUBO);
+		glBindBufferBase(GL_UNIFORM_BUFFER, Rendering::kLightSpaceMatricesBinding, matricesUBO);
 		glBindBuffer(GL_UNIFORM_BUFFER, 0);
 	}
 
 
-	void ShadowMapRenderer::RenderShadowMaps()
+	const std::vector<glm::mat4>& ShadowMapRenderer::UpdateLightSpaceMatrices()
+	{
+		ZoneScopedN("Shadow CSM Light Matrices");
+		++m_frame;
+
+		const size_t    count        = GetRenderSettings()->shadowCascadeLevels.size() + 1;
+		const glm::vec3 lightDir     = GetRenderSettings()->lightDir;
+		const float     cosThreshold = std::cos(glm::radians(settings.lightAngleThreshold));
+		m_lightMatrices.resize(count);
+		m_cascades.resize(count);
+		m_cascadeFrusta.resize(count);
+
+		const size_t cascades = CascadeCount();
+		for (size_t i = 0; i < count; ++i) {
+			CascadeState&       c       = m_cascades[i];
+			const CascadePolicy policy  = i < cascades ? settings.cascades[i] : CascadePolicy{};
+			const auto          corners = getSliceCorners(getSlice(i));
+
+			// Offset by the index so staggered cascades with the same interval fall due on different frames.
+			c.due      = policy.mode == CascadeUpdate::Staggered && (m_frame + i) % std::max(policy.interval, 1u) == 0;
+			bool refit = !c.valid || c.due || policy.mode == CascadeUpdate::EveryFrame || glm::dot(lightDir, c.lightDir) < cosThreshold || !covers(m_lightMatrices[i], corners);
+
+			c.refit = false;
+			if (!refit) continue;
+
+			const glm::mat4 matrix = getLightSpaceMatrix(corners, policy.mode == CascadeUpdate::EveryFrame ? 0.0f : settings.coverageMargin);
+			c.lightDir             = lightDir;
+			if (matrix == m_lightMatrices[i] && c.valid) continue;
+
+			// The layer no longer matches its matrix until RenderShadowMaps redraws it.
+			m_lightMatrices[i] = matrix;
+			m_cascadeFrusta[i].SetFromMatrix(matrix);
+			c.refit            = true;
+			c.valid            = false;
+		}
+		return m_lightMatrices;
+	}
+
+	void ShadowMapRenderer::Invalidate()
+	{
+		for (CascadeState& c : m_cascades) {
+			c.valid       = false;
+			c.staticValid = false;
+		}
+	}
+
+	void ShadowMapRenderer::EnsureStaticCache(bool enabled)
+	{
+		if (enabled == (m_staticDepthMaps != 0)) return;
+
+		if (!enabled) {
+			glDeleteFramebuffers(1, &m_staticFBO);
+			glDeleteTextures(1, &m_staticDepthMaps);
+			m_staticFBO = m_staticDepthMaps = 0;
+			return;
+		}
+
+		// Same format as the live array, so layers copy with a plain depth blit.
+		const auto resolution = static_cast<GLsizei>(GetRenderSettings()->depthMapResolution);
+		glGenTextures(1, &m_staticDepthMaps);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, m_staticDepthMaps);
+		glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT32F, resolution, resolution, int(GetRenderSettings()->shadowCascadeLevels.size()) + 1, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+		glGenFramebuffers(1, &m_staticFBO);
+		glBindFramebuffer(GL_FRAMEBUFFER, m_staticFBO);
+		glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, m_staticDepthMaps, 0);
+		glDrawBuffer(GL_NONE);
+		glReadBuffer(GL_NONE);
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+			GetRenderer().log->error("Static shadow cache framebuffer is not complete!");
+		}
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+		for (CascadeState& c : m_cascades) c.staticValid = false;
+	}
+
+	void ShadowMapRenderer::ClearLayers(GLuint texture, uint32_t mask)
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, m_layerDrawFBO);
+		for (int layer = 0; mask >> layer; ++layer) {
+			if (!(mask & (1u << layer))) continue;
+			glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, texture, 0, layer);
+			glClear(GL_DEPTH_BUFFER_BIT);
+		}
+	}
+
+	void ShadowMapRenderer::SetSkipMask(Engine::Shader& shader, GLint location, uint32_t mask)
+	{
+		shader.Bind();
+		shader.SetInt(location, static_cast<int>(~mask));
+	}
+
+	uint32_t ShadowMapRenderer::DrawQueue(uint32_t mask)
+	{
+		SetSkipMask(m_depthShader, m_depthSkipLocation, mask);
+		m_queue.Sort();
+		m_batcher.Build(m_queue);
+		const uint32_t baseInstance = Rendering::GLInstanceBuffer::Upload(m_batcher.GetInstances());
+
+		Rendering::GLRenderCommands       commands(m_depthShader, Rendering::GLRenderCommands::kDepthOnly);
+		const Rendering::RenderQueueStats stats = m_batcher.Submit(commands, baseInstance);
+		commands.End();
+
+		m_queueStats.draws              += stats.draws;
+		m_queueStats.instances          += stats.instances;
+		m_queueStats.pipelineBinds      += stats.pipelineBinds;
+		m_queueStats.materialBinds      += stats.materialBinds;
+		m_queueStats.textureBinds       += stats.textureBinds;
+		m_queueStats.vertexArrayBinds   += stats.vertexArrayBinds;
+		m_queueStats.rasterStateChanges += stats.rasterStateChanges;
+		m_queueStats.uniformUploads     += stats.uniformUploads;
+		return stats.draws;
+	}
+
+	void ShadowMapRenderer::RenderShadowMaps(const Rendering::VisibleSet* cascadeSets, size_t count)
 	{
 		ZoneScopedN("ShadowMapRenderer::RenderShadowMaps");
 
-		std::vector<glm::mat4> lightMatrices;
+		Scene* scene = GetCurrentScene();
+		if (!scene) return;
+		if (m_lightMatrices.empty()) UpdateLightSpaceMatrices();
+
+		auto&               registry  = GetCurrentSceneRegistry();
+		TransformHierarchy& hierarchy = scene->GetTransformHierarchy();
+		const size_t        cascades  = std::min(CascadeCount(), count);
+		const uint64_t      animFrame = GetAnimationManager().GetAnimationFrame();
+		auto&               trees     = GetTerrainManager().GetVegetation();
+
+		EnsureStaticCache(settings.cacheStaticCasters);
+		const bool cacheStatic = m_staticDepthMaps != 0;
+
+		m_queueStats          = {};
+		m_stats.cascadeCount  = static_cast<uint32_t>(cascades);
+		m_stats.updated       = m_stats.skipped = m_stats.staticDraws = 0;
+
+		auto isCaster = [&](entt::entity entity) {
+			return registry.all_of<Engine::Components::ShadowCaster>(entity) && registry.get<Engine::Components::ModelRenderer>(entity).model.IsValid();
+		};
+		auto lastMoved = [&](entt::entity entity) -> uint64_t& {
+			const auto index = static_cast<size_t>(entt::to_entity(entity));
+			if (index >= m_lastMoved.size()) m_lastMoved.resize(index + 1, 0);
+			return m_lastMoved[index];
+		};
+		// 0 = never seen moving.
+		auto isDynamic = [&](entt::entity entity) {
+			const uint64_t moved = lastMoved(entity);
+			return moved != 0 && m_frame - moved < settings.staticSettleFrames;
+		};
+		auto mix = [](uint64_t hash, uint64_t value) {
+			hash ^= value;
+			return hash * 1099511628211ull;
+		};
+
 		{
-			ZoneScopedN("Shadow CSM Light Matrices");
-			lightMatrices = getLightSpaceMatrices();
+			ZoneScopedN("Shadow Skinned Casters");
+			// Shared once-per-frame CPU skin (parallel); free for GBuffer/pick reuse.
+			GetAnimationManager().PrepareSkinnedMeshes();
+
+			m_skinnedCasters.clear();
+			auto viewAnim = registry.view<Engine::Components::EntityMetadata, Components::SkinnedMeshComponent, Components::Transform, Components::ShadowCaster>();
+			for (auto entity : viewAnim) {
+				const auto& skinned = viewAnim.get<Components::SkinnedMeshComponent>(entity);
+				const auto* anim    = registry.try_get<Components::AnimationComponent>(entity);
+				if (!skinned.meshes || skinned.skin_frame_cache.empty() || !anim) continue;
+
+				SkinnedCaster caster;
+				caster.entity    = entity;
+				caster.hasBounds = anim->boundsRadius > 0.0f;
+				caster.bounds    = {anim->boundsCenter - glm::vec3(anim->boundsRadius), anim->boundsCenter + glm::vec3(anim->boundsRadius)};
+				caster.moved     = hierarchy.HasChanged(entity) || hierarchy.IsDirty(entity);
+				caster.evaluated = anim->lastEvaluatedFrame;
+				for (size_t i = 0; i < cascades; ++i) {
+					if (!caster.hasBounds || m_cascadeFrusta[i].Intersects(caster.bounds)) caster.cascades |= 1u << i;
+				}
+				m_skinnedCasters.push_back(caster);
+			}
 		}
 
+		// Which cascades to draw, and for each whether its static casters come from the cache.
+		uint32_t updateMask = 0; // every cascade drawn this frame
+		uint32_t directMask = 0; // all casters drawn straight into the live layer
+		uint32_t staticMask = 0; // static cache layer redrawn, then copied
+		uint32_t cachedMask = 0; // static cache layer copied, dynamic casters drawn on top
 		{
-			ZoneScopedN("Shadow FBO Setup");
-			m_depthShader.Bind();
+			ZoneScopedN("Shadow Cascade Policies");
+			for (size_t i = 0; i < cascades; ++i) {
+				CascadeState&       c      = m_cascades[i];
+				ShadowCascadeStats& stats  = m_stats.cascades[i];
+				const CascadePolicy policy = settings.cascades[i];
+				const uint32_t      bit    = 1u << i;
+
+				uint64_t everything = 14695981039346656037ull;
+				uint64_t statics    = everything;
+				bool     changed    = false;
+				stats.casters = stats.dynamicCasters = stats.draws = 0;
+				for (const entt::entity entity : cascadeSets[i].entities) {
+					if (!isCaster(entity)) continue;
+					if (hierarchy.HasChanged(entity) || hierarchy.IsDirty(entity)) {
+						lastMoved(entity) = m_frame;
+						changed           = true;
+					}
+					++stats.casters;
+					everything = mix(everything, entt::to_integral(entity));
+					if (isDynamic(entity))
+						++stats.dynamicCasters;
+					else
+						statics = mix(statics, entt::to_integral(entity));
+				}
+				for (const SkinnedCaster& caster : m_skinnedCasters) {
+					if (!(caster.cascades & bit)) continue;
+					++stats.casters;
+					++stats.dynamicCasters;
+					everything = mix(everything, entt::to_integral(caster.entity));
+					changed    = changed || caster.moved || caster.evaluated > c.animationFrame;
+				}
+				statics    = mix(statics, trees.GetShadowSignature(i));
+				everything = mix(everything, statics);
+				changed    = changed || everything != c.casterSignature;
+
+				// A staggered cascade redraws when due even if its matrix held, or moving casters would freeze in it.
+				const bool update = !c.valid || policy.mode == CascadeUpdate::EveryFrame || (policy.mode == CascadeUpdate::Staggered && c.due) ||
+				                    (policy.mode == CascadeUpdate::OnChange && changed);
+				stats.updated         = update;
+				stats.staticFromCache = false;
+				if (!update) {
+					++stats.framesSinceUpdate;
+					assert(policy.mode != CascadeUpdate::Staggered || stats.framesSinceUpdate < std::max(policy.interval, 1u));
+					++stats.skipCount;
+					++m_stats.skipped;
+					continue;
+				}
 
+				updateMask |= bit;
+				stats.framesSinceUpdate = 0;
+				++stats.updateCount;
+				++m_stats.updated;
+				c.valid           = true;
+				c.casterSignature = everything;
+				c.animationFrame  = animFrame;
+
+				// A matrix that just changed will likely change again next frame; only a settled one is worth caching.
+				if (!cacheStatic || c.refit) {
+					directMask    |= bit;
+					c.staticValid  = false;
+				}
+				else if (c.staticValid && c.staticSignature == statics && c.staticMatrix == m_lightMatrices[i]) {
+					cachedMask            |= bit;
+					stats.staticFromCache  = true;
+				}
+				else {
+					staticMask        |= bit;
+					c.staticValid      = true;
+					c.staticSignature  = statics;
+					c.staticMatrix     = m_lightMatrices[i];
+				}
+			}
+		}
+		if (updateMask == 0) return;
+
+		// Queue the casters of the cascades in `mask` that pass `keep`, each entity once.
+		auto queueCasters = [&](uint32_t mask, auto&& keep) {
+			m_queue.Clear();
+			if (++m_listGeneration == 0) {
+				std::fill(m_listStamp.begin(), m_listStamp.end(), 0);
+				m_listGeneration = 1;
+			}
+			for (size_t i = 0; i < cascades; ++i) {
+				if (!(mask & (1u << i))) continue;
+				for (const entt::entity entity : cascadeSets[i].entities) {
+					const auto index = static_cast<size_t>(entt::to_entity(entity));
+					if (index >= m_listStamp.size()) m_listStamp.resize(index + 1, 0);
+					if (m_listStamp[index] == m_listGeneration || !isCaster(entity) || !keep(entity)) continue;
+					m_listStamp[index] = m_listGeneration;
+
+					const auto* model = GetAssetManager().Get(registry.get<Engine::Components::ModelRenderer>(entity).model);
+					if (!model) continue;
+					model->EnqueueDepth(m_queue, m_queue.AddTransform(registry.get<Engine::Components::Transform>(entity).GetWorldMatrix()), entity);
+				}
+			}
+		};
+		auto countDraws = [&](uint32_t mask, uint32_t draws) {
+			for (size_t i = 0; i < cascades; ++i) {
+				if (mask & (1u << i)) m_stats.cascades[i].draws += draws;
+			}
+		};
+		// Terrain trees, already culled against the cascades by TerrainManager::PrepareFrame.
+		auto drawTrees = [&](uint32_t mask) {
+			const uint32_t before = trees.GetStats().draws;
+			trees.RenderShadows(m_depthShader);
+			countDraws(mask, trees.GetStats().draws - before);
+			return trees.GetStats().draws - before;
+		};
+		auto isStatic = [&](entt::entity entity) { return !isDynamic(entity); };
+		auto dynamicOnly = [&](entt::entity entity) { return isDynamic(entity); };
+		auto any = [](entt::entity) { return true; };
+
+		const auto resolution = static_cast<GLint>(GetRenderSettings()->depthMapResolution);
+		{
+			ZoneScopedN("Shadow FBO Setup");
 			glBindBuffer(GL_UNIFORM_BUFFER, matricesUBO);
-			for (size_t i = 0; i < lightMatrices.size(); ++i) {
-				glBufferSubData(GL_UNIFORM_BUFFER, static_cast<GLintptr>(i * sizeof(glm::mat4x4)), sizeof(glm::mat4x4), glm::value_ptr(lightMatrices[i]));
+			for (size_t i = 0; i < m_lightMatrices.size(); ++i) {
+				glBufferSubData(GL_UNIFORM_BUFFER, static_cast<GLintptr>(i * sizeof(glm::mat4x4)), sizeof(glm::mat4x4), glm::value_ptr(m_lightMatrices[i]));
 			}
 			glBindBuffer(GL_UNIFORM_BUFFER, 0);
+			glViewport(0, 0, resolution, resolution);
+		}
 
-			glBindFramebuffer(GL_FRAMEBUFFER, lightFBO);
-			glViewport(0, 0, GetRenderSettings()->depthMapResolution, GetRenderSettings()->depthMapResolution);
-			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		if (staticMask) {
+			ZoneScopedN("Shadow Static Cache");
+			ClearLayers(m_staticDepthMaps, staticMask);
+			glBindFramebuffer(GL_FRAMEBUFFER, m_staticFBO);
+			queueCasters(staticMask, isStatic);
+			const uint32_t draws = DrawQueue(staticMask);
+			countDraws(staticMask, draws);
+			m_stats.staticDraws = draws + drawTrees(staticMask);
 		}
 
 		{
 			ZoneScopedN("Shadow Static Models");
-			auto view = GetCurrentSceneRegistry().view<Engine::Components::EntityMetadata, Engine::Components::Transform, Engine::Components::ModelRenderer, Engine::Components::ShadowCaster>();
-
-			for (auto [entity, metadata, transform, renderer, shadowCaster] : view.each()) {
-				if (!renderer.model.IsValid()) continue;
-
-				auto* model = GetAssetManager().Get(renderer.model);
-				if (!model) continue;
+			if (staticMask | cachedMask) {
+				// Static layers under the dynamic casters.
+				glBindFramebuffer(GL_READ_FRAMEBUFFER, m_layerReadFBO);
+				glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_layerDrawFBO);
+				for (size_t i = 0; i < cascades; ++i) {
+					if (!((staticMask | cachedMask) & (1u << i))) continue;
+					glFramebufferTextureLayer(GL_READ_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, m_staticDepthMaps, 0, static_cast<GLint>(i));
+					glFramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, lightDepthMaps, 0, static_cast<GLint>(i));
+					glBlitFramebuffer(0, 0, resolution, resolution, 0, 0, resolution, resolution, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+				}
+			}
+			if (directMask) ClearLayers(lightDepthMaps, directMask);
+			glBindFramebuffer(GL_FRAMEBUFFER, lightFBO);
 
-				glm::mat4 modelMatrix = CalculateModelMatrix(transform);
-				m_depthShader.SetMat4("model", &modelMatrix);
-				model->Draw(m_depthShader, true, true);
+			if (directMask == updateMask) {
+				// Nothing cached: one pass for every caster.
+				queueCasters(updateMask, any);
+				countDraws(updateMask, DrawQueue(updateMask));
+				drawTrees(updateMask);
+			}
+			else {
+				if (directMask) {
+					queueCasters(directMask, isStatic);
+					countDraws(directMask, DrawQueue(directMask));
+					drawTrees(directMask);
+				}
+				queueCasters(updateMask, dynamicOnly);
+				countDraws(updateMask, DrawQueue(updateMask));
 			}
 		}
 
 		{
 			ZoneScopedN("Shadow Skinned Meshes");
-			// Shared once-per-frame CPU skin (parallel); free for GBuffer/pick reuse.
-			GetAnimationManager().PrepareSkinnedMeshes();
-
-			m_animationDepthShader.Bind();
-
-			glBindBuffer(GL_UNIFORM_BUFFER, matricesUBO);
-			for (size_t i = 0; i < lightMatrices.size(); ++i) {
-				glBufferSubData(GL_UNIFORM_BUFFER, static_cast<GLintptr>(i * sizeof(glm::mat4x4)), sizeof(glm::mat4x4), glm::value_ptr(lightMatrices[i]));
-			}
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
+			const int skip = static_cast<int>(~updateMask);
+			SetSkipMask(m_animationDepthShader, m_animationSkipLocation, updateMask);
 
-			auto viewAnim = GetCurrentSceneRegistry().view<Engine::Components::EntityMetadata, Components::SkinnedMeshComponent, Components::Transform, Components::ShadowCaster>();
-			for (auto entity : viewAnim) {
+			for (const SkinnedCaster& caster : m_skinnedCasters) {
+				if (!(caster.cascades & updateMask)) continue;
 				ZoneScopedN("Shadow Skinned Entity");
-				Entity e(entity, GetCurrentScene());
-				auto&  skinned = e.GetComponent<Components::SkinnedMeshComponent>();
-				if (!skinned.meshes || skinned.skin_frame_cache.empty()) {
-					continue;
-				}
-				if (!e.HasComponent<Components::AnimationComponent>()) {
-					continue;
-				}
+				auto& skinned = registry.get<Components::SkinnedMeshComponent>(caster.entity);
 
-				const ozz::math::Float4x4 model = FromMatrix(e.GetComponent<Components::Transform>().GetWorldMatrix());
+				const ozz::math::Float4x4 model = FromMatrix(registry.get<Components::Transform>(caster.entity).GetWorldMatrix());
 
+				const auto& caches = GetAnimationManager().GetSkinFrameCaches(skinned);
 				for (size_t mi = 0; mi < skinned.meshes->size(); ++mi) {
 					const auto& mesh  = (*skinned.meshes)[mi];
-					const auto& cache = skinned.skin_frame_cache[mi];
+					const auto& cache = caches[mi];
 					if (!cache.valid) continue;
-					GetAnimationManager().renderer_->DrawSkinnedMeshShadowsCached(&m_animationDepthShader, cache, mesh, model);
+					if (GetAnimationManager().renderer_->DrawSkinnedMeshShadowsCached(&m_animationDepthShader, cache, mesh, model, skip)) countDraws(caster.cascades & updateMask, 1);
 				}
 			}
 		}
@@ -253,24 +588,17 @@ namespace Engine {
 	{
 		shader.Bind();
 		ENGINE_GLCheckError();
-		shader.SetInt("cascadeCount", static_cast<int>(GetRenderSettings()->shadowCascadeLevels.size()));
-		shader.SetInt("shadowMap", textureSlot);
-
-		for (size_t i = 0; i < GetRenderSettings()->shadowCascadeLevels.size(); ++i) {
-			shader.SetFloat("cascadePlaneDistances[" + std::to_string(i) + "]", GetRenderSettings()->shadowCascadeLevels[i]);
-		}
-		ENGINE_GLCheckError();
-		shader.SetVec3("lightDir", GetRenderSettings()->lightDir);
-		ENGINE_GLCheckError();
-		shader.SetFloat("farPlane", GetRenderSettings()->CAMERA_FAR_PLANE);
-		ENGINE_GLCheckError();
-		shader.SetVec2("texScale", glm::vec2(1.0, 1.0));
-		ENGINE_GLCheckError();
-		shader.SetVec3("viewPos", GetCamera().GetPosition());
-		ENGINE_GLCheckError();
-		shader.SetMat4("view", &V);
-		glm::mat4 proj = GetCamera().GetProjectionMatrix();
-		shader.SetMat4("projection", &proj);
+		// Shaders reading FrameData declare none of these; the lookups then miss without touching GL.
+		const std::vector<float>& cascades = GetRenderSettings()->shadowCascadeLevels;
+		shader.SetInt(shader.GetUniformLocation("cascadeCount"), static_cast<int>(cascades.size()));
+		shader.SetInt(shader.GetUniformLocation("shadowMap"), textureSlot);
+		shader.SetFloatArray(shader.GetUniformLocation("cascadePlaneDistances"), cascades.data(), static_cast<int>(cascades.size()));
+		shader.SetVec3(shader.GetUniformLocation("lightDir"), GetRenderSettings()->lightDir);
+		shader.SetFloat(shader.GetUniformLocation("farPlane"), GetRenderSettings()->CAMERA_FAR_PLANE);
+		shader.SetVec2(shader.GetUniformLocation("texScale"), glm::vec2(1.0, 1.0));
+		shader.SetVec3(shader.GetUniformLocation("viewPos"), GetCamera().GetPosition());
+		shader.SetMat4(shader.GetUniformLocation("view"), V);
+		shader.SetMat4(shader.GetUniformLocation("projection"), GetCamera().GetProjectionMatrix());
 		ENGINE_GLCheckError();
 		glActiveTexture(GL_TEXTURE0 + textureSlot);
 		glBindTexture(GL_TEXTURE_2D_ARRAY, lightDepthMaps);
@@ -7,34 +7,165 @@
 
 
 #include "glm/ext/matrix_clip_space.hpp"
+#include "entt/entt.hpp"
 #include "core/Window.h"
 #include "Camera.h"
 #include "rendering/Shader.h"
+#include "rendering/culling/CullingWorld.h"
+#include "rendering/queue/InstanceBatcher.h"
 
 
 
 
 namespace Engine {
+
+	constexpr size_t kMaxShadowCascades = 16; // LightSpaceMatrices block size
+
+	enum class CascadeUpdate : uint8_t {
+		EveryFrame,
+		Staggered, // every `interval` frames, cascades with the same interval on different frames
+		OnChange,  // only when its casters change or the camera / light move beyond the thresholds
+	};
+
+	struct CascadePolicy {
+		CascadeUpdate mode     = CascadeUpdate::EveryFrame;
+		uint32_t      interval = 1; // Staggered only
+	};
+
+	struct ShadowCacheSettings {
+		/// Per cascade, nearest first. Far cascades barely change from frame to frame.
+		CascadePolicy cascades[kMaxShadowCascades] = {
+		    {CascadeUpdate::EveryFrame, 1}, {CascadeUpdate::EveryFrame, 1}, {CascadeUpdate::Staggered, 2}, {CascadeUpdate::Staggered, 4}, {CascadeUpdate::OnChange, 1},
+		};
+		/// Cascades that are not redrawn every frame are fit this much wider (fraction of their width per side),
+		/// so the camera can move a little before their slice leaves the map and forces an update.
+		float    coverageMargin      = 0.1f;
+		float    lightAngleThreshold = 0.25f; // degrees the light may turn before every held cascade updates
+		/// Keep a second depth array with only the static casters, so an update draws just the dynamic ones
+		/// while the cascade's matrix stays the same. Doubles the shadow map memory.
+		bool     cacheStaticCasters  = true;
+		uint32_t staticSettleFrames  = 60; // a caster that has not moved for this many frames counts as static
+	};
+
+	struct ShadowCascadeStats {
+		bool     updated           = false; // rendered this frame
+		bool     staticFromCache   = false; // its static casters were copied, not drawn
+		uint32_t casters           = 0;     // culled caster list, skinned included
+		uint32_t dynamicCasters    = 0;
+		uint32_t draws             = 0;     // this frame, static + dynamic + skinned + trees
+		uint32_t framesSinceUpdate = 0;
+		uint64_t updateCount       = 0;
+		uint64_t skipCount         = 0;
+	};
+
+	struct ShadowStats {
+		ShadowCascadeStats cascades[kMaxShadowCascades];
+		uint32_t           cascadeCount = 0;
+		uint32_t           updated      = 0; // cascades rendered this frame
+		uint32_t           skipped      = 0;
+		uint32_t           staticDraws  = 0; // into the static cache
+	};
+
+	/// Cascaded shadow maps, updated incrementally.
+	///
+	/// Each cascade has a CascadePolicy. A cascade that is not due keeps its light matrix and its depth
+	/// layer; the depth geometry shaders skip its layer through `skipCascades`, so the casters shared by
+	/// several cascades are still drawn once. Casters that have not moved for a while are also drawn into
+	/// a separate static depth array; while a cascade's matrix and static casters stay the same, an update
+	/// copies that layer and draws only the dynamic casters on top. Every draw is depth-only: opaque
+	/// materials are dropped so their meshes batch, alpha-tested ones bind just the diffuse texture.
 	class ShadowMapRenderer {
 	  public:
 		void Initialize();
-		void RenderShadowMaps();
+		/// Refit the cascades that are due for this frame's camera; the others keep their matrix.
+		/// Call before culling / RenderShadowMaps.
+		const std::vector<glm::mat4>& UpdateLightSpaceMatrices();
+		[[nodiscard]] const std::vector<glm::mat4>& GetLightSpaceMatrices() const { return m_lightMatrices; }
+		/// Redraw the cascades that need it. `cascadeSets[i]` are the casters culled against cascade i.
+		void RenderShadowMaps(const Rendering::VisibleSet* cascadeSets, size_t count);
 		void UploadShadowMatrices(Engine::Shader& shader, glm::mat4& V, int textureSlot = 1);
+		[[nodiscard]] const Rendering::RenderQueueStats& GetQueueStats() const { return m_queueStats; }
+		[[nodiscard]] const ShadowStats&                 GetStats() const { return m_stats; }
+		/// Redraw every cascade (and the static cache) next frame.
+		void Invalidate();
+
+		ShadowCacheSettings settings;
 
 	  private:
+		struct CascadeState {
+			bool      valid = false;     // the layer holds a rendering made with `lightMatrix`
+			bool      refit = false;     // UpdateLightSpaceMatrices gave it a new matrix this frame
+			bool      due   = false;     // a staggered cascade's interval came round this frame
+			glm::vec3 lightDir{0.0f};    // at the last refit
+			uint64_t  casterSignature = 0; // every caster, at the last update
+			uint64_t  animationFrame  = 0; // AnimationManager::GetAnimationFrame at the last update
+
+			bool      staticValid = false; // the static layer holds `staticSignature` drawn with `staticMatrix`
+			glm::mat4 staticMatrix{1.0f};
+			uint64_t  staticSignature = 0;
+		};
+
+		struct SkinnedCaster {
+			entt::entity    entity = entt::null;
+			Rendering::AABB bounds;
+			bool            hasBounds = false; // unknown bounds are in every cascade
+			bool            moved     = false;
+			uint64_t        evaluated = 0;     // AnimationComponent::lastEvaluatedFrame
+			uint32_t        cascades  = 0;     // mask of the cascades it is in
+		};
+
+		/// The camera slice of a cascade.
+		struct Slice {
+			float nearPlane;
+			float farPlane;
+		};
 
 		std::vector<glm::vec4> getFrustumCornersWorldSpace(const glm::mat4& projview);
 		std::vector<glm::vec4> getFrustumCornersWorldSpace(const glm::mat4& proj, const glm::mat4& view);
-		glm::mat4              getLightSpaceMatrix(float nearPlane, float farPlane);
-		std::vector<glm::mat4> getLightSpaceMatrices();
+		glm::mat4              getLightSpaceMatrix(const std::vector<glm::vec4>& corners, float margin);
+		std::vector<glm::vec4> getSliceCorners(const Slice& slice);
+		[[nodiscard]] Slice    getSlice(size_t cascade) const;
+		/// True if every corner is inside the map `lightMatrix` renders.
+		static bool            covers(const glm::mat4& lightMatrix, const std::vector<glm::vec4>& corners);
 
+		[[nodiscard]] size_t CascadeCount() const;
+		void                 EnsureStaticCache(bool enabled);
+		/// Clear the depth of each layer of `texture` in `mask`.
+		void                 ClearLayers(GLuint texture, uint32_t mask);
+		/// Upload and draw m_queue with the depth shader into the layers in `mask`; returns the draws issued.
+		uint32_t             DrawQueue(uint32_t mask);
+		void                 SetSkipMask(Engine::Shader& shader, GLint location, uint32_t mask);
 
 		static unsigned int lightFBO;
 		static unsigned int matricesUBO;
 		static unsigned int lightDepthMaps;
 
+		std::vector<glm::mat4> m_lightMatrices;
+
+		Rendering::RenderQueue      m_queue;
+		Rendering::InstanceBatcher  m_batcher;
+		Rendering::RenderQueueStats m_queueStats;
+
 		Engine::Shader m_depthShader;
 		Engine::Shader m_animationDepthShader;
+		GLint          m_depthSkipLocation     = -1;
+		GLint          m_animationSkipLocation = -1;
+
+		// Static casters only, one layer per cascade; see ShadowCacheSettings::cacheStaticCasters.
+		GLuint m_staticFBO       = 0;
+		GLuint m_staticDepthMaps = 0;
+		// Single-layer attachments for clears and static -> live copies.
+		GLuint m_layerReadFBO = 0;
+		GLuint m_layerDrawFBO = 0;
+
+		std::vector<CascadeState>  m_cascades;
+		std::vector<Rendering::Frustum> m_cascadeFrusta; // of m_lightMatrices
+		uint64_t                   m_frame = 0;
+		std::vector<SkinnedCaster> m_skinnedCasters;
+		std::vector<uint64_t>      m_lastMoved; // entt::to_entity -> m_frame a caster last moved on
+		std::vector<uint64_t>      m_listStamp; // entt::to_entity -> last pass it was queued in
+		uint64_t                   m_listGeneration = 0;
+		ShadowStats                m_stats;
 	};
 
 } // namespace Engine
\ No newline at end of file
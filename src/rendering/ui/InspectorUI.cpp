@@ -164,6 +164,15 @@ namespace Engine {
 		return changed;
 	}
 
+	bool LeftLabelSliderInt(const char* label, int* v, int v_min, int v_max, float labelWidth)
+	{
+		BeginLeftLabelRow(label, labelWidth);
+		ImGui::SetNextItemWidth(-1);
+		bool changed = ImGui::SliderInt("##v", v, v_min, v_max);
+		EndLeftLabelRow();
+		return changed;
+	}
+
 	bool LeftLabelDragFloat(const char* label, float* v, float speed, float labelWidth)
 	{
 		BeginLeftLabelRow(label, labelWidth);
@@ -294,18 +303,17 @@ namespace Engine {
 			ImGui::InputTextWithHint("##af", "Filter...", filter, IM_ARRAYSIZE(filter));                                                                                                                                                       \
 			auto& storage = GetAssetManager().GetStorage<atype>();                                                                                                                                                                             \
 			ImGui::BeginChild("##alist", ImVec2(280, 220), true);                                                                                                                                                                              \
-			for (const auto& [guid, asset] : storage.guidToAsset) {                                                                                                                                                                            \
-				if (!asset) continue;                                                                                                                                                                                                          \
-				AssetHandle<atype> h(guid);                                                                                                                                                                                                    \
-				atype*             assetPtr = asset.get();                                                                                                                                                                                     \
-				std::string        shown    = nameA;                                                                                                                                                                                           \
-				if (filter[0] && shown.find(filter) == std::string::npos) continue;                                                                                                                                                            \
-				if (ImGui::Selectable(shown.c_str())) {                                                                                                                                                                                        \
-					*assetRef = h;                                                                                                                                                                                                             \
-					used      = true;                                                                                                                                                                                                          \
-					ImGui::CloseCurrentPopup();                                                                                                                                                                                                \
-				}                                                                                                                                                                                                                              \
-			}                                                                                                                                                                                                                                  \
+			storage.ForEach([&](const std::string& guid, atype& asset) {                                                                                                                                                                       \
+				AssetHandle<atype> h(guid);                                                                                                                                                                                                       \
+				atype*             assetPtr = &asset;                                                                                                                                                                                             \
+				std::string        shown    = nameA;                                                                                                                                                                                              \
+				if (filter[0] && shown.find(filter) == std::string::npos) return;                                                                                                                                                                 \
+				if (ImGui::Selectable(shown.c_str())) {                                                                                                                                                                                           \
+					*assetRef = h;                                                                                                                                                                                                                   \
+					used      = true;                                                                                                                                                                                                                \
+					ImGui::CloseCurrentPopup();                                                                                                                                                                                                      \
+				}                                                                                                                                                                                                                                 \
+			});                                                                                                                                                                                                                                \
 			ImGui::EndChild();                                                                                                                                                                                                                 \
 			ImGui::EndPopup();                                                                                                                                                                                                                 \
 		}                                                                                                                                                                                                                                      \
@@ -40,6 +40,7 @@ namespace Engine {
 	bool LeftLabelInputText(const char* label, std::string* str, float labelWidth = 0.0f, ImGuiInputTextFlags flags = 0);
 
 	bool LeftLabelSliderFloat(const char* label, float* v, float v_min, float v_max, const char* format = "%.3f", ImGuiSliderFlags flags = 0, float labelWidth = 0.0f);
+	bool LeftLabelSliderInt(const char* label, int* v, int v_min, int v_max, float labelWidth = 0.0f);
 	bool LeftLabelDragFloat(const char* label, float* v, float speed = 0.1f, float labelWidth = 0.0f);
 	bool LeftLabelDragFloat2(const char* label, float v[2], float speed = 0.1f, float labelWidth = 0.0f);
 	bool LeftLabelDragFloat3(const char* label, float v[3], float speed = 0.1f, float labelWidth = 0.0f);
@@ -6,6 +6,11 @@
 #include "core/EngineData.h"
 
 #include "rendering/Renderer.h"
+#include "rendering/queue/RenderQueueBenchmark.h"
+#include "assets/AssetBenchmark.h"
+#include "animation/SkinningBenchmark.h"
+#include "assets/SceneLoadBenchmark.h"
+#include "animation/SkinningKernel.h"
 #include "rendering/ui/GameUIManager.h"
 
 #include "rendering/ui/IconsFontAwesome6.h"
@@ -20,6 +25,9 @@
 #include "assets/impl/JSONSceneLoader.h"
 
 #include "physics/PhysicsManager.h"
+#include "animation/AnimationManager.h"
+#include "terrain/TerrainManager.h"
+#include "terrain/TerrainBuildCache.h"
 
 #include "core/Input.h"
 #include "core/SceneManager.h"
@@ -1022,6 +1030,196 @@ namespace Engine::UI {
             ImGui::Unindent();
         }
 
+        if(ImGui::CollapsingHeader("Shadows")) {
+            ImGui::Indent();
+
+            auto&              shadows      = *GetRenderer().GetShadowRenderer();
+            const ShadowStats& shadowStats  = shadows.GetStats();
+            static const char* kUpdateModes = "Every frame\0Staggered\0On change\0";
+            ImGui::Text("%u cascades updated, %u skipped, %u static cache draws", shadowStats.updated, shadowStats.skipped, shadowStats.staticDraws);
+            for (uint32_t i = 0; i < shadowStats.cascadeCount; ++i) {
+                const ShadowCascadeStats& cascade = shadowStats.cascades[i];
+                CascadePolicy&            policy  = shadows.settings.cascades[i];
+                ImGui::PushID(static_cast<int>(i));
+                int mode = static_cast<int>(policy.mode);
+                ImGui::SetNextItemWidth(110.0f);
+                if (ImGui::Combo("##mode", &mode, kUpdateModes)) {
+                    policy.mode = static_cast<CascadeUpdate>(mode);
+                    shadows.Invalidate();
+                }
+                if (policy.mode == CascadeUpdate::Staggered) {
+                    ImGui::SameLine();
+                    int interval = static_cast<int>(policy.interval);
+                    ImGui::SetNextItemWidth(80.0f);
+                    if (ImGui::InputInt("##interval", &interval)) {
+                        policy.interval = static_cast<uint32_t>(std::max(interval, 1));
+                        shadows.Invalidate();
+                    }
+                }
+                ImGui::SameLine();
+                ImGui::Text("Cascade %u: %s%s  casters %u (%u dynamic)  draws %u  idle %u frames  (%llu updates, %llu skips)", i, cascade.updated ? "updated" : "skipped",
+                            cascade.staticFromCache ? ", static cached" : "", cascade.casters, cascade.dynamicCasters, cascade.draws, cascade.framesSinceUpdate,
+                            static_cast<unsigned long long>(cascade.updateCount), static_cast<unsigned long long>(cascade.skipCount));
+                ImGui::PopID();
+            }
+            ImGui::SliderFloat("Held cascade margin", &shadows.settings.coverageMargin, 0.0f, 0.5f);
+            ImGui::SliderFloat("Light angle threshold (deg)", &shadows.settings.lightAngleThreshold, 0.0f, 5.0f);
+            ImGui::Checkbox("Cache static casters", &shadows.settings.cacheStaticCasters);
+            int settle = static_cast<int>(shadows.settings.staticSettleFrames);
+            if (ImGui::InputInt("Static after still frames", &settle)) shadows.settings.staticSettleFrames = static_cast<uint32_t>(std::max(settle, 1));
+            if (ImGui::Button("Redraw all cascades")) shadows.Invalidate();
+
+            ImGui::Unindent();
+        }
+
+        if(ImGui::CollapsingHeader("Render Queue")) {
+            ImGui::Indent();
+
+            auto queueStatsRow = [](const char* label, const Rendering::RenderQueueStats& stats) {
+                ImGui::Text("%-9s draws %6u  instances %6u  state changes %6u  (tex %u, mat %u, vao %u)  uniforms %7u", label, stats.draws, stats.instances,
+                            stats.StateChanges(), stats.textureBinds, stats.materialBinds, stats.vertexArrayBinds, stats.uniformUploads);
+            };
+            queueStatsRow("GBuffer", GetRenderer().GetGBufferQueueStats());
+            queueStatsRow("Shadow", GetRenderer().GetShadowRenderer()->GetQueueStats());
+            ImGui::Text("GL uniform calls last frame: %u", GetRenderer().GetUniformCallsLastFrame());
+            ImGui::Text("Skinned meshes: %d GPU, %d CPU", GetAnimationManager().GetGpuSkinnedMeshCount(), GetAnimationManager().GetCpuSkinnedMeshCount());
+            ImGui::Text("Characters: %d skinned, %d culled, %d poses not sampled", GetAnimationManager().GetSkinnedEntityCount(), GetAnimationManager().GetCulledEntityCount(),
+                        GetAnimationManager().GetSkippedPoseCount());
+            ImGui::Checkbox("Cull off-screen skinning", &GetAnimationManager().GetCullOffscreen());
+            ImGui::Checkbox("Skip off-screen pose sampling", &GetAnimationManager().GetSkipOffscreenSampling());
+            const int* lodCounts = GetAnimationManager().GetLodLevelCounts();
+            ImGui::Text("Animation LOD: %d / %d / %d / %d, %d poses evaluated, %d deferred, %d skins reused", lodCounts[0], lodCounts[1], lodCounts[2], lodCounts[3],
+                        GetAnimationManager().GetEvaluatedPoseCount(), GetAnimationManager().GetDeferredPoseCount(), GetAnimationManager().GetReusedSkinCount());
+            ImGui::InputInt("Animation joint budget (0 = off)", &GetAnimationManager().GetLodJointBudget(), 64, 1024);
+            ImGui::Text("Shared poses: %d groups, %d members, %d skins shared", GetAnimationManager().GetSharedPoseGroupCount(),
+                        GetAnimationManager().GetSharedPoseMemberCount(), GetAnimationManager().GetSharedSkinCount());
+            ImGui::Checkbox("Share poses of every character", &GetAnimationManager().GetAutoPoseSharing());
+            if (ImGui::InputInt("Pose share phases per clip", &GetAnimationManager().GetPoseSharePhases(), 1, 8)) {
+                GetAnimationManager().SetPoseSharePhases(GetAnimationManager().GetPoseSharePhasesValue());
+            }
+
+            const Terrain::TerrainLodStats& terrainStats = GetTerrainManager().GetLodStats();
+            ImGui::Text("Terrain: %u / %u chunks drawn, %u culled, %u triangles, LOD %u / %u / %u / %u / %u", terrainStats.drawn, terrainStats.chunks, terrainStats.culled,
+                        terrainStats.triangles, terrainStats.levelCounts[0], terrainStats.levelCounts[1], terrainStats.levelCounts[2], terrainStats.levelCounts[3],
+                        terrainStats.levelCounts[4]);
+            ImGui::SliderFloat("Terrain LOD pixel error (0 = off)", &GetTerrainManager().GetLodPixelError(), 0.0f, 16.0f);
+            ImGui::Checkbox("Cull terrain chunks", &GetTerrainManager().GetCullChunks());
+
+            Terrain::VegetationSystem&       vegetation      = GetTerrainManager().GetVegetation();
+            const Terrain::VegetationStats&  vegetationStats = vegetation.GetStats();
+            ImGui::Text("Vegetation: %u trees in %u tiles / %u cells (%u culled), drawn %u / %u / %u (full / LOD / impostor), %u shadow, %u draws, %u colliders",
+                        vegetationStats.instances, vegetationStats.tiles, vegetationStats.cells, vegetationStats.cellsCulled, vegetationStats.drawn[Terrain::kBandFull],
+                        vegetationStats.drawn[Terrain::kBandLod], vegetationStats.drawn[Terrain::kBandImpostor], vegetationStats.shadowInstances, vegetationStats.draws,
+                        vegetationStats.colliders);
+            ImGui::Checkbox("Draw vegetation", &vegetation.settings.enabled);
+            ImGui::SliderFloat("Vegetation distance scale", &vegetation.settings.distanceScale, 0.1f, 4.0f);
+            ImGui::Checkbox("Vegetation shadows", &vegetation.settings.shadows);
+            ImGui::SliderFloat("Vegetation shadow distance", &vegetation.settings.shadowDistance, 0.0f, 500.0f);
+            ImGui::SliderFloat("Tree collider radius", &vegetation.settings.colliderRadius, 0.0f, 100.0f);
+
+            static bool hasBenchmark = false;
+            static Rendering::RenderQueueBenchmarkResult benchmark;
+            if (ImGui::Button("Run 10k entity benchmark")) {
+                benchmark    = Rendering::RunRenderQueueBenchmark(10000);
+                hasBenchmark = true;
+            }
+            if (hasBenchmark) {
+                queueStatsRow("Unsorted", benchmark.naive);
+                queueStatsRow("Sorted", benchmark.sorted);
+                queueStatsRow("Instanced", benchmark.instanced);
+                ImGui::Text("build %.2f ms, sort %.2f ms, submit %.2f / %.2f ms, batch + submit %.2f ms", benchmark.buildMs, benchmark.sortMs, benchmark.submitNaiveMs,
+                            benchmark.submitSortedMs, benchmark.batchMs);
+            }
+
+            ImGui::Unindent();
+        }
+
+        if(ImGui::CollapsingHeader("Asset Streaming")) {
+            ImGui::Indent();
+
+            auto stats = GetAssetManager().GetAsyncLoadStats();
+            ImGui::Text("Pending %u, loaded %u, failed %u", stats.pending, stats.completed, stats.failed);
+            ImGui::Text("Uploads this frame %u (%.2f ms)", stats.uploadsLastRun, stats.uploadMsLastRun);
+            float budget = static_cast<float>(GetAssetManager().uploadBudgetMs);
+            if (ImGui::SliderFloat("Upload budget (ms)", &budget, 0.5f, 16.0f)) GetAssetManager().uploadBudgetMs = budget;
+
+            auto& streamer      = GetTerrainManager().GetStreamer();
+            auto  terrainStats  = streamer.GetStats();
+            ImGui::Text("Terrain tiles: %u resident, %u pending, %u failed of %u (%u loaded, %u evicted)", terrainStats.resident, terrainStats.pending,
+                        terrainStats.failed, terrainStats.tiles, terrainStats.loadedTotal, terrainStats.evictedTotal);
+            ImGui::Text("Terrain memory: %.1f MB resident, %.1f MB pending", terrainStats.residentBytes / (1024.0 * 1024.0), terrainStats.pendingBytes / (1024.0 * 1024.0));
+            ImGui::SliderFloat("Terrain load radius", &streamer.settings.loadRadius, 50.0f, 5000.0f);
+            ImGui::SliderFloat("Terrain unload radius", &streamer.settings.unloadRadius, streamer.settings.loadRadius, 6000.0f);
+            int budgetMb = static_cast<int>(streamer.settings.memoryBudget >> 20);
+            if (ImGui::InputInt("Terrain memory budget (MB)", &budgetMb, 16, 128)) streamer.settings.memoryBudget = static_cast<size_t>(std::max(budgetMb, 1)) << 20;
+            auto& terrainBuild = Terrain::GetTerrainBuildOptions();
+            ImGui::Checkbox("Cache terrain builds", &terrainBuild.useCache);
+            ImGui::Checkbox("Dump terrain splat images", &terrainBuild.dumpSplatImages);
+
+            ImGui::Unindent();
+        }
+
+        if(ImGui::CollapsingHeader("Asset Lookup")) {
+            ImGui::Indent();
+
+            static bool hasBenchmark = false;
+            static AssetLookupBenchmarkResult benchmark;
+            if (ImGui::Button("Run Get() benchmark")) {
+                benchmark    = RunAssetLookupBenchmark();
+                hasBenchmark = true;
+            }
+            if (hasBenchmark) {
+                ImGui::Text("%u assets, %u lookups", benchmark.assets, benchmark.lookups);
+                ImGui::Text("GUID map (old)   %7.1f ns / Get", benchmark.legacyNs);
+                ImGui::Text("Slot, uncached   %7.1f ns / Get", benchmark.uncachedNs);
+                ImGui::Text("Slot, cached     %7.1f ns / Get", benchmark.cachedNs);
+            }
+
+            ImGui::Unindent();
+        }
+
+        if(ImGui::CollapsingHeader("Scene Load")) {
+            ImGui::Indent();
+
+            static bool hasBenchmark = false;
+            static SceneLoadBenchmarkResult benchmark;
+            if (ImGui::Button("Run scene1 load benchmark")) {
+                benchmark    = RunSceneLoadBenchmark();
+                hasBenchmark = true;
+            }
+            if (hasBenchmark && !benchmark.ok) ImGui::TextUnformatted("Could not read scenes/scene1.json");
+            if (hasBenchmark && benchmark.ok) {
+                ImGui::Text("%u entities, %u iterations", benchmark.entities, benchmark.iterations);
+                ImGui::Text("JSON    %8.2f ms  %7.1f KB", benchmark.jsonMs, benchmark.jsonBytes / 1024.0);
+                ImGui::Text("Binary  %8.2f ms  %7.1f KB", benchmark.binaryMs, benchmark.binaryBytes / 1024.0);
+                ImGui::Text("Packed  %8.2f ms  %7.1f KB", benchmark.packedMs, benchmark.packedBytes / 1024.0);
+            }
+
+            ImGui::Unindent();
+        }
+
+        if(ImGui::CollapsingHeader("Skinning")) {
+            ImGui::Indent();
+
+            ImGui::Text("CPU kernel: %s", SkinningKernelLevelName(DetectSkinningKernelLevel()));
+            static bool hasBenchmark = false;
+            static SkinningBenchmarkResult benchmark;
+            if (ImGui::Button("Run skinning benchmark")) {
+                benchmark    = RunSkinningBenchmark();
+                hasBenchmark = true;
+            }
+            if (hasBenchmark) {
+                ImGui::Text("%u vertices, %u joints, %u iterations", benchmark.vertices, benchmark.joints, benchmark.iterations);
+                ImGui::Text("ozz SkinningJob  %7.1f Mvert/s", benchmark.ozzMvps);
+                ImGui::Text("Kernel scalar    %7.1f Mvert/s", benchmark.scalarMvps);
+                if (benchmark.sse2Mvps > 0.0) ImGui::Text("Kernel SSE2      %7.1f Mvert/s", benchmark.sse2Mvps);
+                if (benchmark.avx2Mvps > 0.0) ImGui::Text("Kernel AVX2      %7.1f Mvert/s", benchmark.avx2Mvps);
+                ImGui::Text("Max error vs ozz %.5f", benchmark.maxError);
+            }
+
+            ImGui::Unindent();
+        }
+
         ImGui::Text("Albedo");
         ImGui::Image((ImTextureID)(intptr_t)gbuffer->GetAlbedo(),
                      ImVec2(previewSize, previewSize),
@@ -11,6 +11,7 @@
 
 #include "rendering/ui/UIManager.h"
 #include "rendering/ui/EditorSession.h"
+#include "rendering/Renderer.h"
 #include "components/impl/TransformComponent.h"
 
 
@@ -31,8 +32,16 @@ namespace Engine {
 			const float    fps = io.Framerate;
 			const float    ms  = (fps > 0.0f) ? (1000.0f / fps) : 0.0f;
 
-			char buf[64];
-			std::snprintf(buf, sizeof(buf), "%.0f FPS  (%.1f ms)", fps, ms);
+			char buf[160];
+			int  len = std::snprintf(buf, sizeof(buf), "%.0f FPS  (%.1f ms)", fps, ms);
+
+			const auto& visibleSets = GetRenderer().GetVisibleSets();
+			if (!visibleSets.empty() && len > 0 && len < static_cast<int>(sizeof(buf))) {
+				const auto& camera  = visibleSets[Renderer::kCameraView].stats;
+				uint32_t    shadows = 0;
+				for (size_t i = Renderer::kCameraView + 1; i < visibleSets.size(); ++i) shadows += visibleSets[i].stats.visible;
+				std::snprintf(buf + len, sizeof(buf) - len, "\nMeshes %u / %u  (culled %u, shadow %u)", camera.visible, camera.tested, camera.culled, shadows);
+			}
 
 			const ImVec2 textSize = ImGui::CalcTextSize(buf);
 			const float  pad     = 6.0f;
@@ -104,8 +113,7 @@ namespace Engine {
 
 			if (*selectedEntity && GetCurrentSceneRegistry().valid(selectedEntity->GetENTTHandle()) &&
 			    selectedEntity->HasComponent<Components::Transform>()) {
-				auto& meta = selectedEntity->GetComponent<Components::EntityMetadata>();
-				auto& tr   = selectedEntity->GetComponent<Components::Transform>();
+				auto&     tr    = selectedEntity->GetComponent<Components::Transform>();
 				glm::mat4 model = tr.GetWorldMatrix();
 
 				if (canManipulate) {
@@ -136,20 +144,7 @@ namespace Engine {
 						glm::vec3 worldPos, worldScale;
 						glm::quat worldRot;
 						Components::Transform::ExtractTRS(model, worldPos, worldRot, worldScale);
-						tr.SetWorldFromMatrix(model);
-
-						if (meta.parentEntity.IsValid()) {
-							auto parentEntity = GetCurrentScene()->Get(meta.parentEntity);
-							if (parentEntity && parentEntity.HasComponent<Components::Transform>()) {
-								auto& parentTr = parentEntity.GetComponent<Components::Transform>();
-								tr.SetLocalFromWorld(parentTr.GetWorldMatrix(), worldPos, worldRot, worldScale);
-							}
-						}
-						else {
-							tr.SetLocalPosition(worldPos);
-							tr.SetLocalRotation(worldRot);
-							tr.SetLocalScale(worldScale);
-						}
+						tr.SetWorldTRS(worldPos, worldRot, worldScale);
 
 						tr.SyncWithPhysics(*selectedEntity);
 						editor.MarkDirty();
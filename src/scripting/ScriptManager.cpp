@@ -287,6 +287,7 @@ namespace Engine {
 	void ScriptManager::onGameStart()
 	{
 		log->debug("Reloading all scripts");
+		lua["math"]["randomseed"](m_randomSeed);
 
 #ifndef GAME_BUILD
 		// Clear all event subscriptions to prevent accumulation across restarts
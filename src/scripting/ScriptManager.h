@@ -1,5 +1,6 @@
 #pragma once
 #include <sol/sol.hpp>
+#include <random>
 #include "core/module/Module.h"
 #include "core/Entity.h"
 #include "EventBus.h"
@@ -13,6 +14,7 @@ namespace Engine {
 		void                      onGameStart() override;
 		void                      onShutdown() override;
 		[[nodiscard]] std::string name() const override { return "ScriptModule"; }
+		[[nodiscard]] UpdatePhase updatePhase() const override { return UpdatePhase::FrameBegin; }
 		void                      ReloadEditorScript();
 		void                      EditorScriptUpdate(float dt);
 
@@ -23,6 +25,11 @@ namespace Engine {
 		// Get event bus for external access
 		EventBus& GetEventBus() { return eventBus; }
 
+		/// Seed for Lua's math.random, applied every time the game starts. Replays
+		/// record it so scripts draw the same numbers.
+		void                   SetRandomSeed(uint32_t seed) { m_randomSeed = seed; }
+		[[nodiscard]] uint32_t GetRandomSeed() const { return m_randomSeed; }
+
 
 		struct CollisionEvent {
 			Entity& a;
@@ -38,5 +45,8 @@ namespace Engine {
 		
 		// Event bus for publish/subscribe pattern
 		EventBus      eventBus;
+
+	  private:
+		uint32_t m_randomSeed = std::random_device{}();
 	};
 } // namespace Engine
\ No newline at end of file
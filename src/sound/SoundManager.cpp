@@ -20,9 +20,24 @@ namespace Engine::Audio {
 	// SoundBuffer implementation
 	SoundBuffer::SoundBuffer(const std::string& filename) : m_loaded(false)
 	{
-		name = GetFileName(filename);
-		// Generate buffer
-		alGenBuffers(1, &m_bufferID);
+		SoundData data;
+		if (Decode(filename, data)) {
+			Upload(data);
+		}
+		else {
+			name = data.name;
+			alGenBuffers(1, &m_bufferID);
+		}
+	}
+
+	SoundBuffer::SoundBuffer(const SoundData& data) : m_loaded(false)
+	{
+		Upload(data);
+	}
+
+	bool SoundBuffer::Decode(const std::string& filename, SoundData& out)
+	{
+		out.name = GetFileName(filename);
 
 		// Open audio file with libsndfile
 		SF_INFO fileInfo;
@@ -31,28 +46,35 @@ namespace Engine::Audio {
 		SNDFILE* file = sf_open(filename.c_str(), SFM_READ, &fileInfo);
 		if (!file) {
 			GetSoundManager().log->error("Failed to open sound file: {}", filename);
-			return;
+			return false;
 		}
 
 		// Read the audio data
-		std::vector<short> samples(fileInfo.frames * fileInfo.channels);
-		sf_read_short(file, samples.data(), static_cast<long>(samples.size()));
+		out.samples.resize(fileInfo.frames * fileInfo.channels);
+		sf_read_short(file, out.samples.data(), static_cast<long>(out.samples.size()));
 		sf_close(file);
 
-		// Determine format based on channels
-		ALenum format;
-		if (fileInfo.channels == 1)
-			format = AL_FORMAT_MONO16;
-		else if (fileInfo.channels == 2)
-			format = AL_FORMAT_STEREO16;
-		else {
+		if (fileInfo.channels != 1 && fileInfo.channels != 2) {
 			GetSoundManager().log->error("Unsupported channel count: {}", fileInfo.channels);
-			return;
+			return false;
 		}
+		out.channels   = fileInfo.channels;
+		out.sampleRate = fileInfo.samplerate;
+		return true;
+	}
+
+	void SoundBuffer::Upload(const SoundData& data)
+	{
+		name = data.name;
+		// Generate buffer
+		alGenBuffers(1, &m_bufferID);
+
+		// Determine format based on channels
+		ALenum format = data.channels == 1 ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
 
 		// Load data into OpenAL buffer
-		int size = samples.size() * sizeof(short);
-		alBufferData(m_bufferID, format, samples.data(), size, fileInfo.samplerate);
+		int size = static_cast<int>(data.samples.size() * sizeof(short));
+		alBufferData(m_bufferID, format, data.samples.data(), size, data.sampleRate);
 
 		// Check for errors
 		ALenum error = alGetError();
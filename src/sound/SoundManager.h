@@ -14,17 +14,31 @@
 
 
 namespace Engine::Audio {
+	/// PCM samples read from disk, not yet in an OpenAL buffer.
+	struct SoundData {
+		std::string        name;
+		std::vector<short> samples;
+		int                channels   = 0;
+		int                sampleRate = 0;
+	};
+
 	class SoundBuffer {
 	  public:
 		explicit SoundBuffer(const std::string& filename);
+		explicit SoundBuffer(const SoundData& data);
 		~SoundBuffer();
 
+		/// Read and validate `filename` with libsndfile. Safe on worker threads.
+		static bool Decode(const std::string& filename, SoundData& out);
+
 		[[nodiscard]] ALuint GetBufferID() const { return m_bufferID; }
 		[[nodiscard]] bool   IsLoaded() const { return m_loaded; }
 
 		std::string name;
 
 	  private:
+		void Upload(const SoundData& data);
+
 		ALuint m_bufferID{};
 		bool   m_loaded;
 	};
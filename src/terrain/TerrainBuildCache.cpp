@@ -0,0 +1,114 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#include "TerrainBuildCache.h"
+
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+#include <tracy/Tracy.hpp>
+
+#include "TerrainTile.h"
+#include "assets/CookedData.h"
+
+namespace Engine::Terrain {
+
+	namespace {
+		constexpr char kMagic[4] = {'T', 'B', 'L', 'D'};
+
+		std::atomic<uint32_t> s_nextTempId{0};
+	} // namespace
+
+	TerrainBuildOptions& GetTerrainBuildOptions()
+	{
+		static TerrainBuildOptions options;
+		return options;
+	}
+
+	uint64_t TerrainBuildCache::HashFile(const std::string& path)
+	{
+		ZoneScopedN("Hash terrain file");
+		std::ifstream file(path, std::ios::binary);
+		if (!file) return 0;
+
+		uint64_t          hash = 14695981039346656037ull;
+		std::vector<char> block(1 << 16);
+		while (file) {
+			file.read(block.data(), static_cast<std::streamsize>(block.size()));
+			const std::streamsize read = file.gcount();
+			for (std::streamsize i = 0; i < read; ++i) {
+				hash ^= static_cast<uint8_t>(block[i]);
+				hash *= 1099511628211ull;
+			}
+		}
+		return file.bad() ? 0 : hash;
+	}
+
+	std::string TerrainBuildCache::EntryPath(uint64_t key)
+	{
+		char name[32];
+		std::snprintf(name, sizeof(name), "%016llx.tbld", static_cast<unsigned long long>(key));
+		return (std::filesystem::path(GetTerrainBuildOptions().directory) / name).string();
+	}
+
+	bool TerrainBuildCache::Load(uint64_t key, TerrainTile& tile, bool withSplat)
+	{
+		ZoneScopedN("Load terrain build cache");
+		std::vector<uint8_t> data;
+		if (key == 0 || !AppendFileBytes(EntryPath(key), data)) return false;
+
+		CookedReader reader(data.data(), data.size());
+		char         magic[4];
+		uint32_t     version = 0;
+		uint64_t     stored  = 0;
+		if (!reader.Bytes(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(magic)) != 0 || !reader.Pod(version) || version != kVersion ||
+		    !reader.Pod(stored) || stored != key)
+			return false;
+
+		if (!tile.ReadBuildData(reader, withSplat)) {
+			spdlog::warn("Terrain build cache entry for '{}' is unusable, rebuilding", tile.name);
+			return false;
+		}
+		return true;
+	}
+
+	void TerrainBuildCache::Store(uint64_t key, const TerrainTile& tile)
+	{
+		ZoneScopedN("Store terrain build cache");
+		if (key == 0) return;
+
+		std::vector<uint8_t> data;
+		CookedWriter         writer(data);
+		writer.Bytes(kMagic, sizeof(kMagic));
+		writer.Pod(kVersion);
+		writer.Pod(key);
+		tile.WriteBuildData(writer);
+
+		// Write aside and rename, so a crash or a second loader never leaves a half-written entry.
+		std::error_code ec;
+		const std::string path = EntryPath(key);
+		std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+		const std::string temp = path + ".tmp" + std::to_string(s_nextTempId.fetch_add(1, std::memory_order_relaxed));
+		{
+			std::ofstream os(temp, std::ios::binary | std::ios::trunc);
+			os.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+			if (!os) {
+				spdlog::warn("Could not write terrain build cache '{}'", temp);
+				os.close();
+				std::filesystem::remove(temp, ec);
+				return;
+			}
+		}
+		std::filesystem::rename(temp, path, ec);
+		if (ec) {
+			spdlog::warn("Could not write terrain build cache '{}': {}", path, ec.message());
+			std::filesystem::remove(temp, ec);
+		}
+	}
+
+} // namespace Engine::Terrain
@@ -0,0 +1,44 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace Engine::Terrain {
+
+	class TerrainTile;
+
+	struct TerrainBuildOptions {
+		bool        useCache        = true;
+		bool        dumpSplatImages = false; // write each tile's packed splat images to debug/splat
+		std::string directory       = "cache/terrain";
+	};
+
+	TerrainBuildOptions& GetTerrainBuildOptions();
+
+	/// Derived data of terrain files: what BuildMesh and BuildSplatTextures produce (staged vertices,
+	/// chunk index patterns, packed splat images) and the serialized heightfield shape, one file per
+	/// source file content. A hit skips the whole build; only GL upload is left.
+	/// Safe to use from loader threads.
+	class TerrainBuildCache {
+	  public:
+		/// FNV-1a 64 of the file's bytes; 0 if it cannot be read.
+		static uint64_t HashFile(const std::string& path);
+
+		/// Fill `tile` (already read from its file) from the entry for `key`. False on a miss, in which
+		/// case the tile may hold partial data and must be built as usual.
+		static bool Load(uint64_t key, TerrainTile& tile, bool withSplat);
+		/// Save what `tile` has built and still has staged.
+		static void Store(uint64_t key, const TerrainTile& tile);
+
+	  private:
+		/// Bump whenever the build output changes (vertex layout, chunk patterns, shape settings...).
+		static constexpr uint32_t kVersion = 1;
+
+		static std::string EntryPath(uint64_t key);
+	};
+
+} // namespace Engine::Terrain
@@ -0,0 +1,290 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#include "TerrainChunks.h"
+
+#include "assets/CookedData.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <tracy/Tracy.hpp>
+
+namespace Engine::Terrain {
+
+	namespace {
+		uint32_t FloorPowerOfTwo(uint32_t v)
+		{
+			uint32_t p = 1;
+			while (p * 2 <= v) p *= 2;
+			return p;
+		}
+
+		// Closest distance from `p` to `box`; 0 inside.
+		float DistanceToBox(const Rendering::AABB& box, const glm::vec3& p)
+		{
+			const glm::vec3 d = glm::max(glm::max(box.min - p, p - box.max), glm::vec3(0.0f));
+			return glm::length(d);
+		}
+	} // namespace
+
+	void TerrainChunkGrid::Clear()
+	{
+		m_chunks.clear();
+		m_patternSets.clear();
+		m_indices.clear();
+		m_res = m_chunkQuads = m_chunksX = m_chunksZ = 0;
+	}
+
+	void TerrainChunkGrid::Write(CookedWriter& writer) const
+	{
+		writer.Pod(m_res);
+		writer.Pod(m_chunkQuads);
+		writer.Pod(m_chunksX);
+		writer.Pod(m_chunksZ);
+		writer.Array(m_chunks);
+		writer.Array(m_patternSets);
+		writer.Array(m_indices);
+	}
+
+	bool TerrainChunkGrid::Read(CookedReader& reader)
+	{
+		Clear();
+		const bool ok = reader.Pod(m_res) && reader.Pod(m_chunkQuads) && reader.Pod(m_chunksX) && reader.Pod(m_chunksZ) && reader.Array(m_chunks) &&
+		                reader.Array(m_patternSets) && reader.Array(m_indices) && m_chunks.size() == static_cast<size_t>(m_chunksX) * m_chunksZ;
+		bool valid = ok;
+		for (const TerrainChunk& chunk : m_chunks) valid = valid && chunk.patternSet < m_patternSets.size() && chunk.levelCount <= kMaxTerrainLods;
+		for (const PatternSet& set : m_patternSets) {
+			for (const auto& level : set.patterns) {
+				for (const TerrainIndexRange& range : level) valid = valid && static_cast<size_t>(range.first) + range.count <= m_indices.size();
+			}
+		}
+		if (!valid) Clear();
+		return valid;
+	}
+
+	void TerrainChunkGrid::Build(const std::vector<float>& heights, uint32_t res, const glm::vec3& size, uint32_t chunkQuads, uint32_t maxLevels)
+	{
+		ZoneScopedN("Build terrain chunks");
+		Clear();
+		if (res < 2 || heights.size() < static_cast<size_t>(res) * res) return;
+
+		const uint32_t quads = res - 1;
+		m_res                = res;
+		m_chunkQuads         = FloorPowerOfTwo(std::clamp<uint32_t>(chunkQuads, 1, quads));
+		m_chunksX            = (quads + m_chunkQuads - 1) / m_chunkQuads;
+		m_chunksZ            = m_chunksX;
+		maxLevels            = std::clamp<uint32_t>(maxLevels, 1, kMaxTerrainLods);
+
+		const float cellX = size.x / float(quads);
+		const float cellZ = size.z / float(quads);
+
+		m_chunks.resize(static_cast<size_t>(m_chunksX) * m_chunksZ);
+		for (uint32_t cz = 0; cz < m_chunksZ; ++cz) {
+			for (uint32_t cx = 0; cx < m_chunksX; ++cx) {
+				TerrainChunk& chunk = m_chunks[cz * m_chunksX + cx];
+				chunk.x             = cx;
+				chunk.z             = cz;
+				chunk.quadsX        = std::min(m_chunkQuads, quads - cx * m_chunkQuads);
+				chunk.quadsZ        = std::min(m_chunkQuads, quads - cz * m_chunkQuads);
+				chunk.baseVertex    = cz * m_chunkQuads * res + cx * m_chunkQuads;
+				chunk.patternSet    = FindOrAddPatternSet(chunk.quadsX, chunk.quadsZ, maxLevels);
+				chunk.levelCount    = m_patternSets[chunk.patternSet].levelCount;
+
+				float minH = heights[chunk.baseVertex];
+				float maxH = minH;
+				for (uint32_t z = 0; z <= chunk.quadsZ; ++z) {
+					for (uint32_t x = 0; x <= chunk.quadsX; ++x) {
+						const float h = heights[chunk.baseVertex + z * res + x];
+						minH          = std::min(minH, h);
+						maxH          = std::max(maxH, h);
+					}
+				}
+				chunk.bounds.min = {cellX * float(cx * m_chunkQuads), minH * size.y, cellZ * float(cz * m_chunkQuads)};
+				chunk.bounds.max = {cellX * float(cx * m_chunkQuads + chunk.quadsX), maxH * size.y, cellZ * float(cz * m_chunkQuads + chunk.quadsZ)};
+
+				ComputeErrors(heights, size.y, chunk);
+			}
+		}
+	}
+
+	uint32_t TerrainChunkGrid::FindOrAddPatternSet(uint32_t quadsX, uint32_t quadsZ, uint32_t maxLevels)
+	{
+		for (uint32_t i = 0; i < m_patternSets.size(); ++i) {
+			if (m_patternSets[i].quadsX == quadsX && m_patternSets[i].quadsZ == quadsZ) return i;
+		}
+
+		// Level n needs both sides to be a multiple of 2^n.
+		PatternSet set;
+		set.quadsX     = quadsX;
+		set.quadsZ     = quadsZ;
+		set.levelCount = 1;
+		while (set.levelCount < maxLevels) {
+			const uint32_t step = 1u << set.levelCount;
+			if (quadsX % step != 0 || quadsZ % step != 0) break;
+			++set.levelCount;
+		}
+
+		for (uint32_t level = 0; level < set.levelCount; ++level) {
+			for (uint32_t mask = 0; mask < kTerrainEdgeMasks; ++mask) {
+				BuildPattern(quadsX, quadsZ, level, static_cast<uint8_t>(mask), set.patterns[level][mask]);
+			}
+		}
+		m_patternSets.push_back(set);
+		return static_cast<uint32_t>(m_patternSets.size() - 1);
+	}
+
+	void TerrainChunkGrid::BuildPattern(uint32_t quadsX, uint32_t quadsZ, uint32_t level, uint8_t edgeMask, TerrainIndexRange& range)
+	{
+		const uint32_t step = 1u << level;
+
+		// Odd vertices on a stitched edge fold onto the previous even one, which the coarser
+		// neighbour also has. The triangles that collapse are dropped below.
+		auto vertex = [&](uint32_t x, uint32_t z) -> uint32_t {
+			const bool oddX = (x / step) % 2 == 1 && x < quadsX;
+			const bool oddZ = (z / step) % 2 == 1 && z < quadsZ;
+			if (oddX && ((z == 0 && (edgeMask & kEdgeNegZ)) || (z == quadsZ && (edgeMask & kEdgePosZ)))) x -= step;
+			if (oddZ && ((x == 0 && (edgeMask & kEdgeNegX)) || (x == quadsX && (edgeMask & kEdgePosX)))) z -= step;
+			return z * m_res + x;
+		};
+		auto triangle = [&](uint32_t a, uint32_t b, uint32_t c) {
+			if (a == b || b == c || a == c) return;
+			m_indices.insert(m_indices.end(), {a, b, c});
+		};
+
+		range.first = static_cast<uint32_t>(m_indices.size());
+		m_indices.reserve(m_indices.size() + static_cast<size_t>(quadsX / step) * (quadsZ / step) * 6);
+		for (uint32_t z = 0; z < quadsZ; z += step) {
+			for (uint32_t x = 0; x < quadsX; x += step) {
+				// Same split and winding as the full-resolution grid.
+				const uint32_t i0 = vertex(x, z);
+				const uint32_t i1 = vertex(x + step, z);
+				const uint32_t i2 = vertex(x, z + step);
+				const uint32_t i3 = vertex(x + step, z + step);
+				triangle(i0, i2, i1);
+				triangle(i1, i2, i3);
+			}
+		}
+		range.count = static_cast<uint32_t>(m_indices.size()) - range.first;
+	}
+
+	void TerrainChunkGrid::ComputeErrors(const std::vector<float>& heights, float heightScale, TerrainChunk& chunk) const
+	{
+		const uint32_t res = m_res;
+		auto height = [&](uint32_t x, uint32_t z) { return heights[chunk.baseVertex + z * res + x]; };
+
+		chunk.error[0] = 0.0f;
+		for (uint32_t level = 1; level < kMaxTerrainLods; ++level) {
+			if (level >= chunk.levelCount) {
+				chunk.error[level] = chunk.error[level - 1];
+				continue;
+			}
+
+			const uint32_t step     = 1u << level;
+			const float    invStep  = 1.0f / float(step);
+			float          maxError = 0.0f;
+			for (uint32_t z = 0; z <= chunk.quadsZ; ++z) {
+				const uint32_t z0 = std::min(z / step * step, chunk.quadsZ - step);
+				const float    fz = float(z - z0) * invStep;
+				for (uint32_t x = 0; x <= chunk.quadsX; ++x) {
+					const uint32_t x0 = std::min(x / step * step, chunk.quadsX - step);
+					const float    fx = float(x - x0) * invStep;
+
+					// Cells split along (x + step, z) - (x, z + step), as in BuildPattern.
+					const float h0 = height(x0, z0);
+					const float h1 = height(x0 + step, z0);
+					const float h2 = height(x0, z0 + step);
+					const float h3 = height(x0 + step, z0 + step);
+					const float approx = fx + fz <= 1.0f ? h0 + fx * (h1 - h0) + fz * (h2 - h0) : h3 + (1.0f - fx) * (h2 - h3) + (1.0f - fz) * (h1 - h3);
+					maxError           = std::max(maxError, std::abs(approx - height(x, z)));
+				}
+			}
+			chunk.error[level] = std::max(chunk.error[level - 1], maxError * heightScale);
+		}
+	}
+
+	const TerrainIndexRange& TerrainChunkGrid::GetPattern(const TerrainChunk& chunk, uint32_t level, uint8_t edgeMask) const
+	{
+		return m_patternSets[chunk.patternSet].patterns[level][edgeMask & (kTerrainEdgeMasks - 1)];
+	}
+
+	void TerrainChunkGrid::Select(const TerrainLodView& view, TerrainSelection& out) const
+	{
+		ZoneScopedN("Select terrain chunks");
+		const size_t count = m_chunks.size();
+		out.levels.assign(count, 0);
+		out.draws.clear();
+		out.stats        = {};
+		out.stats.chunks = static_cast<uint32_t>(count);
+		if (count == 0) return;
+
+		// Errors are heights, so only the model's Y axis scales them.
+		const float errorScale = glm::length(glm::vec3(view.model[1]));
+
+		for (size_t i = 0; i < count; ++i) {
+			const TerrainChunk& chunk = m_chunks[i];
+			if (view.projectionScale <= 0.0f || chunk.levelCount == 1) continue;
+			// The neighbouring tile picks its levels on its own, so only full detail is sure to match it.
+			if (view.lockBorders && (chunk.x == 0 || chunk.z == 0 || chunk.x + 1 == m_chunksX || chunk.z + 1 == m_chunksZ)) continue;
+
+			const float distance = DistanceToBox(Rendering::AABB::Transform(chunk.bounds, view.model), view.cameraPosition);
+			const float budget   = view.pixelError * distance / view.projectionScale; // world units per pixelError pixels
+			for (uint32_t level = chunk.levelCount - 1; level > 0; --level) {
+				if (chunk.error[level] * errorScale <= budget) {
+					out.levels[i] = static_cast<uint8_t>(level);
+					break;
+				}
+			}
+		}
+
+		// Neighbours may differ by one level at most; only ever lower levels, so this terminates.
+		auto neighbour = [&](uint32_t x, uint32_t z, int dx, int dz) -> int64_t {
+			const int64_t nx = int64_t(x) + dx;
+			const int64_t nz = int64_t(z) + dz;
+			if (nx < 0 || nz < 0 || nx >= m_chunksX || nz >= m_chunksZ) return -1;
+			return nz * m_chunksX + nx;
+		};
+		constexpr int     kOffsets[4][2] = {{0, -1}, {1, 0}, {0, 1}, {-1, 0}}; // TerrainEdge bit order
+		bool changed = true;
+		while (changed) {
+			changed = false;
+			for (size_t i = 0; i < count; ++i) {
+				for (const auto& offset : kOffsets) {
+					const int64_t n = neighbour(m_chunks[i].x, m_chunks[i].z, offset[0], offset[1]);
+					if (n < 0 || out.levels[i] <= out.levels[n] + 1) continue;
+					out.levels[i] = static_cast<uint8_t>(out.levels[n] + 1);
+					changed       = true;
+				}
+			}
+		}
+
+		const Rendering::Frustum frustum(view.viewProjection);
+		for (size_t i = 0; i < count; ++i) {
+			const TerrainChunk& chunk = m_chunks[i];
+			if (view.cull && !frustum.Intersects(Rendering::AABB::Transform(chunk.bounds, view.model))) {
+				++out.stats.culled;
+				continue;
+			}
+
+			uint8_t mask = 0;
+			for (int side = 0; side < 4; ++side) {
+				const int64_t n = neighbour(chunk.x, chunk.z, kOffsets[side][0], kOffsets[side][1]);
+				if (n >= 0 && out.levels[n] > out.levels[i]) mask |= static_cast<uint8_t>(1u << side);
+			}
+
+			TerrainChunkDraw draw;
+			draw.chunk      = static_cast<uint32_t>(i);
+			draw.baseVertex = chunk.baseVertex;
+			draw.level      = out.levels[i];
+			draw.edgeMask   = mask;
+			draw.range      = GetPattern(chunk, draw.level, mask);
+			out.draws.push_back(draw);
+
+			++out.stats.drawn;
+			++out.stats.levelCounts[draw.level];
+			out.stats.triangles += draw.range.count / 3;
+		}
+	}
+
+} // namespace Engine::Terrain
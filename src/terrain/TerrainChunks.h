@@ -0,0 +1,138 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "rendering/culling/Frustum.h"
+
+namespace Engine {
+	class CookedWriter;
+	class CookedReader;
+}
+
+namespace Engine::Terrain {
+
+	constexpr uint32_t kMaxTerrainLods = 6;
+
+	/// Edge bits of a chunk whose neighbour on that side is one level coarser.
+	enum TerrainEdge : uint8_t {
+		kEdgeNegZ = 1 << 0,
+		kEdgePosX = 1 << 1,
+		kEdgePosZ = 1 << 2,
+		kEdgeNegX = 1 << 3,
+	};
+	constexpr uint32_t kTerrainEdgeMasks = 16;
+
+	/// [first, first + count) of TerrainChunkGrid::GetIndices().
+	struct TerrainIndexRange {
+		uint32_t first = 0;
+		uint32_t count = 0;
+	};
+
+	/// A block of quads of the tile's full-resolution grid.
+	struct TerrainChunk {
+		uint32_t        x = 0, z = 0;           // chunk coordinates
+		uint32_t        quadsX = 0, quadsZ = 0; // smaller than chunkQuads in the last row / column
+		uint32_t        baseVertex = 0;         // grid index of the chunk's first vertex
+		uint32_t        patternSet = 0;         // index patterns for this chunk size
+		uint32_t        levelCount = 1;
+		Rendering::AABB bounds;                 // tile space
+		/// Max height difference between the full grid and level n's triangles, tile space. Never decreases with n.
+		float error[kMaxTerrainLods]{};
+	};
+
+	/// Camera for TerrainChunkGrid::Select.
+	struct TerrainLodView {
+		glm::mat4 model{1.0f};          // tile to world
+		glm::mat4 viewProjection{1.0f};
+		glm::vec3 cameraPosition{0.0f};
+		float     projectionScale = 0;  // pixels per world unit at distance 1: projection[1][1] * viewportHeight / 2
+		float     pixelError      = 2;  // coarsest level whose error stays under this many pixels
+		bool      cull            = true;
+		bool      lockBorders     = true; // keep chunks on the tile's edge at level 0, so adjacent tiles meet without cracks
+	};
+
+	struct TerrainChunkDraw {
+		uint32_t          chunk      = 0;
+		uint32_t          baseVertex = 0;
+		TerrainIndexRange range;
+		uint8_t           level    = 0;
+		uint8_t           edgeMask = 0;
+	};
+
+	struct TerrainLodStats {
+		uint32_t chunks    = 0;
+		uint32_t culled    = 0;
+		uint32_t drawn     = 0;
+		uint32_t triangles = 0;
+		uint32_t levelCounts[kMaxTerrainLods]{};
+	};
+
+	/// Output of Select; keep one around so its vectors are reused.
+	struct TerrainSelection {
+		std::vector<uint8_t>          levels; // per chunk, culled ones included
+		std::vector<TerrainChunkDraw> draws;
+		TerrainLodStats               stats;
+	};
+
+	/// Geomipmapped chunks of a heightmap grid. Level n of a chunk keeps every 2^n-th vertex; adjacent
+	/// chunks differ by at most one level and the finer one folds its odd edge vertices onto the coarser
+	/// neighbour's, so there are no cracks. Tiles do not see each other's levels, so chunks on a tile's
+	/// border stay at level 0 (TerrainLodView::lockBorders) and adjacent tiles meet at full detail.
+	/// Indices are relative to the chunk's first vertex in a res x res grid, so chunks of one size
+	/// share a pattern per (level, edge mask).
+	///
+	/// Knows nothing about GL: the tile uploads GetIndices() once and draws each TerrainChunkDraw with
+	/// its base vertex.
+	class TerrainChunkGrid {
+	  public:
+		/// `chunkQuads` is rounded down to a power of two. `heights` are the normalized heightmap samples;
+		/// vertex (x, z) sits at (size.x * x / (res - 1), h * size.y, size.z * z / (res - 1)).
+		void Build(const std::vector<float>& heights, uint32_t res, const glm::vec3& size, uint32_t chunkQuads = 32, uint32_t maxLevels = 5);
+		void Clear();
+
+		/// Everything Build produced, for the terrain build cache.
+		void Write(CookedWriter& writer) const;
+		/// False (and cleared) if the data is damaged.
+		bool Read(CookedReader& reader);
+
+		/// Pick a level per chunk by screen-space error, restrict neighbours to one level apart,
+		/// then cull against view.viewProjection and emit one draw per visible chunk.
+		void Select(const TerrainLodView& view, TerrainSelection& out) const;
+
+		[[nodiscard]] const TerrainIndexRange& GetPattern(const TerrainChunk& chunk, uint32_t level, uint8_t edgeMask) const;
+
+		[[nodiscard]] const std::vector<TerrainChunk>& GetChunks() const { return m_chunks; }
+		[[nodiscard]] const std::vector<uint32_t>&     GetIndices() const { return m_indices; }
+		[[nodiscard]] uint32_t                         GetChunksX() const { return m_chunksX; }
+		[[nodiscard]] uint32_t                         GetChunksZ() const { return m_chunksZ; }
+		[[nodiscard]] uint32_t                         GetChunkQuads() const { return m_chunkQuads; }
+		[[nodiscard]] uint32_t                         GetResolution() const { return m_res; }
+
+	  private:
+		struct PatternSet {
+			uint32_t          quadsX = 0, quadsZ = 0;
+			uint32_t          levelCount = 1;
+			TerrainIndexRange patterns[kMaxTerrainLods][kTerrainEdgeMasks];
+		};
+
+		uint32_t FindOrAddPatternSet(uint32_t quadsX, uint32_t quadsZ, uint32_t maxLevels);
+		void     BuildPattern(uint32_t quadsX, uint32_t quadsZ, uint32_t level, uint8_t edgeMask, TerrainIndexRange& range);
+		void     ComputeErrors(const std::vector<float>& heights, float heightScale, TerrainChunk& chunk) const;
+
+		std::vector<TerrainChunk> m_chunks;
+		std::vector<PatternSet>   m_patternSets;
+		std::vector<uint32_t>     m_indices;
+		uint32_t                  m_res        = 0;
+		uint32_t                  m_chunkQuads = 0;
+		uint32_t                  m_chunksX    = 0;
+		uint32_t                  m_chunksZ    = 0;
+	};
+
+} // namespace Engine::Terrain
@@ -8,36 +8,87 @@
 #include "components/impl/EntityMetadataComponent.h"
 #include "components/impl/TransformComponent.h"
 #include "components/impl/TerrainRendererComponent.h"
+#include "physics/PhysicsManager.h"
+
+#include <algorithm>
+#include <glm/gtc/matrix_transform.hpp>
 
 namespace Engine::Terrain {
 
 	void TerrainManager::onInit()
 	{
         ZoneScopedN("Initialize Terrain Manager");
-        for (auto& terrPairs : GetAssetManager().GetStorage<TerrainTile>().guidToAsset) {
-            auto& tile = terrPairs.second;
-
-            // todo move!!
-            TextureHandle tex1 = GetAssetManager().Load<Texture>("resources/textures/Terrain Grass.png");
-            TextureHandle tex2 = GetAssetManager().Load<Texture>("resources/textures/Terrain Dirt.png");
-            TextureHandle tex3 = GetAssetManager().Load<Texture>("resources/textures/Terrain Sand.png");
-            TextureHandle tex4 = GetAssetManager().Load<Texture>("resources/textures/Terrain Rock.png");
-            TextureHandle tex5 = GetAssetManager().Load<Texture>("resources/engine/white.png");
-
-
-            tile->diffuseTextures.clear();
-            tile->diffuseTextures.push_back(tex1);
-            tile->diffuseTextures.push_back(tex2);
-            tile->diffuseTextures.push_back(tex3);
-            tile->diffuseTextures.push_back(tex4);
-            tile->diffuseTextures.push_back(tex5);
-        }
+        GetAssetManager().GetStorage<TerrainTile>().ForEach([this](const std::string&, TerrainTile& terrain) {
+            terrain.diffuseTextures.clear();
+            AssignDiffuseTextures(terrain);
+        });
+	}
+
+	void TerrainManager::AssignDiffuseTextures(TerrainTile& tile)
+	{
+        if (!tile.diffuseTextures.empty()) return;
+
+        // todo move!!
+        TextureHandle tex1 = GetAssetManager().Load<Texture>("resources/textures/Terrain Grass.png");
+        TextureHandle tex2 = GetAssetManager().Load<Texture>("resources/textures/Terrain Dirt.png");
+        TextureHandle tex3 = GetAssetManager().Load<Texture>("resources/textures/Terrain Sand.png");
+        TextureHandle tex4 = GetAssetManager().Load<Texture>("resources/textures/Terrain Rock.png");
+        TextureHandle tex5 = GetAssetManager().Load<Texture>("resources/engine/white.png");
+
+        tile.diffuseTextures.push_back(tex1);
+        tile.diffuseTextures.push_back(tex2);
+        tile.diffuseTextures.push_back(tex3);
+        tile.diffuseTextures.push_back(tex4);
+        tile.diffuseTextures.push_back(tex5);
 	}
 
 	void TerrainManager::onUpdate(float dt)
 	{
 		ZoneScoped;
 
+		glm::vec3 focus = GetCamera().GetPosition();
+		if (IsSimulating()) {
+			if (auto character = GetPhysics().GetCharacter()) {
+				const JPH::RVec3 p = character->GetPosition();
+				focus              = glm::vec3(p.GetX(), p.GetY(), p.GetZ());
+			}
+		}
+		m_streamer.Update(focus);
+
+		CollectTiles(m_colliderTiles);
+		m_vegetation.UpdateColliders(m_colliderTiles);
+	}
+
+	void TerrainManager::CollectTiles(std::vector<PlacedTile>& out)
+	{
+		out.clear();
+		if (GetCurrentScene()) {
+			auto view = GetCurrentSceneRegistry().view<Components::EntityMetadata, Components::Transform, Components::TerrainRenderer>();
+			for (auto [entity, metadata, transform, renderer] : view.each()) {
+				if (!renderer.visible) continue;
+				if (!renderer.terrainTile.IsValid()) continue;
+				auto tile = GetAssetManager().Get(renderer.terrainTile);
+				if (tile == nullptr) continue;
+				out.push_back({tile, transform.GetWorldMatrix()});
+			}
+		}
+
+		// Streamed world tiles sit at their file position; skip any a scene entity already places.
+		const size_t placedByEntities = out.size();
+		for (const TerrainStreamer::ResidentTile& resident : m_streamer.GetResidentTiles()) {
+			TerrainTile* tile = GetAssetManager().Get(resident.handle);
+			if (tile == nullptr) continue;
+			auto end = out.begin() + static_cast<std::ptrdiff_t>(placedByEntities);
+			if (std::find_if(out.begin(), end, [&](const PlacedTile& placed) { return placed.tile == tile; }) != end) continue;
+			out.push_back({tile, glm::translate(glm::mat4(1.0f), resident.position)});
+		}
+	}
+
+	void TerrainManager::PrepareFrame(const std::vector<Rendering::Frustum>& views)
+	{
+		ZoneScopedN("Prepare terrain frame");
+		CollectTiles(m_frameTiles);
+		m_vegetation.Prepare(m_frameTiles, views.data(), views.size(), GetCamera().GetPosition());
 	}
 
 
@@ -78,51 +129,39 @@ namespace Engine::Terrain {
 
         ENGINE_GLCheckError();
 
+        m_lodStats = {};
 
+		for (const PlacedTile& placed : m_frameTiles) RenderTileGBuffer(*placed.tile, placed.model);
 
-		auto view = GetCurrentSceneRegistry().view<Components::EntityMetadata, Components::Transform, Components::TerrainRenderer>();
-		for (auto [entity, metadata, transform, renderer] : view.each()) {
-
-            if (!renderer.visible) continue;
-            if (!renderer.terrainTile.IsValid()) continue;
-			auto tile = GetAssetManager().Get(renderer.terrainTile);
-			if (tile == nullptr) continue;
-
-
-			glm::mat4 viewM            = GetCamera().GetViewMatrix();
-			glm::mat4 terrainTransform = transform.GetWorldMatrix();
-
-
-            auto gbufferShader = tile->terrainShader;
-
-			gbufferShader->Bind();
-			gbufferShader->SetMat4("model", &terrainTransform);
+		m_vegetation.RenderGBuffer(GetRenderer().GetGBufferShader());
+        glEnable(GL_BLEND);
+	}
 
+	void TerrainManager::RenderTileGBuffer(TerrainTile& tile, const glm::mat4& model)
+	{
+		AssignDiffuseTextures(tile);
 
-            glm::mat4 V = GetCamera().GetViewMatrix();
-            gbufferShader->SetMat4("view", &V);
-            glm::mat4 proj = GetCamera().GetProjectionMatrix();
-            gbufferShader->SetMat4("projection", &proj);
+		auto gbufferShader = tile.terrainShader;
 
+		gbufferShader->Bind();
+		gbufferShader->SetMat4("model", &model);
+		// view / projection come from FrameData.
 
-            gbufferShader->SetVec2("textureScale", glm::vec2(100.0, 100.0));
 
-            ENGINE_GLCheckError();
+		gbufferShader->SetVec2("textureScale", glm::vec2(100.0, 100.0));
 
+		ENGINE_GLCheckError();
 
-			for (size_t i = 0; i < tile->splatTextures.size(); ++i)
-				glBindTextureUnit(static_cast<GLuint>(i), tile->splatTextures[i]);
 
-			size_t base = tile->splatTextures.size();
-			for (size_t i = 0; i < tile->diffuseTextures.size(); ++i) {
-				GetAssetManager().Get(tile->diffuseTextures[i])->Bind(base + i);
-			}
+		for (size_t i = 0; i < tile.splatTextures.size(); ++i)
+			glBindTextureUnit(static_cast<GLuint>(i), tile.splatTextures[i]);
 
-			glBindVertexArray(tile->vao);
-			glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(tile->indexCount), GL_UNSIGNED_INT, nullptr);
-			glBindVertexArray(0);
+		size_t base = tile.splatTextures.size();
+		for (size_t i = 0; i < tile.diffuseTextures.size(); ++i) {
+			GetAssetManager().Get(tile.diffuseTextures[i])->Bind(base + i);
 		}
-        glEnable(GL_BLEND);
+
+		DrawChunks(tile, model);
 	}
 
     void TerrainManager::Render()
@@ -156,14 +195,43 @@ namespace Engine::Terrain {
 				GetAssetManager().Get(tile->diffuseTextures[i])->Bind(base + i);
 			}
 
-			glBindVertexArray(tile->vao);
-			glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(tile->indexCount), GL_UNSIGNED_INT, nullptr);
-			glBindVertexArray(0);
+			DrawChunks(*tile, terrainTransform);
+		}
+	}
+
+	void TerrainManager::DrawChunks(const TerrainTile& tile, const glm::mat4& model)
+	{
+		ZoneScopedN("Draw terrain chunks");
+
+		const glm::mat4 projection = GetCamera().GetProjectionMatrix();
+
+		TerrainLodView lodView;
+		lodView.model           = model;
+		lodView.viewProjection  = projection * GetCamera().GetViewMatrix();
+		lodView.cameraPosition  = GetCamera().GetPosition();
+		lodView.projectionScale = m_pixelError > 0.0f ? projection[1][1] * 0.5f * static_cast<float>(GetWindow().GetHeight()) : 0.0f;
+		lodView.pixelError      = m_pixelError;
+		lodView.cull            = m_cullChunks;
+		tile.chunks.Select(lodView, m_selection);
+
+		m_lodStats.chunks += m_selection.stats.chunks;
+		m_lodStats.culled += m_selection.stats.culled;
+		m_lodStats.drawn += m_selection.stats.drawn;
+		m_lodStats.triangles += m_selection.stats.triangles;
+		for (uint32_t i = 0; i < kMaxTerrainLods; ++i) m_lodStats.levelCounts[i] += m_selection.stats.levelCounts[i];
+
+		glBindVertexArray(tile.vao);
+		for (const TerrainChunkDraw& draw : m_selection.draws) {
+			glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(draw.range.count), GL_UNSIGNED_INT,
+			                         reinterpret_cast<void*>(static_cast<uintptr_t>(draw.range.first) * sizeof(uint32_t)), static_cast<GLint>(draw.baseVertex));
 		}
+		glBindVertexArray(0);
 	}
 
 	void TerrainManager::onShutdown()
 	{
+		m_vegetation.ClearColliders();
+		m_streamer.Clear();
 	}
 } // namespace Engine::Terrain
 
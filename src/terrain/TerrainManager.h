@@ -13,6 +13,8 @@
 
 
 #include "TerrainTile.h"
+#include "TerrainStreamer.h"
+#include "VegetationSystem.h"
 
 typedef unsigned int GLuint;
 namespace Engine::Terrain {
@@ -21,13 +23,48 @@ namespace Engine::Terrain {
 	class TerrainManager : public Module {
 	  public:
 		void Render();
+		/// Main thread, after culling and GLInstanceBuffer::BeginFrame: gather this frame's tiles and
+		/// cull their vegetation for `views` (camera first, then the shadow cascades).
+		void PrepareFrame(const std::vector<Rendering::Frustum>& views);
+		/// Terrain chunks and vegetation of the tiles PrepareFrame gathered.
 		void RenderGBuffer();
 
+		/// Chunks drawn / culled and triangles, summed over every tile in the last RenderGBuffer.
+		[[nodiscard]] const TerrainLodStats& GetLodStats() const { return m_lodStats; }
+		/// Screen-space error (pixels) a chunk LOD may show; 0 = always full resolution.
+		float& GetLodPixelError() { return m_pixelError; }
+		bool&  GetCullChunks() { return m_cullChunks; }
+
+		/// World tiles paged in around the camera (the player while playing).
+		[[nodiscard]] TerrainStreamer& GetStreamer() { return m_streamer; }
+		/// Tree instances of every tile.
+		[[nodiscard]] VegetationSystem& GetVegetation() { return m_vegetation; }
+
 		void                      onInit() override;
 		void                      onUpdate(float dt) override;
 		void                      onGameStart() override {}
 		void                      onShutdown() override;
 		[[nodiscard]] std::string name() const override { return "TerrainModule"; };
+
+	  private:
+		/// Bind the tile's shader and textures, then DrawChunks.
+		void RenderTileGBuffer(TerrainTile& tile, const glm::mat4& model);
+		/// Select the tile's chunks for the camera and draw them; the tile's shader must be bound.
+		void DrawChunks(const TerrainTile& tile, const glm::mat4& model);
+		/// Layer textures for tiles that have none yet (streamed tiles arrive after onInit).
+		void AssignDiffuseTextures(TerrainTile& tile);
+		/// Visible TerrainRenderer tiles, then resident streamed tiles no entity already places.
+		void CollectTiles(std::vector<PlacedTile>& out);
+
+		TerrainStreamer         m_streamer;
+		VegetationSystem        m_vegetation;
+		std::vector<PlacedTile> m_frameTiles;    // PrepareFrame -> RenderGBuffer
+		std::vector<PlacedTile> m_colliderTiles; // scratch for onUpdate
+
+		TerrainSelection m_selection;
+		TerrainLodStats  m_lodStats;
+		float            m_pixelError = 2.0f;
+		bool             m_cullChunks = true;
 	};
 
 } // namespace Engine::Terrain
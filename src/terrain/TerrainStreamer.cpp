@@ -0,0 +1,200 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#include "TerrainStreamer.h"
+
+#include "TerrainTile.h"
+#include "assets/AssetManager.h"
+#include "assets/impl/TerrainLoader.h"
+#include "core/EngineData.h"
+#include "physics/PhysicsManager.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+#include <tracy/Tracy.hpp>
+
+namespace Engine::Terrain {
+
+	namespace {
+		// Distance from `p` to the box's footprint on the XZ plane.
+		float DistanceXZ(const Rendering::AABB& box, const glm::vec3& p)
+		{
+			const float dx = std::max({box.min.x - p.x, 0.0f, p.x - box.max.x});
+			const float dz = std::max({box.min.z - p.z, 0.0f, p.z - box.max.z});
+			return std::sqrt(dx * dx + dz * dz);
+		}
+	} // namespace
+
+	bool TerrainStreamer::AddTile(const std::string& path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file) return false;
+
+		TerrainTile header;
+		try {
+			TerrainLoader::ReadHeader(file, header);
+		}
+		catch (const std::exception& e) {
+			GetDefaultLogger()->warn("Skipping terrain tile {}: {}", path, e.what());
+			return false;
+		}
+
+		TileRecord& record    = m_tiles.emplace_back();
+		record.path           = path;
+		record.bounds.min     = {header.posX, header.posY, header.posZ};
+		record.bounds.max     = record.bounds.min + glm::vec3(header.sizeX, header.sizeY, header.sizeZ);
+		record.estimatedBytes = TerrainTile::EstimateMemoryBytes(header.heightRes, header.splatRes, header.splatLayerCount);
+		return true;
+	}
+
+	void TerrainStreamer::Clear()
+	{
+		for (TileRecord& record : m_tiles) Release(record);
+		m_tiles.clear();
+		m_resident.clear();
+		m_stats = {};
+	}
+
+	void TerrainStreamer::MakeResident(TileRecord& record, TerrainTile& tile)
+	{
+		record.state = TileState::Resident;
+		record.bytes = tile.GetMemoryBytes();
+		++m_stats.loadedTotal;
+
+		JPH::BodyInterface* bodies = GetPhysics().GetBodyInterface();
+		if (!bodies || !tile.heightfieldShape) return;
+		const JPH::BodyCreationSettings settings(tile.heightfieldShape, JPH::RVec3(tile.posX, tile.posY, tile.posZ), JPH::Quat::sIdentity(), JPH::EMotionType::Static,
+		                                         Layers::NON_MOVING);
+		record.body = bodies->CreateAndAddBody(settings, JPH::EActivation::DontActivate);
+	}
+
+	void TerrainStreamer::Release(TileRecord& record)
+	{
+		if (!record.body.IsInvalid()) {
+			if (JPH::BodyInterface* bodies = GetPhysics().GetBodyInterface()) {
+				if (bodies->IsAdded(record.body)) bodies->RemoveBody(record.body);
+				bodies->DestroyBody(record.body);
+			}
+			record.body = JPH::BodyID();
+		}
+		if (record.state == TileState::Resident) {
+			// The GL objects go with the tile when the AssetManager frees it next frame.
+			GetAssetManager().Unload(record.handle);
+			++m_stats.evictedTotal;
+		}
+		record.state = record.state == TileState::Failed ? TileState::Failed : TileState::Unloaded;
+		record.bytes = 0;
+	}
+
+	void TerrainStreamer::Update(const glm::vec3& focus)
+	{
+		ZoneScopedN("Stream terrain");
+		AssetManager& assets  = GetAssetManager();
+		const float   loadR   = settings.loadRadius;
+		const float   unloadR = std::max(settings.unloadRadius, loadR);
+		size_t        used    = 0;
+		uint32_t      pending = 0;
+
+		for (TileRecord& record : m_tiles) {
+			record.distance = DistanceXZ(record.bounds, focus);
+
+			if (record.state == TileState::Loading && !assets.IsLoading(record.handle.GetID())) {
+				if (TerrainTile* tile = assets.Get(record.handle)) {
+					MakeResident(record, *tile);
+				}
+				else {
+					GetDefaultLogger()->warn("Terrain tile {} failed to load; it will not be retried", record.path);
+					record.state = TileState::Failed;
+				}
+			}
+			else if (record.state == TileState::Resident) {
+				if (!assets.Get(record.handle)) {
+					// Unloaded or reloaded behind our back; request it again.
+					record.state = TileState::Unloaded;
+					Release(record);
+				}
+				else {
+					GetPhysics().KeepBodyAdded(record.body);
+				}
+			}
+
+			if (record.state == TileState::Resident && record.distance > unloadR) Release(record);
+
+			if (record.state == TileState::Resident) used += record.bytes;
+			if (record.state == TileState::Loading) {
+				used += record.estimatedBytes;
+				++pending;
+			}
+		}
+
+		// Nearest first; a tile that does not fit may push out resident tiles farther away than itself.
+		m_candidates.clear();
+		for (uint32_t i = 0; i < m_tiles.size(); ++i) {
+			if (m_tiles[i].state == TileState::Unloaded && m_tiles[i].distance <= loadR) m_candidates.push_back(i);
+		}
+		std::sort(m_candidates.begin(), m_candidates.end(), [&](uint32_t a, uint32_t b) { return m_tiles[a].distance < m_tiles[b].distance; });
+
+		for (uint32_t index : m_candidates) {
+			if (pending >= settings.maxPending) break;
+			TileRecord& record = m_tiles[index];
+
+			while (used + record.estimatedBytes > settings.memoryBudget) {
+				TileRecord* farthest = nullptr;
+				for (TileRecord& other : m_tiles) {
+					if (other.state == TileState::Resident && other.distance > record.distance && (!farthest || other.distance > farthest->distance)) farthest = &other;
+				}
+				if (!farthest) break;
+				used -= farthest->bytes;
+				Release(*farthest);
+			}
+			if (used + record.estimatedBytes > settings.memoryBudget) continue;
+
+			record.handle = assets.LoadAsync<TerrainTile>(record.path);
+			record.state  = TileState::Loading;
+			used += record.estimatedBytes;
+			++pending;
+
+			// Loaders without a worker path (or an already loaded asset) finish inside LoadAsync.
+			if (!assets.IsLoading(record.handle.GetID())) {
+				--pending;
+				used -= record.estimatedBytes;
+				if (TerrainTile* tile = assets.Get(record.handle)) {
+					MakeResident(record, *tile);
+					used += record.bytes;
+				}
+				else {
+					record.state = TileState::Failed;
+				}
+			}
+		}
+
+		m_resident.clear();
+		const uint32_t loadedTotal  = m_stats.loadedTotal;
+		const uint32_t evictedTotal = m_stats.evictedTotal;
+		m_stats                     = {};
+		m_stats.tiles               = static_cast<uint32_t>(m_tiles.size());
+		m_stats.loadedTotal         = loadedTotal;
+		m_stats.evictedTotal        = evictedTotal;
+		for (const TileRecord& record : m_tiles) {
+			switch (record.state) {
+				case TileState::Resident:
+					m_resident.push_back({record.handle, record.bounds.min});
+					++m_stats.resident;
+					m_stats.residentBytes += record.bytes;
+					break;
+				case TileState::Loading:
+					++m_stats.pending;
+					m_stats.pendingBytes += record.estimatedBytes;
+					break;
+				case TileState::Failed: ++m_stats.failed; break;
+				case TileState::Unloaded: break;
+			}
+		}
+	}
+
+} // namespace Engine::Terrain
+
+#include "assets/AssetManager.inl"
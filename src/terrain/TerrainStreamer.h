@@ -0,0 +1,88 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Jolt/Jolt.h"
+#include "Jolt/Physics/Body/BodyID.h"
+
+#include "assets/AssetHandle.h"
+#include "rendering/culling/Frustum.h"
+
+namespace Engine::Terrain {
+
+	struct TerrainStreamingSettings {
+		float    loadRadius   = 1000.0f;       // tiles whose XZ footprint comes this close to the focus are requested
+		float    unloadRadius = 1300.0f;       // resident tiles farther than this are released; kept >= loadRadius
+		size_t   memoryBudget = 512ull << 20;  // resident + pending tile bytes
+		uint32_t maxPending   = 2;             // tile loads in flight at once
+	};
+
+	struct TerrainStreamingStats {
+		uint32_t tiles         = 0;
+		uint32_t resident      = 0;
+		uint32_t pending       = 0;
+		uint32_t failed        = 0;
+		uint32_t loadedTotal   = 0;
+		uint32_t evictedTotal  = 0;
+		size_t   residentBytes = 0;
+		size_t   pendingBytes  = 0; // header estimates of tiles still loading
+	};
+
+	/// Pages a world of terrain tiles in and out around a focus point.
+	///
+	/// Tiles are registered by path; only their headers are read up front. Loads go through
+	/// AssetManager::LoadAsync, so file reading, mesh / chunk / heightfield building run on the
+	/// loader threads and the GL uploads on the main thread under AssetManager::uploadBudgetMs.
+	/// Resident tiles get a static Jolt body that is removed again when the tile is released.
+	class TerrainStreamer {
+	  public:
+		/// Read the tile's header and add it to the world. False if the file is not a terrain tile. Main thread.
+		bool AddTile(const std::string& path);
+		/// Release every tile and forget them. Main thread.
+		void Clear();
+
+		/// Finish landed loads, release far tiles, request near ones within the budget. Main thread, once per frame.
+		void Update(const glm::vec3& focus);
+
+		/// Handles of the tiles resident after the last Update, with their world offset.
+		struct ResidentTile {
+			TerrainHandle handle;
+			glm::vec3     position{0.0f};
+		};
+		[[nodiscard]] const std::vector<ResidentTile>& GetResidentTiles() const { return m_resident; }
+
+		[[nodiscard]] const TerrainStreamingStats& GetStats() const { return m_stats; }
+		TerrainStreamingSettings                   settings;
+
+	  private:
+		enum class TileState : uint8_t { Unloaded, Loading, Resident, Failed };
+
+		struct TileRecord {
+			std::string     path;
+			TerrainHandle   handle; // set on the first request
+			Rendering::AABB bounds; // world, from the header
+			size_t          estimatedBytes = 0;
+			size_t          bytes          = 0; // measured once resident
+			JPH::BodyID     body;
+			TileState       state    = TileState::Unloaded;
+			float           distance = 0.0f;
+		};
+
+		void MakeResident(TileRecord& record, TerrainTile& tile);
+		void Release(TileRecord& record);
+
+		std::vector<TileRecord>   m_tiles;
+		std::vector<ResidentTile> m_resident;
+		std::vector<uint32_t>     m_candidates; // scratch
+		TerrainStreamingStats     m_stats;
+	};
+
+} // namespace Engine::Terrain
@@ -14,6 +14,9 @@
 #include "stb/stb_image_write.h"
 #include "components/impl/TerrainRendererComponent.h"
 #include "Jolt/Physics/Collision/Shape/HeightFieldShape.h"
+#include "Jolt/Core/StreamWrapper.h"
+#include "assets/CookedData.h"
+#include "core/ThreadPool.h"
 #include <stdexcept>
 
 namespace Engine::Terrain {
@@ -117,8 +120,19 @@ namespace Engine::Terrain {
               "} vs_out;\n"
               "\n"
               "uniform mat4 model;\n"
-              "uniform mat4 view;\n"
-              "uniform mat4 projection;\n"
+              "\n"
+              "// Layout matches Rendering::FrameUniforms.\n"
+              "layout (std140) uniform FrameData {\n"
+              "    mat4 view;\n"
+              "    mat4 projection;\n"
+              "    mat4 invView;\n"
+              "    mat4 invProjection;\n"
+              "    vec3 viewPos;\n"
+              "    float farPlane;\n"
+              "    vec3 lightDir;\n"
+              "    int cascadeCount;\n"
+              "    vec4 cascadeSplits[4];\n"
+              "};\n"
               "\n"
               "void main()\n"
               "{\n"
@@ -139,6 +153,12 @@ namespace Engine::Terrain {
 
 	void TerrainTile::SetupShader()
 	{
+		// The generated program depends only on the layer count, so tiles share it. Main thread only.
+		static std::unordered_map<uint32_t, std::weak_ptr<Engine::Shader>> s_shaders;
+		std::weak_ptr<Engine::Shader>& cached = s_shaders[splatLayerCount];
+		terrainShader                         = cached.lock();
+		if (terrainShader) return;
+
 		std::string vertexCode   = GenerateGLSLVertexShader();
 		std::string fragmentCode = GenerateGLSLShader();
 
@@ -148,6 +168,7 @@ namespace Engine::Terrain {
 		terrainShader = std::make_shared<Engine::Shader>();
 		bool success  = terrainShader->LoadFromSource(vertexCode, fragmentCode);
 		ENGINE_VERIFY(success, "Failed to compile terrain shader");
+		cached = terrainShader;
 
 		spdlog::debug("num of textures: {}", splatTextures.size());
 	}
@@ -158,87 +179,78 @@ namespace Engine::Terrain {
 	}
 
 
-	void TerrainTile::GenerateMesh()
+	TerrainTile::~TerrainTile()
 	{
-		uint32_t res = heightRes;
+		// Tiles still loaded at exit may outlive the GL context.
+		if (!IsHeadless() && glfwGetCurrentContext() != nullptr) ReleaseGpuResources();
+	}
 
-		std::vector<glm::vec3> positions(res * res);
-		std::vector<glm::vec2> uvs(res * res);
-		std::vector<glm::vec3> normals(res * res, glm::vec3(0.0f));
-		std::vector<float>     vertices;
-		std::vector<uint32_t>  indices;
+	void TerrainTile::GenerateMesh()
+	{
+		BuildMesh();
+		// Headless has no GL context; the heightfield is all physics needs.
+		if (!IsHeadless()) UploadMesh();
+	}
 
-		auto getHeight = [&](int x, int z) -> float {
-			x = std::clamp(x, 0, int(res) - 1);
-			z = std::clamp(z, 0, int(res) - 1);
-			return heightmap[z * res + x];
-		};
+	void TerrainTile::BuildMesh()
+	{
+		ZoneScopedN("Build terrain mesh");
+		const int res = static_cast<int>(heightRes);
 
-		// Step 1: Generate vertex positions and UVs
-		for (uint32_t z = 0; z < res; ++z) {
-			for (uint32_t x = 0; x < res; ++x) {
-				auto u = float(x) / float(res - 1);
-				auto v = float(z) / float(res - 1);
-				auto h = getHeight((int) x, (int) z);
+		std::vector<float>& vertices = m_stagedVertices;
+		vertices.resize(static_cast<size_t>(res) * res * 8);
 
-				glm::vec3 pos(sizeX * u, h * sizeY, sizeZ * v);
-				positions[z * res + x] = pos;
-				uvs[z * res + x]       = glm::vec2(u, v);
-			}
-		}
+		auto position = [&](int x, int z) {
+			const float u = float(x) / float(res - 1);
+			const float v = float(z) / float(res - 1);
+			return glm::vec3(sizeX * u, heightmap[z * res + x] * sizeY, sizeZ * v);
+		};
+		// Quad (x, z) is split into T1 = (p0, p2, p1) and T2 = (p1, p2, p3), p0 at (x, z), p3 at (x + 1, z + 1).
+		auto quadNormal = [&](int x, int z, bool second) {
+			const glm::vec3 p0 = position(x, z), p1 = position(x + 1, z), p2 = position(x, z + 1);
+			if (!second) return glm::normalize(glm::cross(p2 - p0, p1 - p0));
+			return glm::normalize(glm::cross(p2 - p1, position(x + 1, z + 1) - p1));
+		};
 
-		// Step 2: Generate indices and normals
-		for (uint32_t z = 0; z < res - 1; ++z) {
-			for (uint32_t x = 0; x < res - 1; ++x) {
-				uint32_t i0 = z * res + x;
-				uint32_t i1 = i0 + 1;
-				uint32_t i2 = i0 + res;
-				uint32_t i3 = i2 + 1;
-
-				// Triangle 1
-				{
-					glm::vec3 edge1 = positions[i2] - positions[i0];
-					glm::vec3 edge2 = positions[i1] - positions[i0];
-					glm::vec3 n     = glm::normalize(glm::cross(edge1, edge2));
-					normals[i0] += n;
-					normals[i1] += n;
-					normals[i2] += n;
-					indices.push_back(i0);
-					indices.push_back(i2);
-					indices.push_back(i1);
-				}
-				// Triangle 2
-				{
-					glm::vec3 edge1 = positions[i2] - positions[i1];
-					glm::vec3 edge2 = positions[i3] - positions[i1];
-					glm::vec3 n     = glm::normalize(glm::cross(edge1, edge2));
-					normals[i1] += n;
-					normals[i2] += n;
-					normals[i3] += n;
-					indices.push_back(i1);
-					indices.push_back(i2);
-					indices.push_back(i3);
+		// Rows are independent: each vertex gathers the face normals of the triangles around it, the
+		// same sum a scatter over every triangle would give.
+		GetThreadPool().ParallelFor(res, 16, [&](int begin, int end) {
+			for (int z = begin; z < end; ++z) {
+				for (int x = 0; x < res; ++x) {
+					glm::vec3 normal(0.0f);
+					const bool right = x < res - 1, left = x > 0, up = z < res - 1, down = z > 0;
+					if (right && up) normal += quadNormal(x, z, false);
+					if (left && up) normal += quadNormal(x - 1, z, false) + quadNormal(x - 1, z, true);
+					if (right && down) normal += quadNormal(x, z - 1, false) + quadNormal(x, z - 1, true);
+					if (left && down) normal += quadNormal(x - 1, z - 1, true);
+					normal = glm::normalize(normal);
+
+					const glm::vec3 pos = position(x, z);
+					float*          out = &vertices[(static_cast<size_t>(z) * res + x) * 8];
+					out[0]              = pos.x;
+					out[1]              = pos.y;
+					out[2]              = pos.z;
+					out[3]              = float(x) / float(res - 1);
+					out[4]              = float(z) / float(res - 1);
+					out[5]              = normal.x;
+					out[6]              = normal.y;
+					out[7]              = normal.z;
 				}
 			}
-		}
+		});
 
-		// Step 3: Normalize normals and create vertex buffer
-		for (uint32_t i = 0; i < positions.size(); ++i) {
-			glm::vec3 pos  = positions[i];
-			glm::vec2 uv   = uvs[i];
-			glm::vec3 norm = glm::normalize(normals[i]);
-
-			vertices.push_back(pos.x);
-			vertices.push_back(pos.y);
-			vertices.push_back(pos.z);
-			vertices.push_back(uv.x);
-			vertices.push_back(uv.y);
-			vertices.push_back(norm.x);
-			vertices.push_back(norm.y);
-			vertices.push_back(norm.z);
-		}
+		// Chunks and their shared LOD index patterns; every level draws from the grid above.
+		chunks.Build(heightmap, heightRes, glm::vec3(sizeX, sizeY, sizeZ));
+		vegetation.Build(trees, glm::vec3(sizeX, sizeY, sizeZ), chunks.GetChunksX());
 
-		indexCount = indices.size();
+		CreateHeightfieldShape();
+	}
+
+	void TerrainTile::UploadMesh()
+	{
+		ZoneScopedN("Upload terrain mesh");
+		const std::vector<float>&    vertices = m_stagedVertices;
+		const std::vector<uint32_t>& indices  = chunks.GetIndices();
 
 		glGenVertexArrays(1, &vao);
 		glGenBuffers(1, &vbo);
@@ -260,7 +272,44 @@ namespace Engine::Terrain {
 
 		glBindVertexArray(0);
 
-		// -------- HEIGHTFIELD SHAPE CREATION (no body) --------
+		m_stagedVertices.clear();
+		m_stagedVertices.shrink_to_fit();
+	}
+
+	void TerrainTile::ReleaseGpuResources()
+	{
+		if (vao) glDeleteVertexArrays(1, &vao);
+		if (vbo) glDeleteBuffers(1, &vbo);
+		if (ebo) glDeleteBuffers(1, &ebo);
+		if (!splatTextures.empty()) glDeleteTextures(static_cast<GLsizei>(splatTextures.size()), splatTextures.data());
+		vao = vbo = ebo = 0;
+		splatTextures.clear();
+	}
+
+	size_t TerrainTile::EstimateMemoryBytes(uint32_t heightRes, uint32_t splatRes, uint32_t splatLayerCount)
+	{
+		const size_t heights = static_cast<size_t>(heightRes) * heightRes;
+		const size_t texels  = static_cast<size_t>(splatRes) * splatRes;
+		// heightmap + vertex buffer, splatmap + one RGBA texture per 4 layers
+		return heights * (sizeof(float) + 8 * sizeof(float)) + texels * (splatLayerCount + 4 * ((splatLayerCount + 3) / 4));
+	}
+
+	size_t TerrainTile::GetMemoryBytes() const
+	{
+		const size_t heights = static_cast<size_t>(heightRes) * heightRes;
+		size_t       bytes   = heightmap.size() * sizeof(float) + splatmap.size() + trees.size() * sizeof(TreeInstance);
+		bytes += chunks.GetIndices().size() * sizeof(uint32_t) * (ebo ? 2 : 1);
+		bytes += vegetation.GetMemoryBytes();
+		bytes += m_stagedVertices.size() * sizeof(float) + (vbo ? heights * 8 * sizeof(float) : 0);
+		for (const auto& layer : m_stagedSplat) bytes += layer.size();
+		bytes += splatTextures.size() * static_cast<size_t>(splatRes) * splatRes * 4;
+		return bytes;
+	}
+
+	// Heightfield shape only; the body is created by whoever places the tile.
+	void TerrainTile::CreateHeightfieldShape()
+	{
+		uint32_t res = heightRes;
 
 		std::vector<uint8_t>       materialIndices(heightRes * heightRes, 0);
 		Array<PhysicsMaterialRefC> materials = {new JPH::PhysicsMaterial()};
@@ -287,38 +336,101 @@ namespace Engine::Terrain {
 
 	void TerrainTile::GenerateSplatTextures()
 	{
-		uint32_t layerCount = splatLayerCount;
-		uint32_t res        = splatRes;
-		uint32_t count      = (layerCount + 3) / 4;
+		BuildSplatTextures();
+		UploadSplatTextures();
+	}
+
+	void TerrainTile::BuildSplatTextures()
+	{
+		ZoneScopedN("Build terrain splat textures");
+		const uint32_t layerCount = splatLayerCount;
+		const uint32_t res        = splatRes;
+		const uint32_t count      = (layerCount + 3) / 4;
+
+		m_stagedSplat.assign(count, std::vector<uint8_t>(static_cast<size_t>(res) * res * 4, 0));
+		GetThreadPool().ParallelFor(static_cast<int>(res), 32, [&](int begin, int end) {
+			for (int y = begin; y < end; ++y) {
+				for (uint32_t x = 0; x < res; ++x) {
+					const size_t texel = static_cast<size_t>(y) * res + x;
+					const size_t idx   = texel * layerCount;
+					for (uint32_t layer = 0; layer < layerCount; ++layer) m_stagedSplat[layer / 4][texel * 4 + layer % 4] = splatmap[idx + layer];
+				}
+			}
+		});
+	}
 
+	void TerrainTile::DumpSplatImages() const
+	{
 		std::filesystem::create_directories("debug/splat");
+		for (size_t i = 0; i < m_stagedSplat.size(); ++i) {
+			std::string filename = "debug/splat/tile_" + name + "_layerGroup_" + std::to_string(i) + ".png";
+			stbi_write_png(filename.c_str(), (GLsizei) splatRes, (GLsizei) splatRes, 4, m_stagedSplat[i].data(), (GLsizei) splatRes * 4);
+		}
+	}
 
-		for (uint32_t i = 0; i < count; ++i) {
-			std::vector<uint8_t> rgba(res * res * 4, 0);
+	void TerrainTile::WriteBuildData(CookedWriter& writer) const
+	{
+		writer.Array(m_stagedVertices);
+		chunks.Write(writer);
+
+		// The heightfield is written in Jolt's own format; restoring it skips re-quantizing the samples.
+		std::ostringstream        shapeStream(std::ios::binary);
+		JPH::StreamOutWrapper     shapeOut(shapeStream);
+		JPH::Shape::ShapeToIDMap    shapeIds;
+		JPH::Shape::MaterialToIDMap materialIds;
+		if (heightfieldShape) heightfieldShape->SaveWithChildren(shapeOut, shapeIds, materialIds);
+		writer.String(shapeStream.str());
+
+		writer.Pod(static_cast<uint8_t>(!m_stagedSplat.empty()));
+		writer.Pod(static_cast<uint32_t>(m_stagedSplat.size()));
+		for (const auto& rgba : m_stagedSplat) writer.Array(rgba);
+	}
 
-			for (uint32_t y = 0; y < res; ++y) {
-				for (uint32_t x = 0; x < res; ++x) {
-					int idx = (int) (y * res + x) * (int) layerCount;
-					for (int c = 0; c < 4; ++c) {
-						uint32_t layer = i * 4 + c;
-						if (layer < layerCount) rgba[(y * res + x) * 4 + c] = splatmap[idx + layer];
-					}
-				}
+	bool TerrainTile::ReadBuildData(CookedReader& reader, bool withSplat)
+	{
+		ZoneScopedN("Read cached terrain build");
+		const size_t vertexCount = static_cast<size_t>(heightRes) * heightRes * 8;
+		std::string  shapeBytes;
+		if (!reader.Array(m_stagedVertices) || m_stagedVertices.size() != vertexCount || !chunks.Read(reader) || !reader.String(shapeBytes)) return false;
+		if (chunks.GetResolution() != heightRes) return false;
+
+		uint8_t  hasSplat   = 0;
+		uint32_t splatCount = 0;
+		if (!reader.Pod(hasSplat) || !reader.Pod(splatCount)) return false;
+		if (withSplat) {
+			if (!hasSplat || splatCount != (splatLayerCount + 3) / 4) return false;
+			m_stagedSplat.resize(splatCount);
+			for (auto& rgba : m_stagedSplat) {
+				if (!reader.Array(rgba) || rgba.size() != static_cast<size_t>(splatRes) * splatRes * 4) return false;
 			}
+		}
+
+		std::istringstream            shapeStream(shapeBytes, std::ios::binary);
+		JPH::StreamInWrapper          shapeIn(shapeStream);
+		JPH::Shape::IDToShapeMap      shapeIds;
+		JPH::Shape::IDToMaterialMap   materialIds;
+		JPH::Shape::ShapeResult       result = JPH::Shape::sRestoreWithChildren(shapeIn, shapeIds, materialIds);
+		if (result.HasError()) return false;
+		heightfieldShape = result.Get();
+
+		vegetation.Build(trees, glm::vec3(sizeX, sizeY, sizeZ), chunks.GetChunksX());
+		return true;
+	}
 
-			// Upload to OpenGL
+	void TerrainTile::UploadSplatTextures()
+	{
+		ZoneScopedN("Upload terrain splat textures");
+		for (const std::vector<uint8_t>& rgba : m_stagedSplat) {
 			GLuint tex;
 			glGenTextures(1, &tex);
 			glBindTexture(GL_TEXTURE_2D, tex);
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, (GLsizei) res, (GLsizei) res, 0, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, (GLsizei) splatRes, (GLsizei) splatRes, 0, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 			splatTextures.push_back(tex);
-
-			// Save to PNG for debugging
-			std::string filename = "debug/splat/tile_" + name + "_layerGroup_" + std::to_string(i) + ".png";
-			stbi_write_png(filename.c_str(), (GLsizei) res, (GLsizei) res, 4, rgba.data(), (GLsizei) res * 4);
 		}
+		m_stagedSplat.clear();
+		m_stagedSplat.shrink_to_fit();
 	}
 
 } // namespace Engine::Terrain
\ No newline at end of file
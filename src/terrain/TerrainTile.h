@@ -9,6 +9,8 @@
 #include "core/Window.h"
 #include "rendering/Shader.h"
 #include "rendering/Texture.h"
+#include "TerrainChunks.h"
+#include "VegetationLayer.h"
 
 #include "Jolt/Jolt.h"
 #include "Jolt/Geometry/Triangle.h"
@@ -21,18 +23,42 @@
 
 namespace Engine::Terrain {
 
-	struct TreeInstance {
-		float    x, y, z;
-		float    scale;
-		uint32_t prefabIndex;
-	};
-
 	class TerrainTile {
 	  public:
+		TerrainTile() = default;
+		~TerrainTile();
+		TerrainTile(const TerrainTile&)            = delete;
+		TerrainTile& operator=(const TerrainTile&) = delete;
+
+		/// BuildMesh, then UploadMesh unless headless.
 		void GenerateMesh();
+		/// BuildSplatTextures, then UploadSplatTextures.
 		void GenerateSplatTextures();
+		/// Shared with every tile of the same layer count.
 		void SetupShader();
 
+		/// Any thread: vertex data, chunks, the vegetation layer and the heightfield shape. The vertices stay staged for UploadMesh.
+		void BuildMesh();
+		/// Main thread: upload the staged vertices and the chunk index patterns, then drop the staged copy.
+		void UploadMesh();
+		/// Any thread: pack the splatmap into one RGBA image per 4 layers.
+		void BuildSplatTextures();
+		/// Write what BuildSplatTextures staged to debug/splat as PNGs.
+		void DumpSplatImages() const;
+		/// Staged vertices, chunks, heightfield shape and staged splat images, for TerrainBuildCache.
+		void WriteBuildData(CookedWriter& writer) const;
+		/// Instead of BuildMesh (+ BuildSplatTextures if `withSplat`). False if the data does not fit this tile.
+		bool ReadBuildData(CookedReader& reader, bool withSplat);
+		/// Main thread: upload what BuildSplatTextures staged.
+		void UploadSplatTextures();
+		/// Main thread: free the VAO, buffers and splat textures.
+		void ReleaseGpuResources();
+
+		/// CPU + GPU bytes the tile holds right now.
+		[[nodiscard]] size_t GetMemoryBytes() const;
+		/// What a tile with this header will hold once uploaded (chunk index patterns not included).
+		[[nodiscard]] static size_t EstimateMemoryBytes(uint32_t heightRes, uint32_t splatRes, uint32_t splatLayerCount);
+
 		std::string               name;
 		uint32_t                  heightRes;
 		uint32_t                  splatRes;
@@ -41,21 +67,27 @@ namespace Engine::Terrain {
 		std::vector<float>        heightmap;
 		std::vector<uint8_t>      splatmap;
 		std::vector<TreeInstance> trees;
+		VegetationLayer           vegetation; // `trees` binned per chunk, built with the mesh
 		JPH::Ref<JPH::Shape>      heightfieldShape;
 
 		std::shared_ptr<Engine::Shader> terrainShader;
-		float                           posX;
-		float                           posY;
-		float                           posZ;
+		float                           posX = 0.0f;
+		float                           posY = 0.0f;
+		float                           posZ = 0.0f;
 
 		// Runtime-generated OpenGL assets
 		GLuint                                    vao        = 0;
 		GLuint                                    vbo        = 0;
-		GLuint                                    ebo        = 0;
-		GLuint                                    indexCount = 0;
+		GLuint                                    ebo        = 0; // every chunk LOD pattern, see chunks.GetIndices()
+		TerrainChunkGrid                          chunks;
 		std::vector<GLuint>                       splatTextures;   // One RGBA texture per 4 layers
 		std::vector<TextureHandle> diffuseTextures; // One RGBA texture per 4 layers
 	  private:
+		void CreateHeightfieldShape();
+
+		std::vector<float>                m_stagedVertices; // BuildMesh -> UploadMesh
+		std::vector<std::vector<uint8_t>> m_stagedSplat;    // BuildSplatTextures -> UploadSplatTextures
+
 		[[nodiscard]] std::string GenerateGLSLShader() const;
 		[[nodiscard]] std::string GenerateGLSLVertexShader() const;
 	};
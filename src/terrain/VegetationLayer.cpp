@@ -0,0 +1,83 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#include "VegetationLayer.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include <tracy/Tracy.hpp>
+
+namespace Engine::Terrain {
+
+	namespace {
+		std::atomic<uint32_t> s_nextLayerId{1};
+	}
+
+	void VegetationLayer::Clear()
+	{
+		m_cells.clear();
+		m_positions.clear();
+		m_scales.clear();
+		m_prototypes.clear();
+		m_id = 0;
+	}
+
+	void VegetationLayer::Build(const std::vector<TreeInstance>& trees, const glm::vec3& size, uint32_t cellsPerSide)
+	{
+		ZoneScopedN("Build vegetation layer");
+		Clear();
+		m_id = s_nextLayerId.fetch_add(1, std::memory_order_relaxed);
+		if (trees.empty()) return;
+
+		const uint32_t cells = std::max<uint32_t>(cellsPerSide, 1);
+		auto cellOf = [&](const TreeInstance& tree) {
+			const uint32_t cx = std::min(static_cast<uint32_t>(std::max(tree.x, 0.0f) * float(cells)), cells - 1);
+			const uint32_t cz = std::min(static_cast<uint32_t>(std::max(tree.z, 0.0f) * float(cells)), cells - 1);
+			return cz * cells + cx;
+		};
+
+		// Counting sort by cell, so each cell's trees are contiguous.
+		m_cells.resize(static_cast<size_t>(cells) * cells);
+		for (const TreeInstance& tree : trees) ++m_cells[cellOf(tree)].count;
+		uint32_t offset = 0;
+		for (VegetationCell& cell : m_cells) {
+			cell.first = offset;
+			offset += cell.count;
+			cell.count = 0;
+		}
+
+		m_positions.resize(trees.size());
+		m_scales.resize(trees.size());
+		m_prototypes.resize(trees.size());
+		for (const TreeInstance& tree : trees) {
+			VegetationCell& cell  = m_cells[cellOf(tree)];
+			const uint32_t  index = cell.first + cell.count++;
+			const glm::vec3 p(tree.x * size.x, tree.y * size.y, tree.z * size.z);
+
+			m_positions[index]  = p;
+			m_scales[index]     = tree.scale;
+			m_prototypes[index] = static_cast<uint16_t>(std::min<uint32_t>(tree.prefabIndex, 0xFFFF));
+
+			if (cell.count == 1) {
+				cell.bounds.min = cell.bounds.max = p;
+				cell.maxScale                     = tree.scale;
+			}
+			else {
+				cell.bounds.min = glm::min(cell.bounds.min, p);
+				cell.bounds.max = glm::max(cell.bounds.max, p);
+				cell.maxScale   = std::max(cell.maxScale, tree.scale);
+			}
+		}
+
+		// Empty cells cost nothing to skip, but there is no reason to visit them at all.
+		m_cells.erase(std::remove_if(m_cells.begin(), m_cells.end(), [](const VegetationCell& cell) { return cell.count == 0; }), m_cells.end());
+	}
+
+	size_t VegetationLayer::GetMemoryBytes() const
+	{
+		return m_cells.size() * sizeof(VegetationCell) + m_positions.size() * (sizeof(glm::vec3) + sizeof(float) + sizeof(uint16_t));
+	}
+
+} // namespace Engine::Terrain
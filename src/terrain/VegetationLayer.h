@@ -0,0 +1,58 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "rendering/culling/Frustum.h"
+
+namespace Engine::Terrain {
+
+	/// One tree as the tile file stores it: position normalized to the tile's size.
+	struct TreeInstance {
+		float    x, y, z;
+		float    scale;
+		uint32_t prefabIndex;
+	};
+
+	/// A square cell of the tile and the trees whose trunk base lies inside it.
+	struct VegetationCell {
+		Rendering::AABB bounds;        // tile space, trunk bases only; grow by the prototype extents before culling
+		float           maxScale = 0;  // largest instance scale in the cell
+		uint32_t        first    = 0;  // [first, first + count) of the instance arrays
+		uint32_t        count    = 0;
+	};
+
+	/// Tree instances of a tile, binned into cells and stored as parallel arrays so culling only
+	/// streams the data it reads. Cells line up with the tile's terrain chunks. Knows nothing about
+	/// GL or physics; VegetationSystem draws and collides them.
+	class VegetationLayer {
+	  public:
+		/// Any thread. `size` scales the normalized tree positions into tile space.
+		void Build(const std::vector<TreeInstance>& trees, const glm::vec3& size, uint32_t cellsPerSide);
+		void Clear();
+
+		[[nodiscard]] const std::vector<VegetationCell>& GetCells() const { return m_cells; }
+		[[nodiscard]] const std::vector<glm::vec3>&      GetPositions() const { return m_positions; }
+		[[nodiscard]] const std::vector<float>&          GetScales() const { return m_scales; }
+		[[nodiscard]] const std::vector<uint16_t>&       GetPrototypes() const { return m_prototypes; }
+		[[nodiscard]] size_t                             GetInstanceCount() const { return m_positions.size(); }
+		[[nodiscard]] size_t                             GetMemoryBytes() const;
+
+		/// Unique per Build, so per-tile state elsewhere survives a tile being freed and its address reused.
+		[[nodiscard]] uint32_t GetId() const { return m_id; }
+
+	  private:
+		std::vector<VegetationCell> m_cells;
+		std::vector<glm::vec3>      m_positions;  // tile space
+		std::vector<float>          m_scales;
+		std::vector<uint16_t>       m_prototypes; // TreeInstance::prefabIndex
+		uint32_t                    m_id = 0;
+	};
+
+} // namespace Engine::Terrain
@@ -0,0 +1,432 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#include "VegetationSystem.h"
+
+#include "TerrainTile.h"
+#include "assets/AssetManager.h"
+#include "core/EngineData.h"
+#include "core/ThreadPool.h"
+#include "physics/PhysicsManager.h"
+#include "rendering/Model.h"
+#include "rendering/queue/GLInstanceBuffer.h"
+#include "rendering/queue/GLRenderCommands.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <tracy/Tracy.hpp>
+
+namespace Engine::Terrain {
+
+	namespace {
+		constexpr uint32_t kMaxCascades  = 32; // bits of a cascade mask
+		constexpr int      kCellsPerTask = 8;
+
+		/// Order-independent per-tree term of a cascade's shadow signature.
+		uint64_t ShadowKey(uint32_t layerId, uint32_t instance, uint32_t bucket)
+		{
+			uint64_t x = (uint64_t(layerId) << 32 | instance) ^ (uint64_t(bucket) * 0x9E3779B97F4A7C15ull);
+			x          = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+			x          = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+			return x ^ (x >> 31);
+		}
+
+		/// First set model at or before `band`, else the first one after it.
+		const ModelHandle* ResolveModel(const VegetationPrototype& prototype, uint32_t band)
+		{
+			for (int b = static_cast<int>(band); b >= 0; --b) {
+				if (prototype.models[b].IsValid()) return &prototype.models[b];
+			}
+			for (uint32_t b = band + 1; b < kVegetationBands; ++b) {
+				if (prototype.models[b].IsValid()) return &prototype.models[b];
+			}
+			return nullptr;
+		}
+
+		/// Tile-space box of a tree at `position`, or of every tree in a cell when `lo` != `hi`.
+		Rendering::AABB TreeBox(const Rendering::AABB& extent, const glm::vec3& lo, const glm::vec3& hi, float scale)
+		{
+			return {lo + extent.min * scale, hi + extent.max * scale};
+		}
+
+		float DistanceToBox(const Rendering::AABB& box, const glm::vec3& p)
+		{
+			const glm::vec3 d = glm::max(glm::max(box.min - p, p - box.max), glm::vec3(0.0f));
+			return glm::length(d);
+		}
+	} // namespace
+
+	void VegetationSystem::SetPrototype(uint32_t index, const VegetationPrototype& prototype)
+	{
+		if (index >= m_prototypes.size()) {
+			m_prototypes.resize(index + 1);
+			m_hasPrototype.resize(index + 1, false);
+		}
+		m_prototypes[index]   = prototype;
+		m_hasPrototype[index] = true;
+	}
+
+	void VegetationSystem::ClearPrototypes()
+	{
+		m_prototypes.clear();
+		m_hasPrototype.clear();
+	}
+
+	uint32_t VegetationSystem::GetSlot(uint32_t prefabIndex) const
+	{
+		// The default prototype takes the slot after the last registered one.
+		return prefabIndex < m_prototypes.size() && m_hasPrototype[prefabIndex] ? prefabIndex : static_cast<uint32_t>(m_prototypes.size());
+	}
+
+	const VegetationPrototype& VegetationSystem::GetSlotPrototype(uint32_t slot) const
+	{
+		return slot < m_prototypes.size() ? m_prototypes[slot] : m_default;
+	}
+
+	void VegetationSystem::EnsureDefaultModel()
+	{
+		if (m_defaultLoaded) return;
+		m_defaultLoaded = true;
+		if (!ResolveModel(m_default, kBandFull)) m_default.models[kBandFull] = GetAssetManager().LoadAsync<Rendering::Model>("assets/models/cylinder.obj");
+	}
+
+	void VegetationSystem::Prepare(const std::vector<PlacedTile>& tiles, const Rendering::Frustum* views, size_t viewCount, const glm::vec3& cameraPosition)
+	{
+		ZoneScopedN("Prepare vegetation");
+		m_stats.tiles = m_stats.cells = m_stats.cellsCulled = m_stats.instances = m_stats.shadowInstances = m_stats.draws = 0;
+		std::fill(std::begin(m_stats.drawn), std::end(m_stats.drawn), 0u);
+		m_camera.refs.clear();
+		m_camera.instances.clear();
+		m_camera.bucketFirst.clear();
+		m_shadow.refs.clear();
+		m_shadow.instances.clear();
+		m_shadow.bucketFirst.clear();
+		m_shadowSignatures.clear();
+		if (!settings.enabled || viewCount == 0) return;
+
+		EnsureDefaultModel();
+
+		// Conservative tree bounds: every loaded prototype model, X / Z made symmetric so impostor yaw stays inside.
+		const uint32_t slotCount = static_cast<uint32_t>(m_prototypes.size()) + 1;
+		float          maxEnd    = 0.0f;
+		bool           anyModel  = false;
+		m_extent                 = {};
+		for (uint32_t slot = 0; slot < slotCount; ++slot) {
+			if (slot < m_prototypes.size() && !m_hasPrototype[slot]) continue;
+			const VegetationPrototype& prototype = GetSlotPrototype(slot);
+			maxEnd                               = std::max(maxEnd, prototype.bandEnd[kVegetationBands - 1]);
+			for (const ModelHandle& handle : prototype.models) {
+				const Rendering::Model* model = handle.IsValid() ? GetAssetManager().Get(handle) : nullptr;
+				if (!model) continue;
+				const float     half = std::max({std::abs(model->m_boundsMin.x), std::abs(model->m_boundsMax.x), std::abs(model->m_boundsMin.z), std::abs(model->m_boundsMax.z)});
+				const glm::vec3 lo   = glm::vec3(-half, model->m_boundsMin.y, -half) * prototype.modelScale;
+				const glm::vec3 hi   = glm::vec3(half, model->m_boundsMax.y, half) * prototype.modelScale;
+				m_extent             = anyModel ? Rendering::AABB::Union(m_extent, {lo, hi}) : Rendering::AABB{lo, hi};
+				anyModel             = true;
+			}
+		}
+		if (!anyModel) return;
+		maxEnd *= settings.distanceScale;
+
+		m_jobs.clear();
+		m_tileCameras.resize(tiles.size());
+		for (uint32_t t = 0; t < tiles.size(); ++t) {
+			const VegetationLayer& layer = tiles[t].tile->vegetation;
+			m_tileCameras[t]             = glm::vec3(glm::inverse(tiles[t].model) * glm::vec4(cameraPosition, 1.0f));
+			for (uint32_t c = 0; c < layer.GetCells().size(); ++c) m_jobs.push_back({t, c});
+			m_stats.instances += static_cast<uint32_t>(layer.GetInstanceCount());
+			++m_stats.tiles;
+		}
+		m_stats.cells = static_cast<uint32_t>(m_jobs.size());
+		if (m_jobs.empty()) return;
+
+		const size_t   cascadeCount  = std::min<size_t>(viewCount - 1, kMaxCascades);
+		const bool     shadows       = settings.shadows && cascadeCount > 0;
+		const float    shadowEnd     = std::min(settings.shadowDistance, maxEnd);
+		const float    distanceScale = settings.distanceScale;
+		m_cameraRefs.resize(m_jobs.size());
+		m_shadowRefs.resize(m_jobs.size());
+		m_shadowJobKeys.assign(shadows ? m_jobs.size() * cascadeCount : 0, 0);
+
+		std::vector<uint8_t> culledCells(m_jobs.size(), 0);
+		GetThreadPool().ParallelFor(static_cast<int>(m_jobs.size()), kCellsPerTask, [&](int begin, int end) {
+			for (int j = begin; j < end; ++j) {
+				const CellJob&         job    = m_jobs[j];
+				const PlacedTile&      placed = tiles[job.tile];
+				const VegetationLayer& layer  = placed.tile->vegetation;
+				const VegetationCell&  cell   = layer.GetCells()[job.cell];
+				std::vector<Ref>&      camera = m_cameraRefs[j];
+				std::vector<Ref>&      shadow = m_shadowRefs[j];
+				camera.clear();
+				shadow.clear();
+
+				const Rendering::AABB cellBox  = Rendering::AABB::Transform(TreeBox(m_extent, cell.bounds.min, cell.bounds.max, cell.maxScale), placed.model);
+				const float           distance = DistanceToBox(cellBox, cameraPosition);
+				uint64_t*             keys     = shadows ? m_shadowJobKeys.data() + static_cast<size_t>(j) * cascadeCount : nullptr;
+				if (distance > maxEnd) {
+					culledCells[j] = 1;
+					continue;
+				}
+
+				// Planes the whole cell is inside of are skipped for its trees.
+				uint8_t    cameraMask    = Rendering::Frustum::kAllPlanes;
+				const bool cameraVisible = views[0].Test(cellBox, cameraMask) != Rendering::Frustum::Result::Outside;
+				uint32_t   cascades      = 0;
+				if (shadows && distance <= shadowEnd) {
+					for (size_t v = 0; v < cascadeCount; ++v) {
+						if (views[1 + v].Intersects(cellBox)) cascades |= 1u << v;
+					}
+				}
+				if (!cameraVisible) culledCells[j] = 1;
+				if (!cameraVisible && cascades == 0) continue;
+
+				const auto& positions  = layer.GetPositions();
+				const auto& scales     = layer.GetScales();
+				const auto& prototypes = layer.GetPrototypes();
+				for (uint32_t i = cell.first; i < cell.first + cell.count; ++i) {
+					const glm::vec3 world = glm::vec3(placed.model * glm::vec4(positions[i], 1.0f));
+					const float     d     = glm::distance(world, cameraPosition);
+
+					const uint32_t             slot      = GetSlot(prototypes[i]);
+					const VegetationPrototype& prototype = GetSlotPrototype(slot);
+					uint32_t                   band      = 0;
+					while (band < kVegetationBands && d > prototype.bandEnd[band] * distanceScale) ++band;
+					if (band == kVegetationBands) continue;
+
+					const Rendering::AABB box    = Rendering::AABB::Transform(TreeBox(m_extent, positions[i], positions[i], scales[i]), placed.model);
+					const uint32_t        bucket = slot * kVegetationBands + band;
+					if (cameraVisible) {
+						uint8_t mask = cameraMask;
+						if (mask == 0 || views[0].Test(box, mask) != Rendering::Frustum::Result::Outside) camera.push_back({job.tile, i, bucket});
+					}
+					if (cascades != 0 && band != kBandImpostor && prototype.castShadows && d <= shadowEnd) {
+						const uint64_t key    = ShadowKey(layer.GetId(), i, bucket);
+						bool           queued = false;
+						for (size_t v = 0; v < cascadeCount; ++v) {
+							if (!(cascades & (1u << v)) || !views[1 + v].Intersects(box)) continue;
+							if (!queued) shadow.push_back({job.tile, i, bucket});
+							queued   = true;
+							keys[v] += key;
+						}
+					}
+				}
+			}
+		});
+		for (uint8_t culled : culledCells) m_stats.cellsCulled += culled;
+		m_shadowSignatures.assign(shadows ? cascadeCount : 0, 0);
+		for (size_t k = 0; k < m_shadowJobKeys.size(); ++k) m_shadowSignatures[k % cascadeCount] += m_shadowJobKeys[k];
+
+		BuildPass(m_camera, m_cameraRefs, tiles);
+		if (shadows) BuildPass(m_shadow, m_shadowRefs, tiles);
+
+		for (uint32_t slot = 0; slot < slotCount; ++slot) {
+			for (uint32_t band = 0; band < kVegetationBands; ++band) {
+				const uint32_t b = slot * kVegetationBands + band;
+				m_stats.drawn[band] += m_camera.bucketFirst[b + 1] - m_camera.bucketFirst[b];
+			}
+		}
+		m_stats.shadowInstances = static_cast<uint32_t>(m_shadow.instances.size());
+
+		// Both passes draw from the shared per-frame instance buffer.
+		m_camera.baseInstance = Rendering::GLInstanceBuffer::Upload(m_camera.instances);
+		if (!m_shadow.instances.empty()) m_shadow.baseInstance = Rendering::GLInstanceBuffer::Upload(m_shadow.instances);
+	}
+
+	void VegetationSystem::BuildPass(Pass& pass, const std::vector<std::vector<Ref>>& perJob, const std::vector<PlacedTile>& tiles)
+	{
+		ZoneScopedN("Build vegetation instances");
+		const uint32_t buckets = (static_cast<uint32_t>(m_prototypes.size()) + 1) * kVegetationBands;
+
+		// Counting sort by bucket; job order keeps each bucket roughly sorted by cell.
+		pass.bucketFirst.assign(buckets + 1, 0);
+		for (const std::vector<Ref>& refs : perJob) {
+			for (const Ref& ref : refs) ++pass.bucketFirst[ref.bucket + 1];
+		}
+		for (uint32_t b = 0; b < buckets; ++b) pass.bucketFirst[b + 1] += pass.bucketFirst[b];
+
+		std::vector<uint32_t> cursor(pass.bucketFirst.begin(), pass.bucketFirst.end() - 1);
+		pass.refs.resize(pass.bucketFirst[buckets]);
+		for (const std::vector<Ref>& refs : perJob) {
+			for (const Ref& ref : refs) pass.refs[cursor[ref.bucket]++] = ref;
+		}
+
+		pass.instances.resize(pass.refs.size());
+		GetThreadPool().ParallelFor(static_cast<int>(pass.refs.size()), 256, [&](int begin, int end) {
+			for (int i = begin; i < end; ++i) {
+				const Ref&                 ref       = pass.refs[i];
+				const PlacedTile&          placed    = tiles[ref.tile];
+				const VegetationLayer&     layer     = placed.tile->vegetation;
+				const VegetationPrototype& prototype = GetSlotPrototype(ref.bucket / kVegetationBands);
+				const glm::vec3&           position  = layer.GetPositions()[ref.instance];
+				const float                scale     = layer.GetScales()[ref.instance] * prototype.modelScale;
+
+				glm::mat4 local = glm::translate(glm::mat4(1.0f), position);
+				if (ref.bucket % kVegetationBands == kBandImpostor) {
+					const glm::vec3 toCamera = m_tileCameras[ref.tile] - position;
+					local                    = glm::rotate(local, std::atan2(toCamera.x, toCamera.z), glm::vec3(0.0f, 1.0f, 0.0f));
+				}
+				Rendering::InstanceData& instance = pass.instances[i];
+				instance.world                    = placed.model * glm::scale(local, glm::vec3(scale));
+				instance.entity                   = static_cast<uint32_t>(entt::entity(entt::null));
+			}
+		});
+	}
+
+	void VegetationSystem::RenderGBuffer(const Shader& shader)
+	{
+		ZoneScopedN("Render vegetation GBuffer");
+		DrawPass(m_camera, shader, false);
+	}
+
+	void VegetationSystem::RenderShadows(const Shader& shader)
+	{
+		ZoneScopedN("Render vegetation shadows");
+		DrawPass(m_shadow, shader, true);
+	}
+
+	void VegetationSystem::DrawPass(const Pass& pass, const Shader& shader, bool shadowPass)
+	{
+		if (pass.instances.empty()) return;
+
+		Rendering::GLRenderCommands commands(shader, shadowPass ? Rendering::GLRenderCommands::kDepthOnly : Rendering::GLRenderCommands::kUploadMaterials);
+		Rendering::RenderQueueStats stats;
+		Rendering::StateTracker     state(commands, stats, true);
+		for (uint32_t bucket = 0; bucket + 1 < pass.bucketFirst.size(); ++bucket) {
+			const uint32_t first = pass.bucketFirst[bucket];
+			const uint32_t count = pass.bucketFirst[bucket + 1] - first;
+			if (count == 0) continue;
+
+			const VegetationPrototype& prototype = GetSlotPrototype(bucket / kVegetationBands);
+			const ModelHandle*         handle    = ResolveModel(prototype, bucket % kVegetationBands);
+			const Rendering::Model*    model     = handle ? GetAssetManager().Get(*handle) : nullptr;
+			if (!model) continue;
+
+			for (const auto& mesh : model->GetMeshes()) {
+				Rendering::DrawItem item;
+				item.material      = shadowPass ? Rendering::DepthOnlyMaterial(mesh->GetMaterial().get()) : mesh->GetMaterial().get();
+				item.vertexArray   = mesh->GetVAO();
+				item.indexCount    = mesh->GetIndexCount();
+				item.cullBackfaces = shadowPass || prototype.cullBackfaces; // depth always culls, like the static casters
+				state.Apply(item);
+				commands.DrawIndexedInstanced(item.indexCount, pass.baseInstance + first, count);
+				++m_stats.draws;
+			}
+		}
+		commands.End();
+	}
+
+	void VegetationSystem::UpdateColliders(const std::vector<PlacedTile>& tiles)
+	{
+		ZoneScopedN("Update vegetation colliders");
+		JPH::BodyInterface* bodies = GetPhysics().GetBodyInterface();
+		if (!bodies) return;
+
+		// Things that can hit a tree: the player and every awake dynamic / kinematic body.
+		m_colliderFoci.clear();
+		if (auto character = GetPhysics().GetCharacter()) {
+			const JPH::RVec3 p = character->GetPosition();
+			m_colliderFoci.emplace_back(p.GetX(), p.GetY(), p.GetZ());
+		}
+		JPH::BodyIDVector active;
+		GetPhysics().GetPhysicsSystem()->GetActiveBodies(JPH::EBodyType::RigidBody, active);
+		for (const JPH::BodyID& id : active) {
+			const JPH::RVec3 p = bodies->GetCenterOfMassPosition(id);
+			m_colliderFoci.emplace_back(p.GetX(), p.GetY(), p.GetZ());
+		}
+
+		for (auto& [key, collider] : m_colliders) collider.used = false;
+
+		// A collider is made within colliderRadius and kept until twice as far, so trees at the
+		// edge do not churn bodies every frame.
+		const float createRadius = settings.colliderRadius;
+		const float keepRadius   = createRadius * 2.0f;
+		struct Candidate {
+			uint64_t key;
+			float    distance;
+			uint32_t tile;
+			uint32_t instance;
+		};
+		std::vector<Candidate> candidates;
+		if (settings.enabled && !m_colliderFoci.empty()) {
+			for (uint32_t t = 0; t < tiles.size(); ++t) {
+				const VegetationLayer& layer = tiles[t].tile->vegetation;
+				const auto&            positions = layer.GetPositions();
+				for (const VegetationCell& cell : layer.GetCells()) {
+					const Rendering::AABB box = Rendering::AABB::Transform(cell.bounds, tiles[t].model);
+					float                 near = keepRadius + 1.0f;
+					for (const glm::vec3& focus : m_colliderFoci) near = std::min(near, DistanceToBox(box, focus));
+					if (near > keepRadius) continue;
+
+					for (uint32_t i = cell.first; i < cell.first + cell.count; ++i) {
+						const VegetationPrototype& prototype = GetSlotPrototype(GetSlot(layer.GetPrototypes()[i]));
+						if (prototype.colliderRadius <= 0.0f) continue;
+						const glm::vec3 world = glm::vec3(tiles[t].model * glm::vec4(positions[i], 1.0f));
+						float           d     = keepRadius + 1.0f;
+						for (const glm::vec3& focus : m_colliderFoci) d = std::min(d, glm::distance(world, focus));
+						if (d <= keepRadius) candidates.push_back({(uint64_t(layer.GetId()) << 32) | i, d, t, i});
+					}
+				}
+			}
+		}
+
+		// Nearest first, so the budget goes to the trees most likely to be hit.
+		std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) { return a.distance < b.distance; });
+		uint32_t kept = 0;
+		for (const Candidate& candidate : candidates) {
+			if (kept >= settings.maxColliders) break;
+			auto it = m_colliders.find(candidate.key);
+			if (it == m_colliders.end()) {
+				if (candidate.distance > createRadius) continue;
+
+				const PlacedTile&          placed    = tiles[candidate.tile];
+				const VegetationLayer&     layer     = placed.tile->vegetation;
+				const VegetationPrototype& prototype = GetSlotPrototype(GetSlot(layer.GetPrototypes()[candidate.instance]));
+				const float                scale     = layer.GetScales()[candidate.instance];
+				const float                radius    = prototype.colliderRadius * scale;
+				const float                half      = prototype.colliderHalfHeight * scale;
+				const glm::vec3            centre    = glm::vec3(placed.model * glm::vec4(layer.GetPositions()[candidate.instance] + glm::vec3(0.0f, half, 0.0f), 1.0f));
+
+				const JPH::Ref<JPH::Shape>      shape = new JPH::CylinderShape(half, radius, std::min(JPH::cDefaultConvexRadius, 0.5f * std::min(half, radius)));
+				const JPH::BodyCreationSettings bodySettings(shape, JPH::RVec3(centre.x, centre.y, centre.z), JPH::Quat::sIdentity(), JPH::EMotionType::Static, Layers::NON_MOVING);
+				const JPH::BodyID               body = bodies->CreateAndAddBody(bodySettings, JPH::EActivation::DontActivate);
+				if (body.IsInvalid()) break; // out of bodies
+				it = m_colliders.emplace(candidate.key, Collider{body, false}).first;
+			}
+			else {
+				GetPhysics().KeepBodyAdded(it->second.body);
+			}
+			it->second.used = true;
+			++kept;
+		}
+
+		for (auto it = m_colliders.begin(); it != m_colliders.end();) {
+			if (it->second.used) {
+				++it;
+				continue;
+			}
+			if (bodies->IsAdded(it->second.body)) bodies->RemoveBody(it->second.body);
+			bodies->DestroyBody(it->second.body);
+			it = m_colliders.erase(it);
+		}
+		m_stats.colliders = static_cast<uint32_t>(m_colliders.size());
+	}
+
+	void VegetationSystem::ClearColliders()
+	{
+		if (JPH::BodyInterface* bodies = GetPhysics().GetBodyInterface()) {
+			for (auto& [key, collider] : m_colliders) {
+				if (bodies->IsAdded(collider.body)) bodies->RemoveBody(collider.body);
+				bodies->DestroyBody(collider.body);
+			}
+		}
+		m_colliders.clear();
+		m_stats.colliders = 0;
+	}
+
+} // namespace Engine::Terrain
+
+#include "assets/AssetManager.inl"
@@ -0,0 +1,161 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Jolt/Jolt.h"
+#include "Jolt/Physics/Body/BodyID.h"
+
+#include "assets/AssetHandle.h"
+#include "rendering/culling/Frustum.h"
+#include "rendering/queue/InstanceBatcher.h"
+
+namespace Engine {
+	class Shader;
+}
+
+namespace Engine::Terrain {
+
+	class TerrainTile;
+
+	/// Distance bands, nearest first. Past the last band's end a tree is not drawn.
+	enum VegetationBand : uint8_t {
+		kBandFull,
+		kBandLod,
+		kBandImpostor, // drawn turned about Y to face the camera
+		kVegetationBands,
+	};
+
+	/// What a TreeInstance::prefabIndex draws and collides as.
+	struct VegetationPrototype {
+		/// Per band; an unset slot uses the nearest set band before it. The impostor is a vertical
+		/// card facing +Z, e.g. a quad with a baked side view of the tree.
+		ModelHandle models[kVegetationBands];
+		float       bandEnd[kVegetationBands] = {40.0f, 120.0f, 400.0f}; // world units from the camera
+		float       modelScale                = 1.0f;                     // times the instance scale
+		float       colliderRadius            = 0.25f;                    // trunk cylinder, times the instance scale; 0 = none
+		float       colliderHalfHeight        = 2.5f;
+		bool        castShadows               = true; // impostors never do
+		bool        cullBackfaces             = false;
+	};
+
+	struct VegetationSettings {
+		bool     enabled        = true;
+		float    distanceScale  = 1.0f;   // multiplies every prototype's band ends
+		bool     shadows        = true;
+		float    shadowDistance = 150.0f; // trees farther from the camera cast no shadow
+		float    colliderRadius = 20.0f;  // trees within this of the player or an awake body get a collider
+		uint32_t maxColliders   = 256;    // shares PhysicsManager's cMaxBodies with everything else
+	};
+
+	struct VegetationStats {
+		uint32_t tiles           = 0;
+		uint32_t cells           = 0;
+		uint32_t cellsCulled     = 0; // by the camera
+		uint32_t instances       = 0;
+		uint32_t drawn[kVegetationBands]{};
+		uint32_t shadowInstances = 0;
+		uint32_t draws           = 0; // instanced draw calls, GBuffer + shadow
+		uint32_t colliders       = 0;
+	};
+
+	/// A tile placed in the world this frame.
+	struct PlacedTile {
+		TerrainTile* tile = nullptr;
+		glm::mat4    model{1.0f};
+	};
+
+	/// Draws every tile's VegetationLayer with instancing and gives nearby trees colliders.
+	///
+	/// Prepare culls each cell against the camera and the shadow cascades on the ThreadPool, picks a
+	/// band per tree by camera distance and builds one instance range per (prototype, band). The
+	/// GBuffer and shadow passes then draw each range with one instanced call per mesh.
+	/// Colliders are static cylinders that exist only while the player or an awake dynamic body is
+	/// near the tree, so the body count stays small however many trees the world has.
+	class VegetationSystem {
+	  public:
+		/// Indices without a prototype draw as `GetDefaultPrototype()`.
+		void                       SetPrototype(uint32_t index, const VegetationPrototype& prototype);
+		void                       ClearPrototypes();
+		[[nodiscard]] size_t       GetPrototypeCount() const { return m_prototypes.size(); }
+		VegetationPrototype&       GetDefaultPrototype() { return m_default; }
+
+		/// Main thread, once per frame before the shadow pass. `views[0]` is the camera, the rest are shadow cascades.
+		void Prepare(const std::vector<PlacedTile>& tiles, const Rendering::Frustum* views, size_t viewCount, const glm::vec3& cameraPosition);
+		/// Draw what Prepare selected. The shader must take per-instance world matrices.
+		void RenderGBuffer(const Shader& shader);
+		void RenderShadows(const Shader& shader);
+		/// Changes whenever the trees Prepare picked for shadow cascade `cascade` change (0 = none).
+		[[nodiscard]] uint64_t GetShadowSignature(size_t cascade) const { return cascade < m_shadowSignatures.size() ? m_shadowSignatures[cascade] : 0; }
+
+		/// Main thread: add colliders around the player / awake bodies, drop those left behind
+		/// or on tiles that are gone.
+		void UpdateColliders(const std::vector<PlacedTile>& tiles);
+		/// Destroy every collider.
+		void ClearColliders();
+
+		[[nodiscard]] const VegetationStats& GetStats() const { return m_stats; }
+		VegetationSettings                   settings;
+
+	  private:
+		/// A tree picked for a pass: which tile and instance, and which instance range it goes to.
+		struct Ref {
+			uint32_t tile;
+			uint32_t instance;
+			uint32_t bucket; // prototype * kVegetationBands + band
+		};
+
+		struct CellJob {
+			uint32_t tile;
+			uint32_t cell;
+		};
+
+		/// Ordered by bucket, instances of one bucket are contiguous.
+		struct Pass {
+			std::vector<Ref>                      refs;
+			std::vector<Rendering::InstanceData>  instances;
+			std::vector<uint32_t>                 bucketFirst; // per bucket, into `instances`; one past the last entry
+			uint32_t                              baseInstance = 0;
+		};
+
+		struct Collider {
+			JPH::BodyID body;
+			bool        used = false; // wanted by this UpdateColliders
+		};
+
+		void                                     EnsureDefaultModel();
+		[[nodiscard]] uint32_t                   GetSlot(uint32_t prefabIndex) const;
+		[[nodiscard]] const VegetationPrototype& GetSlotPrototype(uint32_t slot) const;
+		/// Gather the per-job refs by bucket and build their instance data.
+		void BuildPass(Pass& pass, const std::vector<std::vector<Ref>>& perJob, const std::vector<PlacedTile>& tiles);
+		void DrawPass(const Pass& pass, const Shader& shader, bool shadowPass);
+
+		std::vector<VegetationPrototype> m_prototypes;
+		std::vector<bool>                m_hasPrototype; // SetPrototype was called for the index
+		VegetationPrototype              m_default;
+		bool                             m_defaultLoaded = false;
+		Rendering::AABB                  m_extent;       // union of the prototype models at instance scale 1, symmetric in X / Z
+
+		std::vector<CellJob>            m_jobs;
+		std::vector<std::vector<Ref>>   m_cameraRefs; // per job
+		std::vector<std::vector<Ref>>   m_shadowRefs; // per job
+		std::vector<glm::vec3>          m_tileCameras; // camera position in each tile's space, for impostor yaw
+		std::vector<uint64_t>           m_shadowJobKeys;    // per job * cascade: sum of ShadowKey of its shadow trees
+		std::vector<uint64_t>           m_shadowSignatures; // per cascade
+		Pass                            m_camera;
+		Pass                            m_shadow;
+
+		std::unordered_map<uint64_t, Collider> m_colliders; // (layer id << 32) | instance
+		std::vector<glm::vec3>                 m_colliderFoci;
+
+		VegetationStats m_stats;
+	};
+
+} // namespace Engine::Terrain
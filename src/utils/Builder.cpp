@@ -9,7 +9,7 @@
 
 #include <cstdlib>
 #include "core/EngineData.h"
-#include "assets/impl/BinarySceneLoader.h"
+#include "assets/impl/PackedSceneLoader.h"
 #include <sol/sol.hpp>
 #include <fstream>
 
@@ -17,11 +17,135 @@
 #include "rendering/ui/EditorSession.h"
 #include "utils/StartupScene.h"
 
+#include "animation/Animation.h"
+#include "animation/Skeleton.h"
+#include "assets/AssetManager.h"
+#include "assets/AssetPack.h"
+#include "assets/Prefab.h"
+#include "rendering/Model.h"
+#include "rendering/Texture.h"
+#include "rendering/particles/Particle.h"
+#include "sound/SoundManager.h"
+#include "terrain/TerrainTile.h"
+
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <unordered_set>
+
 namespace Engine {
 	namespace fs = std::filesystem;
 
 
-	void CopyResourcesAssets(const fs::path& sourceRoot, const fs::path& outRoot)
+	using AssetPackFormat::AssetType;
+
+	/// What LoadGameAssets would load `path` as; nullopt for files it skips.
+	std::optional<AssetType> PackedAssetType(const fs::path& path)
+	{
+		const std::string ext = path.extension().string();
+		if (ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".dds") return AssetType::Texture;
+		if (ext == ".obj") return AssetType::Model;
+		if (ext == ".wav") return AssetType::Sound;
+		if (ext == ".material") return AssetType::Material;
+		if (ext == ".anim") return AssetType::Animation;
+		if (ext == ".bin") return AssetType::Terrain;
+		if (ext == ".efk") return AssetType::Particle;
+		if (ext == ".prefab") return AssetType::Prefab;
+		if (ext != ".ozz") return std::nullopt;
+
+		// .ozz is shared by clips / skeletons / skinned meshes; only clips and skeletons are assets.
+		try {
+			std::ifstream  file(path.string() + ".meta");
+			nlohmann::json j;
+			file >> j;
+			const std::string type = j.value("type", "");
+			if (type.find("Skeleton") != std::string::npos) return AssetType::Skeleton;
+			if (type.find("Animation") != std::string::npos && type.find("offline") == std::string::npos) return AssetType::Animation;
+		}
+		catch (...) {
+			// no or malformed meta: not loaded at startup either
+		}
+		return std::nullopt;
+	}
+
+	/// Cooked entry if T's loader cooks `path`, else a loose entry (the file ships as is, its GUID in the pack).
+	template <typename T>
+	bool AddToPack(AssetPackWriter& pack, AssetType type, const std::string& path)
+	{
+		auto&             manager = GetAssetManager();
+		const std::string guid    = manager.EnsureMetaFile<T>(path);
+		auto&             loader  = manager.GetStorage<T>().loader;
+
+		std::vector<uint8_t> cooked;
+		try {
+			if (loader && loader->SupportsCooking() && loader->Cook(path, cooked)) {
+				pack.AddCooked(type, guid, path, std::move(cooked));
+				return true;
+			}
+		}
+		catch (const std::exception& e) {
+			GetDefaultLogger()->warn("Could not cook {}: {}", path, e.what());
+		}
+		pack.AddLoose(type, guid, path);
+		return false;
+	}
+
+	/// Cook every startup asset under resources/ and assets/ into `packPath`. Returns the project-relative
+	/// paths that no longer need to ship as files (cooked sources and their .meta).
+	std::unordered_set<std::string> CookAssets(const fs::path& sourceRoot, const fs::path& packPath)
+	{
+		AssetPackWriter                 pack;
+		std::unordered_set<std::string> replaced;
+		std::unordered_set<std::string> seen;
+		size_t                          cookedCount = 0;
+
+		for (const char* folder : {"resources", "assets"}) {
+			const fs::path root = sourceRoot / folder;
+			if (!fs::is_directory(root)) continue;
+
+			for (const auto& entry : fs::recursive_directory_iterator(root)) {
+				if (!entry.is_regular_file()) continue;
+				const std::string filename = entry.path().filename().string();
+				if (!filename.empty() && filename[0] == '.') continue;
+
+				const std::optional<AssetType> type = PackedAssetType(entry.path());
+				if (!type) continue;
+
+				const std::string relative = fs::relative(entry.path(), sourceRoot).generic_string();
+				const std::string path     = NormalizePath(relative);
+				if (!seen.insert(path).second) continue;
+
+				bool cooked = false;
+				switch (*type) {
+					case AssetType::Texture: cooked = AddToPack<Texture>(pack, *type, path); break;
+					case AssetType::Model: cooked = AddToPack<Rendering::Model>(pack, *type, path); break;
+					case AssetType::Sound: cooked = AddToPack<Audio::SoundBuffer>(pack, *type, path); break;
+					case AssetType::Material: cooked = AddToPack<Material>(pack, *type, path); break;
+					case AssetType::Animation: cooked = AddToPack<Animation>(pack, *type, path); break;
+					case AssetType::Skeleton: cooked = AddToPack<Skeleton>(pack, *type, path); break;
+					case AssetType::Prefab: cooked = AddToPack<Prefab>(pack, *type, path); break;
+					case AssetType::Terrain: cooked = AddToPack<Terrain::TerrainTile>(pack, *type, path); break;
+					case AssetType::Particle: cooked = AddToPack<Particle>(pack, *type, path); break;
+				}
+				if (!cooked) continue;
+				++cookedCount;
+				// Images stay on disk: particle effects, UI and the skybox read them by path.
+				if (*type != AssetType::Texture) {
+					replaced.insert(relative);
+					replaced.insert(relative + ".meta");
+				}
+			}
+		}
+
+		if (!pack.Save(packPath.string())) {
+			GetDefaultLogger()->error("Could not write asset pack {}", packPath.string());
+			return {};
+		}
+		GetDefaultLogger()->info("Cooked {} of {} assets into {}", cookedCount, pack.EntryCount(), packPath.string());
+		return replaced;
+	}
+
+	/// Copy resources/ and assets/ (minus resources/engine), skipping project-relative paths in `skip`.
+	void CopyResourcesAssets(const fs::path& sourceRoot, const fs::path& outRoot, const std::unordered_set<std::string>& skip)
 	{
         fs::path sourceResources = sourceRoot / "resources";
 		fs::path outResources    = outRoot / "resources";
@@ -40,6 +164,7 @@ namespace Engine {
 
                     // Skip anything under "engine" folder
                     if (!relativePath.empty() && relativePath.begin()->string() == "engine") continue;
+                    if (skip.count(("resources" / relativePath).generic_string())) continue;
 
                     fs::path destPath = outResources / relativePath;
 
@@ -69,6 +194,7 @@ namespace Engine {
 
                     // Skip anything under "engine" folder
                     if (!relativePath.empty() && relativePath.begin()->string() == "engine") continue;
+                    if (skip.count(("assets" / relativePath).generic_string())) continue;
 
                     fs::path destPath = outAssets / relativePath;
 
@@ -121,8 +247,9 @@ namespace Engine {
 		// Create output directory
 		CreateOutputDirectory(outPath);
 
-		// Copy resources
-        CopyResourcesAssets(fs::current_path(), outPath);
+		// Cook assets into the pack, then copy whatever still has to ship as a file
+		const std::unordered_set<std::string> cooked = CookAssets(fs::current_path(), outPath / kAssetPackPath);
+        CopyResourcesAssets(fs::current_path(), outPath, cooked);
 
 		// Pre-compile scripts
 
@@ -210,7 +337,7 @@ namespace Engine {
 		const fs::path projBin = fs::current_path() / sceneBinRel;
 		fs::create_directories(outBin.parent_path());
 
-		BinarySceneLoader::SerializeScene(GetSceneManager().GetActiveScene(), outBin.string());
+		PackedSceneLoader::SerializeScene(GetSceneManager().GetActiveScene(), outBin.string());
 		GetDefaultLogger()->info("Packed current scene {} -> {}", UI::GetEditor().scenePath, outBin.string());
 
 		{
@@ -265,4 +392,6 @@ namespace Engine {
 		}
 
     }
-} // namespace Engine
\ No newline at end of file
+} // namespace Engine
+
+#include "assets/AssetManager.inl"
@@ -0,0 +1,41 @@
+//
+// Created by gabe on 10/18/26.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Engine {
+
+	/// Read-only memory mapping of a whole file. The view stays valid until Close() or destruction.
+	class MappedFile {
+	  public:
+		MappedFile() = default;
+		~MappedFile() { Close(); }
+
+		MappedFile(const MappedFile&)            = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		/// False (and closed) if the file is missing, empty or cannot be mapped.
+		bool Open(const std::string& path);
+		void Close();
+
+		[[nodiscard]] bool           IsOpen() const { return m_data != nullptr; }
+		[[nodiscard]] const uint8_t* Data() const { return m_data; }
+		[[nodiscard]] size_t         Size() const { return m_size; }
+
+	  private:
+		const uint8_t* m_data = nullptr;
+		size_t         m_size = 0;
+#ifdef _WIN32
+		void* m_file    = nullptr;
+		void* m_mapping = nullptr;
+#else
+		int m_fd = -1;
+#endif
+	};
+
+} // namespace Engine